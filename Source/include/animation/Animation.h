@@ -3,9 +3,12 @@
 #include <game/GameManager.h> //for HTreeObjectLoc
 #include <glfw/glfw3.h>
 #include <assimp/types.h>
+#include <map>
+#include <mutex>
 
 struct aiNodeAnim;
 struct aiAnimation;
+struct aiNode;
 
 
 namespace GEE
@@ -128,20 +131,92 @@ namespace GEE
 		std::vector<std::shared_ptr<AnimationVecKey>> PosKeys;
 		std::vector<std::shared_ptr<AnimationQuatKey>> RotKeys;
 		std::vector<std::shared_ptr<AnimationVecKey>> ScaleKeys;
+		std::vector<std::shared_ptr<AnimationVecKey>> InPlacePosKeys;	//Only filled for the root motion channel: PosKeys with the root motion removed
 		AnimationChannel(aiNodeAnim*, float tickPerSecond);
 	};
 
-	struct Animation
+	struct AnimationNotify
 	{
+		float Time;
+		std::string Name;
+		AnimationNotify(float time, const std::string& name) :
+			Time(time),
+			Name(name)
+		{
+		}
+	};
+
+	/**
+	 * @brief Horizontal (XZ) displacement of the root channel, extracted once when the clip is cooked. Keys are relative to the first position key and expressed in the space of the root channel's parent.
+	*/
+	struct RootMotionTrack
+	{
+		std::string ChannelName;
+		std::vector<AnimationVecKey> Keys;
+
+		bool IsEmpty() const;
+		glm::vec3 Sample(float time) const;
+	};
+
+	/**
+	 * @brief The keyframe data of an animation. A clip is immutable once it has been added to AnimationClipCache, so it can be shared by every HierarchyTreeT that loads the same file and every AnimationInstance that plays it.
+	*/
+	struct AnimationClip
+	{
+		std::string Name;
 		std::vector<std::shared_ptr<AnimationChannel>> Channels;
+		float Duration;
+		RootMotionTrack RootMotion;
+		std::vector<AnimationNotify> Notifies;	//Sorted by time
+
+		AnimationClip(aiAnimation*);
+
+		/**
+		 * @brief Extracts the root motion of the clip. The root channel is the animated node closest to the scene root. Its horizontal displacement is moved to RootMotion and the in place variant of its position keys is stored in InPlacePosKeys, so the skeleton's root can stay in place while the character is moved by the delta.
+		 * @param sceneRoot: root node of the assimp scene the clip comes from
+		*/
+		void CookRootMotion(const aiNode* sceneRoot);
+		void AddNotify(float time, const std::string& name);
+	};
+
+	/**
+	 * @brief Global registry of loaded animation clips, keyed by the source file path and the clip name.
+	 * The cache does not own the clips - they are reference counted by the Animations and AnimationInstances using them, and an entry expires once its last user is destroyed.
+	 * The cache is guarded by a mutex, so hierarchy trees can be loaded by jobs (e.g. when streaming level cells).
+	*/
+	class AnimationClipCache
+	{
+	public:
+		/**
+		 * @return the cached clip, or nullptr if the clip has not been loaded or has already expired
+		*/
+		static std::shared_ptr<const AnimationClip> Find(const std::string& sourcePath, const std::string& clipName);
+		/**
+		 * @brief Adds a clip to the cache. The clip must not be modified afterwards.
+		 * @return the passed clip, or the clip that had been cached under the same key before (the passed clip is then discarded)
+		*/
+		static std::shared_ptr<const AnimationClip> Add(const std::string& sourcePath, std::shared_ptr<AnimationClip> clip);
+		static unsigned int GetClipCount();	//Returns the number of unique clips that are currently alive
+
+	private:
+		static void EraseExpired();	//ClipsMutex must be locked
+		static std::map<std::pair<std::string, std::string>, std::weak_ptr<const AnimationClip>> Clips;
+		static std::mutex ClipsMutex;
+	};
+
+	/**
+	 * @brief An animation of a HierarchyTreeT. Only the localization belongs to the tree; the keyframe data is shared through the clip.
+	*/
+	struct Animation
+	{
 		struct AnimationLoc : public HTreeObjectLoc	//exact localization of the animation
 		{
 			std::string Name;
 			AnimationLoc(HTreeObjectLoc treeObjectLoc, const std::string& name) : HTreeObjectLoc(treeObjectLoc), Name(name) {}
 		} Localization;
-		float Duration;
+		std::shared_ptr<const AnimationClip> Clip;
 
-		Animation(const HierarchyTemplate::HierarchyTreeT& tree, aiAnimation*);
+		Animation(const HierarchyTemplate::HierarchyTreeT& tree, std::shared_ptr<const AnimationClip> clip);
 	};
 
 	glm::vec3 aiToGlm(const aiVector3D&);
@@ -1,51 +1,76 @@
 #pragma once
 #include <animation/Animation.h>
 #include <scene/Component.h>
-#include <deque>
+#include <functional>
 
 namespace GEE
 {
+	class AnimationInstance;
+	class AnimationManagerComponent;
+
+	struct AnimationNotifyEvent
+	{
+		AnimationManagerComponent& Manager;
+		const AnimationInstance& Instance;
+		const AnimationNotify& Notify;
+	};
+
+	/**
+	 * @brief The playback cursor of a single channel. The keys are sampled directly from the shared clip, so an instance holds no keyframe data of its own - only the current time and the index of the current key of every track.
+	*/
 	struct AnimationChannelInstance
 	{
-		AnimationChannel& ChannelRef;
+		const AnimationChannel& ChannelRef;
 		Component& ChannelComp;
 
 		bool IsValid;
+		bool UseInPlaceKeys;	//Use ChannelRef.InPlacePosKeys (if there are any) instead of PosKeys; set for the root channel when root motion is applied to the character
+		bool bPlaying;			//Restarted and not stopped
 
-		std::deque<std::unique_ptr<Interpolator<glm::vec3>>> PosKeysLeft, ScaleKeysLeft;
-		std::deque<std::unique_ptr<Interpolator<glm::quat>>> RotKeysLeft;
+		float Time;
+		float EndTime;			//The time of the last key of the channel
+		unsigned int PosKeyIndex, RotKeyIndex, ScaleKeyIndex;	//The last key of every track that is not later than Time
 
-		AnimationChannelInstance(AnimationChannel&, Component&);
+		AnimationChannelInstance(const AnimationChannel&, Component&);
 		void Restart();
 		void Stop();
-		float GetTimeLeft()
-		{
-			float timeLeft = 0.0f;
-			for (auto& it : PosKeysLeft)
-				timeLeft += (1.0f - it->GetInterp()->GetT()) * it->GetInterp()->GetDuration();
-
-			return timeLeft;
-		}
+		float GetTimeLeft() const;
 		bool Update(float);	//Returns true if animation is taking place, false otherwise
-
+		void Sample();		//Writes the values at the current time to the transform of the component
 	};
 
 	class AnimationInstance
 	{
 		Animation& Anim;
+		std::shared_ptr<const AnimationClip> Clip;	//Keeps the shared clip data alive for as long as the instance is played
 		Component& AnimRootComp;
-		std::vector<std::unique_ptr<AnimationChannelInstance>> ChannelInstances;
+		std::vector<AnimationChannelInstance> ChannelInstances;
 		float TimePassed;
 
 		bool IsValid;
 
+		AnimationChannelInstance* RootMotionChannel;
+		bool bRootMotion;
+		glm::vec3 PendingRootMotion;	//World space
+
 	public:
 		AnimationInstance(Animation&, Component&);
+		AnimationInstance(const AnimationInstance&) = delete;	//RootMotionChannel points into ChannelInstances
+		AnimationInstance(AnimationInstance&&) = default;
 
 		Animation::AnimationLoc GetLocalization() const;
 		Animation& GetAnimation() const;
+		const AnimationClip& GetClip() const;
 		bool HasFinished() const;
-		void Update(float);
+		bool HasRootMotion() const;
+		void SetRootMotionEnabled(bool);	//If enabled, the root channel is played in place and its displacement is accumulated instead. Takes effect immediately, also if the instance is being played
+		glm::vec3 ConsumeRootMotion();	//Returns the world space root motion accumulated since the last call
+		/**
+		 * @brief Advances the animation.
+		 * @param deltaTime: time step
+		 * @param crossedNotifies: (optional) notifies of the clip within the [TimePassed, TimePassed + deltaTime) window are appended here
+		*/
+		void Update(float deltaTime, std::vector<const AnimationNotify*>* crossedNotifies = nullptr);
 		void Stop();
 		void Restart();
 
@@ -82,6 +107,14 @@ namespace GEE
 		std::vector<std::unique_ptr<AnimationInstance>> AnimInstances;
 		AnimationInstance* CurrentAnim;
 
+		bool bRootMotion;
+		glm::vec3 PendingRootMotion;
+
+		std::vector<std::pair<unsigned int, std::function<void(const AnimationNotifyEvent&)>>> NotifyListeners;	//With the IDs returned by AddNotifyListener
+		unsigned int NextNotifyListenerID;
+		std::vector<std::pair<AnimationInstance*, const AnimationNotify*>> PendingNotifies;
+		std::vector<const AnimationNotify*> CrossedNotifiesCache;
+
 	public:
 		AnimationManagerComponent(Actor&, Component* parentComp, const std::string& name);
 
@@ -91,14 +124,33 @@ namespace GEE
 
 		void AddAnimationInstance(AnimationInstance&&);
 
+		bool IsRootMotionEnabled() const;
+		/**
+		 * @brief Enable to keep the skeleton's root in place and let the owner of the character (e.g. Controller) move it by the extracted root motion.
+		*/
+		void SetRootMotionEnabled(bool);
+		glm::vec3 ConsumeRootMotion();	//Returns the world space root motion accumulated since the last call. Apply it once per frame to the character
+
+		/**
+		 * @brief Register a function to be called for every notify crossed by the animations of this manager. Notifies are collected during the update and dispatched by the scene in one batch after all actors have been updated.
+		 * @param listener: the function to be called
+		 * @return the ID of the listener, for RemoveNotifyListener
+		*/
+		unsigned int AddNotifyListener(std::function<void(const AnimationNotifyEvent&)> listener);
+		void RemoveNotifyListener(unsigned int listenerID);
+		void DispatchNotifies();	//Called by GameScene after the update stage
+
 		virtual void Update(float) override;
 		void SelectAnimation(AnimationInstance*);
 
+		virtual ~AnimationManagerComponent();
+
 		virtual void GetEditorDescription(EditorDescriptionBuilder) override;
 
 		template <typename Archive> void Save(Archive& archive) const
 		{
 			archive(cereal::make_nvp("AnimInstances", cereal::defer(AnimInstances)), cereal::make_nvp("CurrentAnimName", std::string((CurrentAnim) ? (CurrentAnim->GetLocalization().Name) : (""))), cereal::base_class<Component>(this));
+			archive(cereal::make_nvp("RootMotion", bRootMotion));
 		}
 		template <typename Archive> void Load(Archive& archive)
 		{
@@ -106,6 +158,14 @@ namespace GEE
 			std::string currentAnimName;
 			archive(cereal::make_nvp("AnimInstances", cereal::defer(AnimInstances)), cereal::make_nvp("CurrentAnimName", currentAnimName), cereal::base_class<Component>(this));
 
+			bool rootMotion = false;
+			try
+			{
+				archive(cereal::make_nvp("RootMotion", rootMotion));
+			}
+			catch (cereal::Exception&) {}	//Saved before root motion could be enabled; the JSON archive throws before changing its position
+			GetScene().AddPostLoadLambda([this, rootMotion]() { SetRootMotionEnabled(rootMotion); });	//The instances are deferred, so they are loaded after this component
+
 			if (!currentAnimName.empty())
 				for (auto& it : AnimInstances)
 					if (it->GetLocalization().Name == currentAnimName)
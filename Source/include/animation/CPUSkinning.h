@@ -0,0 +1,59 @@
+#pragma once
+#include <rendering/Mesh.h>
+
+namespace GEE
+{
+	namespace CPUSkinning
+	{
+		/**
+		 * @brief Skins vertices the same way geometry.vs does: positions by the weighted bone matrix, normals, tangents and bitangents by its upper 3x3 part. Vertices with no bones bound (first ID and weight equal to 0) are copied unchanged.
+		 * The bone data of the output vertices is cleared, so the skinned shaders treat them as already skinned.
+		 * @param src: bind pose vertices
+		 * @param dst: output vertices (must hold count vertices; may not alias src)
+		 * @param count: number of vertices
+		 * @param palette: bone matrices indexed by bone ID
+		*/
+		void SkinVerticesScalar(const Vertex* src, Vertex* dst, size_t count, const glm::mat4* palette);
+		void SkinVerticesSIMD(const Vertex* src, Vertex* dst, size_t count, const glm::mat4* palette);	//SSE kernel (AVX if compiled with it); falls back to the scalar one on other architectures
+		void SkinVertices(const Vertex* src, Vertex* dst, size_t count, const glm::mat4* palette);	//Uses the fastest available kernel
+
+		const char* GetSIMDKernelName();
+
+		/**
+		 * @brief Runs both kernels on randomly generated vertices and palette. Does not require a GL context.
+		 * @return the maximum absolute difference between any component of the scalar and SIMD outputs
+		*/
+		float ValidateSIMDKernel(size_t vertexCount = 4096, unsigned int boneCount = 64, unsigned int seed = 0);
+		/**
+		 * @brief Measures a kernel on randomly generated vertices and palette. Does not require a GL context.
+		 * @return average time of a single skinning pass in milliseconds
+		*/
+		double BenchmarkKernel(bool simd, size_t vertexCount = 65536, unsigned int boneCount = 64, unsigned int iterations = 100);
+	}
+
+	/**
+	 * @brief Dynamic vertex stream holding the CPU-skinned vertices of a single mesh instance. It shares the index buffer of the source mesh.
+	*/
+	class CPUSkinnedMesh
+	{
+	public:
+		CPUSkinnedMesh(const Mesh&);
+		CPUSkinnedMesh(const CPUSkinnedMesh&) = delete;
+		CPUSkinnedMesh& operator=(const CPUSkinnedMesh&) = delete;
+		~CPUSkinnedMesh();
+
+		bool IsValid() const;
+		bool IsUpToDate(unsigned long long frameIndex) const;
+		void Update(const glm::mat4* palette, unsigned long long frameIndex);	//Skins and uploads the vertices; call only if IsUpToDate returns false
+
+		void Bind() const;
+		void Render() const;
+
+	private:
+		const Mesh& MeshRef;
+		std::shared_ptr<const std::vector<Vertex>> BindPoseVerts;	//Shared with the mesh
+		std::vector<Vertex> SkinnedVerts;
+		unsigned int VAO, VBO;
+		unsigned long long SkinnedFrameIndex;
+	};
+}
@@ -7,6 +7,8 @@
 namespace GEE
 {
 	class SkeletonBatch;
+	class BonePaletteRing;
+	class RenderSnapshot;
 	class SkeletonInfo
 	{
 		std::vector<BoneComponent*> Bones;
@@ -15,6 +17,12 @@ namespace GEE
 
 		unsigned int BoneIDOffset;
 
+		//Palette slice in BonePaletteRing; valid only if PaletteFrameStamp matches the ring's current stamp
+		unsigned long long PaletteFrameStamp;
+		size_t PaletteOffset;
+		friend class BonePaletteRing;
+		friend class RenderSnapshot;
+
 	public:
 		SkeletonInfo();
 		unsigned int GetBoneCount();
@@ -25,6 +33,8 @@ namespace GEE
 		void SetBatchData(SkeletonBatch* batch, unsigned int idOffset);
 		bool VerifyGlobalInverseCompPtrLife();	//Call every frame
 		void FillMatricesVec(std::vector<glm::mat4>&);
+		unsigned int GetPaletteMatCount();	//Number of matrices needed to index every bone by its ID (max ID + 1)
+		void FillPalette(glm::mat4* palette, const RenderSnapshot* snapshot = nullptr);	//Writes bone matrices indexed by bone ID only (BoneIDOffset is ignored). The palette must hold GetPaletteMatCount() matrices. If a snapshot is passed, interpolated bone transforms are used
 		void AddBone(BoneComponent&);
 		void EraseBone(BoneComponent&);
 		void SortBones();	//Sorts bones by id. May improve performance
@@ -100,7 +110,7 @@ namespace GEE
 	{
 		std::vector<std::shared_ptr<SkeletonInfo>> Skeletons;
 		unsigned int BoneCount;
-		UniformBuffer BoneUBO;
+		friend class RenderSnapshot;
 
 	public:
 		SkeletonBatch();
@@ -110,7 +120,6 @@ namespace GEE
 		int GetBatchID();
 		void RecalculateBoneCount();
 		bool AddSkeleton(std::shared_ptr<SkeletonInfo>);
-		void BindToUBO();
 		void VerifySkeletonsLives();	//Call every frame
 
 		template <typename Archive> void Serialize(Archive& archive)
@@ -118,4 +127,40 @@ namespace GEE
 			archive(CEREAL_NVP(Skeletons), CEREAL_NVP(BoneCount));
 		}
 	};
+
+	/**
+	 * @brief Frame-indexed ring buffer of bone palettes, shared by every SkeletonBatch. The buffer is split into RegionCount regions and each frame writes to the next one, so palettes from the frames that the GPU may still be reading are never overwritten.
+	 * A SkeletonInfo gets its slice of the current region the first time it is bound in a frame; its matrices are uploaded once and every following skinned draw of that frame only rebinds the slice.
+	*/
+	class BonePaletteRing
+	{
+	public:
+		static constexpr unsigned int RegionCount = 3;
+
+		BonePaletteRing();
+		void Generate(unsigned int blockBindingSlot, unsigned int regionMatCapacity = 8192);
+		bool HasBeenGenerated() const;
+
+		void BeginFrame();	//Call once per frame, before any skinned mesh is rendered
+		/**
+		 * @brief Binds the palette slice of the skeleton to the bone matrices block. If the skeleton has not been bound in the current frame, a slice is allocated and its matrices are uploaded.
+		 * @param info: the skeleton whose palette should be bound
+		 * @param snapshot: (optional) the snapshot to take the interpolated bone transforms from
+		 * @return true if a palette was bound. Bone IDs in the bound palette are relative to the slice, so boneIDOffset should be 0
+		*/
+		bool BindPalette(SkeletonInfo& info, const RenderSnapshot* snapshot = nullptr);
+
+		void Dispose();
+
+	private:
+		bool Allocate(size_t size, size_t& offset);
+		void Grow();
+
+		UniformBuffer PaletteUBO;
+		size_t RegionSize, RegionOffset, OffsetAlignment;
+		unsigned int CurrentRegion;
+		unsigned long long FrameStamp;	//Changes every frame and every time the buffer is reallocated, invalidating all slices
+		bool bGrowRequested;
+		std::vector<glm::mat4> PaletteCache;
+	};
 }
\ No newline at end of file
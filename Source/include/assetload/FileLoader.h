@@ -19,6 +19,7 @@ namespace GEE
 	class Component;
 	class BoneMapping;
 	class SkeletonInfo;
+	struct AnimationClip;
 	namespace Physics
 	{
 		struct CollisionShape;
@@ -54,6 +55,12 @@ namespace GEE
 		static std::unique_ptr<Physics::CollisionObject> LoadCollisionObject(GameScene& scene, std::stringstream&);
 		static std::shared_ptr<Physics::CollisionShape> LoadTriangleMeshCollisionShape(Physics::PhysicsEngineManager* physicsHandle, const aiScene* scene, aiMesh&);
 		static void LoadLightProbes(GameScene&, std::stringstream&);
+		/**
+		 * @brief Loads the notify tracks from the sidecar file of a model (path + ".notify"), if it exists. Every line is: <animation name> <time in seconds> <notify name>.
+		 * @param path: the path of the model
+		 * @param clips: the clips to apply the notifies to. They must not have been added to AnimationClipCache yet
+		*/
+		static void LoadAnimationNotifies(const std::string& path, std::vector<std::shared_ptr<AnimationClip>>& clips);
 
 		static void LoadMeshFromAi(Mesh* meshPtr, const aiScene* scene, aiMesh* mesh, const HTreeObjectLoc& treeObjLoc, const std::string& directory = std::string(), bool bLoadMaterial = true, MaterialLoadingData* matLoadingData = nullptr, BoneMapping* = nullptr, bool keepVertsData = false);
 
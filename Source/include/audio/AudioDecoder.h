@@ -0,0 +1,104 @@
+#pragma once
+#include <AL/al.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace GEE
+{
+	namespace Audio
+	{
+		class VorbisStream;
+
+		/**
+		 * @brief Decodes an audio file incrementally into interleaved signed 16-bit or 32-bit float PCM frames (one sample per channel). Only mono and stereo files are supported.
+		 * A decoder does not call OpenAL, so it can be used from any thread - but only from one thread at a time.
+		*/
+		class AudioDecoder
+		{
+		public:
+			/**
+			 * @brief Opens a file with the decoder chosen by the extension of the path (wav or ogg).
+			 * @return nullptr if the format is not supported or the file could not be opened
+			*/
+			static std::unique_ptr<AudioDecoder> Open(const std::string& path);
+			virtual ~AudioDecoder() = default;
+
+			const std::string& GetPath() const;
+			unsigned int GetChannelCount() const;
+			unsigned int GetSampleRate() const;
+			size_t GetFrameCount() const;	//The length of the whole file in frames
+			float GetLengthInSeconds() const;
+			bool HasFloatSamples() const;	//True if the samples are stored (or decoded) as floats - ReadFloat returns them without a loss of precision
+			ALenum GetALFormat(bool floatSamples = false) const;	//AL_FORMAT_MONO16 / AL_FORMAT_STEREO16, or their AL_EXT_FLOAT32 counterparts
+
+			/**
+			 * @brief Decodes the next frames of the file.
+			 * @param frames: output; must fit frameCount * GetChannelCount() samples
+			 * @return the number of decoded frames - less than frameCount only at the end of the file (or if the file is truncated)
+			*/
+			virtual size_t Read(int16_t* frames, size_t frameCount) = 0;
+			virtual size_t ReadFloat(float* frames, size_t frameCount);	//Like Read, but the samples are in the [-1, 1] range
+			virtual bool Rewind() = 0;	//Goes back to the first frame
+
+		protected:
+			AudioDecoder(const std::string& path);
+
+			std::string Path;
+			unsigned int ChannelCount;
+			unsigned int SampleRate;
+			size_t FrameCount;
+			bool bFloatSamples;
+
+		private:
+			std::vector<int16_t> ConversionBuffer;	//Used by the default ReadFloat
+		};
+
+		/**
+		 * @brief Reads PCM (8, 16, 24 and 32-bit integer) and IEEE float (32-bit) WAV files. Samples that are not 16-bit are converted while they are read.
+		*/
+		class WavDecoder : public AudioDecoder
+		{
+		public:
+			WavDecoder(const std::string& path);
+			bool IsValid() const;	//False if the file could not be opened or its format is not supported
+
+			virtual size_t Read(int16_t* frames, size_t frameCount) override;
+			virtual size_t ReadFloat(float* frames, size_t frameCount) override;
+			virtual bool Rewind() override;
+
+		private:
+			bool ReadHeader();
+			size_t ReadRaw(size_t frameCount);	//Reads the samples of frameCount frames into ReadBuffer; returns the number of whole frames read
+
+			std::ifstream File;
+			std::streamoff DataOffset;	//Position of the first frame in the file
+			size_t FramesLeft;
+			unsigned int BytesPerSample;
+			std::vector<char> ReadBuffer;	//Raw samples read from the file before the conversion
+		};
+
+		/**
+		 * @brief Decodes Ogg Vorbis files (see VorbisStream).
+		*/
+		class OggVorbisDecoder : public AudioDecoder
+		{
+		public:
+			OggVorbisDecoder(const std::string& path);
+			OggVorbisDecoder(const OggVorbisDecoder&) = delete;
+			OggVorbisDecoder& operator=(const OggVorbisDecoder&) = delete;
+			virtual ~OggVorbisDecoder() override;
+			bool IsValid() const;
+
+			virtual size_t Read(int16_t* frames, size_t frameCount) override;
+			virtual size_t ReadFloat(float* frames, size_t frameCount) override;
+			virtual bool Rewind() override;
+
+		private:
+			std::unique_ptr<VorbisStream> Vorbis;
+			std::vector<float> ConversionBuffer;	//Used by Read	//nullptr if the file could not be opened
+		};
+	}
+}
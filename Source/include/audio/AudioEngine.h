@@ -2,6 +2,8 @@
 #include <vector>
 #include <scene/SoundSourceComponent.h>
 #include <AL/alc.h>
+#include <audio/SoundBufferCache.h>
+#include <audio/VoiceManager.h>
 
 namespace GEE
 {
@@ -11,7 +13,8 @@ namespace GEE
 		{
 			ALCdevice* Device;
 			ALCcontext* Context;
-			std::vector <SoundBuffer> ALBuffers;
+			SoundBufferCache Buffers;
+			VoiceManager Voices;
 
 			Transform* ListenerTransformPtr;
 
@@ -24,10 +27,14 @@ namespace GEE
 			void SetListenerTransformPtr(Transform*);
 			Transform* GetListenerTransformPtr();
 
-			void Update();
+			void Update(float deltaTime);	//Updates the listener and the voices
+
+			void SetCacheFilesEnabled(bool);	//See SoundBufferCache
 
-			virtual void AddBuffer(const SoundBuffer&) override;
 			virtual SoundBuffer FindBuffer(const std::string&) override;
+			virtual SoundBuffer AddBuffer(AudioDecoder&) override;
+			virtual void ReleaseBuffer(const SoundBuffer&) override;
+			virtual VoiceManager& GetVoiceManager() override;
 
 			virtual void CheckError() override;
 
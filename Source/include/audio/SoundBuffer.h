@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+
+namespace GEE
+{
+	namespace Audio
+	{
+		struct SoundBuffer
+		{
+			unsigned int ALIndex;
+			std::string Path;	//used for optimization; we don't load a buffer from file if this file was already read before (there will never be two buffers that share the same path)
+			bool IsValid() const
+			{
+				return ALIndex != 0;
+			}
+		};
+	}
+}
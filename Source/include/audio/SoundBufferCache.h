@@ -0,0 +1,64 @@
+#pragma once
+#include <audio/SoundBuffer.h>
+#include <AL/al.h>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+namespace GEE
+{
+	namespace Audio
+	{
+		class AudioDecoder;
+
+		/**
+		 * @brief The OpenAL buffers of the sounds loaded whole, keyed by the hash of their paths and shared by all sources that play them. A buffer is deleted once the last source releases it.
+		 * Samples are kept as 16-bit integers, or as floats if the file stores floats and AL_EXT_FLOAT32 is supported. Decoded samples can also be written to cache files (<directory>/<hash>.pcm), so a sound is only decoded the first time it is loaded.
+		*/
+		class SoundBufferCache
+		{
+		public:
+			SoundBufferCache(const std::string& directory = "DecodedAudio/");
+			SoundBufferCache(const SoundBufferCache&) = delete;
+			SoundBufferCache& operator=(const SoundBufferCache&) = delete;
+			~SoundBufferCache();	//Must be destroyed while the OpenAL context is still current
+
+			void SetFloatSamples(bool);		//Set if AL_EXT_FLOAT32 is supported
+			void SetCacheFilesEnabled(bool);
+
+			static uint64_t HashPath(const std::string&);
+
+			/**
+			 * @brief Looks for the buffer of a file in memory and then in the cache files. A found buffer is referenced - release it with Release.
+			 * @return an invalid buffer if the file has not been loaded before
+			*/
+			SoundBuffer Find(const std::string& path);
+			/**
+			 * @brief Decodes the whole file into a new buffer (or returns the existing one). The buffer is referenced - release it with Release.
+			 * @return an invalid buffer if the file could not be decoded
+			*/
+			SoundBuffer Add(AudioDecoder&);
+			void Release(const SoundBuffer&);
+			void Clear();	//Deletes all buffers, even if they are referenced
+
+			unsigned int GetBufferCount() const;
+
+		private:
+			struct CachedBuffer
+			{
+				SoundBuffer Buffer;
+				unsigned int RefCount;
+			};
+
+			SoundBuffer AddBuffer(uint64_t hash, const std::string& path, ALenum format, const void* data, size_t size, unsigned int sampleRate);
+			SoundBuffer LoadCacheFile(uint64_t hash, const std::string& path);
+			bool SaveCacheFile(uint64_t hash, const std::string& path, ALenum format, const void* data, size_t size, unsigned int sampleRate) const;
+			std::string GetCacheFilepath(uint64_t hash) const;
+
+			std::unordered_map<uint64_t, CachedBuffer> Buffers;
+			std::string Directory;
+			bool bFloatSamples;
+			bool bCacheFiles;
+		};
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <audio/AudioDecoder.h>
+#include <utility/JobSystem.h>
+
+namespace GEE
+{
+	namespace Audio
+	{
+		/**
+		 * @brief Plays a long sound (music, ambience) without decoding it whole. The decoder fills a small ring of OpenAL buffers which are queued on the source (alSourceQueueBuffers) and refilled once they have been played.
+		 * Decoding is done by the job system; OpenAL is only called from the main thread (in Play, Pause, Stop and Update). The first buffers are decoded as soon as the stream is created, so playback starts without waiting.
+		*/
+		class SoundStream
+		{
+		public:
+			/**
+			 * @param bufferCount: the number of OpenAL buffers in the ring
+			 * @param bufferDuration: the length of a single buffer in seconds. The ring must hold more sound than can be played between two updates
+			*/
+			SoundStream(JobSystem&, std::unique_ptr<AudioDecoder>, unsigned int bufferCount = 4, float bufferDuration = 0.25f);
+			SoundStream(const SoundStream&) = delete;
+			SoundStream& operator=(const SoundStream&) = delete;
+			~SoundStream();	//The stream must be stopped (and the buffers detached from the source) or the source deleted beforehand
+
+			const std::string& GetPath() const;
+			void SetLoop(bool);	//Streams loop by rewinding the decoder - AL_LOOPING must stay disabled on the source
+			bool IsPlaying() const;
+
+			void Play(ALuint source);
+			void Pause(ALuint source);
+			void Stop(ALuint source);	//Stops the source, takes the buffers back and rewinds the stream. Pass 0 if the stream has no source
+			void Update(ALuint source);	//Requeues the buffers that have been played and restarts the source if it ran out of data before the decoder could catch up
+
+			/**
+			 * @brief Plays a file through a stream on an OpenAL Soft loopback device, which mixes without an audio device and faster than real time, and checks that the stream finishes once the whole file has been played. Used by --bench.
+			 * @param path: the path of the file
+			 * @return false if the stream stopped early (decoded chunks were lost), did not stop, or no loopback device could be created
+			*/
+			static bool ValidatePlayback(JobSystem&, const std::string& path);
+
+		private:
+			void StartDecoding(unsigned int chunkCount);
+			void WaitForDecoding();
+			void QueueDecodedChunks(ALuint source);	//Does nothing if the decoding job has not finished yet
+			void UnqueueProcessedBuffers(ALuint source);
+
+			JobSystem& Jobs;
+			std::unique_ptr<AudioDecoder> Decoder;	//Only used by the decoding job while DecodeCounter is not done
+
+			std::vector<ALuint> Buffers;
+			std::vector<ALuint> FreeBuffers;	//Buffers that are not queued on the source
+			size_t FramesPerBuffer;
+
+			JobCounter DecodeCounter;
+			std::vector<std::vector<int16_t>> DecodedChunks;	//Written by the decoding job; one chunk per buffer
+			unsigned int DecodedChunkCount;
+			bool bEndOfStream;	//Set by the decoding job if the decoder ran out of frames (never for looped streams). Read only while DecodeCounter is done
+
+			bool bLoop;
+			bool bPlaying;
+		};
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <audio/SoundBuffer.h>
+#include <AL/al.h>
+#include <AL/alext.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace GEE
+{
+	class Transform;
+
+	namespace Audio
+	{
+		class SoundStream;
+		class VoiceManager;
+
+		enum class VoiceState
+		{
+			STOPPED,
+			PLAYING,
+			PAUSED
+		};
+
+		/**
+		 * @brief A sound played by a sound source. The fields are set by the owner of the voice; the state is managed by the VoiceManager.
+		 * A voice holds a real OpenAL source only while it is among the most audible ones - otherwise it is virtual: its playback position keeps advancing, but nothing is played.
+		*/
+		class Voice
+		{
+		public:
+			SoundBuffer Buffer;				//Played if Stream is nullptr
+			SoundStream* Stream = nullptr;	//Streams are never virtualised while they play (see VoiceManager)
+			const Transform* TransformPtr = nullptr;	//The position of the voice; nullptr - at the listener
+			float Gain = 1.0f;
+			float Priority = 1.0f;			//Multiplies the audibility of the voice
+			float ReferenceDistance = 1.0f;	//The distance at which the voice is heard at full gain (AL_REFERENCE_DISTANCE)
+			float MaxDistance = 100.0f;		//The voice is inaudible (culled) beyond this distance
+			bool bLoop = false;
+
+			VoiceState GetState() const { return State; }
+			bool IsVirtual() const { return Source == 0; }
+			ALuint GetSource() const { return Source; }	//0 if the voice is virtual
+			float GetOffset() const { return Offset; }	//The playback position in seconds (not updated for streams)
+			float GetAudibility() const { return Audibility; }
+
+		private:
+			friend class VoiceManager;
+			VoiceState State = VoiceState::STOPPED;
+			ALuint Source = 0;
+			float Offset = 0.0f;
+			float Length = 0.0f;	//The length of Buffer in seconds
+			float Audibility = 0.0f;
+		};
+
+		/**
+		 * @brief Plays voices with a fixed pool of OpenAL sources. Every frame the playing voices are ranked by audibility (distance attenuation * gain * priority); the most audible ones get the sources, the rest become virtual.
+		 * Voices beyond their max distance (or quieter than the audibility threshold) are culled. The positions and gains of the real voices are sent to OpenAL in one batch per frame (applied at once if AL_SOFT_deferred_updates is supported).
+		 * Streams keep their source from Play to Stop (also when paused) and come before all other voices, because they cannot seek - a stream that could not get a source waits at its current position.
+		*/
+		class VoiceManager
+		{
+		public:
+			VoiceManager(unsigned int maxSourceCount = 32, float audibilityThreshold = 0.001f);
+			VoiceManager(const VoiceManager&) = delete;
+			VoiceManager& operator=(const VoiceManager&) = delete;
+			~VoiceManager();
+
+			void Init();	//Creates the sources (fewer if the device cannot provide that many). An OpenAL context must be current
+			void Dispose();			//Stops all voices and deletes the sources
+
+			void Play(Voice&);	//Starts or resumes the voice. It gets a source in the next Update if it is audible enough
+			void Pause(Voice&);
+			void Stop(Voice&);	//Also rewinds the voice. Must be called before a playing voice is destroyed
+			void SetLoop(Voice&, bool);
+
+			void Update(float deltaTime, const glm::vec3& listenerPosition);
+
+			/**
+			 * @brief Computes the attenuation of the inverse distance clamped model of OpenAL (with rolloff 1), which is used for all sources.
+			 * @return 0 beyond maxDistance
+			*/
+			static float GetAttenuation(float distance, float referenceDistance, float maxDistance);
+
+			unsigned int GetSourceCount() const;
+			unsigned int GetVoiceCount() const;	//Playing and paused voices
+			unsigned int GetRealVoiceCount() const;
+
+		private:
+			void AdvanceVirtualVoice(Voice&, float deltaTime, bool& ended);	//Sets ended if the voice has played to its end
+			void AssignSource(Voice&);
+			void ReleaseSource(Voice&);	//Makes the voice virtual and remembers its playback position
+			void EraseVoice(Voice&);
+
+			LPALDEFERUPDATESSOFT DeferUpdates;		//nullptr if AL_SOFT_deferred_updates is not supported
+			LPALPROCESSUPDATESSOFT ProcessUpdates;
+			unsigned int MaxSourceCount;
+			float AudibilityThreshold;
+			std::vector<ALuint> Sources;
+			std::vector<ALuint> FreeSources;
+			std::vector<Voice*> Voices;			//Playing and paused voices
+			std::vector<Voice*> RankedVoices;	//Reused every frame
+		};
+	}
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <complex>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace GEE
+{
+	namespace Audio
+	{
+		/**
+		 * @brief Decodes the Vorbis I stream of an Ogg file into float PCM. The file is read page by page and decoded one packet at a time, so only a single page and the blocks of the last packet are kept in memory.
+		 * Implements the Vorbis I specification apart from floor type 0, which no current encoder produces. Only the first logical stream of a chained or multiplexed file is decoded.
+		 * Decoding does not allocate memory after the stream has been opened.
+		*/
+		class VorbisStream
+		{
+		public:
+			VorbisStream();
+			VorbisStream(const VorbisStream&) = delete;
+			VorbisStream& operator=(const VorbisStream&) = delete;
+			~VorbisStream();
+
+			/**
+			 * @brief Opens the file and reads the identification, comment and setup headers of the stream.
+			 * @return false if the file could not be opened or it is not a supported Ogg Vorbis file (the reason is printed)
+			*/
+			bool Open(const std::string& path);
+
+			unsigned int GetChannelCount() const;
+			unsigned int GetSampleRate() const;
+			size_t GetFrameCount() const;	//Taken from the granule position of the last page
+
+			/**
+			 * @brief Decodes the next frames of the stream.
+			 * @param frames: output for interleaved samples in the [-1, 1] range; must fit frameCount * GetChannelCount() samples
+			 * @return the number of decoded frames - less than frameCount only at the end of the stream
+			*/
+			size_t Read(float* frames, size_t frameCount);
+			bool Rewind();	//Goes back to the first audio packet
+
+		private:
+			struct Codebook;
+			struct Floor;
+			struct Residue;
+			struct Mapping;
+			struct Mode;
+			class BitReader;
+
+			/**
+			 * @brief The inverse MDCT of a single block size, computed through a DCT-IV of half the size, which is in turn computed by a complex FFT of a quarter of the size.
+			*/
+			struct InverseMdct
+			{
+				void Init(unsigned int blockSize);
+				void Transform(const float* coefficients, float* output);	//blockSize / 2 coefficients to blockSize samples
+
+				unsigned int BlockSize = 0;
+				std::vector<std::complex<float>> PreTwiddles, PostTwiddles, FftTwiddles;
+				std::vector<uint32_t> BitReverse;
+				std::vector<std::complex<float>> Fft;
+				std::vector<float> Dct;
+			};
+
+			bool ReadPage();	//Reads the next page of the stream; pages of other logical streams are skipped
+			bool ReadPacket();	//Reads the next packet of the stream into Packet; false at the end of the stream
+			bool ReadHeaderPacket(uint8_t type);	//Reads the next packet and checks that it is the header of the given type
+			bool ReadIdentificationHeader();
+			bool ReadSetupHeader();
+			bool ReadCodebook(BitReader&, Codebook&);
+			bool ReadFloor(BitReader&, Floor&);
+			bool ReadResidue(BitReader&, Residue&);
+			bool ReadMapping(BitReader&, Mapping&);
+			bool ReadFrameCount();	//Reads the granule position of the last page of the stream
+
+			bool DecodePacket();	//Decodes the audio packet in Packet into DecodedFrames; false if the packet is not an audio packet or is corrupt (it is skipped)
+			bool DecodeFloor(BitReader&, const Floor&, int* y);	//False if the floor of the channel is unused
+			void RenderFloor(const Floor&, const int* y, int halfBlockSize, float* curve);
+			void DecodeResidue(BitReader&, const Residue&, const unsigned int* channels, const bool* bDoNotDecode, unsigned int channelCount, unsigned int halfBlockSize);
+			void DecodePartitions(BitReader&, const Residue&, float* const* vectors, const bool* bDoNotDecode, unsigned int vectorCount, unsigned int vectorSize);
+			void ApplyWindow(float* block, bool bLongBlock, bool bPreviousLong, bool bNextLong) const;
+
+			std::string Path;
+			std::ifstream File;
+			uint32_t SerialNumber;
+			bool bSerialNumberKnown;
+			std::streamoff FirstAudioPageOffset;	//The first audio packet always starts a new page
+
+			std::vector<uint8_t> PageData;
+			uint8_t SegmentSizes[255];
+			unsigned int SegmentCount, SegmentIndex;
+			size_t PageDataOffset;
+			bool bLastPage;
+			std::vector<uint8_t> Packet;
+
+			unsigned int ChannelCount;
+			unsigned int SampleRate;
+			size_t FrameCount;
+			unsigned int BlockSizes[2];	//Short and long
+
+			std::vector<Codebook> Codebooks;
+			std::vector<Floor> Floors;
+			std::vector<Residue> Residues;
+			std::vector<Mapping> Mappings;
+			std::vector<Mode> Modes;
+
+			std::vector<float> WindowSlopes[2];	//The rising half of the short and the long window
+			InverseMdct Mdcts[2];
+
+			std::vector<std::vector<int>> FloorY;	//Per channel; the amplitudes of the floor read from the packet
+			std::vector<float> FloorCurve;
+			std::vector<std::vector<float>> ResidueVectors;	//Per channel
+			std::vector<float> InterleavedResidue;	//Residue type 2 decodes all the channels as one interleaved vector
+			std::vector<uint8_t> Classifications;	//ClassificationStride entries per vector of a residue
+			size_t ClassificationStride;
+			std::vector<std::vector<float>> Blocks;	//Per channel; the windowed output of the inverse MDCT
+			std::vector<std::vector<float>> PreviousRightHalves;	//Per channel; overlapped with the left half of the next block
+			unsigned int PreviousBlockSize;	//0 before the first audio packet, which produces no frames
+
+			std::vector<float> Decoded;	//Interleaved frames of the last packet
+			size_t DecodedFrames, DecodedPosition;
+			size_t FramesLeft;
+		};
+	}
+}
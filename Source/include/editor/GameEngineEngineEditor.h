@@ -38,6 +38,7 @@ namespace GEE
 
 	private:
 		void UpdateRecentProjects();
+		void RenderProfilerOverlay();	//Draws the summary of the last profiled frame over the window. Toggled with F3.
 
 		RenderToolboxCollection* ViewportRenderCollection, * HUDRenderCollection;
 		GameScene* EditorScene;
@@ -52,6 +53,8 @@ namespace GEE
 		Component* SelectedComp;
 		Actor* SelectedActor;
 		GameScene* SelectedScene;
+
+		bool bProfilerOverlay;
 	};
 
 	template<typename T>
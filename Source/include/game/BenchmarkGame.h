@@ -0,0 +1,51 @@
+#pragma once
+#include <game/Game.h>
+
+namespace GEE
+{
+	struct BenchmarkSettings
+	{
+		std::string ProjectFilepath;
+		unsigned int WarmupFrames = 30;		//Not measured - caches, pools and arenas are filled during them
+		unsigned int MeasuredFrames = 300;
+		std::string TraceFilepath;			//(optional) the Chrome trace of the last measured frames is written there
+		std::string ReplayFilepath;			//(optional) input recording to replay; every step of the recording is measured and no warmup frames are run
+
+		/**
+		 * @brief Parses the arguments that follow --bench: <project> [--frames N] [--warmup N] [--trace path] [--replay path]
+		 * @return false if the arguments are invalid
+		*/
+		bool ParseArguments(int argc, char** argv, int firstArgument);
+	};
+
+	/**
+	 * @brief Headless game that loads a project, renders its main scene on the null GL device for a fixed number of frames at a fixed time step and reports the CPU frame time broken down by the profiler scopes (and thus by render passes), together with the commands submitted per frame.
+	 * It needs no window and no GPU, so it can run on build machines. Started with the --bench command line option.
+	 * With --replay, the input recorded with --record is fed to the game at its fixed time step, so the same gameplay can be measured on different builds.
+	 * The benchmark fails if a frame after the warmup allocates from the heap (the engine should reach a steady state during the warmup).
+	 * After the frames, the engine subsystems that can be measured in isolation are benchmarked and validated as well; the benchmark fails if any validation fails.
+	*/
+	class BenchmarkGame : public Game
+	{
+	public:
+		BenchmarkGame(const GameSettings&);
+		virtual void Init(GLFWwindow* window) override;
+		virtual std::vector<GameScene*> GetScenes() override;
+		virtual void Render() override;
+
+		/**
+		 * @brief Loads the null GL device, runs the benchmark and prints the report.
+		 * @return the exit code of the program
+		*/
+		static int Run(const BenchmarkSettings&);
+
+	private:
+		/**
+		 * @brief Benchmarks the engine subsystems in isolation, validates their results (e.g. the SIMD skinning kernel against the scalar reference) and prints the report.
+		 * @return false if a validation failed
+		*/
+		static bool RunSubsystemBenchmarks(GameScene&);
+
+		RenderToolboxCollection* SceneRenderCollection;
+	};
+}
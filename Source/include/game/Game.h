@@ -5,7 +5,9 @@
 #include "GameSettings.h"
 #include "GameScene.h"
 #include <input/Event.h>
+#include <input/InputRecording.h>
 #include <scene/Actor.h>
+#include <utility/JobSystem.h>
 
 namespace GEE
 {
@@ -25,6 +27,7 @@ namespace GEE
 	{
 	public:
 		Game(const ShadingModel&, const GameSettings&);
+		~Game();
 		virtual void Init(GLFWwindow* window);
 
 		void LoadSceneFromFile(const std::string& path, const std::string& name = std::string());
@@ -47,6 +50,7 @@ namespace GEE
 		virtual Physics::PhysicsEngineManager* GetPhysicsHandle() override;
 		virtual RenderEngineManager* GetRenderEngineHandle() override;
 		virtual Audio::AudioEngineManager* GetAudioEngineHandle() override;
+		virtual JobSystem* GetJobSystem() override;
 
 		virtual GameSettings* GetGameSettings() override;
 		virtual GameScene* GetScene(const std::string& name) override;
@@ -59,9 +63,30 @@ namespace GEE
 		virtual std::shared_ptr<Font> FindFont(const std::string& path) override;
 
 		virtual void PreGameLoop();
+		/**
+		 * @brief Polls and handles the events, updates the game in fixed time steps and renders a frame. While input is replayed, the passed times are ignored and exactly one step is done per iteration.
+		 * @return true if the game should end (the window was closed or the input replay has finished)
+		*/
 		virtual bool GameLoopIteration(float timeStep, float deltaTime);
 		virtual void HandleEvents();
 
+		/**
+		 * @brief Starts recording the input from the window, together with the index of the fixed step at which it is handled. Call after PreGameLoop.
+		 * @param timeStep: the time step passed to GameLoopIteration
+		*/
+		void StartInputRecording(float timeStep);
+		/**
+		 * @brief Stops recording the input and writes it to a file.
+		 * @return true if the file was written
+		*/
+		bool StopInputRecording(const std::string& filepath);
+		/**
+		 * @brief Starts feeding the input from a recording instead of the window (which may be absent). The game is updated once per GameLoopIteration with the recorded time step, so the simulation does not depend on the frame times.
+		 * @return false if the recording could not be loaded
+		*/
+		bool StartInputReplay(const std::string& filepath);
+		bool IsReplayingInput() const;
+
 		void Update(float);
 
 		virtual void Render() = 0;
@@ -69,6 +94,7 @@ namespace GEE
 	protected:
 		void SetMainScene(GameScene*);
 		virtual void DeleteScene(GameScene&) override;
+		void FeedReplayedInput();	//Pushes the recorded input of the current step
 
 		GLFWwindow* Window;
 
@@ -86,12 +112,17 @@ namespace GEE
 		RenderEngine RenderEng;
 		Physics::PhysicsEngine PhysicsEng;
 		Audio::AudioEngine AudioEng;
+		JobSystem Jobs;	//Declared after the engines, so the workers are joined before any engine is destroyed
 
 		const ShadingModel Shading;
 		bool GameStarted;
 		bool DebugMode;
 		float LoopBeginTime;
 		float TimeAccumulator;
+		unsigned int FixedStepIndex;	//The number of updates done since the game loop was started
+
+		InputRecorder Recorder;
+		std::unique_ptr<InputReplayer> Replayer;
 	};
 
 	struct GLFWEventProcessor
@@ -103,7 +134,17 @@ namespace GEE
 		static void ScrollCallback(GLFWwindow*, double xoffset, double yoffset);
 		static void FileDropCallback(GLFWwindow*, int count, const char** paths);
 
+		template <typename EventClass> static void PushEvent(const EventClass&);	//Pushes the event to TargetHolder and records it
+
 		static EventHolder* TargetHolder;
+		static InputRecorder* Recorder;
 	};
 
+	template<typename EventClass>
+	inline void GLFWEventProcessor::PushEvent(const EventClass& ev)
+	{
+		TargetHolder->PushEvent(ev);
+		Recorder->RecordEvent(ev);
+	}
+
 }
\ No newline at end of file
@@ -12,11 +12,14 @@ namespace physx
 	class PxScene;
 	class PxController;
 	class PxControllerManager;
+	class PxActor;
 }
 
 namespace GEE
 {
 	class EditorDescriptionBuilder;
+	class JobSystem;
+	class RenderSnapshot;
 
 	class Actor;
 	class GunActor;
@@ -106,21 +109,33 @@ namespace GEE
 		class GameScenePhysicsData;
 		struct CollisionObject;
 		struct CollisionShape;
+		class SceneQueryBatch;
 
 		class PhysicsEngineManager
 		{
 		public:
 			virtual void CreatePxShape(CollisionShape&, CollisionObject&) = 0;
 			virtual void AddCollisionObjectToPxPipeline(GameScenePhysicsData& scenePhysicsData, CollisionObject&) = 0;
+			virtual void RemoveCollisionObjectFromPxPipeline(CollisionObject&) = 0;	//Releases the PxActor of the object
+			virtual bool IsSimulating() const = 0;	//True if a PhysX step is in flight (see the asynchronous mode of PhysicsEngine); PhysX objects must not be read then
+			virtual CollisionObject* FindCollisionObject(const physx::PxActor&) = 0;
+
+			virtual void ScheduleSceneQueries(GameScenePhysicsData&, SceneQueryBatch&) = 0;	//See SceneQueryBatch::ExecuteDeferred
+			virtual void CancelSceneQueries(SceneQueryBatch&) = 0;
 
 			virtual physx::PxController* CreateController(GameScenePhysicsData& scenePhysicsData, const Transform& t) = 0;
 
 			virtual void ApplyForce(CollisionObject&, glm::vec3 force) = 0;
+			virtual void SetVelocity(CollisionObject&, glm::vec3 linear, glm::vec3 angular = glm::vec3(0.0f)) = 0;	//Also wakes the body up
+			virtual void SetSimulationEnabled(CollisionObject&, bool) = 0;	//A disabled object stays in its scene, but it is not simulated, does not collide and is not hit by scene queries (it is not in the broadphase)
+			virtual void SetContinuousCollision(CollisionObject&, bool) = 0;	//Swept collision detection for small and fast bodies (e.g. projectiles), so they don't tunnel through thin geometry. Costly - enable it only where needed
 
 			virtual void DebugRender(GameScenePhysicsData&, RenderEngine&, RenderInfo&) = 0;
 		protected:
 			virtual void RemoveScenePhysicsDataPtr(GameScenePhysicsData& scenePhysicsData) = 0;
+			virtual void ReleaseScenePhysicsData(GameScenePhysicsData& scenePhysicsData) = 0;	//Removes the scene and releases its PxScene and PxControllerManager. Called when the scene physics data is destroyed
 			friend class GameScene;
+			friend class GameScenePhysicsData;
 		};
 	}
 
@@ -128,13 +143,17 @@ namespace GEE
 	{
 		class SoundSourceComponent;
 		struct SoundBuffer;
+		class AudioDecoder;
+		class VoiceManager;
 
 		class AudioEngineManager
 		{
 		public:
 			virtual void CheckError() = 0;
-			virtual SoundBuffer FindBuffer(const std::string& path) = 0;
-			virtual void AddBuffer(const SoundBuffer&) = 0;
+			virtual SoundBuffer FindBuffer(const std::string& path) = 0;	//Looks in memory and in the decoded audio cache files. A found buffer is referenced - release it with ReleaseBuffer
+			virtual SoundBuffer AddBuffer(AudioDecoder&) = 0;	//Decodes the whole file into a buffer (or returns the existing one). The buffer is referenced - release it with ReleaseBuffer
+			virtual void ReleaseBuffer(const SoundBuffer&) = 0;
+			virtual VoiceManager& GetVoiceManager() = 0;
 		};
 	}
 
@@ -145,6 +164,7 @@ namespace GEE
 		virtual Mesh& GetBasicShapeMesh(EngineBasicShape) = 0;
 		virtual Shader* GetLightShader(const RenderToolboxCollection& renderCol, LightType) = 0;
 		virtual RenderToolboxCollection* GetCurrentTbCollection() = 0;
+		virtual RenderSnapshot& GetRenderSnapshot() = 0;
 
 		//TODO: THIS SHOULD NOT BE HERE
 		virtual std::vector<Material*> GetMaterials() = 0;
@@ -162,9 +182,10 @@ namespace GEE
 
 		virtual void EraseRenderTbCollection(RenderToolboxCollection& tbCollection) = 0;
 		virtual void EraseMaterial(Material&) = 0;
+		virtual void UpdateMaterialNameIndex(Material&, const std::string& previousName) = 0;	//Called by Material::SetName. Does nothing if the material has not been added
 
-		virtual Shader* FindShader(std::string) = 0;
-		virtual std::shared_ptr<Material> FindMaterial(std::string) = 0;
+		virtual Shader* FindShader(const std::string&) = 0;
+		virtual std::shared_ptr<Material> FindMaterial(const std::string&) = 0;
 
 		virtual void RenderCubemapFromTexture(Texture targetTex, Texture tex, glm::uvec2 size, Shader&, int* layer = nullptr, int mipLevel = 0) = 0;
 		virtual void RenderCubemapFromScene(RenderInfo info, GameSceneRenderData* sceneRenderData, GEE_FB::Framebuffer target, GEE_FB::FramebufferAttachment targetTex, GLenum attachmentType, Shader* shader = nullptr, int* layer = nullptr, bool fullRender = false) = 0;
@@ -203,6 +224,7 @@ namespace GEE
 		virtual Physics::PhysicsEngineManager* GetPhysicsHandle() = 0;
 		virtual RenderEngineManager* GetRenderEngineHandle() = 0;
 		virtual Audio::AudioEngineManager* GetAudioEngineHandle() = 0;
+		virtual JobSystem* GetJobSystem() = 0;
 
 		virtual GameSettings* GetGameSettings() = 0;
 
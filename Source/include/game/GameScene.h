@@ -6,11 +6,15 @@
 #include <cereal/types/memory.hpp>
 #include <cereal/types/polymorphic.hpp>
 #include <animation/SkeletonInfo.h>
+#include <utility/NameIndex.h>
+#include <scene/ComponentUpdateScheduler.h>
+#include <game/SceneStreaming.h>
 
 namespace GEE
 {
 	class GameScene;
 	class Event;
+	class AnimationManagerComponent;
 
 	class GameSceneRenderData
 	{
@@ -92,11 +96,15 @@ namespace GEE
 		{
 		public:
 			GameScenePhysicsData(PhysicsEngineManager*);
+			GameScenePhysicsData(const GameScenePhysicsData&) = delete;
+			GameScenePhysicsData& operator=(const GameScenePhysicsData&) = delete;
+			~GameScenePhysicsData();	//Must be destroyed after all the collision objects of the scene
 			void AddCollisionObject(CollisionObject&, Transform& t);
 			void EraseCollisionObject(CollisionObject&);
 			Physics::PhysicsEngineManager* GetPhysicsHandle();
 
 			friend class PhysicsEngine;
+			friend class SceneQueryBatch;
 
 		private:
 			Physics::PhysicsEngineManager* PhysicsHandle;
@@ -140,6 +148,8 @@ namespace GEE
 		GameSceneRenderData* GetRenderData();
 		Physics::GameScenePhysicsData* GetPhysicsData();
 		Audio::GameSceneAudioData* GetAudioData();
+		ComponentUpdateScheduler& GetUpdateScheduler();
+		SceneStreamingManager* GetStreamingManager();	//nullptr if the scene is not streamed
 		GameManager* GetGameHandle();
 		/**
 		 * @brief Use the function to check if this is a valid scene. If it returns true, you should remove all references to the scene and avoid processing it at all. The root actor, its children and their components become invalid along with the scene.
@@ -156,6 +166,11 @@ namespace GEE
 		*/
 		void AddPostLoadLambda(std::function<void()> postLoadLambda);
 
+		/**
+		 * @brief Starts streaming the cells of this scene around the active camera. Pass nullptr to stop (the loaded cells stay in the scene).
+		*/
+		void SetStreamingManager(std::unique_ptr<SceneStreamingManager>);
+
 		/**
 		 * @brief Add a UICanvas to check every frame if it contains the cursor. This information can be used to disable some input outside the canvas that contains the cursor. Should be called automatically by the constructor of UICanvasActor.
 		 * @see UICanvasActor::UICanvasActor()
@@ -175,6 +190,16 @@ namespace GEE
 		*/
 		UICanvas* GetCurrentBlockingCanvas() const;
 
+		/**
+		 * @brief Queue an AnimationManagerComponent whose animations crossed notifies in this frame. Its notifies will be dispatched in one batch after the update of all actors. Called automatically by AnimationManagerComponent::Update.
+		 * @param animManager: the manager to be dispatched
+		*/
+		void AddAnimationNotifySource(AnimationManagerComponent& animManager);
+		/**
+		 * @brief Must be called if a queued AnimationManagerComponent is about to be destroyed. Called automatically by the destructor of AnimationManagerComponent.
+		*/
+		void EraseAnimationNotifySource(AnimationManagerComponent& animManager);
+
 		/**
 		 * @brief Returns an actor name that is guaranteed to be unique (no other actor in the scene has it). Always use this function if there is a possibility of duplicating actor names - this can cause crashes.
 		 * @param name: the name that should be converted to unique
@@ -190,15 +215,28 @@ namespace GEE
 		HierarchyTemplate::HierarchyTreeT* FindHierarchyTree(const std::string& name, HierarchyTemplate::HierarchyTreeT* treeToIgnore = nullptr);
 
 		void HandleEventAll(const Event&);
+		/**
+		 * @brief Measures the cost of dispatching an event to a hierarchy of temporary actors, out of which only a few are subscribed to the event. The actors are attached to the root of the scene and deleted afterwards.
+		 * @param actorCount: the number of temporary actors
+		 * @param listenerCount: the number of temporary actors subscribed to the event
+		 * @param eventCount: the number of dispatched events
+		 * @return average time per event in microseconds
+		*/
+		double BenchmarkEventDispatch(unsigned int actorCount = 10000, unsigned int listenerCount = 10, unsigned int eventCount = 1000);
 		void Update(float deltaTime);
 
 		void BindActiveCamera(CameraComponent*);
 
-		Actor* FindActor(std::string name);
+		Actor* FindActor(const std::string& name);	//Returns an actor attached to the root of this scene
 
+		/**
+		 * @brief Calls the post-load lambdas added since the previous call. Called after the scene file has been loaded and after every streamed cell.
+		*/
 		void Load()
 		{
-			for (auto& it : PostLoadLambdas)
+			std::vector<std::function<void()>> lambdas;
+			lambdas.swap(PostLoadLambdas);	//The lambdas may add new ones
+			for (auto& it : lambdas)
 				it();
 		}
 
@@ -219,6 +257,14 @@ namespace GEE
 		std::string Name;
 		GameManager* GameHandle;
 
+		/**
+		 * @brief All actors, components and hierarchy trees of this scene indexed by name - including the ones that are not attached to the root yet. Actors and components keep the indices up to date when they are created, renamed and destroyed, so the indices are declared before (and destroyed after) anything that owns them.
+		*/
+		NameIndex<Actor*> ActorsIndex;
+		NameIndex<Component*> ComponentsIndex;
+		NameIndex<HierarchyTemplate::HierarchyTreeT*> HierarchyTreesIndex;
+		ComponentUpdateScheduler UpdateScheduler;	//Components erase themselves from it when destroyed, so it is declared before the root actor as well
+
 		std::unique_ptr<Actor> RootActor;
 		std::unique_ptr<GameSceneRenderData> RenderData;
 		std::unique_ptr<Physics::GameScenePhysicsData> PhysicsData;
@@ -240,15 +286,23 @@ namespace GEE
 		*/
 		UICanvas* CurrentBlockingCanvas;
 
+		/**
+		 * @brief AnimationManagerComponents with notifies pending in this frame.
+		*/
+		std::vector<AnimationManagerComponent*> AnimationNotifySources;
 
 		std::vector<std::function<void()>> PostLoadLambdas;
 
+		std::unique_ptr<SceneStreamingManager> Streaming;	//Declared after the root actor, so pending loads are finished before the actors are destroyed
+
 		CameraComponent* ActiveCamera;
 
 		bool bKillingProcessStarted;
 
 		friend class Game;
 		friend class GameEngineEngineEditor;
+		friend class Actor;
+		friend class Component;
 	};
 
 	template<typename ActorClass, typename... Args>
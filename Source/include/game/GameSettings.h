@@ -38,6 +38,9 @@ namespace GEE
 
 		bool bWindowFullscreen;
 		std::string WindowTitle;
+		bool bAsyncPhysics;	//PhysX simulates the next step while the frame is rendered (see PhysicsEngine::SetAsyncSimulation)
+		unsigned int PhysicsWorkerCount;	//Threads of the PhysX dispatcher shared by all scenes; 0 - PhysX tasks are run by the job system of the engine
+		bool bCacheDecodedAudio;	//Decoded sounds are written to cache files, so they are not decoded again (see SoundBufferCache)
 
 		struct VideoSettings
 		{
@@ -0,0 +1,104 @@
+#pragma once
+#include <utility/JobSystem.h>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace GEE
+{
+	class GameScene;
+	class Actor;
+
+	struct SceneStreamingSettings
+	{
+		float CellSize = 64.0f;				//The length of the side of a cell, in world units (cells split the XZ plane)
+		float LoadRadius = 96.0f;			//Cells closer to the camera than this are loaded
+		float UnloadRadius = 128.0f;		//Loaded cells further than this are unloaded. Must not be smaller than LoadRadius - the difference keeps cells from being reloaded over and over at the border
+		size_t MemoryBudget = 256 * 1024 * 1024;	//The maximum size of the chunks of all loaded cells, in bytes
+		unsigned int MaxConcurrentLoads = 2;		//Cells read and parsed in the background at the same time
+	};
+
+	enum class StreamingCellState
+	{
+		UNLOADED,
+		LOADING,	//The chunk is being read and parsed by a job
+		LOADED
+	};
+
+	/**
+	 * @brief Streams the actors of a level in a grid of spatial cells. Every cell is serialised to its own chunk - the actors of a cell are the children of a cell actor (GEE_Cell_<x>_<z>) attached to the root of the scene.
+	 * Chunks of the cells around the active camera are read and parsed by the job system; the actors are instantiated on the main thread (at most one cell per frame), after which the post-load lambdas of the cell are resolved.
+	 * The level is described by a manifest (<level path>.cells) written by PartitionScene. The actors that were not partitioned stay in the level file and are always resident.
+	 * Limitations: an actor belongs to the cell it was in when the level was partitioned, even if it moves away, and post-load lambdas can only find actors that are resident or in the same cell.
+	*/
+	class SceneStreamingManager
+	{
+	public:
+		SceneStreamingManager(GameScene&, const SceneStreamingSettings&);
+		SceneStreamingManager(const SceneStreamingManager&) = delete;
+		SceneStreamingManager& operator=(const SceneStreamingManager&) = delete;
+		~SceneStreamingManager();
+
+		/**
+		 * @brief Reads the manifest of a level. The cells are not loaded until Update is called.
+		 * @param manifestFilepath: path of the manifest (<level path>.cells)
+		 * @return nullptr if the manifest could not be read
+		*/
+		static std::unique_ptr<SceneStreamingManager> LoadManifest(GameScene&, const std::string& manifestFilepath);
+
+		/**
+		 * @brief Moves the actors attached to the root of the scene into cells, writes the chunk of every cell and the manifest. Actors that must stay resident (controllers, cameras, skeletal meshes and light probes) are left in place.
+		 * The cells are unloaded (killed) afterwards. They stay attached to the root until the next update of the scene, but actors being killed are not serialized, so saving the level right after partitioning it only saves the resident actors.
+		 * @param levelFilepath: path of the level file; the manifest and the chunks are written next to it
+		 * @return the number of cells written
+		*/
+		static unsigned int PartitionScene(GameScene&, const std::string& levelFilepath, const SceneStreamingSettings& = SceneStreamingSettings());
+
+		static std::string GetManifestFilepath(const std::string& levelFilepath);
+
+		/**
+		 * @brief Starts loading the cells within the load radius of the given position (nearest first, within the memory budget), unloads the ones beyond the unload radius and instantiates a cell whose chunk has been parsed. Called by GameScene::Update with the position of the active camera.
+		*/
+		void Update(const glm::vec3& viewerPosition);
+
+		/**
+		 * @brief Writes the chunks of the loaded cells (so changes made in the editor are kept) and detaches the cell actors from the root, so the scene can be saved without them. Reattach them with AttachCells afterwards.
+		*/
+		std::vector<std::unique_ptr<Actor>> DetachLoadedCells();
+		void AttachCells(std::vector<std::unique_ptr<Actor>>&&);
+
+		const SceneStreamingSettings& GetSettings() const;
+		unsigned int GetCellCount() const;
+		unsigned int GetLoadedCellCount() const;
+		size_t GetLoadedBytes() const;
+
+	private:
+		struct ParsedChunk;
+		struct StreamingCell
+		{
+			glm::ivec2 Coords;
+			std::string Filepath;
+			size_t Bytes;
+			StreamingCellState State;
+			Actor* CellActor;
+			JobCounter LoadCounter;
+			std::unique_ptr<ParsedChunk> Chunk;	//Written by the loading job; read once LoadCounter is done
+		};
+
+		float GetDistance(const StreamingCell&, const glm::vec2& viewerPosition) const;	//Distance from the position to the nearest point of the cell (in XZ)
+		void StartLoading(StreamingCell&);
+		void Instantiate(StreamingCell&);
+		void Unload(StreamingCell&);
+		bool SaveCell(const StreamingCell&) const;
+		bool SaveManifest() const;
+
+		static std::string GetCellName(const glm::ivec2& coords);
+
+		GameScene& Scene;
+		SceneStreamingSettings Settings;
+		std::string ManifestFilepath;
+		std::vector<std::unique_ptr<StreamingCell>> Cells;
+		size_t LoadedBytes;	//Including the cells being loaded
+	};
+}
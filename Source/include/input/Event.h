@@ -2,7 +2,8 @@
 #include <glfw/glfw3.h>
 #include <glm/glm.hpp>
 #include <memory>
-#include <queue>
+#include <vector>
+#include <variant>
 #include <string>
 
 namespace GEE
@@ -176,6 +177,7 @@ namespace GEE
 		MOUSE_RELEASED,
 		FOCUS_SWITCHED
 	};
+	constexpr unsigned int EventTypeCount = static_cast<unsigned int>(EventType::FOCUS_SWITCHED) + 1;
 
 
 	class Event
@@ -240,19 +242,35 @@ namespace GEE
 	{
 	public:
 		CharEnteredEvent(EventType, unsigned int unicode);
+		unsigned int GetUnicode() const;
 		std::string GetUTF8() const;
 
 	private:
 		unsigned int Unicode;
 	};
 
+	/**
+	 * @brief Holds the events that have not been polled yet. Events are stored by value in two arenas: new events are pushed to one of them while the other one is being polled.
+	 * Arenas are cleared without releasing their memory, so pushing an event does not allocate after the first few frames.
+	 * A pointer returned by PollEvent stays valid until the next call to PollEvent, even if new events are pushed in the meantime.
+	*/
 	class EventHolder
 	{
 	public:
-		std::shared_ptr<Event> PollEvent();
+		EventHolder();
+		template <typename EventClass> void PushEvent(const EventClass&);
+		const Event* PollEvent();
 
-		friend struct GLFWEventProcessor;
 	private:
-		std::queue<std::shared_ptr<Event>> Events;
+		typedef std::variant<Event, CursorMoveEvent, MouseButtonEvent, MouseScrollEvent, KeyEvent, CharEnteredEvent> PooledEvent;
+		std::vector<PooledEvent> Arenas[2];
+		unsigned int PolledArena;	//The other arena receives new events
+		size_t PolledCount;
 	};
+
+	template<typename EventClass>
+	inline void EventHolder::PushEvent(const EventClass& ev)
+	{
+		Arenas[(PolledArena + 1) % 2].push_back(ev);
+	}
 }
\ No newline at end of file
@@ -3,16 +3,20 @@
 
 namespace GEE
 {
+	class InputReplayer;
+
 	class InputDevicesStateRetriever
 	{
 	public:
-		InputDevicesStateRetriever(GLFWwindow&);
+		InputDevicesStateRetriever(GLFWwindow*);	//Without a window (headless), the mouse is at (0, 0) and no key is pressed
+		InputDevicesStateRetriever(const InputReplayer&);	//Answers with the state of the replayed input devices
 		glm::dvec2 GetMousePosition() const;
 		glm::dvec2 GetMousePositionNDC() const;
 		bool IsKeyPressed(const Key&) const;
 
 		friend class Game;
 	private:
-		GLFWwindow& WindowRef;
+		GLFWwindow* WindowPtr;
+		const InputReplayer* ReplayerPtr;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+#include <input/Event.h>
+#include <array>
+#include <chrono>
+
+namespace GEE
+{
+	enum class InputRecordType : unsigned char
+	{
+		EVENT,			//An event pushed by the GLFW callbacks
+		MOUSE_LOOK,		//An offset passed to the controller that has mouse control (it bypasses the events)
+		MOUSE_CONTROL	//A controller was given mouse control (X != 0) or mouse control was released (X == 0)
+	};
+
+	/**
+	 * @brief A single recorded input. The meaning of A, B, X and Y depends on the type of the event:
+	 * keys and mouse buttons: A - the key/button, B - the modifier bits; characters: A - the codepoint; cursor moves: X, Y - the position; scrolls and mouse look: X, Y - the offset.
+	*/
+	struct InputRecord
+	{
+		unsigned int StepIndex;		//The number of fixed simulation steps done before the input was handled
+		float Time;					//Seconds since the recording was started
+		InputRecordType Type;
+		EventType EvType;
+		int A, B;
+		float X, Y;
+	};
+
+	struct InputRecording
+	{
+		float TimeStep = 1.0f / 60.0f;
+		glm::ivec2 WindowSize = glm::ivec2(0);	//Used for the normalized mouse position during a replay
+		unsigned int StepCount = 0;
+		std::vector<InputRecord> Records;	//In the order in which the inputs were handled
+
+		/**
+		 * @brief Writes the recording in a compact binary format (little-endian, fixed-size records).
+		 * @return true if the file was written
+		*/
+		bool SaveToFile(const std::string& filepath) const;
+		bool LoadFromFile(const std::string& filepath);
+	};
+
+	/**
+	 * @brief Records the input of a game together with the index of the fixed simulation step at which it was handled, so the simulation can be reproduced exactly regardless of the frame times.
+	 * Hooked to the GLFW callbacks of Game (see GLFWEventProcessor).
+	*/
+	class InputRecorder
+	{
+	public:
+		InputRecorder();
+
+		void Start(float timeStep, glm::ivec2 windowSize);
+		void Stop();
+		bool IsRecording() const;
+
+		void BeginFrame(unsigned int stepIndex);	//Inputs recorded until the next call are handled before the given step
+		void RecordEvent(const Event&);
+		void RecordMouseLook(glm::vec2 offset);
+		void RecordMouseControl(bool bControlled);
+
+		const InputRecording& GetRecording() const;
+
+	private:
+		InputRecord& AddRecord(InputRecordType);
+
+		InputRecording Recording;
+		bool bRecording;
+		unsigned int CurrentStepIndex;
+		std::chrono::steady_clock::time_point StartTime;
+	};
+
+	/**
+	 * @brief Plays back an InputRecording. It also keeps the state of the keys and the mouse that the recorded events lead to, so InputDevicesStateRetriever can be answered without a window.
+	*/
+	class InputReplayer
+	{
+	public:
+		InputReplayer(InputRecording&&);
+
+		/**
+		 * @brief Returns the next record of the given step and applies it to the replayed key and mouse state.
+		 * @return nullptr if all records of the step have been returned
+		*/
+		const InputRecord* PollRecord(unsigned int stepIndex);
+		bool IsFinished(unsigned int stepIndex) const;	//True once all steps of the recording have been done
+		const InputRecording& GetRecording() const;
+
+		bool IsKeyPressed(Key) const;
+		glm::dvec2 GetMousePosition() const;
+
+		/**
+		 * @brief Recreates the event that was recorded.
+		 * @param eventFunc: called with the event (of its original class)
+		*/
+		template <typename EventFunction> static void VisitEvent(const InputRecord&, EventFunction&& eventFunc);
+
+	private:
+		InputRecording Recording;
+		size_t NextRecord;
+		std::array<bool, static_cast<size_t>(Key::LAST) + 1> PressedKeys;
+		glm::dvec2 MousePosition;
+	};
+
+	template<typename EventFunction>
+	inline void InputReplayer::VisitEvent(const InputRecord& record, EventFunction&& eventFunc)
+	{
+		switch (record.EvType)
+		{
+		case EventType::KEY_PRESSED:
+		case EventType::KEY_REPEATED:
+		case EventType::KEY_RELEASED:
+			eventFunc(KeyEvent(record.EvType, static_cast<Key>(record.A), record.B)); break;
+		case EventType::MOUSE_PRESSED:
+		case EventType::MOUSE_RELEASED:
+			eventFunc(MouseButtonEvent(record.EvType, static_cast<MouseButton>(record.A), record.B)); break;
+		case EventType::MOUSE_MOVED:
+			eventFunc(CursorMoveEvent(record.EvType, glm::uvec2(glm::vec2(record.X, record.Y)))); break;
+		case EventType::MOUSE_SCROLLED:
+			eventFunc(MouseScrollEvent(record.EvType, glm::vec2(record.X, record.Y))); break;
+		case EventType::CHARACTER_ENTERED:
+			eventFunc(CharEnteredEvent(record.EvType, static_cast<unsigned int>(record.A))); break;
+		default:
+			eventFunc(Event(record.EvType));
+		}
+	}
+}
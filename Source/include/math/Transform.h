@@ -39,6 +39,9 @@ namespace GEE
 
 		mutable std::vector <bool> DirtyFlags;
 		mutable bool Empty;	//true if the Transform object has never been changed. Allows for a simple optimization - we skip it during world transform calculation
+		mutable int RenderSnapshotSlot;	//Index of this transform's states in the RenderSnapshot. Never copied, so a new Transform never reads the states of another one
+
+		friend class RenderSnapshot;
 	public:
 		std::vector <std::shared_ptr<InterpolatorBase>> Interpolators;
 
@@ -35,6 +35,13 @@ namespace GEE
 			COLLISION_LAST = COLLISION_TRIANGLE_MESH
 		};
 
+		enum CollisionGroup : unsigned int	//Bits of CollisionObject::CollisionGroups; scene queries only hit the objects in the groups they ask for
+		{
+			COLLISION_GROUP_DEFAULT = 1 << 0,
+			COLLISION_GROUP_CHARACTER = 1 << 1,	//Character controllers
+			COLLISION_GROUP_ALL = 0xFFFFFFFF
+		};
+
 		struct CollisionShape
 		{
 			CollisionShapeType Type;
@@ -46,8 +53,9 @@ namespace GEE
 			};
 			std::shared_ptr<ColShapeLoc> OptionalLocalization;
 			Transform ShapeTransform;
-			std::vector<glm::vec3> VertData;
+			std::vector<glm::vec3> VertData;		//Released once the mesh has been cooked (see CookedMeshCache)
 			std::vector<unsigned int> IndicesData;
+			uint64_t MeshHash;	//The key of the cooked triangle mesh in CookedMeshCache; 0 if it has not been computed yet
 			CollisionShape(CollisionShapeType type = CollisionShapeType::COLLISION_BOX);
 			CollisionShape(HTreeObjectLoc treeObjLoc, const std::string& meshName, CollisionShapeType type = CollisionShapeType::COLLISION_BOX);
 			ColShapeLoc* GetOptionalLocalization();	//NOTE: Can be nullptr
@@ -96,6 +104,8 @@ namespace GEE
 			std::vector <std::shared_ptr<CollisionShape>> Shapes;
 			Transform* TransformPtr;
 			unsigned int TransformDirtyFlag;
+			Vec3f ShapesScale;	//The world scale of the object when its PhysX shapes were last scaled; they are only rescaled if the scale changes
+			unsigned int CollisionGroups;	//The CollisionGroup bits of the object. Not serialized - set by the gameplay code
 			bool IgnoreRotation;
 
 			bool IsStatic;
@@ -108,6 +118,7 @@ namespace GEE
 
 			CollisionShape& AddShape(std::shared_ptr<CollisionShape> shape);
 			CollisionShape* FindTriangleMeshCollisionShape(const std::string& meshNodeName, const std::string& meshSpecificName);
+			void SetCollisionGroups(unsigned int groups);	//Also updates the PhysX shapes if they have already been created
 			template <typename Archive> void Serialize(Archive& archive)
 			{
 				archive(CEREAL_NVP(IsStatic), CEREAL_NVP(IgnoreRotation), CEREAL_NVP(Shapes));
@@ -0,0 +1,58 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace physx
+{
+	class PxPhysics;
+	class PxCooking;
+	class PxTriangleMesh;
+}
+
+namespace GEE
+{
+	namespace Physics
+	{
+		struct CollisionShape;
+
+		/**
+		 * @brief Cooked PhysX triangle meshes keyed by the hash of their vertices and indices. Identical meshes are cooked once and shared by all the shapes that use them.
+		 * The cooked data is also written to disk (<directory>/<hash>.pxmesh), so a mesh is only cooked the first time a level that uses it is loaded.
+		*/
+		class CookedMeshCache
+		{
+		public:
+			CookedMeshCache(const std::string& directory = "CookedMeshes/");
+			CookedMeshCache(const CookedMeshCache&) = delete;
+			CookedMeshCache& operator=(const CookedMeshCache&) = delete;
+			~CookedMeshCache();
+
+			void Init(physx::PxPhysics&, physx::PxCooking&);
+
+			static uint64_t ComputeHash(const std::vector<glm::vec3>& vertices, const std::vector<unsigned int>& indices);
+
+			/**
+			 * @brief Returns the cooked mesh of a triangle mesh collision shape: from memory, from disk or cooked from the vertices of the shape, in this order.
+			 * The vertices and indices of the shape are released afterwards - the shape only keeps the hash of the mesh (CollisionShape::MeshHash).
+			 * @return nullptr if the mesh is not cached and the shape has no vertices to cook it from
+			*/
+			physx::PxTriangleMesh* GetTriangleMesh(CollisionShape&);
+
+			void Clear();	//Releases the references of the cache to the meshes; shapes keep their meshes alive
+
+		private:
+			physx::PxTriangleMesh* Cook(const CollisionShape&, uint64_t hash);
+			physx::PxTriangleMesh* LoadFromDisk(uint64_t hash) const;
+			bool SaveToDisk(uint64_t hash, const unsigned char* cookedData, unsigned int size) const;
+			std::string GetFilepath(uint64_t hash) const;
+
+			std::unordered_map<uint64_t, physx::PxTriangleMesh*> Meshes;
+			std::string Directory;
+			physx::PxPhysics* Physics;
+			physx::PxCooking* Cooking;
+		};
+	}
+}
@@ -12,19 +12,37 @@
 #include <game/GameScene.h>
 
 #include <vector>
+#include <unordered_map>
+#include <functional>
 #include <game/GameManager.h>
 
 #include <math/Vec.h>
+#include <physics/CookedMeshCache.h>
 
 namespace GEE
 {
 	struct CollisionShape;
+	class JobSystem;
 	class RenderEngine;
 	class Transform;
 	class RenderInfo;
 
 	namespace Physics
 	{
+		/**
+		 * @brief Runs the PhysX tasks on the threads of the job system of the engine, so PhysX does not start any threads of its own.
+		*/
+		class JobSystemCpuDispatcher : public physx::PxCpuDispatcher
+		{
+		public:
+			JobSystemCpuDispatcher(JobSystem&);
+			virtual void submitTask(physx::PxBaseTask&) override;
+			virtual uint32_t getWorkerCount() const override;
+
+		private:
+			JobSystem& Jobs;
+		};
+
 		class PhysicsEngine : public PhysicsEngineManager
 		{
 			physx::PxDefaultAllocator Allocator;
@@ -33,8 +51,11 @@ namespace GEE
 			static physx::PxFoundation* Foundation;
 			physx::PxPhysics* Physics;
 
-			physx::PxDefaultCpuDispatcher* Dispatcher;
+			physx::PxCpuDispatcher* Dispatcher;	//Shared by all scenes; points to one of the two dispatchers below
+			std::unique_ptr<JobSystemCpuDispatcher> JobDispatcher;
+			physx::PxDefaultCpuDispatcher* DefaultDispatcher;
 			physx::PxCooking* Cooking;
+			CookedMeshCache MeshCache;
 
 			physx::PxMaterial* DefaultMaterial;
 			physx::PxPvd* Pvd;
@@ -44,27 +65,77 @@ namespace GEE
 			bool WasSetup;
 			bool* DebugModePtr;
 
+			bool bAsyncSimulation;
+			bool bSimulating;	//True between Simulate and FetchResults; the PhysX scenes must not be modified then
+
+			struct BufferedCommand
+			{
+				CollisionObject* Object;
+				std::function<void(CollisionObject&)> Command;
+			};
+			std::vector<std::pair<GameScenePhysicsData*, CollisionObject*>> BufferedAdditions;	//Calls made while a step is simulated, applied once its results are fetched
+			std::vector<BufferedCommand> BufferedCommands;	//Applied in the order they were issued
+			std::vector<physx::PxRigidActor*> BufferedReleases;
+
+			std::unordered_map<const physx::PxActor*, CollisionObject*> CollisionObjectsByActor;	//For mapping the active actors reported by PhysX back to our objects
+
+			std::vector<std::pair<GameScenePhysicsData*, SceneQueryBatch*>> DeferredSceneQueries;	//Executed at the end of the update (in Simulate)
+			JobSystem* Jobs;
+
+			std::vector<std::pair<physx::PxRigidActor*, physx::PxTransform>> PoseUpdates;	//Reused by UpdatePxTransforms, so it doesn't allocate every frame
+			std::vector<physx::PxShape*> ShapesBuffer;
+
 		public:
 			PhysicsEngine(bool* debugmode);
-			void Init();
+			/**
+			 * @param jobs: the job system that runs the PhysX tasks if workerCount is 0. It must be initialized and must outlive the simulation of any scene.
+			 * @param workerCount: the number of threads of a PhysX dispatcher shared by all scenes. Pass 0 to run the PhysX tasks on the job system instead.
+			*/
+			void Init(JobSystem& jobs, unsigned int workerCount = 0);
+
+			/**
+			 * @brief Enables the split-phase (asynchronous) mode. In this mode Update only fetches the results of the step started by Simulate at the end of the previous update, so PhysX simulates while the frame is rendered.
+			 * Scenes are not modified while a step is simulated - adding and removing collision objects and applying forces are buffered until the results are fetched.
+			*/
+			void SetAsyncSimulation(bool);
+			bool IsAsyncSimulation() const;
+			virtual bool IsSimulating() const override;
+			virtual CollisionObject* FindCollisionObject(const physx::PxActor&) override;
+
+			virtual void ScheduleSceneQueries(GameScenePhysicsData&, SceneQueryBatch&) override;
+			virtual void CancelSceneQueries(SceneQueryBatch&) override;
 
 		private:
 			physx::PxShape* CreateTriangleMeshShape(CollisionShape*, glm::vec3 scale);
 			virtual void AddCollisionObjectToPxPipeline(GameScenePhysicsData& scenePhysicsData, CollisionObject&) override;
+			virtual void RemoveCollisionObjectFromPxPipeline(CollisionObject&) override;
+			void FlushBufferedCommands();
+			void ExecuteOrBuffer(CollisionObject&, std::function<void(CollisionObject&)> command);	//Executes the command right away, unless a step is simulated
 
 		public:
 			virtual void CreatePxShape(CollisionShape&, CollisionObject&) override;
 			void AddScenePhysicsDataPtr(GameScenePhysicsData& scenePhysicsData);
 			virtual void RemoveScenePhysicsDataPtr(GameScenePhysicsData& scenePhysicsData) override;
+			virtual void ReleaseScenePhysicsData(GameScenePhysicsData& scenePhysicsData) override;
 
 			virtual physx::PxController* CreateController(GameScenePhysicsData& scenePhysicsData, const Transform& t) override;
 
 			virtual void ApplyForce(CollisionObject&, glm::vec3 force) override;
+			virtual void SetVelocity(CollisionObject&, glm::vec3 linear, glm::vec3 angular = glm::vec3(0.0f)) override;
+			virtual void SetSimulationEnabled(CollisionObject&, bool) override;
+			virtual void SetContinuousCollision(CollisionObject&, bool) override;
 			void SetupScene(GameScenePhysicsData& scenePhysicsData);
 
-			void Update(float deltaTime);
-			void UpdateTransforms();
-			void UpdatePxTransforms();
+			void Update(float deltaTime);	//Does the whole step in the synchronous mode; fetches the results of the step in flight in the asynchronous mode
+			void Simulate(float deltaTime);	//Executes the deferred scene queries and starts a step without waiting for it (the step is only started in the asynchronous mode)
+			void FetchResults();			//Waits for the step in flight (if any), updates the transforms and applies the buffered calls
+			void UpdateTransforms();	//Writes back the transforms of the actors that moved during the last step (PhysX reports them as active); sleeping bodies are skipped
+			void UpdatePxTransforms();	//Sends the transforms changed since the last step to PhysX; the poses are set in one batch (as kinematic targets for kinematic bodies)
+
+		private:
+			void UpdatePxShapesScale(CollisionObject&, const Transform& worldTransform);	//Rescales the shapes of the actor in place
+
+		public:
 
 			virtual void DebugRender(GameScenePhysicsData& scenePhysicsData, RenderEngine&, RenderInfo&) override;
 			~PhysicsEngine();
@@ -72,6 +143,7 @@ namespace GEE
 
 
 		void ApplyForce(CollisionObject&, const Vec3f& force);
+		void SetVelocity(CollisionObject&, const Vec3f& linear, const Vec3f& angular);
 
 		namespace Util
 		{
@@ -0,0 +1,94 @@
+#pragma once
+#include <physics/CollisionObject.h>
+#include <vector>
+
+namespace GEE
+{
+	class JobSystem;
+
+	namespace Physics
+	{
+		enum class SceneQueryType
+		{
+			RAYCAST,
+			SWEEP,
+			OVERLAP
+		};
+
+		struct SceneQueryHit
+		{
+			physx::PxRigidActor* Actor = nullptr;	//nullptr if nothing was hit
+			Vec3f Position = Vec3f(0.0f);			//Not set for overlaps
+			Vec3f Normal = Vec3f(0.0f);				//Not set for overlaps
+			float Distance = 0.0f;					//Along the direction of the query; not set for overlaps
+
+			bool HasHit() const { return Actor != nullptr; }
+		};
+
+		/**
+		 * @brief A fixed-capacity batch of raycasts, sweeps and overlaps against a single scene. Every query returns the closest blocking hit (any hit for overlaps) and only hits the objects that belong to one of the collision groups of the query (see CollisionObject::CollisionGroups).
+		 * Queries are read-only, so the batch can be split between the threads of the job system. The queries and the results are kept until Clear is called, so the same batch can be executed every frame without allocating.
+		*/
+		class SceneQueryBatch
+		{
+		public:
+			SceneQueryBatch(unsigned int capacity);
+			SceneQueryBatch(const SceneQueryBatch&) = delete;
+			SceneQueryBatch& operator=(const SceneQueryBatch&) = delete;
+			~SceneQueryBatch();
+
+			/**
+			 * @brief Adds a query to the batch.
+			 * @param shapeType: the shape swept or overlapped (box, sphere or capsule)
+			 * @param shapeSize: half extents of a box; the radius of a sphere in x; the radius and the half height of a capsule in x and y
+			 * @param groupMask: the collision groups that can be hit
+			 * @return the index of the query (and of its result), or -1 if the batch is full or pending
+			*/
+			int AddRaycast(const Vec3f& origin, const Vec3f& direction, float maxDistance, unsigned int groupMask = COLLISION_GROUP_ALL);
+			int AddSweep(CollisionShapeType shapeType, const Vec3f& shapeSize, const Vec3f& origin, const Quatf& rotation, const Vec3f& direction, float maxDistance, unsigned int groupMask = COLLISION_GROUP_ALL);
+			int AddOverlap(CollisionShapeType shapeType, const Vec3f& shapeSize, const Vec3f& position, const Quatf& rotation, unsigned int groupMask = COLLISION_GROUP_ALL);
+
+			/**
+			 * @brief Executes all queries of the batch right away.
+			 * @param jobs: (optional) the queries are split between the threads of the job system. The calling thread waits for all of them.
+			*/
+			void Execute(GameScenePhysicsData&, JobSystem* jobs = nullptr);
+			/**
+			 * @brief Schedules the batch to be executed by the physics engine at the end of the current update (split between the threads of the job system), once the scenes are no longer modified by the gameplay code.
+			 * The results can be read from the next update. The batch must not be changed until then (IsPending returns false).
+			*/
+			void ExecuteDeferred(GameScenePhysicsData&);
+			bool IsPending() const;
+
+			void Clear();	//Removes all queries and their results
+
+			unsigned int GetQueryCount() const;
+			unsigned int GetCapacity() const;
+			const SceneQueryHit& GetHit(unsigned int index) const;
+			CollisionObject* GetHitObject(unsigned int index) const;	//Returns nullptr if nothing was hit or if the hit actor does not belong to a CollisionObject (e.g. it is a character controller)
+
+		private:
+			friend class PhysicsEngine;
+			struct SceneQuery
+			{
+				SceneQueryType Type;
+				CollisionShapeType ShapeType;
+				Vec3f ShapeSize;
+				Vec3f Origin;
+				Quatf Rotation;
+				Vec3f Direction;
+				float MaxDistance;
+				unsigned int GroupMask;
+			};
+
+			int AddQuery(const SceneQuery&);
+			static void ExecuteQuery(physx::PxScene&, const SceneQuery&, SceneQueryHit&);
+
+			std::vector<SceneQuery> Queries;
+			std::vector<SceneQueryHit> Hits;
+			unsigned int Capacity;
+			GameScenePhysicsData* ExecutedScene;	//The scene the batch was last executed against (or is pending for)
+			bool bPending;
+		};
+	}
+}
@@ -7,6 +7,7 @@
 #include <rendering/Texture.h> 
 
 #include <math/Vec.h>
+#include <utility/NameIndex.h>
 #include <cereal/access.hpp>
 #include <cereal/archives/json.hpp>
 #include <cereal/types/polymorphic.hpp>
@@ -35,6 +36,7 @@ namespace GEE
 		Material(MaterialLoc, float depthScale = 0.0f, Shader* shader = nullptr);
 		const MaterialLoc& GetLocalization() const;
 		std::string GetName() const;
+		void SetName(const std::string&);	//Keeps the material index of the render engine up to date; do not assign Localization.Name directly
 		const std::string& GetRenderShaderName() const;
 		Vec4f GetColor() const;
 		void SetDepthScale(float);
@@ -61,7 +63,9 @@ namespace GEE
 		}
 		template <typename Archive> void Load(Archive& archive)
 		{
-			archive(cereal::make_nvp("Name", Localization.Name), cereal::make_nvp("Textures", Textures), cereal::make_nvp("Color", Color), cereal::make_nvp("Shininess", Shininess), cereal::make_nvp("DepthScale", DepthScale), cereal::make_nvp("RenderShaderName", RenderShaderName));
+			std::string name;
+			archive(cereal::make_nvp("Name", name), cereal::make_nvp("Textures", Textures), cereal::make_nvp("Color", Color), cereal::make_nvp("Shininess", Shininess), cereal::make_nvp("DepthScale", DepthScale), cereal::make_nvp("RenderShaderName", RenderShaderName));
+			SetName(name);
 			if (RenderShaderName.empty())
 				RenderShaderName = "Geometry";
 		}
@@ -93,6 +97,9 @@ namespace GEE
 
 		std::shared_ptr<NamedTexture> FindTexture(const std::string& path) const;	//Looks for a texture loaded from the given path.
 		void AddTexture(std::shared_ptr<NamedTexture>);		//Adds the given texture to the LoadedTextures vector. Doesn't check for duplicates - do it yourself using FindTexture()
+
+	private:
+		NameIndex<size_t> LoadedTexturesIndex;	//Indices of LoadedTextures by path
 	};
 
 	/*
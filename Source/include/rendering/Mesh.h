@@ -26,6 +26,14 @@ namespace GEE
 		class HierarchyTreeT;
 	}
 
+	class CPUSkinnedMesh;
+
+	enum class SkinningBackend
+	{
+		GPU,	//Vertices are skinned in the vertex shader of every pass
+		CPU		//Vertices are skinned once per frame into a dynamic vertex stream that every pass reuses
+	};
+
 	class Mesh
 	{
 	public:
@@ -45,6 +53,7 @@ namespace GEE
 		const Material* GetMaterial() const;
 		std::vector<Vertex>* GetVertsData() const;
 		std::vector<unsigned int>* GetIndicesData() const;
+		const std::vector<Vertex>* GetBindPoseVertsData() const;	//Returns nullptr if the mesh is not skinned
 		void RemoveVertsAndIndicesData() const;
 		bool CanCastShadow() const;
 
@@ -76,6 +85,7 @@ namespace GEE
 	private:
 		friend class RenderEngine;	//TODO: usun te linijke po zmianie
 		friend class ModelComponent;
+		friend class CPUSkinnedMesh;
 
 		MeshLoc Localization;
 
@@ -85,6 +95,7 @@ namespace GEE
 
 		mutable std::shared_ptr<std::vector<Vertex>> VertsData;
 		mutable std::shared_ptr<std::vector<unsigned int>> IndicesData;
+		std::shared_ptr<const std::vector<Vertex>> BindPoseVertsData;	//Kept for skinned meshes, so they can be skinned on the CPU without reading the vertex buffer back. Not removed by RemoveVertsAndIndicesData
 
 		bool CastsShadow;
 	};
@@ -94,19 +105,26 @@ namespace GEE
 		Mesh& MeshRef;
 		std::shared_ptr<MaterialInstance> MaterialInst;
 
+		SkinningBackend Skinning;
+		mutable std::unique_ptr<CPUSkinnedMesh> CPUSkinnedStream;	//Created on first use; never copied
+
 	public:
 		MeshInstance(Mesh& mesh, Material* overrideMaterial = nullptr);
 		MeshInstance(Mesh& mesh, std::shared_ptr<MaterialInstance>);
 		MeshInstance(const MeshInstance&);
 		MeshInstance(MeshInstance&&) noexcept;
+		~MeshInstance();
 
 		Mesh& GetMesh();
 		const Mesh& GetMesh() const;
 		const Material* GetMaterialPtr() const;
 		MaterialInstance* GetMaterialInst() const;
+		SkinningBackend GetSkinningBackend() const;
+		CPUSkinnedMesh* GetCPUSkinnedMesh() const;	//Returns nullptr if the CPU skinning backend is not selected or the mesh cannot be skinned on the CPU
 
 		void SetMaterial(Material*);
 		void SetMaterialInst(std::shared_ptr<MaterialInstance>);
+		void SetSkinningBackend(SkinningBackend);	//Only affects skeletal meshes. Select SkinningBackend::CPU for meshes that are rendered in many passes per frame (e.g. shadow casters lit by several point lights)
 
 		template <typename Archive> void Save(Archive& archive)	const
 		{
@@ -116,7 +134,7 @@ namespace GEE
 				materialInst = nullptr;	//don't save the material instance if its the same as the mesh default material.
 
 			archive(cereal::make_nvp("MeshTreePath", mesh.GetLocalization().GetTreeName()), cereal::make_nvp("MeshNodeName", mesh.GetLocalization().NodeName), cereal::make_nvp("MeshSpecificName", mesh.GetLocalization().SpecificName));
-			archive(cereal::make_nvp("MaterialInst", materialInst));
+			archive(cereal::make_nvp("MaterialInst", materialInst), cereal::make_nvp("Skinning", Skinning));
 		}
 		template <typename Archive> static void load_and_construct(Archive& archive, cereal::construct<MeshInstance>& construct)
 		{
@@ -137,12 +155,21 @@ namespace GEE
 			std::shared_ptr<MaterialInstance> materialInst;
 			archive(cereal::make_nvp("MaterialInst", materialInst));
 
+			SkinningBackend skinning = SkinningBackend::GPU;
+			try
+			{
+				archive(cereal::make_nvp("Skinning", skinning));
+			}
+			catch (cereal::Exception&) {}	//Saved before the backend could be selected; the JSON archive throws before changing its position
+
 			if (materialInst)
 				construct(MeshInstance(*mesh, materialInst));
 			else
 				construct(MeshInstance(*mesh));
+			construct->SetSkinningBackend(skinning);
 		}
 	};
 
 	unsigned int generateVAO(unsigned int&, std::vector<unsigned int>, size_t, float*, size_t = -1);
+	void setVertexAttribPointers();	//Sets up and enables attributes 0-6 for the Vertex layout in the currently bound VAO & VBO
 }
\ No newline at end of file
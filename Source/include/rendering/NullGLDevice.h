@@ -0,0 +1,38 @@
+#pragma once
+
+namespace GEE
+{
+	/**
+	 * @brief Commands counted by the null GL device. They are accumulated until ResetCounters is called.
+	*/
+	enum class NullGLCounter
+	{
+		DRAW_CALLS,
+		CLEARS,
+		BINDS,				//Buffers, textures, framebuffers, renderbuffers, vertex arrays, samplers, programs and texture units
+		STATE_CHANGES,		//Capabilities, blending, depth, stencil, culling, masks, viewports and draw buffers
+		BYTES_UPLOADED,		//Buffer and texture data sent with the calls (allocations without data are not counted)
+		OBJECTS_CREATED
+	};
+	constexpr unsigned int NullGLCounterCount = static_cast<unsigned int>(NullGLCounter::OBJECTS_CREATED) + 1;
+
+	/**
+	 * @brief Headless render device. All of the engine's GL calls go through the function pointers loaded by glad, so the device is swapped by loading glad with a different loader:
+	 * Load() points every function at an implementation that accepts the call without a GPU or a context, returns fake handles and successful statuses, and counts the submitted commands.
+	 * This lets the whole render path (shader loading, FullSceneRender, postprocessing) run on machines without a GPU, e.g. for benchmarks.
+	 * Call Load() instead of gladLoadGLLoader, before any engine object is created. Not thread-safe - like a real context, it may only be used on the main thread.
+	*/
+	class NullGLDevice
+	{
+	public:
+		/**
+		 * @brief Loads glad with the null implementation. Reports OpenGL 4.0 with GL_ARB_debug_output.
+		 * @return true if glad was loaded
+		*/
+		static bool Load();
+		static bool IsLoaded();
+
+		static unsigned long long GetCounter(NullGLCounter);
+		static void ResetCounters();
+	};
+}
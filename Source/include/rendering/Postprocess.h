@@ -34,6 +34,7 @@ namespace GEE
 		friend class RenderEngine;	//usun to
 
 		std::shared_ptr<Shader> QuadShader;
+		std::unique_ptr<MeshInstance> QuadMeshInst;	//Created once, so rendering a fullscreen quad does not allocate
 
 		mutable unsigned int FrameIndex;
 
@@ -59,7 +60,7 @@ namespace GEE
 		void RenderFullscreenQuad(RenderInfo& info, Shader* shader = nullptr, bool useShader = true) const {
 			if (!shader) shader = RenderHandle->FindShader("Quad");
 			if (useShader)	shader->Use();
-			RenderHandle->RenderStaticMesh(info, MeshInstance(RenderHandle->GetBasicShapeMesh(EngineBasicShape::QUAD), nullptr), Transform(), shader);
+			RenderHandle->RenderStaticMesh(info, *QuadMeshInst, Transform(), shader);
 		}
 
 		void Dispose();
@@ -2,6 +2,10 @@
 #include "Postprocess.h"
 #include <game/GameManager.h>
 #include "RenderToolbox.h"
+#include <animation/SkeletonInfo.h>
+#include <rendering/RenderSnapshot.h>
+#include <utility/NameIndex.h>
+#include <utility/MemoryArena.h>
 namespace GEE
 {
 	class LightProbe;
@@ -22,6 +26,7 @@ namespace GEE
 		virtual Mesh& GetBasicShapeMesh(EngineBasicShape) override;
 		virtual Shader* GetLightShader(const RenderToolboxCollection& renderCol, LightType type) override;
 		virtual RenderToolboxCollection* GetCurrentTbCollection() override;
+		virtual RenderSnapshot& GetRenderSnapshot() override;
 
 		virtual std::vector<Material*> GetMaterials() override;
 
@@ -35,20 +40,20 @@ namespace GEE
 		virtual Material* AddMaterial(std::shared_ptr<Material> material) override;
 		virtual std::shared_ptr<Shader> AddShader(std::shared_ptr<Shader> shader, bool bForwardShader = false) override;
 
-		void BindSkeletonBatch(SkeletonBatch* batch);
-		void BindSkeletonBatch(GameSceneRenderData* sceneRenderData, unsigned int index);
+		bool BindSkeletonPalette(SkeletonInfo& skelInfo);
 
 		virtual void EraseRenderTbCollection(RenderToolboxCollection& tbCollection) override;
 		virtual void EraseMaterial(Material&) override;
+		virtual void UpdateMaterialNameIndex(Material&, const std::string& previousName) override;
 
-		virtual std::shared_ptr<Material> FindMaterial(std::string) override;
-		virtual Shader* FindShader(std::string) override;
+		virtual std::shared_ptr<Material> FindMaterial(const std::string&) override;
+		virtual Shader* FindShader(const std::string&) override;
 
 
 		void RenderShadowMaps(RenderToolboxCollection& tbCollection, GameSceneRenderData* sceneRenderData, std::vector<std::reference_wrapper<LightComponent>>);
 		void RenderVolume(const RenderInfo&, EngineBasicShape, Shader&, const Transform* = nullptr);
 		void RenderVolume(const RenderInfo&, RenderableVolume*, Shader* boundShader, bool shadedRender);
-		void RenderVolumes(const RenderInfo&, const GEE_FB::Framebuffer& framebuffer, const std::vector<std::unique_ptr<RenderableVolume>>&, bool bIBLPass);
+		void RenderVolumes(const RenderInfo&, const GEE_FB::Framebuffer& framebuffer, const ArenaVector<RenderableVolume*>&, bool bIBLPass);
 		void RenderLightProbes(GameSceneRenderData* sceneRenderData);
 		void RenderRawScene(const RenderInfo& info, GameSceneRenderData* sceneRenderData, Shader* shader = nullptr);
 		void RenderRawSceneUI(const RenderInfo& info, GameSceneRenderData* sceneRenderData);
@@ -80,6 +85,7 @@ namespace GEE
 		void GenerateEngineObjects();
 		void LoadInternalShaders();
 		void Resize(glm::uvec2 resolution);
+		void RenderStaticMeshInstances(const RenderInfo& info, const MeshInstance* const* meshes, size_t meshCount, const Transform& transform, Shader* shader, glm::mat4* lastFrameMVP, Material* overrideMaterial, bool billboard);	//Renders the meshes without copying them into a vector
 
 		GameManager* GameHandle;
 		glm::uvec2 Resolution;
@@ -95,11 +101,18 @@ namespace GEE
 		std::vector <std::shared_ptr <Shader>> ForwardShaders;		//We store forward shaders in a different vector to attempt rendering the scene at forward render stage. Putting non-forward-rendering shaders here will reduce performance.
 		//std::vector <std::shared_ptr <Shader>> SettingIndependentShaders;		//TODO: Put setting independent shaders here. When the user asks for a shader, search in CurrentTbCollection first. Then check here.
 		std::vector <Shader*> LightShaders;		//Same with light shaders
+
+		NameIndex<std::shared_ptr<Material>> MaterialIndex;	//Materials and Shaders indexed by name. Materials are renamed through Material::SetName; shader names must not change after they have been added
+		NameIndex<Shader*> ShaderIndex;
 		std::shared_ptr <Texture> EmptyTexture;
 
 		const Mesh* BoundMesh;
 		const Material* BoundMaterial;
-		SkeletonBatch* BoundSkeletonBatch;
+		const SkeletonInfo* BoundSkeletonInfo;
+		BonePaletteRing BonePalettes;
+		std::vector<glm::mat4> CPUSkinningPalette;
+		unsigned long long FrameIndex;	//Incremented in PrepareFrame
+		RenderSnapshot Snapshot;	//Interpolated transforms of the two most recent simulation states
 
 		std::vector <std::unique_ptr <RenderToolboxCollection>> RenderTbCollections;
 		RenderToolboxCollection* CurrentTbCollection;
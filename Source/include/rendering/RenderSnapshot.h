@@ -0,0 +1,71 @@
+#pragma once
+#include <math/Transform.h>
+#include <vector>
+
+namespace GEE
+{
+	class GameSceneRenderData;
+	class CameraComponent;
+
+	/**
+	 * @brief Double-buffered world transforms of everything that moves on screen - renderables, bones of skinned meshes, lights and active cameras. A new state is captured after every fixed simulation step.
+	 * Rendering interpolates between the two most recent simulation states using the fraction of the time step left in the accumulator, so the image stays smooth when the frame rate is higher than the simulation rate (e.g. 144 Hz rendering with 60 Hz simulation).
+	 * States are kept in a flat array of slots. Every captured Transform remembers the index of its slot, so a query is a single array access. Slots of transforms that were not captured in the last step are reused, so once the scene stops growing no memory is allocated.
+	 * Transforms are never dereferenced through the slots - a destroyed transform's slot simply stops being captured and is recycled.
+	*/
+	class RenderSnapshot
+	{
+	public:
+		RenderSnapshot();
+
+		bool IsEnabled() const;
+		void SetEnabled(bool);
+
+		void BeginCapture();	//Call after every simulation step, before capturing the scenes. The most recent state becomes the previous one
+		/**
+		 * @brief Captures the world transforms of the renderables and skeletons of a scene.
+		 * @param sceneRenderData: the render data of the scene
+		 * @param activeCamera: (optional) the camera of the scene
+		*/
+		void Capture(const GameSceneRenderData& sceneRenderData, const CameraComponent* activeCamera);	//Captures lights too
+		void SetAlpha(float alpha);	//0 - previous simulation state, 1 - the most recent one. Call once per frame, before rendering
+
+		/**
+		 * @return the interpolated world matrix of the transform, or its current world matrix if it was not captured in both of the states
+		*/
+		glm::mat4 GetWorldMatrix(const Transform&) const;
+		/**
+		 * @brief By default, the position is interpolated but the rotation is not - the mouse rotates the camera every frame, so interpolating it would only add latency.
+		 * @param transform: the transform of the camera (or light)
+		 * @param interpolateRotation: whether the rotation should be interpolated as well (lights)
+		 * @return the view matrix
+		*/
+		glm::mat4 GetViewMatrix(const Transform& transform, bool interpolateRotation = false) const;
+		glm::vec3 GetWorldPosition(const Transform&) const;
+		glm::quat GetWorldRotation(const Transform&) const;
+
+		void Clear();
+
+	private:
+		struct TransformState
+		{
+			glm::vec3 Position;
+			glm::quat Rotation;
+			glm::vec3 Scale;
+		};
+		struct Slot
+		{
+			const Transform* Owner;	//nullptr if the slot is free
+			TransformState States[2];	//indexed by step % 2
+			long long CapturedStep[2];	//the step in which each of the states was captured
+		};
+		void CaptureTransform(const Transform&);
+		bool Interpolate(const Transform&, TransformState& result) const;
+
+		std::vector<Slot> Slots;
+		std::vector<int> FreeSlots;	//Always reserved to the capacity of Slots, so recycling never allocates
+		long long StepIndex;
+		float Alpha;
+		bool bEnabled;
+	};
+}
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <algorithm>
 #include <array>
@@ -57,13 +58,13 @@ namespace GEE
 		bool ExpectedMatrices[MATRICES_NB];
 
 		void DebugShader(unsigned int);
-		GLint FindLocation(std::string) const;
+		GLint FindLocation(std::string_view) const;	//Looking up a cached location does not allocate
 		friend class RenderEngine;
 	public:
 		mutable std::vector <UniformLocation> Locations;
 		std::array<std::string, 3> ShadersSource;
 		Shader(std::string name = "undefinedShader");
-		std::string GetName();
+		const std::string& GetName() const;
 		std::vector<std::pair<unsigned int, std::string>>* GetMaterialTextureUnits();
 		bool ExpectsMatrix(unsigned int);
 
@@ -73,17 +74,17 @@ namespace GEE
 		void SetExpectedMatrices(std::vector<MatrixType>);
 		void AddExpectedMatrix(std::string);
 
-		void Uniform1i(std::string, int) const;
-		void Uniform1f(std::string, float) const;
-		void Uniform2fv(std::string, glm::vec2) const;
-		void Uniform3fv(std::string, glm::vec3) const;
-		void Uniform4fv(std::string, glm::vec4) const;
-		void UniformMatrix3fv(std::string, glm::mat3) const;
-		void UniformMatrix4fv(std::string, const glm::mat4&) const;
-		void UniformBlockBinding(std::string, unsigned int) const;
+		void Uniform1i(std::string_view, int) const;
+		void Uniform1f(std::string_view, float) const;
+		void Uniform2fv(std::string_view, glm::vec2) const;
+		void Uniform3fv(std::string_view, glm::vec3) const;
+		void Uniform4fv(std::string_view, glm::vec4) const;
+		void UniformMatrix3fv(std::string_view, glm::mat3) const;
+		void UniformMatrix4fv(std::string_view, const glm::mat4&) const;
+		void UniformBlockBinding(std::string_view, unsigned int) const;
 		void UniformBlockBinding(unsigned int, unsigned int) const;
 
-		unsigned int GetUniformBlockIndex(std::string) const;
+		unsigned int GetUniformBlockIndex(std::string_view) const;
 		void Use() const;
 		void BindMatrices(const glm::mat4& model, const glm::mat4* view, const glm::mat4* projection, const glm::mat4* VP) const;
 
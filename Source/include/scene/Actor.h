@@ -4,6 +4,7 @@
 #include <input/Event.h>
 #include <iostream>
 #include <map>
+#include <array>
 #include <cereal/archives/json.hpp>
 #include <cereal/types/polymorphic.hpp>
 #include <cereal/types/vector.hpp>
@@ -41,6 +42,8 @@ namespace GEE
 		GameScene& GetScene();
 		GameManager* GetGameHandle();
 		bool IsBeingKilled() const;
+		bool IsSerializable() const;
+		void SetSerializable(bool);	//Actors created at runtime by another object (e.g. the actor of a ProjectilePool) should not be saved with the scene, because their owner creates them again after loading
 
 		void SetName(const std::string&);
 
@@ -52,6 +55,11 @@ namespace GEE
 		void SetTransform(Transform);
 		void AddComponent(std::unique_ptr<Component>);
 		virtual Actor& AddChild(std::unique_ptr<Actor>);
+		/**
+		 * @brief Removes a child from this actor without destroying it, so it can be added to another actor.
+		 * @return the detached child or nullptr if the actor is not a child of this actor
+		*/
+		std::unique_ptr<Actor> DetachChild(Actor& child);
 		template <typename ChildClass, typename... Args> ChildClass& CreateChild(Args&&...);
 		template <typename CompClass, typename... Args> CompClass& CreateComponent(Args&&...);	//Adds a new component that is a child of RootComponent.
 		template <typename CompClass, typename... Args> CompClass& CreateComponent(CompClass&&, Component* parent);	//Adds a new component that is a child of parent. Pass nullptr as the second argument to make this created component the new RootComponent.
@@ -59,9 +67,17 @@ namespace GEE
 
 		virtual void Setup();
 
-		virtual void HandleEvent(const Event& ev) {}
+		virtual void HandleEvent(const Event& ev) {}	//Only called for the types of events that the actor is subscribed to
+		/**
+		 * @brief Passes the event to this actor and its descendants. Subtrees without any actor subscribed to the event type are skipped, so the cost of dispatching depends on the number of listeners and not on the size of the scene.
+		*/
 		virtual void HandleEventAll(const Event& ev);
 
+		void SubscribeToEvent(EventType);
+		void UnsubscribeFromEvent(EventType);
+		bool IsSubscribedToEvent(EventType) const;
+		bool HasEventListenersInHierarchy(EventType) const;	//Returns true if this actor or any of its descendants is subscribed to the event type
+
 		virtual void Update(float);
 		void UpdateAll(float);
 
@@ -72,8 +88,14 @@ namespace GEE
 		virtual void DebugRender(RenderInfo info, Shader* shader) const; //this method should only be called to render the components as something (usually a textured billboard) to debug the project.
 		void DebugRenderAll(RenderInfo info, Shader* shader) const;
 
+		/**
+		 * @brief Looks for an actor in the hierarchy of this actor (including this actor). A name that is unique in the scene is resolved through the name index of the scene; a shared name is searched for depth first.
+		 * @param name: the name of the actor
+		 * @return a pointer to the found actor or nullptr if no actor was found. If many actors share the name, the first one (depth first) is returned
+		*/
 		Actor* FindActor(const std::string& name);
 		const Actor* FindActor(const std::string& name) const;
+		bool IsDescendantOf(const Actor&) const;	//Returns true if this actor is a child, a child of a child (etc.) of the given actor
 
 		/**
 		 * @brief Creates UI elements to edit the Actor in the editor
@@ -97,20 +119,24 @@ namespace GEE
 
 		template <typename Archive> void Save(Archive& archive) const
 		{
-			archive(CEREAL_NVP(Name), CEREAL_NVP(RootComponent), CEREAL_NVP(Children));
+			archive(CEREAL_NVP(Name), CEREAL_NVP(RootComponent), cereal::make_nvp("Children", SerializableChildren{ Children }));
 		}
 		template <typename Archive> void Load(Archive& archive)
 		{
 			cereal::LoadAndConstruct<Component>::ActorRef = this;	//For constructing the root component and its children
 			cereal::LoadAndConstruct<Component>::ParentComp = nullptr;	//The root component doesn't have a parent
 			RootComponent = nullptr;
+			const std::string previousName = Name;
 			archive(CEREAL_NVP(Name), CEREAL_NVP(RootComponent));
+			UpdateNameIndex(previousName);
 			std::cout << "Serializing actor " << Name << '\n';
 
 			if (GameHandle->HasStarted())
 				OnStartAll();
 
 			//LoadAndConstruct<Actor>::ParentActor = this;
+			for (auto& it : Children)
+				it->DetachFromParentEventListeners();
 			Children.clear();
 			archive(CEREAL_NVP(Children));
 			//LoadAndConstruct<Actor>::ParentActor = ParentActor;
@@ -118,10 +144,35 @@ namespace GEE
 			{
 				it->ParentActor = this;
 				it->GetTransform()->SetParentTransform(GetTransform());
+				AttachChildEventListeners(*it);
 			}
 		}
 
-		virtual ~Actor() {}
+		virtual ~Actor();
+
+	private:
+		struct SerializableChildren	//Saves the serializable children that are not being killed in the same format as the vector of children, so they are loaded as one
+		{
+			const std::vector<std::unique_ptr<Actor>>& Children;
+
+			template <typename Archive> void Save(Archive& archive) const
+			{
+				cereal::size_type count = 0;	//Killed actors stay attached until the next update of the scene, so they must be skipped explicitly
+				for (auto& child : Children)
+					if (child->IsSerializable() && !child->IsBeingKilled())
+						count++;
+
+				archive(cereal::make_size_tag(count));
+				for (auto& child : Children)
+					if (child->IsSerializable() && !child->IsBeingKilled())
+						archive(child);
+			}
+		};
+
+		void UpdateNameIndex(const std::string& previousName);	//Call after Name has been changed directly
+		void ChangeEventListenerCount(EventType, int difference);	//Updates the count of this actor and all of its ancestors
+		void AttachChildEventListeners(Actor& child);
+		void DetachFromParentEventListeners();
 
 	protected:
 		std::unique_ptr<Component> RootComponent;
@@ -133,6 +184,12 @@ namespace GEE
 		GameManager* GameHandle;
 
 		bool bKillingProcessStarted;
+		bool bSerializable;
+
+	private:
+		unsigned int SubscribedEvents;	//Bitmask of EventTypes
+		std::array<unsigned int, EventTypeCount> EventListenerCounts;	//The number of actors subscribed to each EventType in the hierarchy of this actor (including this actor)
+		bool bEventListenersAttached;	//True if the listeners of this actor are counted by its parent
 	};
 
 
@@ -95,13 +95,13 @@ namespace GEE
 
 
 		virtual void Update(float);
-		void UpdateAll(float dt);
-
-		virtual void QueueAnimation(Animation*);
-		void QueueAnimationAll(Animation*);
-
-		virtual void QueueKeyFrame(AnimationChannel&);
-		void QueueKeyFrameAll(AnimationChannel&);
+		/**
+		 * @brief Make the Update method of this component be called every frame by the ComponentUpdateScheduler of the scene. Component types that need to be ticked call it in their constructors. Components that are not registered are not updated at all.
+		 * @param stage: the stage in which the component will be updated. Registering a component again moves it to the new stage.
+		*/
+		void RegisterForUpdate(UpdateStage stage);
+		void UnregisterFromUpdate();
+		bool IsRegisteredForUpdate() const;
 
 		virtual void DebugRender(RenderInfo info, Shader* shader) const; //this method should only be called to render the component as something (usually a textured billboard) to debug the project.
 		void DebugRenderAll(RenderInfo info, Shader* shader) const;
@@ -109,16 +109,29 @@ namespace GEE
 		virtual std::shared_ptr<AtlasMaterial> LoadDebugRenderMaterial(const std::string& materialName, const std::string& path);
 		virtual MaterialInstance GetDebugMatInst(EditorIconState);
 
-		Component* SearchForComponent(std::string name);
+		Component* SearchForComponent(const std::string& name);
 		template <class CompClass = Component> CompClass* GetComponent(const std::string& name)
 		{
-			if (Name == name)
-				return dynamic_cast<CompClass*>(this);
-
-			for (const auto& it : Children)
-				if (auto found = it->GetComponent<CompClass>(name))
+			return dynamic_cast<CompClass*>(FindComponent(name, [](Component& comp) { return dynamic_cast<CompClass*>(&comp) != nullptr; }));
+		}
+		/**
+		 * @brief Looks for a component in the hierarchy of this component. A name that is unique in the scene is resolved through the name index of the scene; a name shared by many components (e.g. bones of every instance of a model) is searched for depth first in this hierarchy, so the cost does not grow with the number of instances.
+		 * @param name: the name of the component
+		 * @param predicate: the found component must satisfy it (unless it is this component)
+		 * @return this component if its name matches, or the first component further in the hierarchy (depth first) that has the name and satisfies the predicate, or nullptr
+		*/
+		Component* FindComponent(const std::string& name, bool(*predicate)(Component&));
+		bool IsDescendantOf(const Component&) const;
+		template<class CompClass> CompClass* GetFirstComponent()	//Returns the first element further in the hierarchy tree (depth first) that is of CompClass type and is not being killed, or nullptr. Does not allocate, so it can be called every frame
+		{
+			for (auto& child : Children)
+			{
+				if (CompClass* c = dynamic_cast<CompClass*>(child.get()))
+					if (!c->IsBeingKilled())
+						return c;
+				if (CompClass* found = child->GetFirstComponent<CompClass>())
 					return found;
-
+			}
 			return nullptr;
 		}
 		template<class CompClass> void GetAllComponents(std::vector <CompClass*>* comps)	//this function returns every element further in the hierarchy tree (kids, kids' kids, ...) that is of CompClass type
@@ -159,7 +172,9 @@ namespace GEE
 		}
 		template <typename Archive> void Load(Archive& archive)
 		{
+			const std::string previousName = Name;
 			archive(CEREAL_NVP(Name), CEREAL_NVP(ComponentTransform), CEREAL_NVP(CollisionObj));
+			UpdateNameIndex(previousName);
 			if (CollisionObj)
 				Scene.GetPhysicsData()->AddCollisionObject(*CollisionObj, ComponentTransform);
 
@@ -192,6 +207,14 @@ namespace GEE
 		*/
 		virtual ~Component();
 
+	private:
+		void UpdateNameIndex(const std::string& previousName);	//Call after Name has been changed directly
+		Component* FindComponentDepthFirst(const std::string& name, bool(*predicate)(Component&));	//Does not check this component
+
+		friend class ComponentUpdateScheduler;
+		UpdateStage ScheduledStage;	//Only meaningful while the component is registered
+		int UpdateSlot;	//The index of this component in its stage of the ComponentUpdateScheduler or -1 if it is not registered
+
 	public:
 		friend class Actor;
 		std::unique_ptr<Component> DetachChild(Component& soughtChild);	//Find child in hierarchy and detach it from its parent
@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+#include <array>
+
+namespace GEE
+{
+	class Component;
+	class JobSystem;
+
+	/**
+	 * @brief Stages of the per-frame update of components, in the order of execution. Every component type that needs to be ticked opts in to exactly one stage.
+	 * Physics synchronisation is done by the PhysicsEngine before the scenes are updated, sound sources are moved by the VoiceManager after the scenes are updated, and lights do not need to be ticked, so they have no stages here. Transform interpolators are advanced by the actors that add them (e.g. the recoil of GunActor).
+	*/
+	enum class UpdateStage
+	{
+		ANIMATION,	//AnimationManagerComponent - advances animations, which pose the bones
+		BONES,		//BoneComponent - computes the final matrices from the posed bones
+		MATERIALS	//ModelComponent - advances the animations of material instances
+	};
+	constexpr unsigned int UpdateStageCount = static_cast<unsigned int>(UpdateStage::MATERIALS) + 1;
+
+	/**
+	 * @brief Updates the components of a scene stage by stage. Components of every stage are stored contiguously, so the cost of the update depends on the number of components that have to be ticked and not on the size of the scene.
+	 * Components are registered by the constructors of their types (see Component::RegisterForUpdate) and erased automatically when destroyed.
+	 * Killed components are deleted after all stages have been updated.
+	*/
+	class ComponentUpdateScheduler
+	{
+	public:
+		ComponentUpdateScheduler();
+		ComponentUpdateScheduler(const ComponentUpdateScheduler&) = delete;
+		ComponentUpdateScheduler& operator=(const ComponentUpdateScheduler&) = delete;
+
+		void Register(Component&, UpdateStage);
+		void Erase(Component&);
+
+		/**
+		 * @brief Allow the components of a stage to be updated in parallel by the job system. Only enable it for stages whose components do not touch shared state in Update - note that computing a world transform modifies the cached matrices of its parents.
+		 * Stages are serial by default.
+		*/
+		void SetStageParallel(UpdateStage, bool bParallel);
+		size_t GetComponentCount(UpdateStage) const;
+
+		/**
+		 * @brief Updates the components of every stage, in the order of the stages.
+		 * @param deltaTime: the time step
+		 * @param jobSystem: (optional) used for the stages that can be updated in parallel
+		*/
+		void Update(float deltaTime, JobSystem* jobSystem);
+
+		void QueueForDeletion(Component&);	//Called by Component::MarkAsKilled
+		void EraseFromDeletionQueue(Component&);
+		void DeleteQueuedComponents();
+
+	private:
+		struct Stage
+		{
+			std::vector<Component*> Components;
+			bool bParallel;
+		};
+		void Compact();
+
+		std::array<Stage, UpdateStageCount> Stages;
+		std::vector<Component*> DeletionQueue;
+		bool bUpdating;
+		bool bCompactionRequired;	//Components erased during the update leave empty slots, which are removed after the update
+	};
+}
@@ -13,6 +13,7 @@ namespace GEE
 {
 
 	template<class T> class Interpolator;
+	class AnimationManagerComponent;
 
 	enum MovementDirections
 	{
@@ -2,6 +2,7 @@
 #include <scene/Actor.h>
 #include <scene/ModelComponent.h>
 #include <scene/SoundSourceComponent.h>
+#include <scene/ProjectilePool.h>
 
 namespace GEE
 {
@@ -14,6 +15,7 @@ namespace GEE
 		virtual void HandleEvent(const Event& ev) override;
 		void SetFireModel(ModelComponent*);
 		void FireWeapon();	//try to fire held weapon (if exists & it's not on cooldown)
+		ProjectilePool* GetProjectiles();	//Creates the pool of bullets the first time it is called
 		virtual void GetEditorDescription(EditorDescriptionBuilder) override;
 		template <typename Archive>
 		void Save(Archive& archive) const
@@ -38,7 +40,7 @@ namespace GEE
 		ModelComponent* FireModel;
 		Audio::SoundSourceComponent* GunBlast;
 
-		int FiredBullets;
+		std::unique_ptr<ProjectilePool> Projectiles;
 
 		float FireCooldown;	//in seconds
 		float CooldownLeft;	//also in seconds
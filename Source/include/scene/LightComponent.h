@@ -73,6 +73,8 @@ namespace GEE
 
 		virtual ~LightComponent();
 
+		friend class LightVolume;
+
 	private:
 		LightType Type;
 
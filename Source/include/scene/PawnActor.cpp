@@ -7,6 +7,7 @@
 #include <scene/UIButtonActor.h>
 
 #include <scene/UIInputBoxActor.h>
+#include <scene/SoundSourceComponent.h>
 
 namespace GEE
 {
@@ -15,6 +16,7 @@ namespace GEE
 		PreAnimBonePos(glm::vec3(0.0f)),
 		//RootBone(nullptr),
 		AnimManager(nullptr),
+		NotifyListenerID(0),
 		UpdateAnimsListInEditor(nullptr),
 		AnimIndex(0),
 		SpeedPerSec(1.0f),
@@ -95,7 +97,7 @@ namespace GEE
 	{
 		Actor::GetEditorDescription(descBuilder);
 
-		descBuilder.AddField("Anim Manager").GetTemplates().ComponentInput<AnimationManagerComponent>(*GetRoot(), [this](AnimationManagerComponent* animManager) {AnimManager = animManager; UpdateAnimsListInEditor(animManager); });
+		descBuilder.AddField("Anim Manager").GetTemplates().ComponentInput<AnimationManagerComponent>(*GetRoot(), [this](AnimationManagerComponent* animManager) {SetAnimManager(animManager); UpdateAnimsListInEditor(animManager); });
 		descBuilder.AddField("Target position").GetTemplates().VecInput(CurrentTargetPos);
 
 		dynamic_cast<UIInputBoxActor*>(descBuilder.GetDescriptionParent().FindActor("VecBox0"))->SetRetrieveContentEachFrame(true);
@@ -130,6 +132,30 @@ namespace GEE
 		CurrentTargetPos = worldPos;
 	}
 
+	void PawnActor::SetAnimManager(AnimationManagerComponent* animManager)
+	{
+		if (animManager == AnimManager)
+			return;
+
+		if (AnimManager)
+			AnimManager->RemoveNotifyListener(NotifyListenerID);
+		AnimManager = animManager;
+		if (AnimManager)
+			NotifyListenerID = AnimManager->AddNotifyListener([this](const AnimationNotifyEvent& ev) { HandleAnimationNotify(ev); });
+	}
+
+	void PawnActor::HandleAnimationNotify(const AnimationNotifyEvent& ev)
+	{
+		if (IsBeingKilled())
+			return;
+
+		if (Audio::SoundSourceComponent* sound = GetRoot()->GetComponent<Audio::SoundSourceComponent>(ev.Notify.Name))
+		{
+			sound->Stop();	//Restart it if the previous notify is still being played
+			sound->Play();
+		}
+	}
+
 	void PawnActor::MoveAlongPath()
 	{
 		switch (PathIndex)
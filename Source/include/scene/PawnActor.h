@@ -14,6 +14,11 @@ namespace GEE
 		virtual void GetEditorDescription(EditorDescriptionBuilder) override;
 		void MoveToPosition(const glm::vec3& worldPos);
 		void MoveAlongPath();
+		void SetAnimManager(AnimationManagerComponent*);
+		/**
+		 * @brief Plays the sound source component of the pawn that is named after the notify (e.g. "Footstep"), if there is one.
+		*/
+		void HandleAnimationNotify(const AnimationNotifyEvent&);
 
 		template <typename Archive>
 		void Save(Archive& archive) const
@@ -29,7 +34,7 @@ namespace GEE
 			archive(cereal::make_nvp("AnimManagerName", animManagerName), CEREAL_NVP(AnimIndex), cereal::make_nvp("GunName", gunName), CEREAL_NVP(SpeedPerSec), cereal::make_nvp("PlayerTargetName", playerTargetName), cereal::make_nvp("Actor", cereal::base_class<Actor>(this)));
 
 			Scene.AddPostLoadLambda([this, animManagerName, gunName, playerTargetName]() {
-					AnimManager = GetRoot()->GetComponent<AnimationManagerComponent>(animManagerName);
+					SetAnimManager(GetRoot()->GetComponent<AnimationManagerComponent>(animManagerName));
 					Gun = dynamic_cast<GunActor*>(GetScene().FindActor(gunName));
 					PlayerTarget = GetScene().FindActor(playerTargetName);
 				});
@@ -37,6 +42,7 @@ namespace GEE
 	private:
 		//Component* RootBone;
 		AnimationManagerComponent* AnimManager;
+		unsigned int NotifyListenerID;	//The listener registered in AnimManager
 		int AnimIndex;
 		glm::vec3 PreAnimBonePos;
 
@@ -0,0 +1,74 @@
+#pragma once
+#include <math/Vec.h>
+#include <string>
+#include <vector>
+
+namespace GEE
+{
+	class GameScene;
+	class Actor;
+	class ModelComponent;
+	class Material;
+
+	namespace Physics
+	{
+		struct CollisionObject;
+	}
+
+	struct ProjectileSettings
+	{
+		std::string ModelPath = "hqSphere/hqSphere.obj";
+		Material* OverrideMaterial = nullptr;	//nullptr to keep the materials of the model
+		float Scale = 0.2f;
+		float Lifetime = 5.0f;					//in seconds
+		unsigned int Capacity = 32;				//When every projectile is in flight, the oldest one is fired again
+		bool bContinuousCollision = true;		//Keeps fast projectiles from tunneling through thin geometry
+	};
+
+	/**
+	 * @brief A fixed number of projectiles (an actor with a model and a dynamic sphere body each), created once and reused. The model is loaded and the material is looked up only when the pool is created.
+	 * Projectiles that are not in flight are hidden and their bodies are not simulated (they are removed from the broadphase), so they cost next to nothing.
+	 * The projectiles are children of a single actor attached to the root of the scene (<name>), so they are not moved with the owner of the pool. The actor is killed together with the pool and is not saved with the scene. If the actor is deleted first (e.g. in the editor), the pool becomes invalid.
+	*/
+	class ProjectilePool
+	{
+	public:
+		ProjectilePool(GameScene&, const std::string& name, const ProjectileSettings& = ProjectileSettings());
+		ProjectilePool(const ProjectilePool&) = delete;
+		ProjectilePool& operator=(const ProjectilePool&) = delete;
+		~ProjectilePool();
+
+		/**
+		 * @brief Fires a projectile from the pool.
+		 * @param impulse: the impulse applied to the projectile after it is moved to the given position
+		*/
+		void Fire(const Vec3f& position, const Quatf& rotation, const Vec3f& impulse);
+		void Update(float deltaTime);	//Returns the projectiles whose lifetime has expired to the pool
+
+		bool IsValid() const;	//False once the actor that holds the projectiles is being killed or has been deleted (e.g. it was removed in the editor); the pool must not be used afterwards
+		unsigned int GetActiveCount() const;
+		unsigned int GetCapacity() const;
+
+	private:
+		class HolderActor;	//Tells the pool when it is destroyed, so the pool never uses it afterwards
+
+		struct Projectile
+		{
+			Actor* ProjectileActor;
+			std::vector<ModelComponent*> Models;
+			Physics::CollisionObject* Body;
+			float LifeLeft;	//0 if the projectile is not in flight
+		};
+
+		void CreateProjectiles();
+		void Activate(Projectile&, const Vec3f& position, const Quatf& rotation, const Vec3f& impulse);
+		void Deactivate(Projectile&);
+
+		GameScene& Scene;
+		std::string Name;
+		ProjectileSettings Settings;
+		HolderActor* PoolActor;	//nullptr once the actor has been destroyed
+		std::vector<Projectile> Projectiles;
+		unsigned int ActiveCount;
+	};
+}
@@ -1,20 +1,15 @@
 #pragma once
 #include <scene/Component.h>
-#include <AL/al.h>
+#include <audio/VoiceManager.h>
 namespace GEE
 {
 	namespace Audio
 	{
-		struct SoundBuffer
-		{
-			unsigned int ALIndex;
-			std::string Path;	//used for optimization; we don't load a buffer from file if this file was already read before (there will never be two buffers that share the same path)
-			bool IsValid() const
-			{
-				return ALIndex != 0;
-			}
-		};
+		class SoundStream;
 
+		/**
+		 * @brief Plays a sound at the position of the component. The component does not own an OpenAL source - its voice is given one by the VoiceManager of the audio engine only while it is among the most audible voices.
+		*/
 		class SoundSourceComponent : public Component
 		{
 		public:
@@ -22,24 +17,28 @@ namespace GEE
 			SoundSourceComponent(Actor&, Component* parentComp, const std::string& name, SoundBuffer = SoundBuffer(), const Transform& = Transform());
 			SoundSourceComponent(Actor&, Component* parentComp, const std::string& name, const std::string& bufferPath, const Transform& = Transform());
 
-			void LoadSound(const SoundBuffer&);
+			void LoadSound(const SoundBuffer&);	//Takes over a reference to the buffer (see AudioEngineManager::FindBuffer) and releases the previous buffer
+			void LoadStream(std::unique_ptr<SoundStream>);	//The sound is streamed from its file instead of being played from a buffer
+			std::string GetSoundPath() const;
 
 			void SetLoop(bool);
+			void SetGain(float);
+			void SetPriority(float);	//Voices with a higher priority keep their sources when there are not enough for all audible voices
+			void SetDistances(float referenceDistance, float maxDistance);	//Full gain up to referenceDistance; inaudible (culled) beyond maxDistance
 			bool IsPlaying();
+			const Voice& GetVoice() const;
 
 			void Play();
 			void Pause();
 			void Stop();
 
-			virtual void Update(float) override;
-
 			virtual	MaterialInstance GetDebugMatInst(EditorIconState) override;
 
 			virtual void GetEditorDescription(EditorDescriptionBuilder) override;
 			template <typename Archive> void Save(Archive& archive) const
 			{
 				std::string emptyStr = "";
-				archive(cereal::make_nvp("Path", SndBuffer.Path), cereal::make_nvp("Component", cereal::base_class<Component>(this)));
+				archive(cereal::make_nvp("Path", GetSoundPath()), cereal::make_nvp("Component", cereal::base_class<Component>(this)));
 			}
 			template <typename Archive> void Load(Archive& archive)
 			{
@@ -54,23 +53,19 @@ namespace GEE
 			~SoundSourceComponent();
 
 		private:
-			void GenerateAL();
+			void DetachStream();
+			VoiceManager& GetVoiceManager();
 		private:
-			unsigned int ALIndex;
-			SoundBuffer SndBuffer;
+			Voice SourceVoice;	//Holds the buffer, unless the sound is streamed
+			std::unique_ptr<SoundStream> Stream;	//nullptr if the sound is played from the buffer
 
 		};
 
 		namespace Loader
 		{
-			void LoadSoundFromFile(const std::string&, SoundSourceComponent&);
-			namespace Impl
-			{
-				SoundBuffer LoadBufferFromWav(const std::string& path);
-				SoundBuffer LoadBufferFromOgg(const std::string& path);
+			constexpr float StreamingMinLength = 10.0f;	//Sounds at least this long (in seconds) are streamed instead of being loaded whole
 
-				SoundBuffer LoadALBuffer(ALenum, ALvoid*, ALsizei, ALsizei, const std::string&);
-			}
+			void LoadSoundFromFile(const std::string&, SoundSourceComponent&);
 		}
 	}
 }
@@ -0,0 +1,138 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace GEE
+{
+	enum class JobAffinity
+	{
+		Any,		//Can be run by any worker (including the main thread)
+		MainThread	//Can only be run by the main thread (e.g. everything that touches OpenGL)
+	};
+
+	/**
+	 * @brief Counts the unfinished jobs of a group. Jobs can be made dependent on a counter - they will be started once the counter reaches 0.
+	 * A counter must outlive the jobs that signal it and the jobs that depend on it.
+	*/
+	class JobCounter
+	{
+	public:
+		JobCounter();
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+		~JobCounter();
+
+		bool IsDone() const;
+		int GetValue() const;
+
+	private:
+		friend class JobSystem;
+		struct PendingJob
+		{
+			std::function<void()> Function;
+			JobCounter* Signal;
+			JobAffinity Affinity;
+		};
+
+		std::atomic<int> Value;
+		std::mutex ContinuationsMutex;
+		std::vector<PendingJob> Continuations;	//Jobs waiting for this counter to reach 0
+	};
+
+	/**
+	 * @brief Work-stealing job system. Every worker thread (and the main thread) owns a deque of jobs - it pushes and pops jobs at the back of its own deque, while idle workers steal from the front of the others.
+	 * Jobs with MainThread affinity are put into a separate queue which is only drained by the main thread (in RunMainThreadJobs and Wait).
+	 * The main thread is the thread that calls Init.
+	*/
+	class JobSystem
+	{
+	public:
+		JobSystem();
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		/**
+		 * @brief Starts the worker threads.
+		 * @param workerCount: the number of worker threads (not counting the main thread). Pass 0 to use one worker per hardware thread, minus the main thread.
+		*/
+		void Init(unsigned int workerCount = 0);
+		bool HasBeenInitialized() const;
+		unsigned int GetWorkerCount() const;	//Returns the number of threads that execute jobs, including the main thread
+		bool IsMainThread() const;
+
+		/**
+		 * @brief Schedules a job. If the job system has not been initialized, the job is executed immediately (after its dependency).
+		 * @param job: the function to be executed
+		 * @param signal: (optional) counter to be incremented now and decremented once the job has finished
+		 * @param dependency: (optional) the job will not be started before this counter reaches 0
+		 * @param affinity: which threads may execute the job
+		*/
+		void Schedule(std::function<void()> job, JobCounter* signal = nullptr, JobCounter* dependency = nullptr, JobAffinity affinity = JobAffinity::Any);
+		/**
+		 * @brief Executes jobs on the calling thread until the counter reaches 0. The main thread also executes MainThread jobs while waiting.
+		*/
+		void Wait(JobCounter& counter);
+		/**
+		 * @brief Executes all MainThread jobs that have been scheduled so far. Can only be called from the main thread.
+		*/
+		void RunMainThreadJobs();
+
+		/**
+		 * @brief Splits the [0, count) range into batches and executes them in parallel. Returns after all of them have finished.
+		 * @param count: the number of elements
+		 * @param batchSize: the number of elements per job. Pass 0 to split the range evenly between the workers
+		 * @param function: called with the [begin, end) range of a single batch
+		*/
+		void ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)>& function);
+
+		/**
+		 * @brief Measures the overhead of scheduling and executing empty jobs. Does not require the job system to be initialized beforehand - a temporary one is used.
+		 * @param jobCount: the number of empty jobs
+		 * @param workerCount: the number of worker threads of the temporary job system (0 - one per hardware thread)
+		 * @return average time per job in microseconds
+		*/
+		static double BenchmarkSchedulingOverhead(unsigned int jobCount = 100000, unsigned int workerCount = 0);
+
+		void Dispose();	//Finishes the remaining jobs and joins the worker threads
+		~JobSystem();
+
+	private:
+		struct Job
+		{
+			std::function<void()> Function;
+			JobCounter* Signal;
+		};
+		struct WorkerQueue
+		{
+			std::mutex Mutex;
+			std::deque<Job> Jobs;
+		};
+
+		void Enqueue(Job&& job, JobAffinity affinity);
+		bool TryRunJob(unsigned int workerIndex, bool allowMainThreadJobs);
+		bool PopOwn(unsigned int workerIndex, Job& job);
+		bool Steal(unsigned int thiefIndex, Job& job);
+		bool PopMainThreadJob(Job& job);
+		void Execute(Job& job);
+		void Finish(JobCounter& counter);
+		void WorkerLoop(unsigned int workerIndex);
+		unsigned int GetCurrentWorkerIndex() const;
+
+		std::vector<std::unique_ptr<WorkerQueue>> Queues;	//Queues[0] belongs to the main thread
+		WorkerQueue MainThreadQueue;
+		std::vector<std::thread> Workers;
+		std::thread::id MainThreadID;
+
+		std::mutex SleepMutex;
+		std::condition_variable SleepCondition;
+		std::atomic<int> QueuedJobCount;
+		std::atomic<bool> bQuit;
+		bool bInitialized;
+	};
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace GEE
+{
+	/**
+	 * @brief Arenas of memory that only lives for a single frame. Every arena is reset at the beginning of each frame (see MemoryArenas::NewFrame).
+	*/
+	enum class MemoryArenaType
+	{
+		FRAME,			//General purpose
+		RENDER			//Volumes, mesh lists and other data built while rendering a frame
+	};
+	constexpr unsigned int MemoryArenaCount = static_cast<unsigned int>(MemoryArenaType::RENDER) + 1;
+
+	/**
+	 * @brief Bump allocator. Allocations are never freed individually - all of them are released at once by Reset.
+	 * If the current block is exhausted, a new one is allocated from the heap. Reset merges all blocks into a single one big enough for the peak usage, so once the arena has seen its busiest frame it does not touch the heap anymore.
+	 * Not thread-safe - the arenas returned by MemoryArenas::Get may only be used on the main thread.
+	*/
+	class LinearArena
+	{
+	public:
+		LinearArena(const char* name, size_t blockSize = 64 * 1024);
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		/**
+		 * @brief Releases all allocations. Memory allocated from the arena must not be used afterwards.
+		*/
+		void Reset();
+
+		const char* GetName() const;
+		size_t GetUsedBytes() const;
+		size_t GetPeakBytes() const;				//The highest number of bytes used between two resets since the arena was created
+		size_t GetCapacity() const;
+		unsigned int GetAllocationCount() const;	//The number of allocations since the last reset
+		unsigned int GetBlockAllocationCount() const;	//The number of times the arena has allocated memory from the heap since it was created
+
+	private:
+		struct Block
+		{
+			std::unique_ptr<unsigned char[]> Memory;
+			size_t Size;
+		};
+		void AddBlock(size_t minSize);
+
+		const char* Name;
+		size_t BlockSize;
+		std::vector<Block> Blocks;
+		size_t CurrentBlockOffset;
+		size_t UsedBytes, PeakBytes;
+		unsigned int AllocationCount, BlockAllocationCount;
+	};
+
+	/**
+	 * @brief STL-compatible adapter of LinearArena. Deallocation does nothing, so a container that grows leaves its old buffers in the arena until it is reset - reserve the storage up front whenever the size is known.
+	*/
+	template <typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		ArenaAllocator(LinearArena& arena) noexcept : Arena(&arena) {}
+		template <typename U> ArenaAllocator(const ArenaAllocator<U>& allocator) noexcept : Arena(allocator.GetArena()) {}
+
+		T* allocate(size_t n) { return static_cast<T*>(Arena->Allocate(n * sizeof(T), alignof(T))); }
+		void deallocate(T*, size_t) noexcept {}
+		LinearArena* GetArena() const { return Arena; }
+
+		template <typename U> bool operator==(const ArenaAllocator<U>& allocator) const { return Arena == allocator.GetArena(); }
+		template <typename U> bool operator!=(const ArenaAllocator<U>& allocator) const { return Arena != allocator.GetArena(); }
+
+	private:
+		LinearArena* Arena;
+	};
+
+	template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+	class MemoryArenas
+	{
+	public:
+		static LinearArena& Get(MemoryArenaType);
+		/**
+		 * @brief Reports the usage of every arena to the MemoryTracker and resets all of them. Call once per frame on the main thread, when nothing allocated from the arenas is in use anymore.
+		*/
+		static void NewFrame();
+	};
+
+	/**
+	 * @brief Reports the peak usage of every arena and the number of heap allocations per frame.
+	 * The global operator new is replaced by one that counts allocations (on every thread) with a single relaxed atomic increment.
+	*/
+	class MemoryTracker
+	{
+	public:
+		static MemoryTracker& Get();
+
+		void NewFrame();	//Called by MemoryArenas::NewFrame
+		static void RecordHeapAllocation();
+
+		static unsigned long long GetHeapAllocationCount();	//The number of heap allocations since the start of the program, on every thread
+		unsigned long long GetHeapAllocationsLastFrame() const;
+
+		/**
+		 * @brief Prints an error whenever a frame after the warmup allocates from the heap more times than any previous frame since the warmup. Enabled in debug builds; --bench checks every measured frame instead.
+		 * @param warmupFrames: the number of frames after which the engine is expected to reach a steady state
+		*/
+		void SetSteadyStateCheck(bool enabled, unsigned int warmupFrames = 300);
+
+		/**
+		 * @return one line for the heap allocations and one per arena. Used by the editor overlay.
+		*/
+		std::vector<std::string> GetSummary() const;
+
+	private:
+		MemoryTracker();
+
+		struct ArenaFrameStats
+		{
+			size_t UsedBytes;
+			unsigned int AllocationCount;
+		};
+		std::array<ArenaFrameStats, MemoryArenaCount> LastFrameArenaStats;
+		unsigned long long FrameNumber;
+		unsigned long long HeapAllocationsAtFrameBegin, HeapAllocationsLastFrame;
+		bool bSteadyStateCheck;
+		unsigned long long SteadyStateBeginFrame;
+		unsigned long long WorstSteadyStateAllocations;
+	};
+}
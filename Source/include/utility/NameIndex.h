@@ -0,0 +1,178 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include <iterator>
+
+namespace GEE
+{
+	/**
+	 * @brief A name stored once in a global table of strings. Copying and comparing interned names is as cheap as copying and comparing integers, and the hash of the string is computed only once - when it is interned.
+	 * Interned strings are never released, so names should not be generated without limits (e.g. from user input in a loop).
+	*/
+	class InternedName
+	{
+	public:
+		InternedName();	//The empty name
+		InternedName(const std::string&);
+		InternedName(const char*);
+
+		/**
+		 * @brief Looks for a name that has already been interned. Never adds the name to the table and never allocates memory.
+		 * @param name: the string to look for
+		 * @param result: set to the interned name if it was found
+		 * @return true if the name has been interned before
+		*/
+		static bool TryFind(const std::string& name, InternedName& result);
+
+		const std::string& GetString() const;
+		unsigned int GetID() const;
+		size_t GetHash() const;
+		bool IsEmpty() const;
+
+		bool operator==(const InternedName&) const;
+		bool operator!=(const InternedName&) const;
+
+	private:
+		InternedName(unsigned int id, size_t hash);
+
+		unsigned int ID;
+		size_t Hash;
+	};
+}
+
+namespace std
+{
+	template <> struct hash<GEE::InternedName>
+	{
+		size_t operator()(const GEE::InternedName& name) const
+		{
+			return name.GetHash();
+		}
+	};
+}
+
+namespace GEE
+{
+	/**
+	 * @brief Hash index of objects by their names. Many objects can share a name. The index does not know when a name changes - the owner of the index must call Rename.
+	 * Looking an object up does not allocate memory.
+	*/
+	template <typename Value> class NameIndex
+	{
+	public:
+		void Add(const std::string& name, const Value& value);
+		void Erase(const std::string& name, const Value& value);
+		void EraseIf(const std::string& name, const std::function<bool(const Value&)>& predicate);	//Erases the first object with the name that satisfies the predicate
+		void Rename(const std::string& oldName, const std::string& newName, const Value& value);
+		void Clear();
+
+		/**
+		 * @brief Looks for an object with the given name.
+		 * @param name: the name of the object
+		 * @param result: set to the found object
+		 * @param predicate: (optional) the object must also satisfy it. If many objects with the name satisfy it, any of them can be returned
+		 * @return true if an object was found
+		*/
+		bool Find(const std::string& name, Value& result, const std::function<bool(const Value&)>& predicate = nullptr) const;
+		bool Contains(const std::string& name) const;
+		bool IsUnique(const std::string& name) const;	//Returns true if exactly one object has the name. Unlike GetCount, does not visit every object that shares it
+		size_t GetCount(const std::string& name) const;
+
+	private:
+		std::unordered_multimap<InternedName, Value> Objects;
+	};
+
+	template<typename Value>
+	inline void NameIndex<Value>::Add(const std::string& name, const Value& value)
+	{
+		Objects.emplace(InternedName(name), value);
+	}
+
+	template<typename Value>
+	inline void NameIndex<Value>::Erase(const std::string& name, const Value& value)
+	{
+		EraseIf(name, [&value](const Value& indexed) { return indexed == value; });
+	}
+
+	template<typename Value>
+	inline void NameIndex<Value>::EraseIf(const std::string& name, const std::function<bool(const Value&)>& predicate)
+	{
+		InternedName interned;
+		if (!InternedName::TryFind(name, interned))
+			return;
+
+		auto range = Objects.equal_range(interned);
+		for (auto it = range.first; it != range.second; it++)
+			if (predicate(it->second))
+			{
+				Objects.erase(it);
+				return;
+			}
+	}
+
+	template<typename Value>
+	inline void NameIndex<Value>::Rename(const std::string& oldName, const std::string& newName, const Value& value)
+	{
+		if (oldName == newName)
+			return;
+
+		Erase(oldName, value);
+		Add(newName, value);
+	}
+
+	template<typename Value>
+	inline void NameIndex<Value>::Clear()
+	{
+		Objects.clear();
+	}
+
+	template<typename Value>
+	inline bool NameIndex<Value>::Find(const std::string& name, Value& result, const std::function<bool(const Value&)>& predicate) const
+	{
+		InternedName interned;
+		if (!InternedName::TryFind(name, interned))
+			return false;
+
+		auto range = Objects.equal_range(interned);
+		for (auto it = range.first; it != range.second; it++)
+			if (!predicate || predicate(it->second))
+			{
+				result = it->second;
+				return true;
+			}
+
+		return false;
+	}
+
+	template<typename Value>
+	inline bool NameIndex<Value>::Contains(const std::string& name) const
+	{
+		InternedName interned;
+		if (!InternedName::TryFind(name, interned))
+			return false;
+
+		return Objects.find(interned) != Objects.end();
+	}
+
+	template<typename Value>
+	inline bool NameIndex<Value>::IsUnique(const std::string& name) const
+	{
+		InternedName interned;
+		if (!InternedName::TryFind(name, interned))
+			return false;
+
+		auto range = Objects.equal_range(interned);
+		return range.first != range.second && std::next(range.first) == range.second;
+	}
+
+	template<typename Value>
+	inline size_t NameIndex<Value>::GetCount(const std::string& name) const
+	{
+		InternedName interned;
+		if (!InternedName::TryFind(name, interned))
+			return 0;
+
+		return Objects.count(interned);
+	}
+}
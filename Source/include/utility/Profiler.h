@@ -0,0 +1,151 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GEE
+{
+	/**
+	 * @brief Per-frame counters of the work submitted to the GPU. They are reset at the beginning of every frame.
+	*/
+	enum class ProfilerCounter
+	{
+		DRAW_CALLS,
+		STATE_CHANGES,			//Bound shaders, textures and framebuffers
+		UNIFORM_UPLOADS,
+		BUFFER_BYTES_UPLOADED
+	};
+	constexpr unsigned int ProfilerCounterCount = static_cast<unsigned int>(ProfilerCounter::BUFFER_BYTES_UPLOADED) + 1;
+
+	struct ProfilerScopeRecord
+	{
+		const char* Name;
+		double BeginUs, EndUs;	//Microseconds since the profiler was created. GPU scopes are moved to the same timeline.
+		unsigned int ThreadID;
+		unsigned int Depth;		//The number of scopes of the same thread (or of the GPU) that this scope is nested in
+	};
+
+	struct ProfilerFrame
+	{
+		unsigned long long FrameNumber;
+		double BeginUs, EndUs;
+		std::vector<ProfilerScopeRecord> CpuScopes;
+		std::vector<ProfilerScopeRecord> GpuScopes;	//Empty if GPU timing is disabled or the results are not available yet
+		std::array<unsigned long long, ProfilerCounterCount> Counters;
+	};
+
+	/**
+	 * @brief Hierarchical frame profiler. CPU scopes can be recorded on any thread - they are written to a ring of recent frames without locks.
+	 * GPU scopes use GL timer queries and are resolved a few frames later, so the GPU is never stalled. They are only recorded on the thread that enabled GPU timing (the one that owns the GL context); elsewhere and when no context exists they do nothing, so CPU timing works headless.
+	 * Scope names must be string literals (or live as long as the profiler) - only the pointers are stored.
+	 * Use the GEE_PROFILE_* macros rather than the classes directly; defining GEE_NO_PROFILING compiles all of them out and GEE_NO_GPU_PROFILING compiles out the GPU scopes.
+	*/
+	class Profiler
+	{
+	public:
+		static Profiler& Get();
+
+		/**
+		 * @brief Ends the current frame and begins the next one. Call once per frame on the main thread.
+		*/
+		void NewFrame();
+
+		void SetEnabled(bool enabled);
+		bool IsEnabled() const;
+		/**
+		 * @brief Enables GL timer queries. Must be called on the thread that owns a current GL context; if the context does not support timer queries, GPU timing stays disabled.
+		*/
+		void SetGpuTimingEnabled(bool enabled);
+		bool IsGpuTimingEnabled() const;
+
+		void AddToCounter(ProfilerCounter counter, unsigned long long amount = 1);
+
+		/**
+		 * @brief Copies a recently completed frame.
+		 * @param framesAgo: 0 for the most recent completed frame
+		 * @param result: the frame
+		 * @return false if the frame is not in the ring anymore (or has not been recorded)
+		*/
+		bool GetFrame(unsigned int framesAgo, ProfilerFrame& result) const;
+		/**
+		 * @brief Aggregates the scopes of the most recent completed frame by their names. Used by the editor overlay.
+		 * @param maxDepth: deeper scopes are skipped
+		 * @return one line per frame summary, scope and counter
+		*/
+		std::vector<std::string> GetFrameSummary(unsigned int maxDepth = 1) const;
+		/**
+		 * @brief Writes all completed frames of the ring as a Chrome trace (open it in chrome://tracing or Perfetto).
+		 * @param filepath: the path of the JSON file
+		 * @return true if the file was written
+		*/
+		bool ExportChromeTrace(const std::string& filepath) const;
+
+		static constexpr unsigned int FrameRingSize = 16;
+		static constexpr unsigned int MaxCpuScopesPerFrame = 4096;
+
+	private:
+		friend class ProfilerCpuScope;
+		friend class ProfilerGpuScope;
+		Profiler();
+		~Profiler();
+
+		double GetTimeUs() const;
+		static unsigned int GetThreadID();
+		void RecordCpuScope(const ProfilerScopeRecord&);
+		unsigned int BeginGpuScope(const char* name);	//Returns the index of the scope in the current frame or -1 if no scope was begun
+		void EndGpuScope(unsigned int scopeIndex);
+		void ResolveGpuScopes(unsigned long long frameNumber);
+		bool IsGpuThread() const;
+
+		struct FrameSlot;
+		std::unique_ptr<FrameSlot[]> Frames;
+		std::atomic<unsigned long long> CurrentFrame;	//0 before the first call to NewFrame
+		std::array<std::atomic<unsigned long long>, ProfilerCounterCount> Counters;
+		std::atomic<bool> bEnabled, bGpuTimingEnabled;
+		unsigned int MainThreadID, GpuThreadID, GpuDepth;
+		long long StartTimeNs;
+	};
+
+	class ProfilerCpuScope
+	{
+	public:
+		ProfilerCpuScope(const char* name);
+		ProfilerCpuScope(const ProfilerCpuScope&) = delete;
+		~ProfilerCpuScope();
+	private:
+		ProfilerScopeRecord Record;
+		bool bActive;
+	};
+
+	class ProfilerGpuScope
+	{
+	public:
+		ProfilerGpuScope(const char* name);
+		ProfilerGpuScope(const ProfilerGpuScope&) = delete;
+		~ProfilerGpuScope();
+	private:
+		unsigned int ScopeIndex;
+	};
+}
+
+#define GEE_PROFILER_CONCAT_IMPL(a, b) a##b
+#define GEE_PROFILER_CONCAT(a, b) GEE_PROFILER_CONCAT_IMPL(a, b)
+
+#ifdef GEE_NO_PROFILING
+#define GEE_PROFILE_SCOPE(name) ((void)0)
+#define GEE_PROFILE_GPU_SCOPE(name) ((void)0)
+#define GEE_PROFILE_COUNT(counter, amount) ((void)0)
+#else
+#define GEE_PROFILE_SCOPE(name) GEE::ProfilerCpuScope GEE_PROFILER_CONCAT(geeProfilerScope, __LINE__)(name)
+#ifdef GEE_NO_GPU_PROFILING
+#define GEE_PROFILE_GPU_SCOPE(name) ((void)0)
+#else
+#define GEE_PROFILE_GPU_SCOPE(name) GEE::ProfilerGpuScope GEE_PROFILER_CONCAT(geeProfilerGpuScope, __LINE__)(name)
+#endif
+#define GEE_PROFILE_COUNT(counter, amount) GEE::Profiler::Get().AddToCounter(GEE::ProfilerCounter::counter, amount)
+#endif
+
+#define GEE_PROFILE_FUNCTION() GEE_PROFILE_SCOPE(__FUNCTION__)
+#define GEE_PROFILE_PASS(name) GEE_PROFILE_SCOPE(name); GEE_PROFILE_GPU_SCOPE(name)	//Times a render pass on both the CPU and the GPU
@@ -46,9 +46,9 @@ namespace GEE
 		void SubData1f(float, size_t offset);
 		void SubData(size_t size, float* data, size_t offset);
 		void SubData4fv(glm::vec3, size_t offset);
-		void SubData4fv(std::vector<glm::vec3>, size_t offset);
+		void SubData4fv(const std::vector<glm::vec3>&, size_t offset);
 		void SubData4fv(glm::vec4, size_t offset);
-		void SubData4fv(std::vector<glm::vec4>, size_t offset);
+		void SubData4fv(const std::vector<glm::vec4>&, size_t offset);
 		void SubDataMatrix4fv(glm::mat4, size_t offset);
 		void PadOffset();
 
@@ -18,6 +18,7 @@
 #include <input/InputDevicesStateRetriever.h>
 #include <whereami.h>
 #include <scene/BoneComponent.h>
+#include <game/BenchmarkGame.h>
 #include <map>
 
 using namespace GEE;
@@ -36,16 +37,26 @@ EditorManager* EditorEventProcessor::EditorHandle = nullptr;
 
 int main(int argc, char** argv)
 {
+	if (argc > 1 && std::string(argv[1]) == "--bench")	//Headless benchmark on the null GL device; see BenchmarkGame
+	{
+		BenchmarkSettings benchSettings;
+		if (!benchSettings.ParseArguments(argc, argv, 2))
+			return 1;
+		return BenchmarkGame::Run(benchSettings);
+	}
+
 	std::string programFilepath;	//do not rely on this; if called from cmd, for example, it may not actually contain the program filepath
 	std::string projectFilepathArgument;
+	std::string inputRecordingFilepath;	//--record <path>: the input is recorded to this file (it can be replayed with --bench <project> --replay <path>)
 	for (int i = 0; i < argc; i++)
 	{
 		std::cout << argv[i] << '\n';
-		switch (i)
-		{
-		case 0: programFilepath = argv[i]; break;
-		case 1: projectFilepathArgument = argv[i]; break;
-		}
+		if (i == 0)
+			programFilepath = argv[i];
+		else if (std::string(argv[i]) == "--record" && i + 1 < argc)
+			inputRecordingFilepath = argv[++i];
+		else if (projectFilepathArgument.empty())
+			projectFilepathArgument = argv[i];
 	}
 	glfwInit();
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
@@ -99,22 +110,28 @@ int main(int argc, char** argv)
 		editor.LoadProject(projectFilepathArgument);
 
 	editor.PreGameLoop();
+	if (!inputRecordingFilepath.empty())
+		editor.StartInputRecording(1.0f / 60.0f);
 
 	float deltaTime = 0.0f;
 	float lastUpdateTime = glfwGetTime();
 	bool endGame = false;
 
+	const std::string titleMaterialName = "GEE_Engine_Title";
 	do
 	{
 		deltaTime = glfwGetTime() - lastUpdateTime;
 		lastUpdateTime = glfwGetTime();
 
-		if (Material* found = editor.GetRenderEngineHandle()->FindMaterial("GEE_Engine_Title").get())	//dalem tu na chama; da sie to zrobic duzo ladniej ale musialbym zmodyfikowac klase Interpolator zeby obslugiwala lambdy ale mi sie nie chce
+		if (Material* found = editor.GetRenderEngineHandle()->FindMaterial(titleMaterialName).get())	//dalem tu na chama; da sie to zrobic duzo ladniej ale musialbym zmodyfikowac klase Interpolator zeby obslugiwala lambdy ale mi sie nie chce
 			found->SetColor(hsvToRgb(Vec3f(glm::mod((float)glfwGetTime() * 10.0f, 360.0f), 0.6f, 0.6f)));
 
 		endGame = editor.GameLoopIteration(1.0f / 60.0f, deltaTime);
 	} while (!endGame);
 
+	if (!inputRecordingFilepath.empty())
+		editor.StopInputRecording(inputRecordingFilepath);
+
 	editor.SaveProject();
 
 	return 0;
@@ -24,6 +24,7 @@ namespace GEE
 		CanvasParent(canvasParent)
 	{
 		Scene.AddBlockingCanvas(*this);
+		SubscribeToEvent(EventType::MOUSE_SCROLLED);
 	}
 
 	UICanvasActor::UICanvasActor(GameScene& scene, Actor* parentActor, const std::string& name, const Transform& t) :
@@ -193,12 +193,17 @@ void UIMultipleListActor::NestList(UIListActor& list)
 
 	void UICanvasFieldCategory::HandleEventAll(const Event& ev)
 	{
-		HandleEvent(ev);
-		ExpandButton->HandleEvent(ev);
+		if (!HasEventListenersInHierarchy(ev.GetType()))
+			return;
+
+		if (IsSubscribedToEvent(ev.GetType()))
+			HandleEvent(ev);
+		if (ExpandButton->IsSubscribedToEvent(ev.GetType()))
+			ExpandButton->HandleEvent(ev);
 
 		if (bExpanded)
 			for (auto& it : Children)
-				if (it.get() != ExpandButton)
+				if (it.get() != ExpandButton && it->HasEventListenersInHierarchy(ev.GetType()))
 					it->HandleEventAll(ev);
 	}
 
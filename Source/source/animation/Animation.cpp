@@ -207,8 +207,8 @@ namespace GEE
 			*InterpolatedValPtr = Interp->InterpolateValues(MinVal, MaxVal);
 	}
 
-	Animation::Animation(const HierarchyTemplate::HierarchyTreeT& tree, aiAnimation* anim) :
-		Localization(tree, anim->mName.C_Str()), Duration(anim->mDuration / ((anim->mTicksPerSecond != 0.0f) ? (anim->mTicksPerSecond) : (1.0f)))
+	AnimationClip::AnimationClip(aiAnimation* anim) :
+		Name(anim->mName.C_Str()), Duration(anim->mDuration / ((anim->mTicksPerSecond != 0.0f) ? (anim->mTicksPerSecond) : (1.0f)))
 	{
 		for (int i = 0; i < static_cast<int>(anim->mNumChannels); i++)
 		{
@@ -216,6 +216,120 @@ namespace GEE
 		}
 	}
 
+	void AnimationClip::CookRootMotion(const aiNode* sceneRoot)
+	{
+		if (!sceneRoot || !RootMotion.IsEmpty())
+			return;
+
+		//Breadth-first search for the animated node that is closest to the scene root
+		std::shared_ptr<AnimationChannel> rootChannel;
+		std::vector<const aiNode*> nodes = { sceneRoot };
+		for (size_t i = 0; i < nodes.size() && !rootChannel; i++)
+		{
+			auto found = std::find_if(Channels.begin(), Channels.end(), [&](const std::shared_ptr<AnimationChannel>& channel) { return channel->Name == nodes[i]->mName.C_Str(); });
+			if (found != Channels.end())
+				rootChannel = *found;
+
+			for (unsigned int j = 0; j < nodes[i]->mNumChildren; j++)
+				nodes.push_back(nodes[i]->mChildren[j]);
+		}
+
+		if (!rootChannel || rootChannel->PosKeys.size() < 2)
+			return;
+
+		glm::vec3 startPos = rootChannel->PosKeys.front()->Value;
+		RootMotion.ChannelName = rootChannel->Name;
+		for (auto& key : rootChannel->PosKeys)
+		{
+			glm::vec3 displacement = key->Value - startPos;
+			displacement.y = 0.0f;	//Vertical movement (e.g. bobbing) stays in the skeleton
+
+			RootMotion.Keys.push_back(AnimationVecKey(key->Time, displacement));
+			rootChannel->InPlacePosKeys.push_back(std::make_shared<AnimationVecKey>(key->Time, key->Value - displacement));
+		}
+	}
+
+	void AnimationClip::AddNotify(float time, const std::string& name)
+	{
+		auto it = std::upper_bound(Notifies.begin(), Notifies.end(), time, [](float time, const AnimationNotify& notify) { return time < notify.Time; });
+		Notifies.insert(it, AnimationNotify(time, name));
+	}
+
+	std::map<std::pair<std::string, std::string>, std::weak_ptr<const AnimationClip>> AnimationClipCache::Clips;
+	std::mutex AnimationClipCache::ClipsMutex;
+
+	std::shared_ptr<const AnimationClip> AnimationClipCache::Find(const std::string& sourcePath, const std::string& clipName)
+	{
+		std::lock_guard<std::mutex> lock(ClipsMutex);
+		auto found = Clips.find(std::make_pair(sourcePath, clipName));
+		if (found == Clips.end())
+			return nullptr;
+
+		if (auto clip = found->second.lock())
+			return clip;
+
+		Clips.erase(found);
+		return nullptr;
+	}
+
+	std::shared_ptr<const AnimationClip> AnimationClipCache::Add(const std::string& sourcePath, std::shared_ptr<AnimationClip> clip)
+	{
+		std::lock_guard<std::mutex> lock(ClipsMutex);
+		EraseExpired();
+
+		std::weak_ptr<const AnimationClip>& entry = Clips[std::make_pair(sourcePath, clip->Name)];
+		if (auto cached = entry.lock())
+			return cached;
+
+		entry = clip;
+		return clip;
+	}
+
+	unsigned int AnimationClipCache::GetClipCount()
+	{
+		std::lock_guard<std::mutex> lock(ClipsMutex);
+		EraseExpired();
+		return static_cast<unsigned int>(Clips.size());
+	}
+
+	void AnimationClipCache::EraseExpired()
+	{
+		for (auto it = Clips.begin(); it != Clips.end();)
+		{
+			if (it->second.expired())
+				it = Clips.erase(it);
+			else
+				it++;
+		}
+	}
+
+	Animation::Animation(const HierarchyTemplate::HierarchyTreeT& tree, std::shared_ptr<const AnimationClip> clip) :
+		Localization(tree, clip->Name),
+		Clip(clip)
+	{
+	}
+
+	bool RootMotionTrack::IsEmpty() const
+	{
+		return Keys.empty();
+	}
+
+	glm::vec3 RootMotionTrack::Sample(float time) const
+	{
+		if (Keys.empty())
+			return glm::vec3(0.0f);
+		if (time <= Keys.front().Time)
+			return Keys.front().Value;
+		if (time >= Keys.back().Time)
+			return Keys.back().Value;
+
+		auto next = std::upper_bound(Keys.begin(), Keys.end(), time, [](float time, const AnimationVecKey& key) { return time < key.Time; });
+		auto prev = next - 1;
+		float t = (next->Time > prev->Time) ? ((time - prev->Time) / (next->Time - prev->Time)) : (1.0f);
+
+		return glm::mix(prev->Value, next->Value, t);
+	}
+
 	AnimationChannel::AnimationChannel(aiNodeAnim* aiChannel, float ticksPerSecond) :
 		Name(aiChannel->mNodeName.C_Str())
 	{
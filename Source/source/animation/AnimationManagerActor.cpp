@@ -1,6 +1,7 @@
 #include <animation/AnimationManagerActor.h>
 #include <scene/Component.h>
 #include <functional>
+#include <algorithm>
 
 #include <UI/UICanvasActor.h>
 #include <UI/UICanvasField.h>
@@ -9,75 +10,74 @@
 
 namespace GEE
 {
-	AnimationChannelInstance::AnimationChannelInstance(AnimationChannel& channelRef, Component& channelComp) :
-		ChannelRef(channelRef), ChannelComp(channelComp), IsValid(true)
+	namespace
 	{
+		glm::vec3 InterpolateKeys(const glm::vec3& value1, const glm::vec3& value2, float t)
+		{
+			return glm::mix(value1, value2, t);
+		}
+
+		glm::quat InterpolateKeys(const glm::quat& value1, const glm::quat& value2, float t)
+		{
+			return glm::slerp(value1, value2, t);
+		}
+
+		/**
+		 * @brief Moves the cursor to the last key that is not later than the time and interpolates between it and the next key. Before the first key and after the last one, the value of that key is held.
+		 * @return false if there are no keys
+		*/
+		template <typename KeyType, typename ValType> bool SampleKeys(const std::vector<std::shared_ptr<KeyType>>& keys, unsigned int& cursor, float time, ValType& value)
+		{
+			if (keys.empty())
+				return false;
+
+			while (cursor + 1 < keys.size() && keys[cursor + 1]->Time <= time)
+				cursor++;
+
+			const KeyType& key = *keys[cursor];
+			if (cursor + 1 == keys.size() || time <= key.Time)
+			{
+				value = key.Value;
+				return true;
+			}
+
+			const KeyType& nextKey = *keys[cursor + 1];
+			value = InterpolateKeys(key.Value, nextKey.Value, (time - key.Time) / (nextKey.Time - key.Time));
+			return true;
+		}
 	}
 
-	void AnimationChannelInstance::Restart()
+	AnimationChannelInstance::AnimationChannelInstance(const AnimationChannel& channelRef, Component& channelComp) :
+		ChannelRef(channelRef), ChannelComp(channelComp), IsValid(true), UseInPlaceKeys(false), bPlaying(false), Time(0.0f), EndTime(0.0f), PosKeyIndex(0), RotKeyIndex(0), ScaleKeyIndex(0)
 	{
-		PosKeysLeft.clear();
-		RotKeysLeft.clear();
-		ScaleKeysLeft.clear();
-
-		for (int i = 0; i < static_cast<int>(ChannelRef.PosKeys.size() - 1); i++)
-			PosKeysLeft.push_back(std::make_unique<Interpolator<glm::vec3>>(Interpolator<glm::vec3>(Interpolation((i == 0) ? (ChannelRef.PosKeys[0]->Time) : (0.0f), (float)ChannelRef.PosKeys[i + 1]->Time - (float)ChannelRef.PosKeys[i]->Time), ChannelRef.PosKeys[i]->Value, ChannelRef.PosKeys[i + 1]->Value)));
 		if (!ChannelRef.PosKeys.empty())
-			PosKeysLeft.push_back(std::make_unique<Interpolator<glm::vec3>>(Interpolator<glm::vec3>(Interpolation(ChannelRef.PosKeys.back()->Time, 0.0f, InterpolationType::CONSTANT, false, AnimBehaviour::STOP, AnimBehaviour::REPEAT), ChannelRef.PosKeys.back()->Value, ChannelRef.PosKeys.back()->Value)));
-
-		for (int i = 0; i < static_cast<int>(ChannelRef.RotKeys.size() - 1); i++)
-			RotKeysLeft.push_back(std::make_unique<Interpolator<glm::quat>>(Interpolator<glm::quat>(Interpolation((i == 0) ? (ChannelRef.RotKeys[0]->Time) : (0.0f), (float)ChannelRef.RotKeys[i + 1]->Time - (float)ChannelRef.RotKeys[i]->Time), ChannelRef.RotKeys[i]->Value, ChannelRef.RotKeys[i + 1]->Value)));
+			EndTime = std::max(EndTime, ChannelRef.PosKeys.back()->Time);
 		if (!ChannelRef.RotKeys.empty())
-			RotKeysLeft.push_back(std::make_unique<Interpolator<glm::quat>>(Interpolator<glm::quat>(Interpolation(ChannelRef.RotKeys.back()->Time, 0.0f, InterpolationType::CONSTANT, false, AnimBehaviour::STOP, AnimBehaviour::REPEAT), ChannelRef.RotKeys.back()->Value, ChannelRef.RotKeys.back()->Value)));
-
-		for (int i = 0; i < static_cast<int>(ChannelRef.ScaleKeys.size() - 1); i++)
-			ScaleKeysLeft.push_back(std::make_unique<Interpolator<glm::vec3>>(Interpolator<glm::vec3>(Interpolation((i == 0) ? (ChannelRef.ScaleKeys[0]->Time) : (0.0f), (float)ChannelRef.ScaleKeys[i + 1]->Time - (float)ChannelRef.ScaleKeys[i]->Time), ChannelRef.ScaleKeys[i]->Value, ChannelRef.ScaleKeys[i + 1]->Value)));
+			EndTime = std::max(EndTime, ChannelRef.RotKeys.back()->Time);
 		if (!ChannelRef.ScaleKeys.empty())
-			ScaleKeysLeft.push_back(std::make_unique<Interpolator<glm::vec3>>(Interpolator<glm::vec3>(Interpolation(ChannelRef.ScaleKeys.back()->Time, 0.0f, InterpolationType::CONSTANT, false, AnimBehaviour::STOP, AnimBehaviour::REPEAT), ChannelRef.ScaleKeys.back()->Value, ChannelRef.ScaleKeys.back()->Value)));
+			EndTime = std::max(EndTime, ChannelRef.ScaleKeys.back()->Time);
 	}
 
-	void AnimationChannelInstance::Stop()
+	void AnimationChannelInstance::Restart()
 	{
-		PosKeysLeft.clear();
-		RotKeysLeft.clear();
-		ScaleKeysLeft.clear();
+		Time = 0.0f;
+		PosKeyIndex = RotKeyIndex = ScaleKeyIndex = 0;
+		bPlaying = true;
 	}
 
-	bool UpdateKey(InterpolatorBase& key, float& deltaTime)
+	void AnimationChannelInstance::Stop()
 	{
-		//std::cout << "updating key\n";
-		float prevT = key.GetInterp()->GetT();
-		key.Update(deltaTime);
-		if (key.GetHasEnded())
-		{
-			if (key.GetInterp()->GetDuration() > 0.0f)
-				deltaTime -= (1.0f - prevT) * key.GetInterp()->GetDuration();	//subtract used time
-			return true;
-		}
-
-		deltaTime = 0.0f;
-		return false;
+		bPlaying = false;
 	}
 
-	template <typename T> void UpdateKeys(std::deque<std::unique_ptr<Interpolator<T>>>& keys, float deltaTime, std::function<void(const T&)> setValFunc)
+	float AnimationChannelInstance::GetTimeLeft() const
 	{
-		float timeLeft = deltaTime;
-		while (!keys.empty())
-		{
-			float prevTimeLeft = timeLeft;
-			bool pop = UpdateKey(*keys.front(), timeLeft);
-			setValFunc(keys.front()->GetCurrentValue());
-
-			if (pop)
-				keys.pop_front();
-			else
-				break;
-		}
+		return (bPlaying) ? (std::max(EndTime - Time, 0.0f)) : (0.0f);
 	}
 
 	bool AnimationChannelInstance::Update(float deltaTime)
 	{
-		if (!IsValid)
+		if (!IsValid || !bPlaying)
 			return false;
 		if (ChannelComp.IsBeingKilled())
 		{
@@ -86,92 +86,45 @@ namespace GEE
 			return false;
 		}
 
-		UpdateKeys<glm::vec3>(PosKeysLeft, deltaTime, [this](const glm::vec3& vec) {ChannelComp.GetTransform().SetPosition(vec); });
-		UpdateKeys<glm::quat>(RotKeysLeft, deltaTime, [this](const glm::quat& q) {ChannelComp.GetTransform().SetRotation(q); });
-		UpdateKeys<glm::vec3>(ScaleKeysLeft, deltaTime, [this](const glm::vec3& vec) {ChannelComp.GetTransform().SetScale(vec); });
-		/*float timeLeft = deltaTime;
-		while (!PosKeysLeft.empty())
-		{
-			float prevTimeLeft = timeLeft;
-			bool pop = UpdateKey(*PosKeysLeft.front(), timeLeft);
-			ChannelComp.GetTransform().SetPosition(PosKeysLeft.front()->GetCurrentValue());
-
-			if (pop)
-				PosKeysLeft.pop_front();
-			else
-				break;
-		}
-
-		timeLeft = deltaTime;
-		while (!RotKeysLeft.empty())
-		{
-			bool pop = UpdateKey(*RotKeysLeft.front(), timeLeft);
-			ChannelComp.GetTransform().SetRotation(RotKeysLeft.front()->GetCurrentValue());
-
-			if (pop)
-				RotKeysLeft.pop_front();
-			else
-				break;
-		}
-
-		timeLeft = deltaTime;
-		while (!ScaleKeysLeft.empty())
-		{
-			bool pop = UpdateKey(*ScaleKeysLeft.front(), timeLeft);
-			ChannelComp.GetTransform().SetScale(ScaleKeysLeft.front()->GetCurrentValue());
-
-			if (pop)
-				ScaleKeysLeft.pop_front();
-			else
-				break;
-		}
-		/*
-		if (!PosKeysLeft.empty())
-		{
-			PosKeysLeft.front()->Update(deltaTime);
-			if (PosKeysLeft.front()->GetHasEnded())
-			{
-				//float timeLeft = (PosKeysLeft.front()->GetInterp()->GetT() - 1.0f) / PosKeysLeft.front()->GetInterp()->GetDuration() << '\n';
-				PosKeysLeft.pop_front();
-			}
-
-			ChannelComp.GetTransform().SetPosition(PosKeysLeft.front()->GetCurrentValue());
-		}
-
-		if (!RotKeysLeft.empty())
-		{
-			RotKeysLeft.front()->Update(deltaTime);
-			if (RotKeysLeft.front()->GetHasEnded())
-				RotKeysLeft.pop_front();
-
-			ChannelComp.GetTransform().SetRotation(RotKeysLeft.front()->GetCurrentValue());
-		}
+		const bool bWasAnimating = Time <= EndTime;	//The last keys are written once, when the end is crossed
+		Time += deltaTime;
+		if (!bWasAnimating)
+			return false;
 
-		if (!ScaleKeysLeft.empty())
-		{
-			ScaleKeysLeft.front()->Update(deltaTime);
-			if (ScaleKeysLeft.front()->GetHasEnded())
-				ScaleKeysLeft.pop_front();
+		Sample();
+		return Time <= EndTime;
+	}
 
-			ChannelComp.GetTransform().SetScale(ScaleKeysLeft.front()->GetCurrentValue());
-		}
-		*/
-		return !(PosKeysLeft.empty() && RotKeysLeft.empty() && ScaleKeysLeft.empty());
+	void AnimationChannelInstance::Sample()
+	{
+		glm::vec3 vec;
+		glm::quat q;
+		if (SampleKeys((UseInPlaceKeys && !ChannelRef.InPlacePosKeys.empty()) ? (ChannelRef.InPlacePosKeys) : (ChannelRef.PosKeys), PosKeyIndex, Time, vec))
+			ChannelComp.GetTransform().SetPosition(vec);
+		if (SampleKeys(ChannelRef.RotKeys, RotKeyIndex, Time, q))
+			ChannelComp.GetTransform().SetRotation(q);
+		if (SampleKeys(ChannelRef.ScaleKeys, ScaleKeyIndex, Time, vec))
+			ChannelComp.GetTransform().SetScale(vec);
 	}
 
 	AnimationInstance::AnimationInstance(Animation& anim, Component& animRootComp) :
-		Anim(anim), AnimRootComp(animRootComp), TimePassed(0.0f), IsValid(true)
+		Anim(anim), Clip(anim.Clip), AnimRootComp(animRootComp), TimePassed(0.0f), IsValid(true), RootMotionChannel(nullptr), bRootMotion(false), PendingRootMotion(glm::vec3(0.0f))
 	{
 		std::function<void(Component&)> boneFinderFunc = [this, &boneFinderFunc](Component& comp) {
-			auto found = std::find_if(Anim.Channels.begin(), Anim.Channels.end(), [&comp](const std::shared_ptr<AnimationChannel>& channel) { return channel->Name == comp.GetName(); });
-			if (found != Anim.Channels.end())
-				ChannelInstances.push_back(std::make_unique<AnimationChannelInstance>(AnimationChannelInstance(**found, comp)));
+			auto found = std::find_if(Clip->Channels.begin(), Clip->Channels.end(), [&comp](const std::shared_ptr<AnimationChannel>& channel) { return channel->Name == comp.GetName(); });
+			if (found != Clip->Channels.end())
+				ChannelInstances.push_back(AnimationChannelInstance(**found, comp));
 
 			for (auto it : comp.GetChildren())
 				boneFinderFunc(*it);
 		};
 
 		boneFinderFunc(AnimRootComp);
+
+		if (!Clip->RootMotion.IsEmpty())	//After all channels have been added, so the pointer stays valid
+			for (auto& it : ChannelInstances)
+				if (it.ChannelRef.Name == Clip->RootMotion.ChannelName)
+					RootMotionChannel = &it;
 	}
 
 	Animation::AnimationLoc AnimationInstance::GetLocalization() const
@@ -184,12 +137,41 @@ namespace GEE
 		return Anim;
 	}
 
+	const AnimationClip& AnimationInstance::GetClip() const
+	{
+		return *Clip;
+	}
+
 	bool AnimationInstance::HasFinished() const
 	{
-		return TimePassed > GetAnimation().Duration;
+		return TimePassed > GetClip().Duration;
+	}
+
+	bool AnimationInstance::HasRootMotion() const
+	{
+		return RootMotionChannel != nullptr;
+	}
+
+	void AnimationInstance::SetRootMotionEnabled(bool enabled)
+	{
+		const bool bChanged = bRootMotion != enabled;
+		bRootMotion = enabled;
+		if (!RootMotionChannel)
+			return;
+
+		RootMotionChannel->UseInPlaceKeys = enabled;
+		if (bChanged && RootMotionChannel->bPlaying)	//Being played - switch the keys of the root channel at the current time
+			RootMotionChannel->Sample();
+	}
+
+	glm::vec3 AnimationInstance::ConsumeRootMotion()
+	{
+		glm::vec3 rootMotion = PendingRootMotion;
+		PendingRootMotion = glm::vec3(0.0f);
+		return rootMotion;
 	}
 
-	void AnimationInstance::Update(float deltaTime)
+	void AnimationInstance::Update(float deltaTime, std::vector<const AnimationNotify*>* crossedNotifies)
 	{
 		if (!IsValid)
 			return;
@@ -204,14 +186,33 @@ namespace GEE
 		float minT = 1.0f;
 
 		for (auto& it : ChannelInstances)
-			if (it->Update(deltaTime))
+			if (it.Update(deltaTime))
 				finished = false;
 
+		if (bRootMotion && RootMotionChannel && RootMotionChannel->IsValid && !HasFinished())
+		{
+			const RootMotionTrack& track = Clip->RootMotion;
+			glm::vec3 delta = track.Sample(std::min(TimePassed + deltaTime, Clip->Duration)) - track.Sample(TimePassed);
+
+			//The track is expressed in the root channel's parent space
+			if (Transform* parentTransform = RootMotionChannel->ChannelComp.GetTransform().GetParentTransform())
+				delta = glm::vec3(parentTransform->GetWorldTransformMatrix() * glm::vec4(delta, 0.0f));
+
+			PendingRootMotion += delta;
+		}
+
+		if (crossedNotifies && !Clip->Notifies.empty())
+		{
+			auto it = std::lower_bound(Clip->Notifies.begin(), Clip->Notifies.end(), TimePassed, [](const AnimationNotify& notify, float time) { return notify.Time < time; });
+			for (; it != Clip->Notifies.end() && it->Time < TimePassed + deltaTime; it++)
+				crossedNotifies->push_back(&*it);
+		}
+
 		TimePassed += deltaTime;
 
 		/*if (HasFinished())
 		{
-			float nextIterationTime = TimePassed - GetAnimation().Duration;
+			float nextIterationTime = TimePassed - GetClip().Duration;
 			Restart();
 			Update(nextIterationTime);
 		}*/
@@ -220,21 +221,25 @@ namespace GEE
 	void AnimationInstance::Stop()
 	{
 		for (auto& it : ChannelInstances)
-			it->Stop();
-		TimePassed = GetAnimation().Duration;
+			it.Stop();
+		TimePassed = GetClip().Duration;
 	}
 
 	void AnimationInstance::Restart()
 	{
 		for (auto& it : ChannelInstances)
-			it->Restart();
+			it.Restart();
 		TimePassed = 0.0f;
 	}
 
 	AnimationManagerComponent::AnimationManagerComponent(Actor& actor, Component* parentComp, const std::string& name) :
 		Component(actor, parentComp, name, Transform()),
-		CurrentAnim(nullptr)
+		CurrentAnim(nullptr),
+		bRootMotion(false),
+		PendingRootMotion(glm::vec3(0.0f)),
+		NextNotifyListenerID(0)
 	{
+		RegisterForUpdate(UpdateStage::ANIMATION);
 	}
 
 	AnimationInstance* AnimationManagerComponent::GetAnimInstance(int index)
@@ -258,6 +263,47 @@ namespace GEE
 	void AnimationManagerComponent::AddAnimationInstance(AnimationInstance&& animInstance)
 	{
 		AnimInstances.push_back(std::make_unique<AnimationInstance>(std::move(animInstance)));
+		AnimInstances.back()->SetRootMotionEnabled(bRootMotion);
+	}
+
+	bool AnimationManagerComponent::IsRootMotionEnabled() const
+	{
+		return bRootMotion;
+	}
+
+	void AnimationManagerComponent::SetRootMotionEnabled(bool enabled)
+	{
+		bRootMotion = enabled;
+		for (auto& it : AnimInstances)
+			it->SetRootMotionEnabled(enabled);
+		PendingRootMotion = glm::vec3(0.0f);
+	}
+
+	unsigned int AnimationManagerComponent::AddNotifyListener(std::function<void(const AnimationNotifyEvent&)> listener)
+	{
+		NotifyListeners.push_back(std::make_pair(NextNotifyListenerID, listener));
+		return NextNotifyListenerID++;
+	}
+
+	void AnimationManagerComponent::RemoveNotifyListener(unsigned int listenerID)
+	{
+		NotifyListeners.erase(std::remove_if(NotifyListeners.begin(), NotifyListeners.end(), [listenerID](const std::pair<unsigned int, std::function<void(const AnimationNotifyEvent&)>>& listener) { return listener.first == listenerID; }), NotifyListeners.end());
+	}
+
+	void AnimationManagerComponent::DispatchNotifies()
+	{
+		for (auto& notify : PendingNotifies)
+			for (auto& listener : NotifyListeners)
+				listener.second(AnimationNotifyEvent{ *this, *notify.first, *notify.second });
+
+		PendingNotifies.clear();
+	}
+
+	glm::vec3 AnimationManagerComponent::ConsumeRootMotion()
+	{
+		glm::vec3 rootMotion = PendingRootMotion;
+		PendingRootMotion = glm::vec3(0.0f);
+		return rootMotion;
 	}
 
 	void AnimationManagerComponent::Update(float deltaTime)
@@ -266,7 +312,17 @@ namespace GEE
 			//it->Update(deltaTime);
 		if (CurrentAnim)
 		{
-			CurrentAnim->Update(deltaTime);
+			CrossedNotifiesCache.clear();
+			CurrentAnim->Update(deltaTime, (NotifyListeners.empty() || IsBeingKilled()) ? (nullptr) : (&CrossedNotifiesCache));
+			PendingRootMotion += CurrentAnim->ConsumeRootMotion();
+
+			if (!CrossedNotifiesCache.empty())
+			{
+				if (PendingNotifies.empty())
+					GetScene().AddAnimationNotifySource(*this);
+				for (auto notify : CrossedNotifiesCache)
+					PendingNotifies.push_back(std::pair<AnimationInstance*, const AnimationNotify*>(CurrentAnim, notify));
+			}
 			if (CurrentAnim->HasFinished())
 				SelectAnimation(nullptr);
 		}
@@ -280,7 +336,7 @@ namespace GEE
 
 		CurrentAnim = anim;
 		if (CurrentAnim)
-			std::cout << "Started anim " + CurrentAnim->GetAnimation().Localization.Name + ". Nr of channels: " << CurrentAnim->GetAnimation().Channels.size() << '\n';
+			std::cout << "Started anim " + CurrentAnim->GetAnimation().Localization.Name + ". Nr of channels: " << CurrentAnim->GetClip().Channels.size() << '\n';
 		else
 			std::cout << "Selected nullptr animation.\n";
 
@@ -288,10 +344,18 @@ namespace GEE
 			CurrentAnim->Restart();
 	}
 
+	AnimationManagerComponent::~AnimationManagerComponent()
+	{
+		if (!PendingNotifies.empty())
+			GetScene().EraseAnimationNotifySource(*this);
+	}
+
 	void AnimationManagerComponent::GetEditorDescription(EditorDescriptionBuilder descBuilder)
 	{
 		Component::GetEditorDescription(descBuilder);
 
+		descBuilder.AddField("Root motion").GetTemplates().TickBox([this](bool enabled) { SetRootMotionEnabled(enabled); }, [this]() { return IsRootMotionEnabled(); });
+
 		UICanvasField& animField = descBuilder.AddField("Animations");
 
 		float posX = 0.0f;
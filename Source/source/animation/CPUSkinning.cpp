@@ -0,0 +1,304 @@
+#include <animation/CPUSkinning.h>
+#include <utility/Profiler.h>
+#include <chrono>
+#include <random>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GEE_SKINNING_SSE
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define GEE_SKINNING_AVX
+#include <immintrin.h>
+#endif
+#endif
+
+namespace GEE
+{
+	namespace CPUSkinning
+	{
+		namespace
+		{
+			inline bool HasNoBones(const VertexBoneData& boneData)
+			{
+				return boneData.BoneIDs.x == 0 && boneData.BoneWeights.x == 0.0f;	//Same check as in the skinned vertex shaders
+			}
+
+			inline void CopyUnskinned(const Vertex& src, Vertex& dst)
+			{
+				dst = src;
+				dst.BoneData = VertexBoneData();
+			}
+
+#ifdef GEE_SKINNING_SSE
+			inline __m128 TransformSSE(const __m128 cols[4], const glm::vec3& v, bool point)
+			{
+				__m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cols[0], _mm_set1_ps(v.x)), _mm_mul_ps(cols[1], _mm_set1_ps(v.y))), _mm_mul_ps(cols[2], _mm_set1_ps(v.z)));
+				return (point) ? (_mm_add_ps(result, cols[3])) : (result);
+			}
+
+			inline glm::vec3 StoreVec3(__m128 v)
+			{
+				alignas(16) float out[4];
+				_mm_store_ps(out, v);
+				return glm::vec3(out[0], out[1], out[2]);
+			}
+#endif
+		}
+
+		void SkinVerticesScalar(const Vertex* src, Vertex* dst, size_t count, const glm::mat4* palette)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				const VertexBoneData& boneData = src[i].BoneData;
+				if (HasNoBones(boneData))
+				{
+					CopyUnskinned(src[i], dst[i]);
+					continue;
+				}
+
+				glm::mat4 boneMat(0.0f);
+				for (int j = 0; j < 4; j++)
+					if (boneData.BoneWeights[j] != 0.0f)
+						boneMat += palette[boneData.BoneIDs[j]] * boneData.BoneWeights[j];
+
+				const glm::vec3& p = src[i].Position;
+				dst[i].Position = glm::vec3(boneMat[0] * p.x + boneMat[1] * p.y + boneMat[2] * p.z + boneMat[3]);
+
+				glm::mat3 normalMat(boneMat);	//Upper 3x3 part; the shaders normalize the results, so this matches the inverse transpose for rotations and uniform scales
+				dst[i].Normal = normalMat * src[i].Normal;
+				dst[i].Tangent = normalMat * src[i].Tangent;
+				dst[i].Bitangent = normalMat * src[i].Bitangent;
+				dst[i].TexCoord = src[i].TexCoord;
+				dst[i].BoneData = VertexBoneData();
+			}
+		}
+
+		void SkinVerticesSIMD(const Vertex* src, Vertex* dst, size_t count, const glm::mat4* palette)
+		{
+#ifdef GEE_SKINNING_SSE
+			for (size_t i = 0; i < count; i++)
+			{
+				const VertexBoneData& boneData = src[i].BoneData;
+				if (HasNoBones(boneData))
+				{
+					CopyUnskinned(src[i], dst[i]);
+					continue;
+				}
+
+				__m128 cols[4];
+#ifdef GEE_SKINNING_AVX
+				__m256 cols01 = _mm256_setzero_ps(), cols23 = _mm256_setzero_ps();
+				for (int j = 0; j < 4; j++)
+				{
+					if (boneData.BoneWeights[j] == 0.0f)
+						continue;
+
+					const float* mat = &palette[boneData.BoneIDs[j]][0][0];
+					__m256 weight = _mm256_set1_ps(boneData.BoneWeights[j]);
+					cols01 = _mm256_add_ps(cols01, _mm256_mul_ps(_mm256_loadu_ps(mat), weight));
+					cols23 = _mm256_add_ps(cols23, _mm256_mul_ps(_mm256_loadu_ps(mat + 8), weight));
+				}
+				cols[0] = _mm256_castps256_ps128(cols01);
+				cols[1] = _mm256_extractf128_ps(cols01, 1);
+				cols[2] = _mm256_castps256_ps128(cols23);
+				cols[3] = _mm256_extractf128_ps(cols23, 1);
+#else
+				cols[0] = cols[1] = cols[2] = cols[3] = _mm_setzero_ps();
+				for (int j = 0; j < 4; j++)
+				{
+					if (boneData.BoneWeights[j] == 0.0f)
+						continue;
+
+					const float* mat = &palette[boneData.BoneIDs[j]][0][0];
+					__m128 weight = _mm_set1_ps(boneData.BoneWeights[j]);
+					for (int col = 0; col < 4; col++)
+						cols[col] = _mm_add_ps(cols[col], _mm_mul_ps(_mm_loadu_ps(mat + col * 4), weight));
+				}
+#endif
+
+				dst[i].Position = StoreVec3(TransformSSE(cols, src[i].Position, true));
+				dst[i].Normal = StoreVec3(TransformSSE(cols, src[i].Normal, false));
+				dst[i].Tangent = StoreVec3(TransformSSE(cols, src[i].Tangent, false));
+				dst[i].Bitangent = StoreVec3(TransformSSE(cols, src[i].Bitangent, false));
+				dst[i].TexCoord = src[i].TexCoord;
+				dst[i].BoneData = VertexBoneData();
+			}
+#else
+			SkinVerticesScalar(src, dst, count, palette);
+#endif
+		}
+
+		void SkinVertices(const Vertex* src, Vertex* dst, size_t count, const glm::mat4* palette)
+		{
+			SkinVerticesSIMD(src, dst, count, palette);
+		}
+
+		const char* GetSIMDKernelName()
+		{
+#if defined(GEE_SKINNING_AVX)
+			return "AVX";
+#elif defined(GEE_SKINNING_SSE)
+			return "SSE2";
+#else
+			return "Scalar";
+#endif
+		}
+
+		namespace
+		{
+			void GenerateTestData(std::vector<Vertex>& verts, std::vector<glm::mat4>& palette, size_t vertexCount, unsigned int boneCount, unsigned int seed)
+			{
+				std::mt19937 gen(seed);
+				std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+				std::uniform_int_distribution<int> boneDist(0, static_cast<int>(boneCount) - 1);
+
+				palette.resize(boneCount);
+				for (auto& mat : palette)
+					for (int col = 0; col < 4; col++)
+						mat[col] = glm::vec4(dist(gen), dist(gen), dist(gen), (col == 3) ? (1.0f) : (0.0f));
+
+				verts.resize(vertexCount);
+				for (size_t i = 0; i < vertexCount; i++)
+				{
+					Vertex& vert = verts[i];
+					vert.Position = glm::vec3(dist(gen), dist(gen), dist(gen)) * 10.0f;
+					vert.Normal = glm::vec3(dist(gen), dist(gen), dist(gen));
+					vert.TexCoord = glm::vec2(dist(gen), dist(gen));
+					vert.Tangent = glm::vec3(dist(gen), dist(gen), dist(gen));
+					vert.Bitangent = glm::vec3(dist(gen), dist(gen), dist(gen));
+					vert.BoneData = VertexBoneData();
+
+					if (i % 16 == 0)	//Leave some vertices unskinned
+						continue;
+
+					int weightCount = 1 + static_cast<int>(i % 4);
+					for (int j = 0; j < weightCount; j++)
+						vert.BoneData.AddWeight(boneDist(gen), 0.1f + std::abs(dist(gen)));
+					vert.BoneData.BoneWeights /= vert.BoneData.BoneWeights.x + vert.BoneData.BoneWeights.y + vert.BoneData.BoneWeights.z + vert.BoneData.BoneWeights.w;
+				}
+			}
+		}
+
+		float ValidateSIMDKernel(size_t vertexCount, unsigned int boneCount, unsigned int seed)
+		{
+			std::vector<Vertex> verts, scalarOut(vertexCount), simdOut(vertexCount);
+			std::vector<glm::mat4> palette;
+			GenerateTestData(verts, palette, vertexCount, boneCount, seed);
+
+			SkinVerticesScalar(verts.data(), scalarOut.data(), vertexCount, palette.data());
+			SkinVerticesSIMD(verts.data(), simdOut.data(), vertexCount, palette.data());
+
+			auto maxDiff = [](const glm::vec3& a, const glm::vec3& b) { glm::vec3 diff = glm::abs(a - b); return std::max(diff.x, std::max(diff.y, diff.z)); };
+
+			float maxError = 0.0f;
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				maxError = std::max(maxError, maxDiff(scalarOut[i].Position, simdOut[i].Position));
+				maxError = std::max(maxError, maxDiff(scalarOut[i].Normal, simdOut[i].Normal));
+				maxError = std::max(maxError, maxDiff(scalarOut[i].Tangent, simdOut[i].Tangent));
+				maxError = std::max(maxError, maxDiff(scalarOut[i].Bitangent, simdOut[i].Bitangent));
+			}
+
+			return maxError;
+		}
+
+		double BenchmarkKernel(bool simd, size_t vertexCount, unsigned int boneCount, unsigned int iterations)
+		{
+			std::vector<Vertex> verts, out(vertexCount);
+			std::vector<glm::mat4> palette;
+			GenerateTestData(verts, palette, vertexCount, boneCount, 0);
+
+			if (iterations == 0)
+				return 0.0;
+
+			auto begin = std::chrono::steady_clock::now();
+			for (unsigned int i = 0; i < iterations; i++)
+			{
+				if (simd)
+					SkinVerticesSIMD(verts.data(), out.data(), vertexCount, palette.data());
+				else
+					SkinVerticesScalar(verts.data(), out.data(), vertexCount, palette.data());
+			}
+			auto end = std::chrono::steady_clock::now();
+
+			return std::chrono::duration<double, std::milli>(end - begin).count() / static_cast<double>(iterations);
+		}
+	}
+
+	CPUSkinnedMesh::CPUSkinnedMesh(const Mesh& mesh) :
+		MeshRef(mesh),
+		VAO(0),
+		VBO(0),
+		SkinnedFrameIndex(0)
+	{
+		BindPoseVerts = mesh.BindPoseVertsData;	//The vertex buffer is never read back - it holds nothing on the null GL device
+		if (!BindPoseVerts || BindPoseVerts->empty())
+		{
+			std::cout << "ERROR! Cannot skin mesh " << mesh.GetLocalization().NodeName << " on the CPU - it is not skinned or its bind pose was not kept.\n";
+			return;
+		}
+
+		SkinnedVerts = *BindPoseVerts;
+
+		glGenVertexArrays(1, &VAO);
+		glGenBuffers(1, &VBO);
+
+		glBindVertexArray(VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * SkinnedVerts.size(), &SkinnedVerts[0], GL_STREAM_DRAW);
+		GEE_PROFILE_COUNT(BUFFER_BYTES_UPLOADED, sizeof(Vertex) * SkinnedVerts.size());
+		if (mesh.EBO)
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+
+		setVertexAttribPointers();
+		glBindVertexArray(0);
+	}
+
+	CPUSkinnedMesh::~CPUSkinnedMesh()
+	{
+		if (VBO)
+			glDeleteBuffers(1, &VBO);
+		if (VAO)
+			glDeleteVertexArrays(1, &VAO);
+	}
+
+	bool CPUSkinnedMesh::IsValid() const
+	{
+		return VAO != 0;
+	}
+
+	bool CPUSkinnedMesh::IsUpToDate(unsigned long long frameIndex) const
+	{
+		return SkinnedFrameIndex == frameIndex;
+	}
+
+	void CPUSkinnedMesh::Update(const glm::mat4* palette, unsigned long long frameIndex)
+	{
+		if (!IsValid())
+			return;
+
+		GEE_PROFILE_SCOPE("CPUSkinning");
+		CPUSkinning::SkinVertices(BindPoseVerts->data(), SkinnedVerts.data(), SkinnedVerts.size(), palette);
+
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * SkinnedVerts.size(), nullptr, GL_STREAM_DRAW);	//Orphan the storage used by previous frames
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * SkinnedVerts.size(), &SkinnedVerts[0]);
+		GEE_PROFILE_COUNT(BUFFER_BYTES_UPLOADED, sizeof(Vertex) * SkinnedVerts.size());
+
+		SkinnedFrameIndex = frameIndex;
+	}
+
+	void CPUSkinnedMesh::Bind() const
+	{
+		glBindVertexArray(VAO);
+	}
+
+	void CPUSkinnedMesh::Render() const
+	{
+		if (MeshRef.EBO)
+			glDrawElements(GL_TRIANGLES, MeshRef.IndexCount, GL_UNSIGNED_INT, nullptr);
+		else
+			glDrawArrays(GL_TRIANGLES, 0, MeshRef.VertexCount);
+		GEE_PROFILE_COUNT(DRAW_CALLS, 1);
+	}
+}
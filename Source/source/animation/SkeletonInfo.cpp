@@ -1,5 +1,6 @@
 #include <animation/SkeletonInfo.h>
 #include <scene/BoneComponent.h>
+#include <rendering/RenderSnapshot.h>
 
 namespace GEE
 {
@@ -7,7 +8,9 @@ namespace GEE
 		GlobalInverseTransformCompPtr(nullptr),
 
 		BoneIDOffset(0),
-		BatchPtr(nullptr)
+		BatchPtr(nullptr),
+		PaletteFrameStamp(0),
+		PaletteOffset(0)
 	{
 	}
 
@@ -68,6 +71,34 @@ namespace GEE
 		}
 	}
 
+	unsigned int SkeletonInfo::GetPaletteMatCount()
+	{
+		unsigned int count = 0;
+		for (auto it : Bones)
+			count = std::max(count, it->GetID() + 1);
+
+		return count;
+	}
+
+	void SkeletonInfo::FillPalette(glm::mat4* palette, const RenderSnapshot* snapshot)
+	{
+		if (Bones.size() == 0)
+			return;
+
+		if (snapshot)
+		{
+			glm::mat4 globalInverseMat = glm::inverse(snapshot->GetWorldMatrix(GlobalInverseTransformCompPtr->GetTransform()));
+			for (auto it : Bones)
+				palette[it->GetID()] = globalInverseMat * snapshot->GetWorldMatrix(it->GetTransform()) * it->BoneOffset;
+			return;
+		}
+
+		glm::mat4 globalInverseMat = glm::inverse(GlobalInverseTransformCompPtr->GetTransform().GetWorldTransformMatrix());
+
+		for (auto it : Bones)
+			palette[it->GetID()] = globalInverseMat * it->GetTransform().GetWorldTransformMatrix() * it->BoneOffset;
+	}
+
 	void SkeletonInfo::AddBone(BoneComponent& bone)
 	{
 		Bones.push_back(&bone);
@@ -87,9 +118,6 @@ namespace GEE
 	SkeletonBatch::SkeletonBatch() :
 		BoneCount(0)
 	{
-		std::array<glm::mat4, 1024> identities;
-		identities.fill(glm::mat4(1.0f));
-		BoneUBO.Generate(10, sizeof(glm::mat4) * 1024, &identities[0][0][0], GL_STREAM_DRAW);
 	}
 
 	unsigned int SkeletonBatch::GetRemainingCapacity()
@@ -145,22 +173,119 @@ namespace GEE
 		return true;
 	}
 
-	void SkeletonBatch::BindToUBO()
+	void SkeletonBatch::VerifySkeletonsLives()
 	{
-		std::vector<glm::mat4> boneMats;
-		boneMats.resize(BoneCount, glm::mat4(1.0f));
+		Skeletons.erase(std::remove_if(Skeletons.begin(), Skeletons.end(), [](std::shared_ptr<SkeletonInfo>& skeleton) { return !skeleton->VerifyGlobalInverseCompPtrLife(); /* Remove if global inverse comp is not alive. */ }), Skeletons.end());
+	}
 
-		for (int i = 0; i < static_cast<int>(Skeletons.size()); i++)
+	BonePaletteRing::BonePaletteRing() :
+		RegionSize(0),
+		RegionOffset(0),
+		OffsetAlignment(256),
+		CurrentRegion(0),
+		FrameStamp(1),
+		bGrowRequested(false)
+	{
+	}
+
+	void BonePaletteRing::Generate(unsigned int blockBindingSlot, unsigned int regionMatCapacity)
+	{
+		GLint alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		OffsetAlignment = (alignment > 0) ? (static_cast<size_t>(alignment)) : (256);
+
+		RegionSize = static_cast<size_t>(regionMatCapacity) * sizeof(glm::mat4);
+		RegionSize += (OffsetAlignment - RegionSize % OffsetAlignment) % OffsetAlignment;
+
+		//The bound range always spans a whole BoneMatrices block (MaxUBOSize), so keep a tail after the last region for slices allocated at its very end.
+		PaletteUBO.Generate(blockBindingSlot, RegionSize * RegionCount + MaxUBOSize, nullptr, GL_STREAM_DRAW);
+
+		CurrentRegion = 0;
+		RegionOffset = 0;
+		FrameStamp++;
+	}
+
+	bool BonePaletteRing::HasBeenGenerated() const
+	{
+		return PaletteUBO.HasBeenGenerated();
+	}
+
+	void BonePaletteRing::BeginFrame()
+	{
+		if (bGrowRequested)
 		{
-			Skeletons[i]->FillMatricesVec(boneMats);
+			Grow();
+			bGrowRequested = false;
 		}
 
-		BoneUBO.SubData(BoneCount * sizeof(glm::mat4), &boneMats[0][0][0], 0);
+		CurrentRegion = (CurrentRegion + 1) % RegionCount;
+		RegionOffset = 0;
+		FrameStamp++;
 	}
 
-	void SkeletonBatch::VerifySkeletonsLives()
+	bool BonePaletteRing::BindPalette(SkeletonInfo& info, const RenderSnapshot* snapshot)
 	{
-		Skeletons.erase(std::remove_if(Skeletons.begin(), Skeletons.end(), [](std::shared_ptr<SkeletonInfo>& skeleton) { return !skeleton->VerifyGlobalInverseCompPtrLife(); /* Remove if global inverse comp is not alive. */ }), Skeletons.end());
+		if (!HasBeenGenerated())
+			return false;
+
+		if (info.PaletteFrameStamp != FrameStamp)
+		{
+			unsigned int matCount = info.GetPaletteMatCount();
+			if (matCount == 0 || !info.VerifyGlobalInverseCompPtrLife())
+				return false;
+			if (matCount * sizeof(glm::mat4) > MaxUBOSize)
+			{
+				std::cout << "ERROR! Skeleton has more bones than fit in a single palette (" << matCount << ").\n";
+				return false;
+			}
+
+			size_t offset;
+			if (!Allocate(matCount * sizeof(glm::mat4), offset))
+			{
+				//Out of space in this region. Reallocate right away (which invalidates every slice of this frame, so they will be uploaded again) and grow once more at the start of the next frame.
+				std::cout << "INFO: Bone palette ring is full; growing it.\n";
+				Grow();
+				bGrowRequested = true;
+				if (!Allocate(matCount * sizeof(glm::mat4), offset))
+					return false;
+			}
+
+			if (PaletteCache.size() < matCount)
+				PaletteCache.resize(matCount, glm::mat4(1.0f));
+			info.FillPalette(&PaletteCache[0], snapshot);
+
+			PaletteUBO.SubData(matCount * sizeof(glm::mat4), &PaletteCache[0][0][0], offset);
+
+			info.PaletteFrameStamp = FrameStamp;
+			info.PaletteOffset = offset;
+		}
+
+		glBindBufferRange(GL_UNIFORM_BUFFER, PaletteUBO.BlockBindingSlot, PaletteUBO.UBO, info.PaletteOffset, MaxUBOSize);
+		return true;
+	}
+
+	void BonePaletteRing::Dispose()
+	{
+		PaletteUBO.Dispose();
+		PaletteUBO.UBO = 0;
 	}
 
+	bool BonePaletteRing::Allocate(size_t size, size_t& offset)
+	{
+		if (RegionOffset + size > RegionSize)
+			return false;
+
+		offset = CurrentRegion * RegionSize + RegionOffset;
+		RegionOffset += size;
+		RegionOffset += (OffsetAlignment - RegionOffset % OffsetAlignment) % OffsetAlignment;
+
+		return true;
+	}
+
+	void BonePaletteRing::Grow()
+	{
+		unsigned int region = CurrentRegion;
+		Generate(PaletteUBO.BlockBindingSlot, static_cast<unsigned int>(RegionSize * 2 / sizeof(glm::mat4)));
+		CurrentRegion = region;
+	}
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <scene/hierarchy/HierarchyTree.h>
 #include <scene/hierarchy/HierarchyNode.h>
 #include <assetload/FileLoader.h>
+#include <physics/CookedMeshCache.h>
 #include <rendering/Texture.h>
 #include <rendering/LightProbe.h>
 #include <scene/SoundSourceComponent.h>
@@ -344,6 +345,7 @@ namespace GEE
 
 		std::transform(vertsData.begin(), vertsData.end(), shape->VertData.begin(), [](const Vertex& vertex) { return vertex.Position; });
 		shape->IndicesData = indicesData;
+		shape->MeshHash = Physics::CookedMeshCache::ComputeHash(shape->VertData, shape->IndicesData);
 
 		return shape;
 	}
@@ -385,6 +387,30 @@ namespace GEE
 		}
 	}
 
+	void EngineDataLoader::LoadAnimationNotifies(const std::string& path, std::vector<std::shared_ptr<AnimationClip>>& clips)
+	{
+		if (clips.empty())
+			return;
+
+		std::ifstream filestr(path + ".notify");
+		if (!filestr.good())
+			return;
+
+		std::string animName, notifyName;
+		float time;
+		while (filestr >> animName >> time >> notifyName)
+		{
+			auto found = std::find_if(clips.begin(), clips.end(), [&animName](const std::shared_ptr<AnimationClip>& clip) { return clip->Name == animName; });
+			if (found == clips.end())
+			{
+				std::cout << "ERROR! Cannot find animation " << animName << " for notify " << notifyName << " in " << path << ".notify\n";
+				continue;
+			}
+
+			(*found)->AddNotify(time, notifyName);
+		}
+	}
+
 	void EngineDataLoader::LoadMeshFromAi(Mesh* meshPtr, const aiScene* scene, aiMesh* mesh, const HTreeObjectLoc& treeObjLoc, const std::string& directory, bool bLoadMaterial, MaterialLoadingData* matLoadingData, BoneMapping* boneMapping, bool keepVertsData)
 	{
 		std::vector <Vertex> vertices;
@@ -833,6 +859,9 @@ namespace GEE
 					archive.serializeDeferments();
 
 					scene.Load();
+
+					if (std::unique_ptr<SceneStreamingManager> streaming = SceneStreamingManager::LoadManifest(scene, SceneStreamingManager::GetManifestFilepath(filepath)))	//The level has been partitioned into cells
+						scene.SetStreamingManager(std::move(streaming));
 				}
 				catch (cereal::Exception& ex)
 				{
@@ -981,9 +1010,28 @@ namespace GEE
 
 		LoadHierarchyNodeFromAi(gameHandle, assimpScene, directory, &matLoadingData, *treePtr, (assimpScene->mRootNode->mNumMeshes > 0) ? (treePtr->GetRoot().CreateChild<ModelComponent>(treePtr->GetRoot().GetCompBaseType().GetName() + "RootMeshes")) : (treePtr->GetRoot()), assimpScene->mRootNode, treePtr->GetBoneMapping(), nullptr, Transform(), keepVertsData);
 
+		//Clips of a file that has already been loaded (e.g. by another tree) are reused from the cache instead of being loaded again
+		std::vector<std::shared_ptr<const AnimationClip>> clips;
+		std::vector<std::shared_ptr<AnimationClip>> loadedClips;
 		for (int i = 0; i < static_cast<int>(assimpScene->mNumAnimations); i++)
 		{
-			treePtr->AddAnimation(Animation(*treePtr, assimpScene->mAnimations[i]));
+			if (std::shared_ptr<const AnimationClip> cached = AnimationClipCache::Find(path, assimpScene->mAnimations[i]->mName.C_Str()))
+			{
+				clips.push_back(cached);
+				continue;
+			}
+
+			loadedClips.push_back(std::make_shared<AnimationClip>(assimpScene->mAnimations[i]));
+			loadedClips.back()->CookRootMotion(assimpScene->mRootNode);
+			clips.push_back(loadedClips.back());
+		}
+		LoadAnimationNotifies(path, loadedClips);
+		for (auto& it : loadedClips)
+			AnimationClipCache::Add(path, it);
+
+		for (int i = 0; i < static_cast<int>(clips.size()); i++)
+		{
+			treePtr->AddAnimation(Animation(*treePtr, clips[i]));
 			int animIndex = assimpScene->mNumAnimations - 1;
 			std::cout << assimpScene->mAnimations[animIndex]->mDuration / assimpScene->mAnimations[animIndex]->mTicksPerSecond << "<- czas; " << assimpScene->mAnimations[animIndex]->mTicksPerSecond << "<- tps\n";
 		}
@@ -1010,7 +1058,6 @@ namespace GEE
 			for (int i = 0; i < tree.GetAnimationCount(); i++)
 				animManager.AddAnimationInstance(AnimationInstance(tree.GetAnimation(i), comp));
 
-			//comp.QueueAnimationAll(&tree.GetAnimation(0));
 			if (DUPA::AnimTime == 9999.0f)
 				DUPA::AnimTime = 0.0f;
 		}
@@ -0,0 +1,329 @@
+#include <audio/AudioDecoder.h>
+#include <audio/VorbisStream.h>
+#include <AL/alext.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+
+namespace GEE
+{
+	namespace Audio
+	{
+		namespace
+		{
+			constexpr uint16_t WavFormatPCM = 1;
+			constexpr uint16_t WavFormatFloat = 3;
+			constexpr uint16_t WavFormatExtensible = 0xFFFE;	//The actual format is in the first two bytes of the subformat GUID
+
+			template <typename T> bool ReadValue(std::ifstream& file, T& value)
+			{
+				return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));	//WAV files are little-endian, like all the platforms we run on
+			}
+
+			int16_t ToInt16(float sample)
+			{
+				return static_cast<int16_t>(std::clamp(sample, -1.0f, 1.0f) * 32767.0f);
+			}
+		}
+
+		AudioDecoder::AudioDecoder(const std::string& path) :
+			Path(path),
+			ChannelCount(0),
+			SampleRate(0),
+			FrameCount(0),
+			bFloatSamples(false)
+		{
+		}
+
+		std::unique_ptr<AudioDecoder> AudioDecoder::Open(const std::string& path)
+		{
+			std::string format = path.substr(path.find_last_of('.') + 1);
+			std::transform(format.begin(), format.end(), format.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+
+			if (format == "wav")
+			{
+				std::unique_ptr<WavDecoder> decoder = std::make_unique<WavDecoder>(path);
+				if (decoder->IsValid())
+					return decoder;
+			}
+			else if (format == "ogg")
+			{
+				std::unique_ptr<OggVorbisDecoder> decoder = std::make_unique<OggVorbisDecoder>(path);
+				if (decoder->IsValid())
+					return decoder;
+			}
+			else
+				std::cerr << "ERROR! Unrecognized audio format " << format << " of file " << path << '\n';
+
+			return nullptr;
+		}
+
+		const std::string& AudioDecoder::GetPath() const
+		{
+			return Path;
+		}
+
+		unsigned int AudioDecoder::GetChannelCount() const
+		{
+			return ChannelCount;
+		}
+
+		unsigned int AudioDecoder::GetSampleRate() const
+		{
+			return SampleRate;
+		}
+
+		size_t AudioDecoder::GetFrameCount() const
+		{
+			return FrameCount;
+		}
+
+		float AudioDecoder::GetLengthInSeconds() const
+		{
+			return (SampleRate > 0) ? (static_cast<float>(FrameCount) / static_cast<float>(SampleRate)) : (0.0f);
+		}
+
+		bool AudioDecoder::HasFloatSamples() const
+		{
+			return bFloatSamples;
+		}
+
+		ALenum AudioDecoder::GetALFormat(bool floatSamples) const
+		{
+			if (floatSamples)
+				return (ChannelCount == 2) ? (AL_FORMAT_STEREO_FLOAT32) : (AL_FORMAT_MONO_FLOAT32);
+
+			return (ChannelCount == 2) ? (AL_FORMAT_STEREO16) : (AL_FORMAT_MONO16);
+		}
+
+		size_t AudioDecoder::ReadFloat(float* frames, size_t frameCount)
+		{
+			ConversionBuffer.resize(frameCount * ChannelCount);
+			const size_t readFrames = Read(ConversionBuffer.data(), frameCount);
+
+			for (size_t i = 0; i < readFrames * ChannelCount; i++)
+				frames[i] = static_cast<float>(ConversionBuffer[i]) / 32768.0f;
+
+			return readFrames;
+		}
+
+		///////////////////////////////////////////
+		////////////////////WAV////////////////////
+		///////////////////////////////////////////
+
+		WavDecoder::WavDecoder(const std::string& path) :
+			AudioDecoder(path),
+			File(path, std::ios::binary),
+			DataOffset(0),
+			FramesLeft(0),
+			BytesPerSample(0)
+		{
+			if (!File.good())
+			{
+				std::cerr << "ERROR! Can't open WAV file " << path << "!\n";
+				return;
+			}
+
+			if (!ReadHeader())
+				ChannelCount = 0;
+		}
+
+		bool WavDecoder::IsValid() const
+		{
+			return ChannelCount > 0;
+		}
+
+		size_t WavDecoder::Read(int16_t* frames, size_t frameCount)
+		{
+			frameCount = std::min(frameCount, FramesLeft);
+			const size_t sampleCount = frameCount * ChannelCount;
+			if (sampleCount == 0)
+				return 0;
+
+			if (BytesPerSample == 2)	//No conversion needed
+			{
+				File.read(reinterpret_cast<char*>(frames), sampleCount * 2);
+				const size_t readFrames = static_cast<size_t>(File.gcount()) / (2 * ChannelCount);
+				FramesLeft = (readFrames == frameCount) ? (FramesLeft - readFrames) : (0);	//A truncated file ends where the data ends
+				return readFrames;
+			}
+
+			const size_t readFrames = ReadRaw(frameCount);
+			const char* sample = ReadBuffer.data();
+			for (size_t i = 0; i < readFrames * ChannelCount; i++, sample += BytesPerSample)
+			{
+				switch (BytesPerSample)
+				{
+				case 1: frames[i] = static_cast<int16_t>((static_cast<int>(static_cast<unsigned char>(*sample)) - 128) << 8); break;	//8-bit samples are unsigned
+				case 3: frames[i] = static_cast<int16_t>((static_cast<unsigned char>(sample[1])) | (sample[2] << 8)); break;	//Keep the 16 most significant bits
+				case 4:
+					if (bFloatSamples)
+					{
+						float value;
+						std::memcpy(&value, sample, sizeof(float));
+						frames[i] = ToInt16(value);
+					}
+					else
+						frames[i] = static_cast<int16_t>((static_cast<unsigned char>(sample[2])) | (sample[3] << 8));
+					break;
+				}
+			}
+
+			return readFrames;
+		}
+
+		size_t WavDecoder::ReadFloat(float* frames, size_t frameCount)
+		{
+			if (!bFloatSamples)
+				return AudioDecoder::ReadFloat(frames, frameCount);
+
+			const size_t readFrames = ReadRaw(frameCount);
+			std::memcpy(frames, ReadBuffer.data(), readFrames * ChannelCount * sizeof(float));
+			return readFrames;
+		}
+
+		bool WavDecoder::Rewind()
+		{
+			File.clear();
+			File.seekg(DataOffset);
+			FramesLeft = FrameCount;
+			return File.good();
+		}
+
+		size_t WavDecoder::ReadRaw(size_t frameCount)
+		{
+			frameCount = std::min(frameCount, FramesLeft);
+			ReadBuffer.resize(frameCount * ChannelCount * BytesPerSample);
+			if (ReadBuffer.empty())
+				return 0;
+
+			File.read(ReadBuffer.data(), ReadBuffer.size());
+			const size_t readFrames = static_cast<size_t>(File.gcount()) / (BytesPerSample * ChannelCount);
+			FramesLeft = (readFrames == frameCount) ? (FramesLeft - readFrames) : (0);	//A truncated file ends where the data ends
+
+			return readFrames;
+		}
+
+		bool WavDecoder::ReadHeader()
+		{
+			char id[4];
+			uint32_t size = 0;
+			if (!File.read(id, 4) || std::memcmp(id, "RIFF", 4) != 0 || !ReadValue(File, size) || !File.read(id, 4) || std::memcmp(id, "WAVE", 4) != 0)
+			{
+				std::cerr << "ERROR! " << Path << " is not a WAV file.\n";
+				return false;
+			}
+
+			uint16_t format = 0, channels = 0, bitsPerSample = 0;
+			uint32_t sampleRate = 0;
+			bool bFormatFound = false;
+
+			while (File.read(id, 4) && ReadValue(File, size))
+			{
+				const std::streamoff chunkStart = File.tellg();
+
+				if (std::memcmp(id, "fmt ", 4) == 0 && size >= 16)
+				{
+					uint32_t byteRate;
+					uint16_t blockAlign;
+					ReadValue(File, format); ReadValue(File, channels); ReadValue(File, sampleRate); ReadValue(File, byteRate); ReadValue(File, blockAlign); ReadValue(File, bitsPerSample);
+
+					uint16_t extensionSize = 0, validBits, subFormat;
+					uint32_t channelMask;
+					if (format == WavFormatExtensible && size >= 26 && ReadValue(File, extensionSize) && extensionSize >= 10 && ReadValue(File, validBits) && ReadValue(File, channelMask) && ReadValue(File, subFormat))
+						format = subFormat;
+
+					bFormatFound = true;
+				}
+				else if (std::memcmp(id, "data", 4) == 0)
+				{
+					if (!bFormatFound)
+					{
+						std::cerr << "ERROR! WAV file " << Path << " has no format chunk before its data.\n";
+						return false;
+					}
+
+					if ((format != WavFormatPCM && format != WavFormatFloat) || (format == WavFormatPCM && (bitsPerSample % 8 != 0 || bitsPerSample == 0 || bitsPerSample > 32)) || (format == WavFormatFloat && bitsPerSample != 32))
+					{
+						std::cerr << "ERROR! Unsupported sample format of " << Path << ". Format: " << format << ", bit depth: " << bitsPerSample << ".\n";
+						return false;
+					}
+					if (channels != 1 && channels != 2)
+					{
+						std::cerr << "ERROR! Unsupported channel count of " << Path << ": " << channels << ".\n";
+						return false;
+					}
+
+					ChannelCount = channels;
+					SampleRate = sampleRate;
+					BytesPerSample = bitsPerSample / 8;
+					bFloatSamples = format == WavFormatFloat;
+					FrameCount = FramesLeft = size / (BytesPerSample * ChannelCount);
+					DataOffset = chunkStart;
+					return true;
+				}
+
+				File.seekg(chunkStart + size + (size % 2));	//Chunks are padded to an even size
+			}
+
+			std::cerr << "ERROR! WAV file " << Path << " has no data chunk.\n";
+			return false;
+		}
+
+		///////////////////////////////////////////
+		////////////////////OGG////////////////////
+		///////////////////////////////////////////
+
+		OggVorbisDecoder::OggVorbisDecoder(const std::string& path) :
+			AudioDecoder(path),
+			Vorbis(std::make_unique<VorbisStream>())
+		{
+			if (!Vorbis->Open(path))
+			{
+				Vorbis = nullptr;
+				return;
+			}
+
+			if (Vorbis->GetChannelCount() != 1 && Vorbis->GetChannelCount() != 2)
+			{
+				std::cerr << "ERROR! Unsupported channel count of " << path << ": " << Vorbis->GetChannelCount() << ".\n";
+				Vorbis = nullptr;
+				return;
+			}
+
+			ChannelCount = Vorbis->GetChannelCount();
+			SampleRate = Vorbis->GetSampleRate();
+			FrameCount = Vorbis->GetFrameCount();
+			bFloatSamples = true;	//Vorbis is decoded to floats
+		}
+
+		OggVorbisDecoder::~OggVorbisDecoder() = default;
+
+		bool OggVorbisDecoder::IsValid() const
+		{
+			return Vorbis != nullptr;
+		}
+
+		size_t OggVorbisDecoder::Read(int16_t* frames, size_t frameCount)
+		{
+			ConversionBuffer.resize(frameCount * ChannelCount);
+			const size_t readFrames = ReadFloat(ConversionBuffer.data(), frameCount);
+
+			for (size_t i = 0; i < readFrames * ChannelCount; i++)
+				frames[i] = ToInt16(ConversionBuffer[i]);
+
+			return readFrames;
+		}
+
+		size_t OggVorbisDecoder::ReadFloat(float* frames, size_t frameCount)
+		{
+			return (Vorbis) ? (Vorbis->Read(frames, frameCount)) : (0);
+		}
+
+		bool OggVorbisDecoder::Rewind()
+		{
+			return Vorbis && Vorbis->Rewind();
+		}
+	}
+}
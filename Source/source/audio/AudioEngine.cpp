@@ -35,6 +35,13 @@ namespace GEE
 
 			alListenerfv(AL_POSITION, glm::value_ptr(glm::vec3(0.0f)));
 			alListenerfv(AL_VELOCITY, glm::value_ptr(glm::vec3(0.0f)));
+
+			const bool floatSamples = alIsExtensionPresent("AL_EXT_FLOAT32") == AL_TRUE;
+			Buffers.SetFloatSamples(floatSamples);
+			if (!floatSamples)
+				std::cout << "INFO: AL_EXT_FLOAT32 is not supported. Float samples will be converted to 16-bit.\n";
+
+			Voices.Init();
 		}
 
 
@@ -52,30 +59,46 @@ namespace GEE
 			return ListenerTransformPtr;
 		}
 
-		void AudioEngine::Update()
+		void AudioEngine::Update(float deltaTime)
 		{
 			////////////////// Update listener position & orientation
-			if (!ListenerTransformPtr)
-				return;
+			glm::vec3 listenerPosition(0.0f);
+			if (ListenerTransformPtr)
+			{
+				listenerPosition = (glm::vec3)ListenerTransformPtr->GetWorldTransform().Pos();
+				alListenerfv(AL_POSITION, glm::value_ptr(listenerPosition));
 
-			alListenerfv(AL_POSITION, glm::value_ptr((glm::vec3)ListenerTransformPtr->GetWorldTransform().Pos()));
+				glm::vec3 orientationVecs[2] = { ListenerTransformPtr->GetWorldTransform().GetFrontVec(), glm::vec3(0.0f, 1.0f, 0.0f) };
+				alListenerfv(AL_ORIENTATION, &orientationVecs[0].x);
+			}
 
-			glm::vec3 orientationVecs[2] = { ListenerTransformPtr->GetWorldTransform().GetFrontVec(), glm::vec3(0.0f, 1.0f, 0.0f) };
-			alListenerfv(AL_ORIENTATION, &orientationVecs[0].x);
+			////////////////// Give the sources to the most audible voices
+			Voices.Update(deltaTime, listenerPosition);
 		}
 
-		void AudioEngine::AddBuffer(const SoundBuffer& buffer)
+		void AudioEngine::SetCacheFilesEnabled(bool enabled)
 		{
-			ALBuffers.push_back(buffer);
+			Buffers.SetCacheFilesEnabled(enabled);
 		}
 
 		SoundBuffer AudioEngine::FindBuffer(const std::string& path)
 		{
-			auto found = std::find_if(ALBuffers.begin(), ALBuffers.end(), [&](const SoundBuffer& buffer) { return path == buffer.Path; });
-			if (found == ALBuffers.end())
-				return SoundBuffer();
+			return Buffers.Find(path);
+		}
 
-			return *found;
+		SoundBuffer AudioEngine::AddBuffer(AudioDecoder& decoder)
+		{
+			return Buffers.Add(decoder);
+		}
+
+		void AudioEngine::ReleaseBuffer(const SoundBuffer& buffer)
+		{
+			Buffers.Release(buffer);
+		}
+
+		VoiceManager& AudioEngine::GetVoiceManager()
+		{
+			return Voices;
 		}
 
 		void AudioEngine::CheckError()
@@ -100,6 +123,8 @@ namespace GEE
 
 		AudioEngine::~AudioEngine()
 		{
+			Voices.Dispose();	//The sources must let go of the buffers before they are deleted
+			Buffers.Clear();	//While the context is still current
 			if (Context)
 				alcDestroyContext(Context);
 		}
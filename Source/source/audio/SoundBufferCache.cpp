@@ -0,0 +1,236 @@
+#include <audio/SoundBufferCache.h>
+#include <audio/AudioDecoder.h>
+#include <AL/alext.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <iostream>
+
+namespace GEE
+{
+	namespace Audio
+	{
+		namespace
+		{
+			constexpr char CacheFileMagic[4] = { 'G', 'E', 'D', 'A' };
+			constexpr unsigned int CacheFileVersion = 1;
+
+			struct CacheFileHeader
+			{
+				unsigned int Version;
+				uint64_t SourceSize;		//The size and the modification time of the decoded file - the cache file is stale if either changes
+				int64_t SourceWriteTime;
+				ALenum Format;
+				unsigned int SampleRate;
+				uint64_t DataSize;
+			};
+
+			bool GetSourceFileInfo(const std::string& path, uint64_t& size, int64_t& writeTime)
+			{
+				std::error_code error;
+				size = static_cast<uint64_t>(std::filesystem::file_size(path, error));
+				if (error)
+					return false;
+				writeTime = static_cast<int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+				return !error;
+			}
+		}
+
+		SoundBufferCache::SoundBufferCache(const std::string& directory) :
+			Directory(directory),
+			bFloatSamples(false),
+			bCacheFiles(false)
+		{
+		}
+
+		SoundBufferCache::~SoundBufferCache()
+		{
+			Clear();
+		}
+
+		void SoundBufferCache::SetFloatSamples(bool floatSamples)
+		{
+			bFloatSamples = floatSamples;
+		}
+
+		void SoundBufferCache::SetCacheFilesEnabled(bool enabled)
+		{
+			bCacheFiles = enabled;
+		}
+
+		uint64_t SoundBufferCache::HashPath(const std::string& path)	//FNV-1a
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (char c : path)
+			{
+				hash ^= static_cast<unsigned char>(c);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		SoundBuffer SoundBufferCache::Find(const std::string& path)
+		{
+			const uint64_t hash = HashPath(path);
+			auto found = Buffers.find(hash);
+			if (found != Buffers.end() && found->second.Buffer.Path == path)
+			{
+				found->second.RefCount++;
+				return found->second.Buffer;
+			}
+
+			if (bCacheFiles && found == Buffers.end())
+				return LoadCacheFile(hash, path);
+
+			return SoundBuffer();
+		}
+
+		SoundBuffer SoundBufferCache::Add(AudioDecoder& decoder)
+		{
+			SoundBuffer buffer = Find(decoder.GetPath());
+			if (buffer.IsValid())
+				return buffer;
+
+			const uint64_t hash = HashPath(decoder.GetPath());
+			const bool floatSamples = bFloatSamples && decoder.HasFloatSamples();
+			const size_t frameSize = decoder.GetChannelCount() * ((floatSamples) ? (sizeof(float)) : (sizeof(int16_t)));
+			size_t frameCount = 0;
+
+			std::vector<char> data(decoder.GetFrameCount() * frameSize);
+			if (floatSamples)
+				frameCount = decoder.ReadFloat(reinterpret_cast<float*>(data.data()), decoder.GetFrameCount());
+			else
+				frameCount = decoder.Read(reinterpret_cast<int16_t*>(data.data()), decoder.GetFrameCount());
+
+			if (frameCount == 0)
+			{
+				std::cerr << "ERROR! Can't decode " << decoder.GetPath() << ".\n";
+				return SoundBuffer();
+			}
+			data.resize(frameCount * frameSize);	//Shorter than expected if the file is truncated
+
+			if (decoder.GetChannelCount() == 2)
+				std::cerr << "INFO: Audio file " << decoder.GetPath() << " is stereo - it won't work with a 3D sound source.\n";
+			std::cout << decoder.GetPath() << ": " << frameCount << " frames,  samplerate: " << decoder.GetSampleRate() << ",  " << ((floatSamples) ? ("float") : ("16-bit")) << ",  length[s]: " << decoder.GetLengthInSeconds() << '\n';
+
+			if (bCacheFiles)
+				SaveCacheFile(hash, decoder.GetPath(), decoder.GetALFormat(floatSamples), data.data(), data.size(), decoder.GetSampleRate());
+
+			return AddBuffer(hash, decoder.GetPath(), decoder.GetALFormat(floatSamples), data.data(), data.size(), decoder.GetSampleRate());
+		}
+
+		void SoundBufferCache::Release(const SoundBuffer& buffer)
+		{
+			if (!buffer.IsValid())
+				return;
+
+			auto found = Buffers.find(HashPath(buffer.Path));
+			if (found == Buffers.end() || found->second.Buffer.ALIndex != buffer.ALIndex)	//Buffers whose path hashes collide are not cached
+			{
+				alDeleteBuffers(1, &buffer.ALIndex);
+				return;
+			}
+
+			if (--found->second.RefCount > 0)
+				return;
+
+			alDeleteBuffers(1, &found->second.Buffer.ALIndex);
+			Buffers.erase(found);
+		}
+
+		void SoundBufferCache::Clear()
+		{
+			for (auto& it : Buffers)
+				alDeleteBuffers(1, &it.second.Buffer.ALIndex);
+			Buffers.clear();
+		}
+
+		unsigned int SoundBufferCache::GetBufferCount() const
+		{
+			return static_cast<unsigned int>(Buffers.size());
+		}
+
+		SoundBuffer SoundBufferCache::AddBuffer(uint64_t hash, const std::string& path, ALenum format, const void* data, size_t size, unsigned int sampleRate)
+		{
+			SoundBuffer buffer;
+			buffer.Path = path;
+			alGenBuffers(1, &buffer.ALIndex);
+			alBufferData(buffer.ALIndex, format, data, static_cast<ALsizei>(size), static_cast<ALsizei>(sampleRate));
+
+			if (Buffers.find(hash) != Buffers.end())
+				std::cout << "INFO: The hash of " << path << " collides with the hash of " << Buffers[hash].Buffer.Path << ". The buffer will not be shared.\n";
+			else
+				Buffers[hash] = CachedBuffer{ buffer, 1 };
+
+			return buffer;
+		}
+
+		SoundBuffer SoundBufferCache::LoadCacheFile(uint64_t hash, const std::string& path)
+		{
+			std::ifstream file(GetCacheFilepath(hash), std::ios::binary);
+			if (!file.good())
+				return SoundBuffer();
+
+			char magic[sizeof(CacheFileMagic)];
+			CacheFileHeader header;
+			uint64_t sourceSize = 0;
+			int64_t sourceWriteTime = 0;
+			if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), CacheFileMagic) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+				header.Version != CacheFileVersion || !GetSourceFileInfo(path, sourceSize, sourceWriteTime) || header.SourceSize != sourceSize || header.SourceWriteTime != sourceWriteTime ||
+				((header.Format == AL_FORMAT_MONO_FLOAT32 || header.Format == AL_FORMAT_STEREO_FLOAT32) && !bFloatSamples))
+				return SoundBuffer();
+
+			std::string storedPath;
+			uint32_t pathLength = 0;
+			if (!file.read(reinterpret_cast<char*>(&pathLength), sizeof(pathLength)))
+				return SoundBuffer();
+			storedPath.resize(pathLength);
+			if (!file.read(&storedPath[0], pathLength) || storedPath != path)	//Another file whose path has the same hash
+				return SoundBuffer();
+
+			std::vector<char> data(header.DataSize);
+			if (!file.read(data.data(), data.size()))
+			{
+				std::cout << "ERROR! Decoded audio cache file " << GetCacheFilepath(hash) << " is truncated. " << path << " will be decoded again.\n";
+				return SoundBuffer();
+			}
+
+			return AddBuffer(hash, path, header.Format, data.data(), data.size(), header.SampleRate);
+		}
+
+		bool SoundBufferCache::SaveCacheFile(uint64_t hash, const std::string& path, ALenum format, const void* data, size_t size, unsigned int sampleRate) const
+		{
+			CacheFileHeader header{ CacheFileVersion, 0, 0, format, sampleRate, size };
+			if (!GetSourceFileInfo(path, header.SourceSize, header.SourceWriteTime))
+				return false;
+
+			std::error_code error;
+			std::filesystem::create_directories(Directory, error);
+
+			std::ofstream file(GetCacheFilepath(hash), std::ios::binary);
+			if (!file.good())
+			{
+				std::cout << "ERROR! Could not write decoded audio cache file " << GetCacheFilepath(hash) << ".\n";
+				return false;
+			}
+
+			const uint32_t pathLength = static_cast<uint32_t>(path.size());
+			file.write(CacheFileMagic, sizeof(CacheFileMagic));
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(&pathLength), sizeof(pathLength));
+			file.write(path.data(), pathLength);
+			file.write(static_cast<const char*>(data), size);
+
+			return file.good();
+		}
+
+		std::string SoundBufferCache::GetCacheFilepath(uint64_t hash) const
+		{
+			std::stringstream filepath;
+			filepath << Directory << std::hex << std::setw(16) << std::setfill('0') << hash << ".pcm";
+			return filepath.str();
+		}
+	}
+}
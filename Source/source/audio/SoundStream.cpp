@@ -0,0 +1,255 @@
+#include <audio/SoundStream.h>
+#include <AL/alc.h>
+#include <AL/alext.h>
+#include <algorithm>
+#include <iostream>
+
+namespace GEE
+{
+	namespace Audio
+	{
+		SoundStream::SoundStream(JobSystem& jobs, std::unique_ptr<AudioDecoder> decoder, unsigned int bufferCount, float bufferDuration) :
+			Jobs(jobs),
+			Decoder(std::move(decoder)),
+			Buffers(std::max(bufferCount, 2u), 0),
+			FramesPerBuffer(std::max(static_cast<size_t>(Decoder->GetSampleRate() * bufferDuration), static_cast<size_t>(1))),
+			DecodedChunks(Buffers.size()),
+			DecodedChunkCount(0),
+			bEndOfStream(false),
+			bLoop(false),
+			bPlaying(false)
+		{
+			alGenBuffers(static_cast<ALsizei>(Buffers.size()), Buffers.data());
+			FreeBuffers = Buffers;
+
+			StartDecoding(static_cast<unsigned int>(Buffers.size()));
+		}
+
+		SoundStream::~SoundStream()
+		{
+			WaitForDecoding();
+			alDeleteBuffers(static_cast<ALsizei>(Buffers.size()), Buffers.data());
+		}
+
+		const std::string& SoundStream::GetPath() const
+		{
+			return Decoder->GetPath();
+		}
+
+		void SoundStream::SetLoop(bool loop)
+		{
+			bLoop = loop;	//Read by the next decoding job
+		}
+
+		bool SoundStream::IsPlaying() const
+		{
+			return bPlaying;
+		}
+
+		void SoundStream::Play(ALuint source)
+		{
+			if (bPlaying)
+				return;
+
+			if (FreeBuffers.size() == Buffers.size())	//Nothing is queued yet - wait for the first buffers
+				WaitForDecoding();
+			QueueDecodedChunks(source);
+
+			alSourcePlay(source);
+			bPlaying = true;
+		}
+
+		void SoundStream::Pause(ALuint source)
+		{
+			alSourcePause(source);
+			bPlaying = false;
+		}
+
+		void SoundStream::Stop(ALuint source)
+		{
+			if (source != 0)
+			{
+				alSourceStop(source);
+				UnqueueProcessedBuffers(source);	//All queued buffers count as processed once the source is stopped
+			}
+			bPlaying = false;
+
+			WaitForDecoding();
+			DecodedChunkCount = 0;
+			bEndOfStream = false;
+			if (!Decoder->Rewind())
+				std::cerr << "ERROR! Can't rewind audio stream " << GetPath() << ".\n";
+
+			StartDecoding(static_cast<unsigned int>(FreeBuffers.size()));
+		}
+
+		void SoundStream::Update(ALuint source)
+		{
+			if (!bPlaying)
+				return;
+
+			UnqueueProcessedBuffers(source);
+			QueueDecodedChunks(source);
+
+			ALint state = AL_STOPPED, queued = 0;
+			alGetSourcei(source, AL_SOURCE_STATE, &state);
+			if (state == AL_PLAYING)
+				return;
+
+			alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
+			if (queued > 0)
+				alSourcePlay(source);	//The source ran out of data before the decoder caught up
+			else if (DecodeCounter.IsDone() && bEndOfStream && DecodedChunkCount == 0)	//The job writes bEndOfStream and DecodedChunkCount, so they are read only after it is done
+				Stop(source);	//Finished - rewind, so the stream can be played again
+		}
+
+		void SoundStream::StartDecoding(unsigned int chunkCount)
+		{
+			if (chunkCount == 0 || bEndOfStream)
+				return;
+
+			const bool loop = bLoop;
+			Jobs.Schedule([this, chunkCount, loop]()
+			{
+				const unsigned int channelCount = Decoder->GetChannelCount();
+				DecodedChunkCount = 0;
+
+				for (unsigned int i = 0; i < chunkCount && !bEndOfStream; i++)
+				{
+					std::vector<int16_t>& chunk = DecodedChunks[i];
+					chunk.resize(FramesPerBuffer * channelCount);	//Never reallocates - the capacity is kept
+					size_t decodedFrames = 0;
+					while (decodedFrames < FramesPerBuffer)
+					{
+						const size_t readFrames = Decoder->Read(chunk.data() + decodedFrames * channelCount, FramesPerBuffer - decodedFrames);
+						decodedFrames += readFrames;
+						if (decodedFrames == FramesPerBuffer)
+							break;
+
+						if (!loop || (readFrames == 0 && decodedFrames == 0) || !Decoder->Rewind())	//An empty looped stream would never stop
+						{
+							bEndOfStream = true;
+							break;
+						}
+					}
+
+					if (decodedFrames == 0)
+						break;
+
+					chunk.resize(decodedFrames * channelCount);	//Only the last chunk of the stream can be shorter
+					DecodedChunkCount++;
+				}
+			}, &DecodeCounter);
+		}
+
+		void SoundStream::WaitForDecoding()
+		{
+			if (!DecodeCounter.IsDone())
+				Jobs.Wait(DecodeCounter);
+		}
+
+		void SoundStream::QueueDecodedChunks(ALuint source)
+		{
+			if (!DecodeCounter.IsDone())
+				return;
+
+			for (unsigned int i = 0; i < DecodedChunkCount && !FreeBuffers.empty(); i++)
+			{
+				std::vector<int16_t>& chunk = DecodedChunks[i];
+				const ALuint buffer = FreeBuffers.back();
+				FreeBuffers.pop_back();
+
+				alBufferData(buffer, Decoder->GetALFormat(), chunk.data(), static_cast<ALsizei>(chunk.size() * sizeof(int16_t)), static_cast<ALsizei>(Decoder->GetSampleRate()));
+				alSourceQueueBuffers(source, 1, &buffer);
+			}
+			DecodedChunkCount = 0;
+
+			StartDecoding(static_cast<unsigned int>(FreeBuffers.size()));
+		}
+
+		void SoundStream::UnqueueProcessedBuffers(ALuint source)
+		{
+			ALint processed = 0;
+			alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+			if (processed <= 0)
+				return;
+
+			const size_t freeCount = FreeBuffers.size();
+			FreeBuffers.resize(freeCount + static_cast<size_t>(processed));
+			alSourceUnqueueBuffers(source, processed, FreeBuffers.data() + freeCount);
+		}
+
+		bool SoundStream::ValidatePlayback(JobSystem& jobs, const std::string& path)
+		{
+			if (alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback") != ALC_TRUE)
+			{
+				std::cerr << "ERROR! The OpenAL implementation has no loopback device (ALC_SOFT_loopback), so streaming cannot be validated.\n";
+				return false;
+			}
+			auto loopbackOpenDevice = reinterpret_cast<LPALCLOOPBACKOPENDEVICESOFT>(alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT"));
+			auto renderSamples = reinterpret_cast<LPALCRENDERSAMPLESSOFT>(alcGetProcAddress(nullptr, "alcRenderSamplesSOFT"));
+
+			std::unique_ptr<AudioDecoder> decoder = AudioDecoder::Open(path);
+			if (!decoder)
+				return false;
+			const size_t frameCount = decoder->GetFrameCount();
+			const ALCint sampleRate = static_cast<ALCint>(decoder->GetSampleRate());	//Played at the rate of the file, so every frame of the file is one rendered frame
+
+			ALCdevice* device = loopbackOpenDevice(nullptr);
+			const ALCint attributes[] = { ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT, ALC_FORMAT_TYPE_SOFT, ALC_SHORT_SOFT, ALC_FREQUENCY, sampleRate, 0 };
+			ALCcontext* context = (device) ? (alcCreateContext(device, attributes)) : (nullptr);
+			if (!context)
+			{
+				std::cerr << "ERROR! Can't create an OpenAL loopback device to validate streaming.\n";
+				if (device)
+					alcCloseDevice(device);
+				return false;
+			}
+			ALCcontext* previousContext = alcGetCurrentContext();
+			alcMakeContextCurrent(context);
+
+			const size_t renderedBlockFrames = 1024;
+			size_t renderedFrames = 0;
+			bool bFinished = false;
+			{
+				SoundStream stream(jobs, std::move(decoder));
+				ALuint source = 0;
+				alGenSources(1, &source);
+
+				std::vector<int16_t> mixed(renderedBlockFrames * 2);
+				stream.Play(source);
+				while (stream.IsPlaying() && renderedFrames < frameCount * 2 + static_cast<size_t>(sampleRate))	//Give up if the stream plays for much longer than the file lasts
+				{
+					stream.WaitForDecoding();	//Rendering is faster than real time - let the decoder keep up, so the check is deterministic
+					stream.Update(source);
+					if (!stream.IsPlaying())
+						break;
+
+					renderSamples(device, mixed.data(), static_cast<ALCsizei>(renderedBlockFrames));
+					renderedFrames += renderedBlockFrames;
+				}
+				bFinished = !stream.IsPlaying();
+
+				stream.Stop(source);
+				alDeleteSources(1, &source);
+			}
+
+			alcMakeContextCurrent(previousContext);
+			alcDestroyContext(context);
+			alcCloseDevice(device);
+
+			if (!bFinished)
+			{
+				std::cerr << "ERROR! Stream " << path << " did not finish after " << renderedFrames << " frames (the file has " << frameCount << ").\n";
+				return false;
+			}
+			if (renderedFrames + renderedBlockFrames < frameCount)
+			{
+				std::cerr << "ERROR! Stream " << path << " finished after " << renderedFrames << " frames, but the file has " << frameCount << " - decoded chunks were lost.\n";
+				return false;
+			}
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,299 @@
+#include <audio/VoiceManager.h>
+#include <audio/SoundStream.h>
+#include <math/Transform.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace GEE
+{
+	namespace Audio
+	{
+		VoiceManager::VoiceManager(unsigned int maxSourceCount, float audibilityThreshold) :
+			DeferUpdates(nullptr),
+			ProcessUpdates(nullptr),
+			MaxSourceCount(maxSourceCount),
+			AudibilityThreshold(audibilityThreshold)
+		{
+		}
+
+		VoiceManager::~VoiceManager()
+		{
+			Dispose();
+		}
+
+		void VoiceManager::Init()
+		{
+			alGetError();	//Clear the previous error, so we can tell when the device runs out of sources
+			for (unsigned int i = 0; i < MaxSourceCount; i++)
+			{
+				ALuint source = 0;
+				alGenSources(1, &source);
+				if (alGetError() != AL_NO_ERROR || source == 0)
+					break;
+
+				alSourcei(source, AL_SOURCE_RELATIVE, AL_FALSE);
+				Sources.push_back(source);
+			}
+			FreeSources = Sources;
+
+			if (Sources.size() < MaxSourceCount)
+				std::cout << "INFO: The audio device provides only " << Sources.size() << " of " << MaxSourceCount << " sources.\n";
+
+			if (alIsExtensionPresent("AL_SOFT_deferred_updates") == AL_TRUE)
+			{
+				DeferUpdates = reinterpret_cast<LPALDEFERUPDATESSOFT>(alGetProcAddress("alDeferUpdatesSOFT"));
+				ProcessUpdates = reinterpret_cast<LPALPROCESSUPDATESSOFT>(alGetProcAddress("alProcessUpdatesSOFT"));
+				if (!DeferUpdates || !ProcessUpdates)
+					DeferUpdates = nullptr, ProcessUpdates = nullptr;
+			}
+		}
+
+		void VoiceManager::Dispose()
+		{
+			while (!Voices.empty())
+				Stop(*Voices.back());
+
+			if (!Sources.empty())
+				alDeleteSources(static_cast<ALsizei>(Sources.size()), Sources.data());
+			Sources.clear();
+			FreeSources.clear();
+		}
+
+		void VoiceManager::Play(Voice& voice)
+		{
+			if (voice.State == VoiceState::PLAYING)
+				return;
+
+			if (voice.State == VoiceState::STOPPED)
+			{
+				voice.Offset = 0.0f;
+				voice.Length = 0.0f;
+				if (!voice.Stream && voice.Buffer.IsValid())
+				{
+					ALint size = 0, frequency = 0, channels = 0, bits = 0;
+					alGetBufferi(voice.Buffer.ALIndex, AL_SIZE, &size);
+					alGetBufferi(voice.Buffer.ALIndex, AL_FREQUENCY, &frequency);
+					alGetBufferi(voice.Buffer.ALIndex, AL_CHANNELS, &channels);
+					alGetBufferi(voice.Buffer.ALIndex, AL_BITS, &bits);
+					if (frequency > 0 && channels > 0 && bits > 0)
+						voice.Length = static_cast<float>(size) / static_cast<float>(channels * bits / 8) / static_cast<float>(frequency);
+				}
+
+				Voices.push_back(&voice);
+			}
+			else if (!voice.IsVirtual())	//Only paused streams keep their source
+				voice.Stream->Play(voice.Source);
+
+			voice.State = VoiceState::PLAYING;
+		}
+
+		void VoiceManager::Pause(Voice& voice)
+		{
+			if (voice.State != VoiceState::PLAYING)
+				return;
+
+			voice.State = VoiceState::PAUSED;
+			if (voice.IsVirtual())
+				return;
+
+			if (voice.Stream)
+				voice.Stream->Pause(voice.Source);
+			else
+				ReleaseSource(voice);
+		}
+
+		void VoiceManager::Stop(Voice& voice)
+		{
+			if (voice.State == VoiceState::STOPPED)
+				return;
+
+			if (voice.Stream)
+			{
+				voice.Stream->Stop(voice.Source);	//Rewinds the stream even if it has no source
+				if (!voice.IsVirtual())
+				{
+					alSourcei(voice.Source, AL_BUFFER, 0);	//Clears the queue of the stream
+					FreeSources.push_back(voice.Source);
+					voice.Source = 0;
+				}
+			}
+			else if (!voice.IsVirtual())
+				ReleaseSource(voice);
+
+			voice.State = VoiceState::STOPPED;
+			voice.Offset = 0.0f;
+			voice.Audibility = 0.0f;
+			EraseVoice(voice);
+		}
+
+		void VoiceManager::SetLoop(Voice& voice, bool loop)
+		{
+			voice.bLoop = loop;
+			if (voice.Stream)
+				voice.Stream->SetLoop(loop);
+			else if (!voice.IsVirtual())
+				alSourcei(voice.Source, AL_LOOPING, (loop) ? (AL_TRUE) : (AL_FALSE));
+		}
+
+		void VoiceManager::Update(float deltaTime, const glm::vec3& listenerPosition)
+		{
+			if (DeferUpdates)
+				DeferUpdates();
+
+			////////////////// Find the voices that have ended and compute the audibility of the rest
+			RankedVoices.clear();
+			unsigned int streamSourceCount = 0;
+			for (size_t i = 0; i < Voices.size();)
+			{
+				Voice& voice = *Voices[i];
+				bool bEnded = false;
+				if (voice.State == VoiceState::PLAYING)
+				{
+					if (voice.Stream)
+					{
+						if (!voice.IsVirtual())
+						{
+							voice.Stream->Update(voice.Source);
+							bEnded = !voice.Stream->IsPlaying();
+						}
+					}
+					else if (voice.IsVirtual())
+						AdvanceVirtualVoice(voice, deltaTime, bEnded);
+					else
+					{
+						ALint state = AL_PLAYING;
+						alGetSourcei(voice.Source, AL_SOURCE_STATE, &state);
+						bEnded = state == AL_STOPPED;
+					}
+				}
+
+				if (bEnded)
+				{
+					Stop(voice);	//Erases the voice - Voices[i] is another voice now
+					continue;
+				}
+
+				const glm::vec3 position = (voice.TransformPtr) ? (static_cast<glm::vec3>(voice.TransformPtr->GetWorldTransform().Pos())) : (listenerPosition);
+				voice.Audibility = (voice.State == VoiceState::PLAYING) ? (GetAttenuation(glm::distance(position, listenerPosition), voice.ReferenceDistance, voice.MaxDistance) * voice.Gain * voice.Priority) : (0.0f);
+
+				if (voice.Stream)
+					streamSourceCount += (!voice.IsVirtual() || voice.State == VoiceState::PLAYING) ? (1) : (0);
+				else if (voice.State == VoiceState::PLAYING)
+					RankedVoices.push_back(&voice);
+				i++;
+			}
+
+			////////////////// The most audible voices get the sources left after the streams
+			const size_t realVoiceCount = std::min(RankedVoices.size(), Sources.size() - std::min(static_cast<size_t>(streamSourceCount), Sources.size()));
+			auto byAudibility = [](const Voice* lhs, const Voice* rhs) { return lhs->Audibility > rhs->Audibility; };
+			if (realVoiceCount < RankedVoices.size())
+				std::nth_element(RankedVoices.begin(), RankedVoices.begin() + realVoiceCount, RankedVoices.end(), byAudibility);
+
+			for (size_t i = 0; i < RankedVoices.size(); i++)	//Release the sources first, so they can be given to other voices
+				if (!RankedVoices[i]->IsVirtual() && (i >= realVoiceCount || RankedVoices[i]->Audibility < AudibilityThreshold))
+					ReleaseSource(*RankedVoices[i]);
+
+			for (Voice* voice : Voices)
+				if (voice->Stream && voice->State == VoiceState::PLAYING && voice->IsVirtual() && !FreeSources.empty())
+					AssignSource(*voice);
+
+			for (size_t i = 0; i < realVoiceCount && !FreeSources.empty(); i++)
+				if (RankedVoices[i]->IsVirtual() && RankedVoices[i]->Audibility >= AudibilityThreshold)
+					AssignSource(*RankedVoices[i]);
+
+			////////////////// Send the positions and gains of the real voices in one batch
+			for (Voice* voice : Voices)
+			{
+				if (voice->IsVirtual())
+					continue;
+
+				const glm::vec3 position = (voice->TransformPtr) ? (static_cast<glm::vec3>(voice->TransformPtr->GetWorldTransform().Pos())) : (listenerPosition);
+				alSourcefv(voice->Source, AL_POSITION, glm::value_ptr(position));
+				alSourcef(voice->Source, AL_GAIN, voice->Gain);
+			}
+
+			if (ProcessUpdates)
+				ProcessUpdates();
+		}
+
+		float VoiceManager::GetAttenuation(float distance, float referenceDistance, float maxDistance)
+		{
+			if (distance > maxDistance)
+				return 0.0f;
+
+			referenceDistance = std::max(referenceDistance, 0.0001f);
+			return referenceDistance / std::max(distance, referenceDistance);	//ref / (ref + rolloff * (distance - ref)) with rolloff = 1
+		}
+
+		unsigned int VoiceManager::GetSourceCount() const
+		{
+			return static_cast<unsigned int>(Sources.size());
+		}
+
+		unsigned int VoiceManager::GetVoiceCount() const
+		{
+			return static_cast<unsigned int>(Voices.size());
+		}
+
+		unsigned int VoiceManager::GetRealVoiceCount() const
+		{
+			return static_cast<unsigned int>(Sources.size() - FreeSources.size());
+		}
+
+		void VoiceManager::AdvanceVirtualVoice(Voice& voice, float deltaTime, bool& ended)
+		{
+			voice.Offset += deltaTime;
+			if (voice.Offset < voice.Length)
+				return;
+
+			if (voice.bLoop && voice.Length > 0.0f)
+				voice.Offset = std::fmod(voice.Offset, voice.Length);
+			else
+				ended = true;
+		}
+
+		void VoiceManager::AssignSource(Voice& voice)
+		{
+			voice.Source = FreeSources.back();
+			FreeSources.pop_back();
+
+			alSourcef(voice.Source, AL_REFERENCE_DISTANCE, voice.ReferenceDistance);
+			alSourcef(voice.Source, AL_MAX_DISTANCE, voice.MaxDistance);
+			alSourcef(voice.Source, AL_GAIN, voice.Gain);
+
+			if (voice.Stream)
+			{
+				alSourcei(voice.Source, AL_LOOPING, AL_FALSE);	//Streams loop by rewinding their decoders
+				voice.Stream->Play(voice.Source);
+				return;
+			}
+
+			alSourcei(voice.Source, AL_BUFFER, voice.Buffer.ALIndex);
+			alSourcei(voice.Source, AL_LOOPING, (voice.bLoop) ? (AL_TRUE) : (AL_FALSE));
+			alSourcef(voice.Source, AL_SEC_OFFSET, voice.Offset);
+			alSourcePlay(voice.Source);
+		}
+
+		void VoiceManager::ReleaseSource(Voice& voice)
+		{
+			alGetSourcef(voice.Source, AL_SEC_OFFSET, &voice.Offset);
+			alSourceStop(voice.Source);
+			alSourcei(voice.Source, AL_BUFFER, 0);
+
+			FreeSources.push_back(voice.Source);
+			voice.Source = 0;
+		}
+
+		void VoiceManager::EraseVoice(Voice& voice)
+		{
+			auto found = std::find(Voices.begin(), Voices.end(), &voice);
+			if (found == Voices.end())
+				return;
+
+			*found = Voices.back();
+			Voices.pop_back();
+		}
+	}
+}
@@ -0,0 +1,1221 @@
+#include <audio/VorbisStream.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace GEE
+{
+	namespace Audio
+	{
+		namespace
+		{
+			constexpr uint32_t CodebookSyncPattern = 0x564342;
+			constexpr unsigned int MaxFloorValues = 65;	//The limit of floor type 1 set by the specification
+			constexpr uint64_t MaxCodebookValues = 1 << 24;	//Entries times dimensions; far more than any encoder uses, but it keeps a corrupt header from allocating gigabytes
+			constexpr double Pi = 3.14159265358979323846;
+
+			const float Floor1InverseDB[256] =	//floor1_inverse_dB_table of the specification
+			{
+				1.06498632e-07f, 1.13419510e-07f, 1.20790148e-07f, 1.28639783e-07f, 1.36999503e-07f, 1.45902504e-07f, 1.55384086e-07f, 1.65481808e-07f,
+				1.76235744e-07f, 1.87688556e-07f, 1.99885605e-07f, 2.12875307e-07f, 2.26709133e-07f, 2.41441967e-07f, 2.57132228e-07f, 2.73842119e-07f,
+				2.91637917e-07f, 3.10590224e-07f, 3.30774100e-07f, 3.52269666e-07f, 3.75162131e-07f, 3.99542301e-07f, 4.25506812e-07f, 4.53158634e-07f,
+				4.82607447e-07f, 5.13970008e-07f, 5.47370632e-07f, 5.82941880e-07f, 6.20824721e-07f, 6.61169395e-07f, 7.04135914e-07f, 7.49894639e-07f,
+				7.98627013e-07f, 8.50526305e-07f, 9.05798288e-07f, 9.64662149e-07f, 1.02735135e-06f, 1.09411440e-06f, 1.16521608e-06f, 1.24093845e-06f,
+				1.32158164e-06f, 1.40746545e-06f, 1.49893049e-06f, 1.59633942e-06f, 1.70007854e-06f, 1.81055918e-06f, 1.92821949e-06f, 2.05352603e-06f,
+				2.18697573e-06f, 2.32909770e-06f, 2.48045581e-06f, 2.64164964e-06f, 2.81331904e-06f, 2.99614430e-06f, 3.19085052e-06f, 3.39821008e-06f,
+				3.61904495e-06f, 3.85423073e-06f, 4.10470057e-06f, 4.37144718e-06f, 4.65552830e-06f, 4.95807080e-06f, 5.28027385e-06f, 5.62341620e-06f,
+				5.98885708e-06f, 6.37804669e-06f, 6.79252844e-06f, 7.23394533e-06f, 7.70404768e-06f, 8.20469995e-06f, 8.73788758e-06f, 9.30572514e-06f,
+				9.91046363e-06f, 1.05545014e-05f, 1.12403923e-05f, 1.19708557e-05f, 1.27487892e-05f, 1.35772780e-05f, 1.44596061e-05f, 1.53992714e-05f,
+				1.64000048e-05f, 1.74657689e-05f, 1.86007928e-05f, 1.98095768e-05f, 2.10969138e-05f, 2.24679115e-05f, 2.39280016e-05f, 2.54829774e-05f,
+				2.71390054e-05f, 2.89026502e-05f, 3.07809096e-05f, 3.27812268e-05f, 3.49115326e-05f, 3.71802817e-05f, 3.95964671e-05f, 4.21696677e-05f,
+				4.49100917e-05f, 4.78286020e-05f, 5.09367746e-05f, 5.42469315e-05f, 5.77722021e-05f, 6.15265672e-05f, 6.55249096e-05f, 6.97830837e-05f,
+				7.43179844e-05f, 7.91475832e-05f, 8.42910376e-05f, 8.97687496e-05f, 9.56024232e-05f, 1.01815211e-04f, 1.08431741e-04f, 1.15478237e-04f,
+				1.22982674e-04f, 1.30974775e-04f, 1.39486248e-04f, 1.48550855e-04f, 1.58204537e-04f, 1.68485552e-04f, 1.79434690e-04f, 1.91095358e-04f,
+				2.03513817e-04f, 2.16739296e-04f, 2.30824226e-04f, 2.45824485e-04f, 2.61799549e-04f, 2.78812746e-04f, 2.96931568e-04f, 3.16227874e-04f,
+				3.36778146e-04f, 3.58663878e-04f, 3.81971884e-04f, 4.06794570e-04f, 4.33230365e-04f, 4.61384101e-04f, 4.91367478e-04f, 5.23299270e-04f,
+				5.57306223e-04f, 5.93523087e-04f, 6.32093579e-04f, 6.73170609e-04f, 7.16916984e-04f, 7.63506279e-04f, 8.13123246e-04f, 8.65964568e-04f,
+				9.22239851e-04f, 9.82172205e-04f, 1.04599923e-03f, 1.11397426e-03f, 1.18636654e-03f, 1.26346329e-03f, 1.34557020e-03f, 1.43301289e-03f,
+				1.52613816e-03f, 1.62531529e-03f, 1.73093739e-03f, 1.84342347e-03f, 1.96321961e-03f, 2.09080055e-03f, 2.22667260e-03f, 2.37137428e-03f,
+				2.52547953e-03f, 2.68959929e-03f, 2.86438479e-03f, 3.05052870e-03f, 3.24876909e-03f, 3.45989247e-03f, 3.68473586e-03f, 3.92419053e-03f,
+				4.17920668e-03f, 4.45079478e-03f, 4.74003283e-03f, 5.04806684e-03f, 5.37611870e-03f, 5.72548900e-03f, 6.09756354e-03f, 6.49381755e-03f,
+				6.91582263e-03f, 7.36525143e-03f, 7.84388743e-03f, 8.35362729e-03f, 8.89649242e-03f, 9.47463699e-03f, 1.00903520e-02f, 1.07460804e-02f,
+				1.14444206e-02f, 1.21881440e-02f, 1.29801976e-02f, 1.38237253e-02f, 1.47220679e-02f, 1.56787913e-02f, 1.66976862e-02f, 1.77827962e-02f,
+				1.89384222e-02f, 2.01691482e-02f, 2.14798544e-02f, 2.28757355e-02f, 2.43623294e-02f, 2.59455312e-02f, 2.76316181e-02f, 2.94272769e-02f,
+				3.13396268e-02f, 3.33762504e-02f, 3.55452262e-02f, 3.78551558e-02f, 4.03151996e-02f, 4.29351069e-02f, 4.57252748e-02f, 4.86967564e-02f,
+				5.18613495e-02f, 5.52315898e-02f, 5.88208511e-02f, 6.26433641e-02f, 6.67142794e-02f, 7.10497499e-02f, 7.56669641e-02f, 8.05842280e-02f,
+				8.58210474e-02f, 9.13981795e-02f, 9.73377451e-02f, 1.03663303e-01f, 1.10399932e-01f, 1.17574342e-01f, 1.25214979e-01f, 1.33352146e-01f,
+				1.42018124e-01f, 1.51247263e-01f, 1.61076173e-01f, 1.71543807e-01f, 1.82691678e-01f, 1.94564015e-01f, 2.07207873e-01f, 2.20673427e-01f,
+				2.35014021e-01f, 2.50286549e-01f, 2.66551584e-01f, 2.83873618e-01f, 3.02321315e-01f, 3.21967870e-01f, 3.42891127e-01f, 3.65174145e-01f,
+				3.88905197e-01f, 4.14178461e-01f, 4.41094130e-01f, 4.69758898e-01f, 5.00286460e-01f, 5.32797933e-01f, 5.67422092e-01f, 6.04296386e-01f,
+				6.43566966e-01f, 6.85389578e-01f, 7.29930043e-01f, 7.77365029e-01f, 8.27882588e-01f, 8.81683052e-01f, 9.38979805e-01f, 1.00000000e+00f
+			};
+
+			unsigned int ILog(uint32_t value)	//The position of the highest set bit, counted from 1 (0 for 0)
+			{
+				unsigned int bits = 0;
+				for (; value > 0; value >>= 1)
+					bits++;
+				return bits;
+			}
+
+			float UnpackFloat(uint32_t value)	//float32_unpack of the specification
+			{
+				const double mantissa = static_cast<double>(value & 0x1FFFFF);
+				const int exponent = static_cast<int>((value & 0x7FE00000) >> 21);
+				return static_cast<float>(std::ldexp((value & 0x80000000) ? (-mantissa) : (mantissa), exponent - 788));
+			}
+
+			uint32_t Lookup1Values(uint32_t entryCount, uint32_t dimensions)	//The greatest value whose dimensions-th power is not greater than entryCount
+			{
+				uint32_t values = static_cast<uint32_t>(std::floor(std::pow(static_cast<double>(entryCount), 1.0 / static_cast<double>(dimensions))));
+				while (std::pow(static_cast<double>(values + 1), static_cast<double>(dimensions)) <= static_cast<double>(entryCount))	//pow may be off by one
+					values++;
+				while (values > 0 && std::pow(static_cast<double>(values), static_cast<double>(dimensions)) > static_cast<double>(entryCount))
+					values--;
+				return values;
+			}
+
+			int RenderPoint(int x0, int y0, int x1, int y1, int x)
+			{
+				const int dy = y1 - y0, adx = x1 - x0;
+				const int offset = std::abs(dy) * (x - x0) / adx;
+				return (dy < 0) ? (y0 - offset) : (y0 + offset);
+			}
+
+			void RenderLine(int x0, int y0, int x1, int y1, float* curve, int n)	//Writes the inverse dB of the line from x0 (inclusive) to x1 (exclusive), clipped to n
+			{
+				const int dy = y1 - y0, adx = x1 - x0;
+				const int base = dy / adx;
+				const int sy = (dy < 0) ? (base - 1) : (base + 1);
+				const int ady = std::abs(dy) - std::abs(base) * adx;
+
+				int y = y0, error = 0;
+				if (x0 < n)
+					curve[x0] = Floor1InverseDB[std::clamp(y, 0, 255)];
+				for (int x = x0 + 1; x < x1 && x < n; x++)
+				{
+					error += ady;
+					if (error >= adx)
+					{
+						error -= adx;
+						y += sy;
+					}
+					else
+						y += base;
+					curve[x] = Floor1InverseDB[std::clamp(y, 0, 255)];
+				}
+			}
+		}
+
+		class VorbisStream::BitReader	//Reads the bits of a packet, least significant bit first
+		{
+		public:
+			BitReader(const std::vector<uint8_t>& data, size_t firstByte = 0) :
+				Data(data),
+				Position(firstByte * 8),
+				bEndOfPacket(false)
+			{
+			}
+
+			uint32_t Read(unsigned int bitCount)	//At most 32 bits; returns 0 and sets the end of packet condition if the packet is too short
+			{
+				if (Position + bitCount > Data.size() * 8)
+				{
+					Position = Data.size() * 8;
+					bEndOfPacket = true;
+					return 0;
+				}
+
+				uint32_t value = 0;
+				for (unsigned int read = 0; read < bitCount;)
+				{
+					const unsigned int offset = static_cast<unsigned int>(Position & 7);
+					const unsigned int count = std::min(8 - offset, bitCount - read);
+					value |= static_cast<uint32_t>((Data[Position >> 3] >> offset) & ((1u << count) - 1)) << read;
+					read += count;
+					Position += count;
+				}
+
+				return value;
+			}
+
+			int ReadBit()	//-1 at the end of the packet
+			{
+				if (Position >= Data.size() * 8)
+				{
+					bEndOfPacket = true;
+					return -1;
+				}
+
+				const int bit = (Data[Position >> 3] >> (Position & 7)) & 1;
+				Position++;
+				return bit;
+			}
+
+			bool IsEndOfPacket() const
+			{
+				return bEndOfPacket;
+			}
+
+		private:
+			const std::vector<uint8_t>& Data;
+			size_t Position;
+			bool bEndOfPacket;
+		};
+
+		struct VorbisStream::Codebook
+		{
+			bool BuildTree(const std::vector<uint8_t>& lengths);	//Assigns the codewords as described in the specification; false if the lengths are overspecified
+
+			int DecodeScalar(BitReader& reader) const	//-1 at the end of the packet or if the codeword is not used
+			{
+				for (int32_t node = 0;;)
+				{
+					const int bit = reader.ReadBit();
+					if (bit < 0)
+						return -1;
+
+					const int32_t child = Tree[node * 2 + bit];
+					if (child < 0)
+						return -child - 1;
+					if (child == 0)
+						return -1;
+					node = child;
+				}
+			}
+
+			const float* DecodeVector(BitReader& reader) const	//nullptr at the end of the packet or if the codeword is not used
+			{
+				const int entry = DecodeScalar(reader);
+				return (entry >= 0) ? (&VectorValues[static_cast<size_t>(entry) * Dimensions]) : (nullptr);
+			}
+
+			uint32_t Dimensions = 0;
+			uint32_t EntryCount = 0;
+			std::vector<int32_t> Tree;	//Two children per node, the root is node 0. A positive child is the index of a node, a negative one is the bitwise negation of an entry, 0 is an unused codeword
+			std::vector<float> VectorValues;	//Dimensions values per entry; empty if the codebook has no lookup table (it can only be used as a scalar codebook)
+		};
+
+		bool VorbisStream::Codebook::BuildTree(const std::vector<uint8_t>& lengths)
+		{
+			Tree.assign(2, 0);
+
+			const size_t usedCount = static_cast<size_t>(std::count_if(lengths.begin(), lengths.end(), [](uint8_t length) { return length > 0; }));
+			if (usedCount == 1)	//A single entry is decoded from a single bit of any value
+			{
+				const int32_t entry = static_cast<int32_t>(std::find_if(lengths.begin(), lengths.end(), [](uint8_t length) { return length > 0; }) - lengths.begin());
+				Tree[0] = Tree[1] = ~entry;
+				return true;
+			}
+
+			uint32_t available[33] = {};	//The lowest free codeword of each length, aligned to the most significant bit (0 if there is none)
+			bool bFirst = true;
+			for (size_t entry = 0; entry < lengths.size(); entry++)
+			{
+				const unsigned int length = lengths[entry];
+				if (length == 0)
+					continue;
+
+				uint32_t codeword = 0;
+				if (bFirst)
+				{
+					for (unsigned int i = 1; i <= length; i++)
+						available[i] = 1u << (32 - i);
+					bFirst = false;
+				}
+				else
+				{
+					unsigned int freeLength = length;
+					while (freeLength > 0 && available[freeLength] == 0)
+						freeLength--;
+					if (freeLength == 0)
+						return false;
+
+					codeword = available[freeLength];
+					available[freeLength] = 0;
+					for (unsigned int i = length; i > freeLength; i--)
+						available[i] = codeword + (1u << (32 - i));
+				}
+
+				int32_t node = 0;
+				for (unsigned int bit = 0; bit < length; bit++)
+				{
+					int32_t& child = Tree[node * 2 + ((codeword >> (31 - bit)) & 1)];
+					if (bit == length - 1)
+					{
+						if (child != 0)
+							return false;
+						child = ~static_cast<int32_t>(entry);
+					}
+					else
+					{
+						if (child < 0)
+							return false;
+						if (child == 0)
+							child = static_cast<int32_t>(Tree.size() / 2);
+						node = child;
+						if (static_cast<size_t>(node) * 2 == Tree.size())	//A new node (resizing invalidates child)
+							Tree.resize(Tree.size() + 2, 0);
+					}
+				}
+			}
+
+			return true;
+		}
+
+		struct VorbisStream::Floor	//Floor type 1
+		{
+			std::vector<uint8_t> PartitionClasses;
+			uint8_t ClassDimensions[16];
+			uint8_t ClassSubclasses[16];
+			int ClassMasterbooks[16];
+			int SubclassBooks[16][8];	//-1 if unused
+			int Multiplier;
+			std::vector<int> X;	//In the order of the bitstream
+			std::vector<unsigned int> SortedOrder;	//Indices of X sorted by value
+			std::vector<unsigned int> LowNeighbors, HighNeighbors;
+		};
+
+		struct VorbisStream::Residue
+		{
+			unsigned int Type;
+			uint32_t Begin, End, PartitionSize;
+			unsigned int ClassificationCount;
+			unsigned int Classbook;
+			std::vector<int> Books;	//8 passes per classification; -1 if unused
+		};
+
+		struct VorbisStream::Mapping
+		{
+			std::vector<std::pair<unsigned int, unsigned int>> CouplingSteps;	//Magnitude and angle channels
+			std::vector<unsigned int> Multiplex;	//The submap of each channel
+			std::vector<unsigned int> SubmapFloors, SubmapResidues;
+		};
+
+		struct VorbisStream::Mode
+		{
+			bool bLongBlock;
+			unsigned int Mapping;
+		};
+
+		void VorbisStream::InverseMdct::Init(unsigned int blockSize)
+		{
+			BlockSize = blockSize;
+			const unsigned int m = blockSize / 2, q = blockSize / 4;
+
+			PreTwiddles.resize(q);
+			PostTwiddles.resize(q);
+			FftTwiddles.resize(q / 2);
+			for (unsigned int k = 0; k < q; k++)
+			{
+				PreTwiddles[k] = std::polar(1.0f, static_cast<float>(-Pi * (4.0 * k + 1.0) / (4.0 * m)));
+				PostTwiddles[k] = std::polar(1.0f, static_cast<float>(-Pi * k / m));
+			}
+			for (unsigned int k = 0; k < q / 2; k++)
+				FftTwiddles[k] = std::polar(1.0f, static_cast<float>(-2.0 * Pi * k / q));
+
+			const unsigned int bitCount = ILog(q) - 1;
+			BitReverse.resize(q);
+			for (unsigned int k = 0; k < q; k++)
+			{
+				uint32_t reversed = 0;
+				for (unsigned int bit = 0; bit < bitCount; bit++)
+					reversed |= ((k >> bit) & 1) << (bitCount - 1 - bit);
+				BitReverse[k] = reversed;
+			}
+
+			Fft.resize(q);
+			Dct.resize(m);
+		}
+
+		void VorbisStream::InverseMdct::Transform(const float* coefficients, float* output)
+		{
+			const unsigned int n = BlockSize, m = n / 2, q = n / 4;
+
+			//1. The DCT-IV of the coefficients: pair them into q complex values, transform them with an FFT of size q and unpair the result.
+			for (unsigned int k = 0; k < q; k++)
+				Fft[BitReverse[k]] = std::complex<float>(coefficients[2 * k], coefficients[m - 1 - 2 * k]) * PreTwiddles[k];
+
+			for (unsigned int size = 2; size <= q; size *= 2)
+			{
+				const unsigned int twiddleStep = q / size;
+				for (unsigned int start = 0; start < q; start += size)
+					for (unsigned int k = 0; k < size / 2; k++)
+					{
+						const std::complex<float> odd = Fft[start + k + size / 2] * FftTwiddles[k * twiddleStep];
+						Fft[start + k + size / 2] = Fft[start + k] - odd;
+						Fft[start + k] += odd;
+					}
+			}
+
+			for (unsigned int k = 0; k < q; k++)
+			{
+				const std::complex<float> value = Fft[k] * PostTwiddles[k];
+				Dct[2 * k] = value.real();
+				Dct[m - 1 - 2 * k] = -value.imag();
+			}
+
+			//2. The inverse MDCT is the DCT-IV extended to twice its length (odd symmetry around m - 1/2 and even around -1/2), shifted by a quarter of the block.
+			for (unsigned int i = 0; i < q; i++)
+			{
+				output[i] = Dct[q + i];
+				output[n - q + i] = -Dct[i];
+			}
+			for (unsigned int i = q; i < n - q; i++)
+				output[i] = -Dct[n - q - 1 - i];
+		}
+
+		VorbisStream::VorbisStream() :
+			SerialNumber(0),
+			bSerialNumberKnown(false),
+			FirstAudioPageOffset(0),
+			SegmentCount(0),
+			SegmentIndex(0),
+			PageDataOffset(0),
+			bLastPage(false),
+			ChannelCount(0),
+			SampleRate(0),
+			FrameCount(0),
+			BlockSizes{ 0, 0 },
+			ClassificationStride(0),
+			PreviousBlockSize(0),
+			DecodedFrames(0),
+			DecodedPosition(0),
+			FramesLeft(0)
+		{
+		}
+
+		VorbisStream::~VorbisStream() = default;
+
+		bool VorbisStream::Open(const std::string& path)
+		{
+			Path = path;
+			File.open(path, std::ios::binary);
+			if (!File.good())
+			{
+				std::cerr << "ERROR! Can't open Ogg Vorbis file " << path << "!\n";
+				return false;
+			}
+
+			if (!ReadIdentificationHeader() || !ReadHeaderPacket(3) || !ReadSetupHeader())
+				return false;
+			if (SegmentIndex != SegmentCount)
+			{
+				std::cerr << "ERROR! The first audio packet of Ogg Vorbis file " << path << " does not begin a new page.\n";
+				return false;
+			}
+
+			FirstAudioPageOffset = File.tellg();
+			if (!ReadFrameCount())
+				return false;
+
+			for (unsigned int i = 0; i < 2; i++)
+			{
+				const unsigned int halfSize = BlockSizes[i] / 2;
+				WindowSlopes[i].resize(halfSize);
+				for (unsigned int k = 0; k < halfSize; k++)
+				{
+					const double slope = std::sin((k + 0.5) / halfSize * Pi / 2.0);
+					WindowSlopes[i][k] = static_cast<float>(std::sin(Pi / 2.0 * slope * slope));
+				}
+				Mdcts[i].Init(BlockSizes[i]);
+			}
+
+			FloorY.assign(ChannelCount, std::vector<int>(MaxFloorValues));
+			FloorCurve.resize(BlockSizes[1] / 2);
+			ResidueVectors.assign(ChannelCount, std::vector<float>(BlockSizes[1] / 2));
+			InterleavedResidue.resize(static_cast<size_t>(ChannelCount) * BlockSizes[1] / 2);
+			Blocks.assign(ChannelCount, std::vector<float>(BlockSizes[1]));
+			PreviousRightHalves.assign(ChannelCount, std::vector<float>(BlockSizes[1] / 2));
+			Decoded.resize(static_cast<size_t>(ChannelCount) * BlockSizes[1] / 2);
+
+			return Rewind();
+		}
+
+		unsigned int VorbisStream::GetChannelCount() const
+		{
+			return ChannelCount;
+		}
+
+		unsigned int VorbisStream::GetSampleRate() const
+		{
+			return SampleRate;
+		}
+
+		size_t VorbisStream::GetFrameCount() const
+		{
+			return FrameCount;
+		}
+
+		size_t VorbisStream::Read(float* frames, size_t frameCount)
+		{
+			size_t readFrames = 0;
+			while (readFrames < frameCount && FramesLeft > 0)
+			{
+				if (DecodedPosition == DecodedFrames)
+				{
+					if (!ReadPacket())
+					{
+						FramesLeft = 0;	//A truncated file ends where its packets end
+						break;
+					}
+
+					DecodePacket();
+					continue;
+				}
+
+				const size_t count = std::min({ frameCount - readFrames, DecodedFrames - DecodedPosition, FramesLeft });	//The last packet is trimmed to the granule position of the last page
+				std::memcpy(frames + readFrames * ChannelCount, Decoded.data() + DecodedPosition * ChannelCount, count * ChannelCount * sizeof(float));
+				readFrames += count;
+				DecodedPosition += count;
+				FramesLeft -= count;
+			}
+
+			return readFrames;
+		}
+
+		bool VorbisStream::Rewind()
+		{
+			File.clear();
+			File.seekg(FirstAudioPageOffset);
+			SegmentCount = SegmentIndex = 0;
+			bLastPage = false;
+			PreviousBlockSize = 0;
+			DecodedFrames = DecodedPosition = 0;
+			FramesLeft = FrameCount;
+
+			return File.good();
+		}
+
+		///////////////////////////////////////////
+		//////////////////Ogg pages////////////////
+		///////////////////////////////////////////
+
+		bool VorbisStream::ReadPage()
+		{
+			for (;;)
+			{
+				uint8_t header[27];
+				if (!File.read(reinterpret_cast<char*>(header), sizeof(header)) || std::memcmp(header, "OggS", 4) != 0 || header[4] != 0)
+					return false;
+
+				uint32_t serialNumber = 0;
+				for (int i = 3; i >= 0; i--)
+					serialNumber = (serialNumber << 8) | header[14 + i];
+
+				SegmentCount = header[26];
+				if (!File.read(reinterpret_cast<char*>(SegmentSizes), SegmentCount))
+					return false;
+
+				size_t pageSize = 0;
+				for (unsigned int i = 0; i < SegmentCount; i++)
+					pageSize += SegmentSizes[i];
+				PageData.resize(pageSize);
+				if (!File.read(reinterpret_cast<char*>(PageData.data()), static_cast<std::streamsize>(pageSize)))
+					return false;
+
+				if (!bSerialNumberKnown)
+				{
+					SerialNumber = serialNumber;
+					bSerialNumberKnown = true;
+				}
+				else if (serialNumber != SerialNumber)
+					continue;
+
+				SegmentIndex = 0;
+				PageDataOffset = 0;
+				bLastPage = (header[5] & 4) != 0;
+				return true;
+			}
+		}
+
+		bool VorbisStream::ReadPacket()
+		{
+			Packet.clear();
+			for (;;)
+			{
+				if (SegmentIndex == SegmentCount)
+				{
+					if (bLastPage || !ReadPage())
+						return false;
+				}
+
+				const uint8_t size = SegmentSizes[SegmentIndex++];
+				Packet.insert(Packet.end(), PageData.begin() + PageDataOffset, PageData.begin() + PageDataOffset + size);
+				PageDataOffset += size;
+				if (size < 255)	//Segments of 255 bytes are continued by the next segment, even if it is on the next page
+					return true;
+			}
+		}
+
+		bool VorbisStream::ReadHeaderPacket(uint8_t type)
+		{
+			if (!ReadPacket() || Packet.size() < 7 || Packet[0] != type || std::memcmp(&Packet[1], "vorbis", 6) != 0)
+			{
+				std::cerr << "ERROR! " << Path << " is not an Ogg Vorbis file - header " << static_cast<int>(type) << " is missing.\n";
+				return false;
+			}
+
+			return true;
+		}
+
+		bool VorbisStream::ReadFrameCount()
+		{
+			File.seekg(0, std::ios::end);
+			const std::streamoff fileSize = File.tellg();
+			const std::streamoff tailSize = std::min<std::streamoff>(fileSize, 65536 + 27 + 255);	//Larger than the largest page
+			std::vector<uint8_t> tail(static_cast<size_t>(tailSize));
+			File.seekg(fileSize - tailSize);
+			File.read(reinterpret_cast<char*>(tail.data()), tailSize);
+
+			for (size_t i = (tail.size() >= 27) ? (tail.size() - 27) : (0); i + 27 <= tail.size(); i--)	//The last page of the stream whose granule position is set
+			{
+				if (std::memcmp(&tail[i], "OggS", 4) == 0 && tail[i + 4] == 0)
+				{
+					uint32_t serialNumber = 0;
+					for (int b = 3; b >= 0; b--)
+						serialNumber = (serialNumber << 8) | tail[i + 14 + b];
+
+					uint64_t granulePosition = 0;
+					for (int b = 7; b >= 0; b--)
+						granulePosition = (granulePosition << 8) | tail[i + 6 + b];
+
+					if (serialNumber == SerialNumber && granulePosition != ~uint64_t(0))
+					{
+						FrameCount = static_cast<size_t>(granulePosition);
+						File.clear();
+						return true;
+					}
+				}
+
+				if (i == 0)
+					break;
+			}
+
+			std::cerr << "ERROR! Can't find the length of Ogg Vorbis file " << Path << " - the file may be truncated.\n";
+			return false;
+		}
+
+		///////////////////////////////////////////
+		//////////////////Headers//////////////////
+		///////////////////////////////////////////
+
+		bool VorbisStream::ReadIdentificationHeader()
+		{
+			if (!ReadHeaderPacket(1))
+				return false;
+
+			BitReader reader(Packet, 7);
+			const uint32_t version = reader.Read(32);
+			ChannelCount = reader.Read(8);
+			SampleRate = reader.Read(32);
+			reader.Read(32); reader.Read(32); reader.Read(32);	//Maximum, nominal and minimum bitrate
+			BlockSizes[0] = 1u << reader.Read(4);
+			BlockSizes[1] = 1u << reader.Read(4);
+			const bool bFramingBit = reader.Read(1) != 0;
+
+			if (reader.IsEndOfPacket() || version != 0 || ChannelCount == 0 || SampleRate == 0 || BlockSizes[0] < 64 || BlockSizes[1] > 8192 || BlockSizes[0] > BlockSizes[1] || !bFramingBit)
+			{
+				std::cerr << "ERROR! Invalid Vorbis identification header in " << Path << ".\n";
+				return false;
+			}
+
+			return true;
+		}
+
+		bool VorbisStream::ReadSetupHeader()
+		{
+			if (!ReadHeaderPacket(5))
+				return false;
+
+			BitReader reader(Packet, 7);
+			auto fail = [this](const char* what) { std::cerr << "ERROR! Invalid Vorbis setup header in " << Path << " (" << what << ").\n"; return false; };
+
+			Codebooks.resize(reader.Read(8) + 1);
+			for (Codebook& codebook : Codebooks)
+				if (!ReadCodebook(reader, codebook))
+					return fail("codebook");
+
+			const unsigned int timeCount = reader.Read(6) + 1;	//Placeholders in Vorbis I
+			for (unsigned int i = 0; i < timeCount; i++)
+				if (reader.Read(16) != 0)
+					return fail("time domain transform");
+
+			Floors.resize(reader.Read(6) + 1);
+			for (Floor& floor : Floors)
+				if (!ReadFloor(reader, floor))
+					return false;
+
+			Residues.resize(reader.Read(6) + 1);
+			for (Residue& residue : Residues)
+				if (!ReadResidue(reader, residue))
+					return fail("residue");
+
+			Mappings.resize(reader.Read(6) + 1);
+			for (Mapping& mapping : Mappings)
+				if (!ReadMapping(reader, mapping))
+					return fail("mapping");
+
+			Modes.resize(reader.Read(6) + 1);
+			for (Mode& mode : Modes)
+			{
+				mode.bLongBlock = reader.Read(1) != 0;
+				const uint32_t windowType = reader.Read(16), transformType = reader.Read(16);
+				mode.Mapping = reader.Read(8);
+				if (windowType != 0 || transformType != 0 || mode.Mapping >= Mappings.size())
+					return fail("mode");
+			}
+
+			if (reader.Read(1) == 0 || reader.IsEndOfPacket())
+				return fail("framing bit");
+
+			//Scratch memory for the classifications of the largest residue vector, so decoding does not allocate
+			size_t maxPartitionCount = 0, maxClasswords = 0;
+			for (const Residue& residue : Residues)
+			{
+				const size_t vectorSize = static_cast<size_t>(BlockSizes[1] / 2) * ((residue.Type == 2) ? (ChannelCount) : (1));
+				maxPartitionCount = std::max(maxPartitionCount, (std::min<size_t>(residue.End, vectorSize) - std::min<size_t>(residue.Begin, vectorSize)) / residue.PartitionSize);
+				maxClasswords = std::max<size_t>(maxClasswords, Codebooks[residue.Classbook].Dimensions);
+			}
+			ClassificationStride = maxPartitionCount + maxClasswords;
+			Classifications.resize(ClassificationStride * ChannelCount);
+
+			return true;
+		}
+
+		bool VorbisStream::ReadCodebook(BitReader& reader, Codebook& codebook)
+		{
+			if (reader.Read(24) != CodebookSyncPattern)
+				return false;
+
+			codebook.Dimensions = reader.Read(16);
+			codebook.EntryCount = reader.Read(24);
+			if (codebook.Dimensions == 0 || codebook.EntryCount == 0 || static_cast<uint64_t>(codebook.EntryCount) * codebook.Dimensions > MaxCodebookValues)
+				return false;
+
+			std::vector<uint8_t> lengths(codebook.EntryCount, 0);	//0 for unused entries
+			if (reader.Read(1) == 0)	//Not ordered
+			{
+				const bool bSparse = reader.Read(1) != 0;
+				for (uint8_t& length : lengths)
+					if (!bSparse || reader.Read(1) != 0)
+						length = static_cast<uint8_t>(reader.Read(5) + 1);
+			}
+			else
+			{
+				uint32_t length = reader.Read(5) + 1;
+				for (uint32_t entry = 0; entry < codebook.EntryCount; length++)
+				{
+					const uint32_t count = reader.Read(ILog(codebook.EntryCount - entry));
+					if (length > 32 || entry + count > codebook.EntryCount)
+						return false;
+					std::fill(lengths.begin() + entry, lengths.begin() + entry + count, static_cast<uint8_t>(length));
+					entry += count;
+					if (reader.IsEndOfPacket())
+						return false;
+				}
+			}
+
+			const uint32_t lookupType = reader.Read(4);
+			if (lookupType == 1 || lookupType == 2)
+			{
+				const float minimum = UnpackFloat(reader.Read(32)), delta = UnpackFloat(reader.Read(32));
+				const unsigned int valueBits = reader.Read(4) + 1;
+				const bool bSequence = reader.Read(1) != 0;
+
+				const uint32_t lookupValueCount = (lookupType == 1) ? (Lookup1Values(codebook.EntryCount, codebook.Dimensions)) : (codebook.EntryCount * codebook.Dimensions);
+				std::vector<uint32_t> multiplicands(lookupValueCount);
+				for (uint32_t& multiplicand : multiplicands)
+					multiplicand = reader.Read(valueBits);
+				if (reader.IsEndOfPacket() || lookupValueCount == 0)
+					return false;
+
+				codebook.VectorValues.resize(static_cast<size_t>(codebook.EntryCount) * codebook.Dimensions);
+				for (uint32_t entry = 0; entry < codebook.EntryCount; entry++)
+				{
+					float last = 0.0f;
+					uint32_t indexDivisor = 1;
+					for (uint32_t i = 0; i < codebook.Dimensions; i++)
+					{
+						const uint32_t offset = (lookupType == 1) ? ((entry / indexDivisor) % lookupValueCount) : (entry * codebook.Dimensions + i);
+						const float value = static_cast<float>(multiplicands[offset]) * delta + minimum + last;
+						codebook.VectorValues[static_cast<size_t>(entry) * codebook.Dimensions + i] = value;
+						if (bSequence)
+							last = value;
+						indexDivisor *= lookupValueCount;
+					}
+				}
+			}
+			else if (lookupType != 0)
+				return false;
+
+			return !reader.IsEndOfPacket() && codebook.BuildTree(lengths);
+		}
+
+		bool VorbisStream::ReadFloor(BitReader& reader, Floor& floor)
+		{
+			const uint32_t type = reader.Read(16);
+			if (type != 1)
+			{
+				std::cerr << "ERROR! Unsupported Vorbis floor type " << type << " in " << Path << ".\n";
+				return false;
+			}
+
+			floor.PartitionClasses.resize(reader.Read(5));
+			unsigned int classCount = 0;
+			for (uint8_t& partitionClass : floor.PartitionClasses)
+			{
+				partitionClass = static_cast<uint8_t>(reader.Read(4));
+				classCount = std::max(classCount, partitionClass + 1u);
+			}
+
+			for (unsigned int i = 0; i < classCount; i++)
+			{
+				floor.ClassDimensions[i] = static_cast<uint8_t>(reader.Read(3) + 1);
+				floor.ClassSubclasses[i] = static_cast<uint8_t>(reader.Read(2));
+				floor.ClassMasterbooks[i] = (floor.ClassSubclasses[i] > 0) ? (static_cast<int>(reader.Read(8))) : (-1);
+				for (unsigned int j = 0; j < (1u << floor.ClassSubclasses[i]); j++)
+					floor.SubclassBooks[i][j] = static_cast<int>(reader.Read(8)) - 1;
+
+				if (floor.ClassMasterbooks[i] >= static_cast<int>(Codebooks.size()) || std::any_of(floor.SubclassBooks[i], floor.SubclassBooks[i] + (1u << floor.ClassSubclasses[i]), [this](int book) { return book >= static_cast<int>(Codebooks.size()); }))
+					return false;
+			}
+
+			floor.Multiplier = static_cast<int>(reader.Read(2)) + 1;
+			const unsigned int rangeBits = reader.Read(4);
+			floor.X = { 0, 1 << rangeBits };
+			for (uint8_t partitionClass : floor.PartitionClasses)
+				for (unsigned int j = 0; j < floor.ClassDimensions[partitionClass]; j++)
+					floor.X.push_back(static_cast<int>(reader.Read(rangeBits)));
+
+			if (floor.X.size() > MaxFloorValues || reader.IsEndOfPacket())
+			{
+				std::cerr << "ERROR! Invalid Vorbis floor in " << Path << ".\n";
+				return false;
+			}
+
+			const unsigned int valueCount = static_cast<unsigned int>(floor.X.size());
+			floor.SortedOrder.resize(valueCount);
+			for (unsigned int i = 0; i < valueCount; i++)
+				floor.SortedOrder[i] = i;
+			std::sort(floor.SortedOrder.begin(), floor.SortedOrder.end(), [&floor](unsigned int a, unsigned int b) { return floor.X[a] < floor.X[b]; });
+			for (unsigned int i = 1; i < valueCount; i++)
+				if (floor.X[floor.SortedOrder[i]] == floor.X[floor.SortedOrder[i - 1]])
+				{
+					std::cerr << "ERROR! Invalid Vorbis floor in " << Path << " (repeated X).\n";
+					return false;
+				}
+
+			floor.LowNeighbors.assign(valueCount, 0);
+			floor.HighNeighbors.assign(valueCount, 1);
+			for (unsigned int i = 2; i < valueCount; i++)	//The nearest lower and higher X among the preceding values
+				for (unsigned int j = 0; j < i; j++)
+				{
+					if (floor.X[j] < floor.X[i] && floor.X[j] > floor.X[floor.LowNeighbors[i]])
+						floor.LowNeighbors[i] = j;
+					if (floor.X[j] > floor.X[i] && floor.X[j] < floor.X[floor.HighNeighbors[i]])
+						floor.HighNeighbors[i] = j;
+				}
+
+			return true;
+		}
+
+		bool VorbisStream::ReadResidue(BitReader& reader, Residue& residue)
+		{
+			residue.Type = reader.Read(16);
+			residue.Begin = reader.Read(24);
+			residue.End = reader.Read(24);
+			residue.PartitionSize = reader.Read(24) + 1;
+			residue.ClassificationCount = reader.Read(6) + 1;
+			residue.Classbook = reader.Read(8);
+			if (residue.Type > 2 || residue.Classbook >= Codebooks.size())
+				return false;
+
+			std::vector<uint32_t> cascades(residue.ClassificationCount);
+			for (uint32_t& cascade : cascades)
+			{
+				const uint32_t lowBits = reader.Read(3);
+				cascade = (reader.Read(1) != 0) ? ((reader.Read(5) << 3) | lowBits) : (lowBits);
+			}
+
+			residue.Books.assign(static_cast<size_t>(residue.ClassificationCount) * 8, -1);
+			for (unsigned int i = 0; i < residue.ClassificationCount; i++)
+				for (unsigned int pass = 0; pass < 8; pass++)
+					if (cascades[i] & (1u << pass))
+					{
+						const uint32_t book = reader.Read(8);
+						if (book >= Codebooks.size() || Codebooks[book].VectorValues.empty())
+							return false;
+						residue.Books[i * 8 + pass] = static_cast<int>(book);
+					}
+
+			return !reader.IsEndOfPacket();
+		}
+
+		bool VorbisStream::ReadMapping(BitReader& reader, Mapping& mapping)
+		{
+			if (reader.Read(16) != 0)
+				return false;
+
+			const unsigned int submapCount = (reader.Read(1) != 0) ? (reader.Read(4) + 1) : (1);
+			if (reader.Read(1) != 0)
+			{
+				mapping.CouplingSteps.resize(reader.Read(8) + 1);
+				const unsigned int channelBits = ILog(ChannelCount - 1);
+				for (auto& step : mapping.CouplingSteps)
+				{
+					step.first = reader.Read(channelBits);
+					step.second = reader.Read(channelBits);
+					if (step.first == step.second || step.first >= ChannelCount || step.second >= ChannelCount)
+						return false;
+				}
+			}
+
+			if (reader.Read(2) != 0)
+				return false;
+
+			mapping.Multiplex.assign(ChannelCount, 0);
+			if (submapCount > 1)
+				for (unsigned int& submap : mapping.Multiplex)
+				{
+					submap = reader.Read(4);
+					if (submap >= submapCount)
+						return false;
+				}
+
+			mapping.SubmapFloors.resize(submapCount);
+			mapping.SubmapResidues.resize(submapCount);
+			for (unsigned int i = 0; i < submapCount; i++)
+			{
+				reader.Read(8);	//Unused time configuration
+				mapping.SubmapFloors[i] = reader.Read(8);
+				mapping.SubmapResidues[i] = reader.Read(8);
+				if (mapping.SubmapFloors[i] >= Floors.size() || mapping.SubmapResidues[i] >= Residues.size())
+					return false;
+			}
+
+			return !reader.IsEndOfPacket();
+		}
+
+		///////////////////////////////////////////
+		///////////////Audio packets///////////////
+		///////////////////////////////////////////
+
+		bool VorbisStream::DecodePacket()
+		{
+			DecodedFrames = DecodedPosition = 0;
+
+			BitReader reader(Packet);
+			if (reader.Read(1) != 0 || reader.IsEndOfPacket())
+				return false;
+
+			const uint32_t modeNumber = reader.Read(ILog(static_cast<uint32_t>(Modes.size()) - 1));
+			if (modeNumber >= Modes.size())
+				return false;
+
+			const Mode& mode = Modes[modeNumber];
+			const Mapping& mapping = Mappings[mode.Mapping];
+			const unsigned int n = BlockSizes[mode.bLongBlock], halfN = n / 2;
+			bool bPreviousLong = false, bNextLong = false;
+			if (mode.bLongBlock)
+			{
+				bPreviousLong = reader.Read(1) != 0;
+				bNextLong = reader.Read(1) != 0;
+			}
+			if (reader.IsEndOfPacket())
+				return false;
+
+			//1. Floors. A channel whose floor is unused is silent in this packet, unless it is coupled with a channel that is not.
+			bool bChannelUsed[256], bDoNotDecode[256];
+			for (unsigned int channel = 0; channel < ChannelCount; channel++)
+				bChannelUsed[channel] = DecodeFloor(reader, Floors[mapping.SubmapFloors[mapping.Multiplex[channel]]], FloorY[channel].data());
+			for (const auto& step : mapping.CouplingSteps)
+				if (bChannelUsed[step.first] || bChannelUsed[step.second])
+					bChannelUsed[step.first] = bChannelUsed[step.second] = true;
+
+			//2. Residues, decoded per submap.
+			for (unsigned int channel = 0; channel < ChannelCount; channel++)
+				std::fill(ResidueVectors[channel].begin(), ResidueVectors[channel].begin() + halfN, 0.0f);
+			for (unsigned int submap = 0; submap < mapping.SubmapResidues.size(); submap++)
+			{
+				unsigned int channels[256];
+				unsigned int channelCount = 0;
+				for (unsigned int channel = 0; channel < ChannelCount; channel++)
+					if (mapping.Multiplex[channel] == submap)
+					{
+						bDoNotDecode[channelCount] = !bChannelUsed[channel];
+						channels[channelCount++] = channel;
+					}
+
+				DecodeResidue(reader, Residues[mapping.SubmapResidues[submap]], channels, bDoNotDecode, channelCount, halfN);
+			}
+
+			//3. Inverse channel coupling (square polar mapping), in reverse order.
+			for (auto step = mapping.CouplingSteps.rbegin(); step != mapping.CouplingSteps.rend(); step++)
+			{
+				float* magnitudes = ResidueVectors[step->first].data();
+				float* angles = ResidueVectors[step->second].data();
+				for (unsigned int i = 0; i < halfN; i++)
+				{
+					const float magnitude = magnitudes[i], angle = angles[i];
+					if (magnitude > 0.0f)
+					{
+						magnitudes[i] = (angle > 0.0f) ? (magnitude) : (magnitude + angle);
+						angles[i] = (angle > 0.0f) ? (magnitude - angle) : (magnitude);
+					}
+					else
+					{
+						magnitudes[i] = (angle > 0.0f) ? (magnitude) : (magnitude - angle);
+						angles[i] = (angle > 0.0f) ? (magnitude + angle) : (magnitude);
+					}
+				}
+			}
+
+			//4. The spectrum is the floor curve multiplied by the residue. It is transformed to the time domain and windowed.
+			for (unsigned int channel = 0; channel < ChannelCount; channel++)
+			{
+				float* block = Blocks[channel].data();
+				if (!bChannelUsed[channel])
+				{
+					std::fill(block, block + n, 0.0f);
+					continue;
+				}
+
+				RenderFloor(Floors[mapping.SubmapFloors[mapping.Multiplex[channel]]], FloorY[channel].data(), static_cast<int>(halfN), FloorCurve.data());
+				float* residue = ResidueVectors[channel].data();
+				for (unsigned int i = 0; i < halfN; i++)
+					residue[i] *= FloorCurve[i];
+
+				Mdcts[mode.bLongBlock].Transform(residue, block);
+				ApplyWindow(block, mode.bLongBlock, bPreviousLong, bNextLong);
+			}
+
+			//5. Overlap-add. The frames from the center of the previous block to the center of this one are finished.
+			if (PreviousBlockSize > 0)
+			{
+				const int previousQuarter = static_cast<int>(PreviousBlockSize / 4), quarter = static_cast<int>(n / 4);
+				DecodedFrames = static_cast<size_t>(previousQuarter + quarter);
+				for (unsigned int channel = 0; channel < ChannelCount; channel++)
+				{
+					const float* previous = PreviousRightHalves[channel].data();
+					const float* block = Blocks[channel].data();
+					for (int i = 0; i < previousQuarter + quarter; i++)
+					{
+						const int blockIndex = i - previousQuarter + quarter;
+						float sample = (i < 2 * previousQuarter) ? (previous[i]) : (0.0f);
+						if (blockIndex >= 0 && blockIndex < static_cast<int>(n))
+							sample += block[blockIndex];
+						Decoded[static_cast<size_t>(i) * ChannelCount + channel] = sample;
+					}
+				}
+			}
+
+			for (unsigned int channel = 0; channel < ChannelCount; channel++)
+				std::copy(Blocks[channel].begin() + halfN, Blocks[channel].begin() + n, PreviousRightHalves[channel].begin());
+			PreviousBlockSize = n;
+
+			return true;
+		}
+
+		bool VorbisStream::DecodeFloor(BitReader& reader, const Floor& floor, int* y)
+		{
+			static const int ranges[4] = { 256, 128, 86, 64 };
+			if (reader.Read(1) == 0)
+				return false;
+
+			const unsigned int rangeBits = ILog(ranges[floor.Multiplier - 1] - 1);
+			y[0] = static_cast<int>(reader.Read(rangeBits));
+			y[1] = static_cast<int>(reader.Read(rangeBits));
+
+			unsigned int offset = 2;
+			for (uint8_t partitionClass : floor.PartitionClasses)
+			{
+				const unsigned int dimensions = floor.ClassDimensions[partitionClass], subclassBits = floor.ClassSubclasses[partitionClass];
+				int classValue = 0;
+				if (subclassBits > 0 && (classValue = Codebooks[floor.ClassMasterbooks[partitionClass]].DecodeScalar(reader)) < 0)
+					return false;
+
+				for (unsigned int j = 0; j < dimensions; j++)
+				{
+					const int book = floor.SubclassBooks[partitionClass][classValue & ((1 << subclassBits) - 1)];
+					classValue >>= subclassBits;
+					y[offset + j] = 0;
+					if (book >= 0 && (y[offset + j] = Codebooks[book].DecodeScalar(reader)) < 0)
+						return false;
+				}
+				offset += dimensions;
+			}
+
+			return !reader.IsEndOfPacket();	//The floor is unused if the packet ends while it is read
+		}
+
+		void VorbisStream::RenderFloor(const Floor& floor, const int* y, int halfBlockSize, float* curve)
+		{
+			static const int ranges[4] = { 256, 128, 86, 64 };
+			const int range = ranges[floor.Multiplier - 1];
+			const unsigned int valueCount = static_cast<unsigned int>(floor.X.size());
+
+			//1. Amplitude values: each value is coded as an offset from the value predicted by its neighbors.
+			int finalY[MaxFloorValues];
+			bool bStep2[MaxFloorValues];
+			finalY[0] = y[0];
+			finalY[1] = y[1];
+			bStep2[0] = bStep2[1] = true;
+			for (unsigned int i = 2; i < valueCount; i++)
+			{
+				const unsigned int low = floor.LowNeighbors[i], high = floor.HighNeighbors[i];
+				const int predicted = RenderPoint(floor.X[low], finalY[low], floor.X[high], finalY[high], floor.X[i]);
+				const int value = y[i], highRoom = range - predicted, lowRoom = predicted;
+				const int room = std::min(highRoom, lowRoom) * 2;
+
+				bStep2[i] = value != 0;
+				if (value == 0)
+				{
+					finalY[i] = predicted;
+					continue;
+				}
+
+				bStep2[low] = bStep2[high] = true;
+				if (value >= room)
+					finalY[i] = (highRoom > lowRoom) ? (value - lowRoom + predicted) : (predicted - value + highRoom - 1);
+				else
+					finalY[i] = (value % 2 == 1) ? (predicted - (value + 1) / 2) : (predicted + value / 2);
+			}
+
+			//2. Curve synthesis: lines between the values in the order of X.
+			int lowX = 0, lowY = finalY[floor.SortedOrder[0]] * floor.Multiplier;
+			for (unsigned int k = 1; k < valueCount; k++)
+			{
+				const unsigned int i = floor.SortedOrder[k];
+				if (!bStep2[i])
+					continue;
+
+				const int highY = finalY[i] * floor.Multiplier;
+				RenderLine(lowX, lowY, floor.X[i], highY, curve, halfBlockSize);
+				lowX = floor.X[i];
+				lowY = highY;
+			}
+			if (lowX < halfBlockSize)
+				RenderLine(lowX, lowY, halfBlockSize, lowY, curve, halfBlockSize);
+		}
+
+		void VorbisStream::DecodeResidue(BitReader& reader, const Residue& residue, const unsigned int* channels, const bool* bDoNotDecode, unsigned int channelCount, unsigned int halfBlockSize)
+		{
+			if (channelCount == 0)
+				return;
+
+			if (residue.Type == 2)	//All channels are interleaved into one vector
+			{
+				if (std::all_of(bDoNotDecode, bDoNotDecode + channelCount, [](bool bSkip) { return bSkip; }))
+					return;
+
+				const unsigned int vectorSize = halfBlockSize * channelCount;
+				std::fill(InterleavedResidue.begin(), InterleavedResidue.begin() + vectorSize, 0.0f);
+				float* interleaved = InterleavedResidue.data();
+				const bool bDecode = false;
+				DecodePartitions(reader, residue, &interleaved, &bDecode, 1, vectorSize);
+
+				for (unsigned int c = 0; c < channelCount; c++)
+				{
+					float* vector = ResidueVectors[channels[c]].data();
+					for (unsigned int i = 0; i < halfBlockSize; i++)
+						vector[i] = interleaved[i * channelCount + c];
+				}
+				return;
+			}
+
+			float* vectors[256];
+			for (unsigned int c = 0; c < channelCount; c++)
+				vectors[c] = ResidueVectors[channels[c]].data();
+			DecodePartitions(reader, residue, vectors, bDoNotDecode, channelCount, halfBlockSize);
+		}
+
+		void VorbisStream::DecodePartitions(BitReader& reader, const Residue& residue, float* const* vectors, const bool* bDoNotDecode, unsigned int vectorCount, unsigned int vectorSize)
+		{
+			const uint32_t begin = std::min(residue.Begin, vectorSize), end = std::min(residue.End, vectorSize);
+			if (end <= begin)
+				return;
+
+			const uint32_t partitionCount = (end - begin) / residue.PartitionSize;
+			const Codebook& classbook = Codebooks[residue.Classbook];
+			const uint32_t classwords = classbook.Dimensions;
+
+			for (unsigned int pass = 0; pass < 8; pass++)
+				for (uint32_t partition = 0; partition < partitionCount;)
+				{
+					if (pass == 0)	//The classifications of the next classwords partitions
+						for (unsigned int j = 0; j < vectorCount; j++)
+						{
+							if (bDoNotDecode[j])
+								continue;
+
+							int value = classbook.DecodeScalar(reader);
+							if (value < 0)
+								return;	//The rest of the residue is zero if the packet ends
+
+							uint8_t* classifications = &Classifications[j * ClassificationStride + partition];
+							for (int i = static_cast<int>(classwords) - 1; i >= 0; i--)
+							{
+								classifications[i] = static_cast<uint8_t>(value % residue.ClassificationCount);
+								value /= residue.ClassificationCount;
+							}
+						}
+
+					for (uint32_t i = 0; i < classwords && partition < partitionCount; i++, partition++)
+						for (unsigned int j = 0; j < vectorCount; j++)
+						{
+							if (bDoNotDecode[j])
+								continue;
+
+							const int book = residue.Books[Classifications[j * ClassificationStride + partition] * 8 + pass];
+							if (book < 0)
+								continue;
+
+							const Codebook& codebook = Codebooks[book];
+							float* output = vectors[j] + begin + partition * residue.PartitionSize;
+							if (residue.Type == 0)	//The values of a vector are spread over the partition
+							{
+								const uint32_t step = residue.PartitionSize / codebook.Dimensions;
+								for (uint32_t k = 0; k < step; k++)
+								{
+									const float* values = codebook.DecodeVector(reader);
+									if (!values)
+										return;
+									for (uint32_t d = 0; d < codebook.Dimensions; d++)
+										output[k + d * step] += values[d];
+								}
+							}
+							else
+								for (uint32_t k = 0; k < residue.PartitionSize;)
+								{
+									const float* values = codebook.DecodeVector(reader);
+									if (!values)
+										return;
+									for (uint32_t d = 0; d < codebook.Dimensions && k < residue.PartitionSize; d++)
+										output[k++] += values[d];
+								}
+						}
+				}
+		}
+
+		void VorbisStream::ApplyWindow(float* block, bool bLongBlock, bool bPreviousLong, bool bNextLong) const
+		{
+			const unsigned int n = BlockSizes[bLongBlock], shortN = BlockSizes[0];
+
+			//A long block next to a short one has the slope of the short window, centered on its quarter
+			const bool bLongLeft = bLongBlock && bPreviousLong, bLongRight = bLongBlock && bNextLong;
+			const unsigned int leftStart = (bLongBlock && !bPreviousLong) ? (n / 4 - shortN / 4) : (0);
+			const unsigned int rightStart = (bLongBlock && !bNextLong) ? (3 * n / 4 - shortN / 4) : (n / 2);
+			const std::vector<float>& leftSlope = WindowSlopes[bLongLeft], & rightSlope = WindowSlopes[bLongRight];
+			const unsigned int leftN = static_cast<unsigned int>(leftSlope.size()), rightN = static_cast<unsigned int>(rightSlope.size());
+
+			std::fill(block, block + leftStart, 0.0f);
+			for (unsigned int i = 0; i < leftN; i++)
+				block[leftStart + i] *= leftSlope[i];
+			for (unsigned int i = 0; i < rightN; i++)
+				block[rightStart + i] *= rightSlope[rightN - 1 - i];
+			std::fill(block + rightStart + rightN, block + n, 0.0f);
+		}
+	}
+}
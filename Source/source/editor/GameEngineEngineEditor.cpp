@@ -14,6 +14,8 @@
 #include <scene/PawnActor.h>
 #include <scene/Controller.h>
 #include <input/InputDevicesStateRetriever.h>
+#include <utility/Profiler.h>
+#include <utility/MemoryArena.h>
 #include <whereami.h>
 #include <map>
 
@@ -40,7 +42,8 @@ namespace GEE
 		EditorScene(nullptr),
 		SelectedComp(nullptr),
 		SelectedActor(nullptr),
-		SelectedScene(nullptr)
+		SelectedScene(nullptr),
+		bProfilerOverlay(false)
 		//CanvasContext(nullptr)
 	{
 		{
@@ -269,6 +272,9 @@ namespace GEE
 
 					window.AddField("Default font").GetTemplates().PathInput([this](const std::string& path) { Fonts.push_back(std::make_shared<Font>(*DefaultFont)); *DefaultFont = *EngineDataLoader::LoadFont(*this, path); }, [this]() {return GetDefaultFont()->GetPath(); }, { "*.ttf", "*.otf" });
 					window.AddField("Rebuild light probes").CreateChild<UIButtonActor>("RebuildProbesButton", "Rebuild", [this]() { RenderEng.PreLoopPass(); });
+					window.AddField("Stream in cells").CreateChild<UIButtonActor>("PartitionSceneButton", "Partition", [this]() { if (GetMainScene() && SceneStreamingManager::PartitionScene(*GetMainScene(), ProjectFilepath) > 0) SaveProject(); });
+					window.AddField("Profiler overlay (F3)").GetTemplates().TickBox([this]() -> bool { return (bProfilerOverlay = !bProfilerOverlay); });
+					window.AddField("Profiler trace").CreateChild<UIButtonActor>("ExportTraceButton", "Export", [this]() { Profiler::Get().ExportChromeTrace(ExecutableFolder + "/profiler_trace.json"); });
 					UIAutomaticListActor& aaSelectionList = window.AddField("Anti-aliasing").CreateChild<UIAutomaticListActor>("AASelectionList", Vec3f(2.0f, 0.0f, 0.0f));
 
 					std::function<void(AntiAliasingType)> setAAFunc = [this](AntiAliasingType type) { const_cast<GameSettings::VideoSettings&>(ViewportRenderCollection->GetSettings()).AAType = type; UpdateSettings(); };
@@ -402,9 +408,9 @@ namespace GEE
 			return;
 		}
 
-		while (std::shared_ptr<Event> polledEvent = EventHolderObj.PollEvent())
+		while (const Event* polledEvent = EventHolderObj.PollEvent())
 		{
-			if (polledEvent->GetType() == EventType::KEY_PRESSED && dynamic_cast<KeyEvent&>(*polledEvent).GetKeyCode() == Key::TAB)
+			if (polledEvent->GetType() == EventType::KEY_PRESSED && dynamic_cast<const KeyEvent&>(*polledEvent).GetKeyCode() == Key::TAB)
 			{
 				std::cout << "Pressed TAB!\n";
 				bool sceneChanged = false;
@@ -436,7 +442,9 @@ namespace GEE
 					for (auto& it : Scenes)
 						it->RootActor->HandleEventAll(Event(EventType::FOCUS_SWITCHED));
 			}
-			else if (polledEvent->GetType() == EventType::KEY_PRESSED && dynamic_cast<KeyEvent&>(*polledEvent).GetKeyCode() == Key::S && GetInputRetriever().IsKeyPressed(Key::LEFT_CONTROL))
+			else if (polledEvent->GetType() == EventType::KEY_PRESSED && dynamic_cast<const KeyEvent&>(*polledEvent).GetKeyCode() == Key::F3)
+				bProfilerOverlay = !bProfilerOverlay;
+			else if (polledEvent->GetType() == EventType::KEY_PRESSED && dynamic_cast<const KeyEvent&>(*polledEvent).GetKeyCode() == Key::S && GetInputRetriever().IsKeyPressed(Key::LEFT_CONTROL))
 			{
 				SaveProject();
 				std::cout << "Project " << ProjectName << " saved.\n";
@@ -817,9 +825,26 @@ namespace GEE
 				RenderEng.FullSceneRender(info, meshPreviewScene->GetRenderData(), &renderTbCollection.GetTb<FinalRenderTargetToolbox>()->GetFinalFramebuffer());
 			}
 
+		if (bProfilerOverlay)
+			RenderProfilerOverlay();
+
 		glfwSwapBuffers(Window);
 	}
 
+	void GameEngineEngineEditor::RenderProfilerOverlay()
+	{
+		std::vector<std::string> lines = Profiler::Get().GetFrameSummary();
+		if (lines.empty())
+			return;
+		std::vector<std::string> memoryLines = MemoryTracker::Get().GetSummary();
+		lines.insert(lines.end(), memoryLines.begin(), memoryLines.end());
+
+		GEE_FB::getDefaultFramebuffer(Settings->WindowSize).Bind(true);
+		const float lineHeight = 20.0f;
+		for (int i = 0; i < static_cast<int>(lines.size()); i++)
+			RenderEng.RenderText(RenderInfo(*HUDRenderCollection), *GetDefaultFont(), lines[i], Transform(glm::vec3(8.0f, static_cast<float>(Settings->WindowSize.y) - lineHeight * static_cast<float>(i + 1), 0.0f), glm::vec3(0.0f), glm::vec3(lineHeight / 2.0f)), glm::vec3(1.0f, 0.9f, 0.2f), nullptr, true);
+	}
+
 	void GameEngineEngineEditor::LoadProject(const std::string& filepath)
 	{
 		ProjectFilepath = filepath;
@@ -844,6 +869,11 @@ namespace GEE
 			ProjectFilepath = ProjectFilepath.substr(0, ProjectFilepath.find(".geeprojectold")) + ".json";
 		std::cout << "Saving project to path " << ProjectFilepath << "\n";
 
+		SceneStreamingManager* streaming = GetMainScene()->GetStreamingManager();
+		std::vector<std::unique_ptr<Actor>> streamedCells;	//Streamed actors are saved to the chunks of their cells, not to the project file
+		if (streaming)
+			streamedCells = streaming->DetachLoadedCells();
+
 		std::ofstream serializationStream(ProjectFilepath);
 		{
 			try
@@ -860,6 +890,9 @@ namespace GEE
 		}
 		serializationStream.close();
 
+		if (streaming)
+			streaming->AttachCells(std::move(streamedCells));
+
 		UpdateRecentProjects();
 
 		std::cout << "Project " + ProjectName + " (" + ProjectFilepath + ") saved successfully.\n";
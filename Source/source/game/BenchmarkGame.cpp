@@ -0,0 +1,246 @@
+#include <game/BenchmarkGame.h>
+#include <assetload/FileLoader.h>
+#include <rendering/NullGLDevice.h>
+#include <rendering/RenderToolbox.h>
+#include <animation/CPUSkinning.h>
+#include <audio/SoundStream.h>
+#include <scene/CameraComponent.h>
+#include <utility/Profiler.h>
+#include <utility/JobSystem.h>
+#include <utility/MemoryArena.h>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+namespace GEE
+{
+	bool BenchmarkSettings::ParseArguments(int argc, char** argv, int firstArgument)
+	{
+		for (int i = firstArgument; i < argc; i++)
+		{
+			const std::string argument = argv[i];
+			const bool hasValue = i + 1 < argc;
+
+			if (argument == "--frames" && hasValue)
+				MeasuredFrames = static_cast<unsigned int>(std::stoul(argv[++i]));
+			else if (argument == "--warmup" && hasValue)
+				WarmupFrames = static_cast<unsigned int>(std::stoul(argv[++i]));
+			else if (argument == "--trace" && hasValue)
+				TraceFilepath = argv[++i];
+			else if (argument == "--replay" && hasValue)
+				ReplayFilepath = argv[++i];
+			else if (ProjectFilepath.empty() && argument.rfind("--", 0) != 0)
+				ProjectFilepath = argument;
+			else
+			{
+				std::cout << "ERROR! Unknown benchmark argument " << argument << ".\n";
+				return false;
+			}
+		}
+
+		if (ProjectFilepath.empty() || MeasuredFrames == 0)
+		{
+			std::cout << "ERROR! Usage: --bench <project> [--frames N] [--warmup N] [--trace path] [--replay path]\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	BenchmarkGame::BenchmarkGame(const GameSettings& settings) :
+		Game(settings.Video.Shading, settings),
+		SceneRenderCollection(nullptr)
+	{
+		Settings = std::make_unique<GameSettings>(settings);
+	}
+
+	void BenchmarkGame::Init(GLFWwindow* window)
+	{
+		Game::Init(window);
+		Profiler::Get().SetGpuTimingEnabled(false);	//The null device measures nothing
+		SceneRenderCollection = &RenderEng.AddRenderTbCollection(RenderToolboxCollection("BenchmarkRenderCollection", Settings->Video));
+	}
+
+	std::vector<GameScene*> BenchmarkGame::GetScenes()
+	{
+		std::vector<GameScene*> scenes(Scenes.size());
+		std::transform(Scenes.begin(), Scenes.end(), scenes.begin(), [](std::unique_ptr<GameScene>& sceneVec) { return sceneVec.get(); });
+		return scenes;
+	}
+
+	void BenchmarkGame::Render()
+	{
+		RenderEng.PrepareFrame();
+
+		if (GetMainScene() && GetMainScene()->GetActiveCamera())
+		{
+			RenderInfo info = GetMainScene()->GetActiveCamera()->GetRenderInfo(*SceneRenderCollection);
+			RenderEng.PrepareScene(*SceneRenderCollection, GetMainScene()->GetRenderData());
+			RenderEng.FullSceneRender(info, GetMainScene()->GetRenderData(), &SceneRenderCollection->GetTb<FinalRenderTargetToolbox>()->GetFinalFramebuffer());
+		}
+
+		RenderEng.PostFrame();
+	}
+
+	int BenchmarkGame::Run(const BenchmarkSettings& benchSettings)
+	{
+		if (!NullGLDevice::Load())
+			return 1;
+
+		GameSettings settings = EngineDataLoader::LoadSettingsFromFile<GameSettings>("Settings.ini");
+		settings.Video.Resolution = settings.WindowSize;
+		settings.Video.Shading = ShadingModel::SHADING_PBR_COOK_TORRANCE;
+
+		BenchmarkGame game(settings);
+		game.Init(nullptr);
+		game.LoadSceneFromFile(benchSettings.ProjectFilepath, "GEE_Main");
+		GameScene* mainScene = game.GetScene("GEE_Main");
+		if (!mainScene)
+		{
+			std::cout << "ERROR! Could not load project " << benchSettings.ProjectFilepath << ".\n";
+			return 1;
+		}
+		game.SetMainScene(mainScene);
+		game.SetActiveScene(mainScene);
+
+		if (!mainScene->GetActiveCamera())
+			if (Actor* camActor = mainScene->FindActor("CameraActor"))
+				if (CameraComponent* camera = camActor->GetRoot()->GetComponent<CameraComponent>("Camera"))
+					mainScene->BindActiveCamera(camera);
+		if (!mainScene->GetActiveCamera())
+			std::cout << "INFO: The benchmarked scene has no active camera - only the update will be measured.\n";
+
+		game.PreGameLoop();
+
+		if (!benchSettings.ReplayFilepath.empty() && !game.StartInputReplay(benchSettings.ReplayFilepath))
+			return 1;
+		const bool bReplay = game.IsReplayingInput();	//Measure until the recording ends instead of a fixed number of frames
+
+		const float timeStep = 1.0f / 60.0f;
+		for (unsigned int i = 0; i < benchSettings.WarmupFrames && !bReplay; i++)	//Warmup frames would advance the simulation past the state the input was recorded in
+			game.GameLoopIteration(timeStep, timeStep);
+
+		struct ScopeStats
+		{
+			const char* Name;
+			unsigned int Depth;
+			double TotalUs;
+		};
+		std::vector<ScopeStats> scopeStats;	//In the order of first appearance, which follows the structure of the frame
+		std::vector<double> frameTimesUs;
+		frameTimesUs.reserve(benchSettings.MeasuredFrames);
+		std::array<unsigned long long, NullGLCounterCount> commandTotals{};
+
+		ProfilerFrame frame;
+		unsigned int measuredFrames = 0;
+		const bool bCheckAllocations = !bReplay && benchSettings.WarmupFrames > 0;	//Without warmup frames, caches and pools are still being filled
+		unsigned int allocatingFrames = 0;
+		unsigned long long maxFrameAllocations = 0;
+		bool bFinished = false;
+		for (unsigned int i = 0; (bReplay) ? (!bFinished) : (i <= benchSettings.MeasuredFrames); i++)	//The profiler completes a frame when the next one begins, so every frame is collected one iteration later
+		{
+			NullGLDevice::ResetCounters();
+			const unsigned long long allocationsBefore = MemoryTracker::GetHeapAllocationCount();	//Counted around the iteration only, so the bookkeeping of the benchmark is not included
+			bFinished = game.GameLoopIteration(timeStep, timeStep);
+			const unsigned long long frameAllocations = MemoryTracker::GetHeapAllocationCount() - allocationsBefore;
+			if (frameAllocations > 0)
+			{
+				allocatingFrames++;
+				maxFrameAllocations = std::max(maxFrameAllocations, frameAllocations);
+			}
+			if (bFinished)
+				Profiler::Get().NewFrame();	//The last iteration of a replay does not begin a frame
+			else if (bReplay || i < benchSettings.MeasuredFrames)
+			{
+				measuredFrames++;
+				for (unsigned int counter = 0; counter < NullGLCounterCount; counter++)
+					commandTotals[counter] += NullGLDevice::GetCounter(static_cast<NullGLCounter>(counter));
+			}
+
+			if (i == 0 || !Profiler::Get().GetFrame(0, frame))
+				continue;
+
+			frameTimesUs.push_back(frame.EndUs - frame.BeginUs);
+			for (const ProfilerScopeRecord& scope : frame.CpuScopes)
+			{
+				auto found = std::find_if(scopeStats.begin(), scopeStats.end(), [&scope](const ScopeStats& stats) { return stats.Depth == scope.Depth && std::strcmp(stats.Name, scope.Name) == 0; });
+				if (found == scopeStats.end())
+					found = scopeStats.insert(scopeStats.end(), ScopeStats{ scope.Name, scope.Depth, 0.0 });
+				found->TotalUs += scope.EndUs - scope.BeginUs;
+			}
+		}
+
+		if (frameTimesUs.empty() || measuredFrames == 0)
+		{
+			std::cout << "ERROR! No frames were profiled. Is profiling compiled out?\n";
+			return 1;
+		}
+
+		std::vector<double> sortedTimes = frameTimesUs;
+		std::sort(sortedTimes.begin(), sortedTimes.end());
+		double totalUs = 0.0;
+		for (double time : frameTimesUs)
+			totalUs += time;
+		const double frameCount = static_cast<double>(frameTimesUs.size());
+
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "Benchmark: " << benchSettings.ProjectFilepath << ", " << frameTimesUs.size() << " frames";
+		if (bReplay)
+			std::cout << " replaying " << benchSettings.ReplayFilepath << '\n';
+		else
+			std::cout << " after " << benchSettings.WarmupFrames << " warmup frames\n";
+		std::cout << "CPU frame time (ms): avg " << totalUs / frameCount / 1000.0 << ", median " << sortedTimes[sortedTimes.size() / 2] / 1000.0 << ", p95 " << sortedTimes[static_cast<size_t>(0.95 * (frameCount - 1.0))] / 1000.0 << ", min " << sortedTimes.front() / 1000.0 << ", max " << sortedTimes.back() / 1000.0 << '\n';
+		std::cout << "CPU time per frame by scope (ms):\n";
+		for (const ScopeStats& stats : scopeStats)
+			std::cout << std::string(2 * (stats.Depth + 1), ' ') << stats.Name << ": " << stats.TotalUs / frameCount / 1000.0 << '\n';
+
+		const char* commandNames[NullGLCounterCount] = { "Draw calls", "Clears", "Binds", "State changes", "Bytes uploaded", "Objects created" };
+		std::cout << "GL commands per frame:\n" << std::setprecision(1);
+		for (unsigned int counter = 0; counter < NullGLCounterCount; counter++)
+			std::cout << "  " << commandNames[counter] << ": " << static_cast<double>(commandTotals[counter]) / static_cast<double>(measuredFrames) << '\n';
+
+		if (!benchSettings.TraceFilepath.empty() && !Profiler::Get().ExportChromeTrace(benchSettings.TraceFilepath))
+			std::cout << "ERROR! Could not write the trace to " << benchSettings.TraceFilepath << ".\n";
+
+		std::cout << "Heap allocations: " << allocatingFrames << " frames allocated, at most " << maxFrameAllocations << " times\n";
+		bool bPassed = true;
+		if (bCheckAllocations && allocatingFrames > 0)
+		{
+			std::cout << "ERROR! " << allocatingFrames << " frames after the warmup allocated from the heap (at most " << maxFrameAllocations << " times in a frame).\n";
+			bPassed = false;
+		}
+
+		return (RunSubsystemBenchmarks(*mainScene) && bPassed) ? (0) : (1);
+	}
+
+	bool BenchmarkGame::RunSubsystemBenchmarks(GameScene& scene)
+	{
+		bool bPassed = true;
+		std::cout << "Subsystems:\n" << std::setprecision(3);
+
+		const float skinningError = CPUSkinning::ValidateSIMDKernel();
+		const float maxSkinningError = 1.0e-3f;	//The kernels only differ in the order of floating point operations
+		std::cout << "  CPU skinning (65536 vertices, " << CPUSkinning::GetSIMDKernelName() << " kernel): scalar " << CPUSkinning::BenchmarkKernel(false) << " ms, SIMD " << CPUSkinning::BenchmarkKernel(true) << " ms, max difference " << skinningError << '\n';
+		if (!(skinningError <= maxSkinningError))
+		{
+			std::cout << "ERROR! The SIMD skinning kernel differs from the scalar reference by " << skinningError << " (more than " << maxSkinningError << ").\n";
+			bPassed = false;
+		}
+
+		const unsigned int jobCount = 100000;
+		std::cout << "  Job scheduling (" << jobCount << " empty jobs): " << JobSystem::BenchmarkSchedulingOverhead(jobCount) << " us per job\n";
+
+		for (const std::string& streamedFilepath : { "Sounds/shotgun.wav", "Sounds/shotgun.ogg" })	//The same sound through both decoders
+		{
+			const bool bStreamValid = Audio::SoundStream::ValidatePlayback(*scene.GetGameHandle()->GetJobSystem(), streamedFilepath);
+			std::cout << "  Audio streaming (" << streamedFilepath << " on a loopback device): " << ((bStreamValid) ? ("played whole") : ("FAILED")) << '\n';
+			if (!bStreamValid)
+				bPassed = false;
+		}
+
+		const unsigned int eventActorCount = 10000, eventListenerCount = 10, eventCount = 1000;
+		std::cout << "  Event dispatch (" << eventActorCount << " actors, " << eventListenerCount << " listeners): " << scene.BenchmarkEventDispatch(eventActorCount, eventListenerCount, eventCount) << " us per event\n";
+
+		return bPassed;
+	}
+}
@@ -5,6 +5,8 @@
 #include <scene/Controller.h>
 #include <scene/Actor.h>
 #include <input/InputDevicesStateRetriever.h>
+#include <utility/Profiler.h>
+#include <utility/MemoryArena.h>
 #include <thread>
 
 namespace GEE
@@ -18,6 +20,7 @@ namespace GEE
 	Controller* mouseController = nullptr;  //there are 2 similiar camera variables: ActiveCamera and global MouseController. the first one is basically the camera we use to see the world (view mat); the second one is updated by mouse controls.
 											//this is a shitty comment that doesnt fit since a few months ago but i dont want to erase it
 	EventHolder* GLFWEventProcessor::TargetHolder = nullptr;
+	InputRecorder* GLFWEventProcessor::Recorder = nullptr;
 
 	void APIENTRY debugOutput(GLenum source,	//Copied from learnopengl.com - I don't think it's worth it to rewrite a bunch of couts.
 		GLenum type,
@@ -82,35 +85,51 @@ namespace GEE
 		DebugMode = true;
 		LoopBeginTime = 0.0f;
 		TimeAccumulator = 0.0f;
+		FixedStepIndex = 0;
 
 		GEE_FB::Framebuffer DefaultFramebuffer;
 	}
 
+	Game::~Game()
+	{
+		Scenes.clear();	//Components release their sound buffers and physics actors when they are destroyed, so the scenes must be destroyed before the engines
+	}
+
 	void Game::Init(GLFWwindow* window)
 	{
 		Window = window;
-		glfwSetWindowSize(Window, Settings->WindowSize.x, Settings->WindowSize.y);
+		GLFWEventProcessor::TargetHolder = &EventHolderObj;
+		GLFWEventProcessor::Recorder = &Recorder;
 
-		if (Settings->bWindowFullscreen)
-			glfwSetWindowMonitor(Window, glfwGetPrimaryMonitor(), 0, 0, Settings->WindowSize.x, Settings->WindowSize.y, 60);
+		if (Window)	//Headless games (e.g. benchmarks running on the null GL device) have no window
+		{
+			glfwSetWindowSize(Window, Settings->WindowSize.x, Settings->WindowSize.y);
 
-		if (!Settings->Video.bVSync)
-			glfwSwapInterval(0);
+			if (Settings->bWindowFullscreen)
+				glfwSetWindowMonitor(Window, glfwGetPrimaryMonitor(), 0, 0, Settings->WindowSize.x, Settings->WindowSize.y, 60);
 
-		GLFWEventProcessor::TargetHolder = &EventHolderObj;
+			if (!Settings->Video.bVSync)
+				glfwSwapInterval(0);
 
-		glfwSetInputMode(Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-		glfwSetCursorPos(Window, (double)Settings->WindowSize.x / 2.0, (double)Settings->WindowSize.y / 2.0);
+			glfwSetInputMode(Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+			glfwSetCursorPos(Window, (double)Settings->WindowSize.x / 2.0, (double)Settings->WindowSize.y / 2.0);
 
-		glfwSetCursorPosCallback(Window, GLFWEventProcessor::CursorPosCallback);
-		glfwSetMouseButtonCallback(Window, GLFWEventProcessor::MouseButtonCallback);
-		glfwSetKeyCallback(Window, GLFWEventProcessor::KeyPressedCallback);
-		glfwSetCharCallback(Window, GLFWEventProcessor::CharEnteredCallback);
-		glfwSetScrollCallback(Window, GLFWEventProcessor::ScrollCallback);
-		glfwSetDropCallback(Window, GLFWEventProcessor::FileDropCallback);
+			glfwSetCursorPosCallback(Window, GLFWEventProcessor::CursorPosCallback);
+			glfwSetMouseButtonCallback(Window, GLFWEventProcessor::MouseButtonCallback);
+			glfwSetKeyCallback(Window, GLFWEventProcessor::KeyPressedCallback);
+			glfwSetCharCallback(Window, GLFWEventProcessor::CharEnteredCallback);
+			glfwSetScrollCallback(Window, GLFWEventProcessor::ScrollCallback);
+			glfwSetDropCallback(Window, GLFWEventProcessor::FileDropCallback);
+		}
 
+		Jobs.Init();
+#ifdef _DEBUG
+		MemoryTracker::Get().SetSteadyStateCheck(true);
+#endif
 		RenderEng.Init(glm::uvec2(Settings->Video.Resolution.x, Settings->Video.Resolution.y));
-		PhysicsEng.Init();
+		PhysicsEng.Init(Jobs, Settings->PhysicsWorkerCount);
+		PhysicsEng.SetAsyncSimulation(Settings->bAsyncPhysics);
+		AudioEng.SetCacheFilesEnabled(Settings->bCacheDecodedAudio);
 
 		DefaultFont = EngineDataLoader::LoadFont(*this, "fonts/Atkinson-Hyperlegible-Regular-102.otf");
 
@@ -162,7 +181,10 @@ namespace GEE
 	void Game::PassMouseControl(Controller* controller)
 	{
 		mouseController = controller;
+		Recorder.RecordMouseControl(controller != nullptr);
 
+		if (!Window)
+			return;
 		if (!mouseController)
 			glfwSetInputMode(Window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
 		else
@@ -189,7 +211,10 @@ namespace GEE
 
 	InputDevicesStateRetriever Game::GetInputRetriever()
 	{
-		return InputDevicesStateRetriever(*Window);
+		if (Replayer)
+			return InputDevicesStateRetriever(*Replayer);
+
+		return InputDevicesStateRetriever(Window);
 	}
 
 	Physics::PhysicsEngineManager* Game::GetPhysicsHandle()
@@ -207,6 +232,11 @@ namespace GEE
 		return &AudioEng;
 	}
 
+	JobSystem* Game::GetJobSystem()
+	{
+		return &Jobs;
+	}
+
 	GameSettings* Game::GetGameSettings()
 	{
 		return Settings.get();
@@ -272,6 +302,7 @@ namespace GEE
 		const float timeStep = 1.0f / 60.0f;
 		float deltaTime = 0.0f;
 		TimeAccumulator = 0.0f;
+		FixedStepIndex = 0;
 
 		LoopBeginTime = (float)glfwGetTime();
 
@@ -285,14 +316,29 @@ namespace GEE
 
 	bool Game::GameLoopIteration(float timeStep, float deltaTime)
 	{
-		if (glfwWindowShouldClose(Window))
+		if (Window && glfwWindowShouldClose(Window))
 			return true;
 
-		glfwPollEvents();
+		if (Replayer)
+		{
+			if (Replayer->IsFinished(FixedStepIndex))
+				return true;
+
+			timeStep = deltaTime = Replayer->GetRecording().TimeStep;
+		}
 
+		Profiler::Get().NewFrame();
+		MemoryArenas::NewFrame();
+		Recorder.BeginFrame(FixedStepIndex);
+		if (Replayer)
+			FeedReplayedInput();
+		else if (Window)
+		{
+			glfwPollEvents();
 
-		if (glfwGetKey(Window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-			glfwSetWindowShouldClose(Window, true);
+			if (glfwGetKey(Window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+				glfwSetWindowShouldClose(Window, true);
+		}
 
 		if (deltaTime > 0.25f)
 			deltaTime = 0.25f;
@@ -319,26 +365,113 @@ namespace GEE
 			std::cout << "OpenGL Error: " << error << ".\n";
 		}
 
-		HandleEvents();
+		{
+			GEE_PROFILE_SCOPE("HandleEvents");
+			HandleEvents();
+		}
 
 		TimeAccumulator += deltaTime;
 
 		while (TimeAccumulator >= timeStep)
 		{
 			Update(timeStep);
+			FixedStepIndex++;
 
 			TimeAccumulator -= timeStep;
 		}
+		RenderEng.GetRenderSnapshot().SetAlpha(TimeAccumulator / timeStep);	//Render between the two most recent simulation states
 
-		Render();
+		Jobs.RunMainThreadJobs();	//GL work scheduled by jobs during the update
+		{
+			GEE_PROFILE_SCOPE("Render");
+			Render();
+		}
 		ticks++;
 
 		return false;
 	}
 
+	void Game::StartInputRecording(float timeStep)
+	{
+		if (Replayer)
+		{
+			std::cout << "ERROR! Input cannot be recorded while it is being replayed.\n";
+			return;
+		}
+
+		FixedStepIndex = 0;		//Recorded step indices are relative to the beginning of the recording
+		TimeAccumulator = 0.0f;
+		Recorder.Start(timeStep, Settings->WindowSize);
+		Recorder.BeginFrame(FixedStepIndex);
+		Recorder.RecordMouseControl(mouseController != nullptr);	//The initial state
+	}
+
+	bool Game::StopInputRecording(const std::string& filepath)
+	{
+		if (!Recorder.IsRecording())
+			return false;
+
+		Recorder.BeginFrame(FixedStepIndex);	//Include the steps done since the last frame began
+		Recorder.Stop();
+		std::cout << "INFO: Recorded " << Recorder.GetRecording().Records.size() << " inputs over " << Recorder.GetRecording().StepCount << " steps to " << filepath << ".\n";
+		return Recorder.GetRecording().SaveToFile(filepath);
+	}
+
+	bool Game::StartInputReplay(const std::string& filepath)
+	{
+		InputRecording recording;
+		if (!recording.LoadFromFile(filepath))
+			return false;
+
+		Recorder.Stop();
+		Replayer = std::make_unique<InputReplayer>(std::move(recording));
+		FixedStepIndex = 0;
+		TimeAccumulator = 0.0f;
+		std::cout << "INFO: Replaying " << Replayer->GetRecording().Records.size() << " inputs over " << Replayer->GetRecording().StepCount << " steps from " << filepath << ".\n";
+		return true;
+	}
+
+	bool Game::IsReplayingInput() const
+	{
+		return Replayer != nullptr;
+	}
+
+	void Game::FeedReplayedInput()
+	{
+		while (const InputRecord* record = Replayer->PollRecord(FixedStepIndex))
+		{
+			switch (record->Type)
+			{
+			case InputRecordType::EVENT:
+				InputReplayer::VisitEvent(*record, [this](const auto& ev) { EventHolderObj.PushEvent(ev); });
+				break;
+			case InputRecordType::MOUSE_LOOK:
+				if (mouseController)
+					mouseController->RotateWithMouse(glm::vec2(record->X, record->Y));
+				break;
+			case InputRecordType::MOUSE_CONTROL:
+				if (record->X == 0.0f)
+					PassMouseControl(nullptr);
+				else if (!mouseController && GetMainScene())	//The controller might have been bound by something that is not replayed (e.g. the editor) - bind the one the editor would
+				{
+					Controller* controller = dynamic_cast<Controller*>(GetMainScene()->FindActor("MojTestowyController"));
+					if (!controller)
+					{
+						std::vector<Controller*> controllers;
+						GetMainScene()->GetRootActor()->GetAllActors(&controllers);
+						if (!controllers.empty())
+							controller = controllers[0];
+					}
+					PassMouseControl(controller);
+				}
+				break;
+			}
+		}
+	}
+
 	void Game::HandleEvents()
 	{
-		while (std::shared_ptr<Event> polledEvent = EventHolderObj.PollEvent())
+		while (const Event* polledEvent = EventHolderObj.PollEvent())
 		{
 			for (int i = 0; i < static_cast<int>(Scenes.size()); i++)
 				Scenes[i]->RootActor->HandleEventAll(*polledEvent);
@@ -347,13 +480,34 @@ namespace GEE
 
 	void Game::Update(float deltaTime)
 	{
+		GEE_PROFILE_SCOPE("Update");
 		DUPA::AnimTime += deltaTime;
-		PhysicsEng.Update(deltaTime);
+		{
+			GEE_PROFILE_SCOPE("Physics");
+			PhysicsEng.Update(deltaTime);	//In the asynchronous mode it only waits for the step started at the end of the previous update
+		}
 
 		for (int i = 0; i < static_cast<int>(Scenes.size()); i++)
+		{
+			GEE_PROFILE_SCOPE("Scene");
 			Scenes[i]->Update(deltaTime);
+		}
 
-		AudioEng.Update();
+		{
+			GEE_PROFILE_SCOPE("PhysicsSimulate");
+			PhysicsEng.Simulate(deltaTime);	//Executes the deferred scene queries; in the asynchronous mode the step is simulated while the rest of the frame is rendered
+		}
+
+		{
+			GEE_PROFILE_SCOPE("Audio");
+			AudioEng.Update(deltaTime);
+		}
+
+		RenderSnapshot& snapshot = RenderEng.GetRenderSnapshot();
+		snapshot.BeginCapture();
+		for (int i = 0; i < static_cast<int>(Scenes.size()); i++)
+			if (!Scenes[i]->IsBeingKilled())
+				snapshot.Capture(*Scenes[i]->GetRenderData(), Scenes[i]->GetActiveCamera());
 	}
 	void Game::SetMainScene(GameScene* scene)
 	{
@@ -371,7 +525,7 @@ namespace GEE
 
 	void GLFWEventProcessor::CursorPosCallback(GLFWwindow* window, double xpos, double ypos)
 	{
-		TargetHolder->Events.push(std::make_shared<CursorMoveEvent>(CursorMoveEvent(EventType::MOUSE_MOVED, glm::vec2(static_cast<float>(xpos), static_cast<float>(ypos)))));
+		PushEvent(CursorMoveEvent(EventType::MOUSE_MOVED, glm::vec2(static_cast<float>(xpos), static_cast<float>(ypos))));
 
 		if (!mouseController || !TargetHolder)
 			return;
@@ -380,22 +534,24 @@ namespace GEE
 		glfwGetWindowSize(window, &halfWindowSize.x, &halfWindowSize.y);
 		halfWindowSize /= 2;
 		glfwSetCursorPos(window, (double)halfWindowSize.x, (double)halfWindowSize.y);
-		mouseController->RotateWithMouse(glm::vec2(xpos - (float)halfWindowSize.x, ypos - (float)halfWindowSize.y)); //Implement it as an Event instead! TODO
+		const glm::vec2 offset(xpos - (float)halfWindowSize.x, ypos - (float)halfWindowSize.y);
+		Recorder->RecordMouseLook(offset);
+		mouseController->RotateWithMouse(offset); //Implement it as an Event instead! TODO
 	}
 
 	void GLFWEventProcessor::MouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
 	{
-		TargetHolder->Events.push(std::make_shared<MouseButtonEvent>(MouseButtonEvent((action == GLFW_PRESS) ? (EventType::MOUSE_PRESSED) : (EventType::MOUSE_RELEASED), static_cast<MouseButton>(button), mods)));
+		PushEvent(MouseButtonEvent((action == GLFW_PRESS) ? (EventType::MOUSE_PRESSED) : (EventType::MOUSE_RELEASED), static_cast<MouseButton>(button), mods));
 	}
 
 	void GLFWEventProcessor::KeyPressedCallback(GLFWwindow*, int key, int scancode, int action, int mods)
 	{
-		TargetHolder->Events.push(std::make_shared<KeyEvent>(KeyEvent((action == GLFW_PRESS) ? (EventType::KEY_PRESSED) : ((action == GLFW_REPEAT) ? (EventType::KEY_REPEATED) : (EventType::KEY_RELEASED)), static_cast<Key>(key), mods)));
+		PushEvent(KeyEvent((action == GLFW_PRESS) ? (EventType::KEY_PRESSED) : ((action == GLFW_REPEAT) ? (EventType::KEY_REPEATED) : (EventType::KEY_RELEASED)), static_cast<Key>(key), mods));
 	}
 
 	void GLFWEventProcessor::CharEnteredCallback(GLFWwindow*, unsigned int codepoint)
 	{
-		TargetHolder->Events.push(std::make_shared<CharEnteredEvent>(CharEnteredEvent(EventType::CHARACTER_ENTERED, codepoint)));
+		PushEvent(CharEnteredEvent(EventType::CHARACTER_ENTERED, codepoint));
 	}
 
 	void GLFWEventProcessor::ScrollCallback(GLFWwindow* window, double offsetX, double offsetY)
@@ -403,8 +559,8 @@ namespace GEE
 		std::cout << "Scrolled " << offsetX << ", " << offsetY << "\n";
 		glm::dvec2 cursorPos(0.0);
 		glfwGetCursorPos(window, &cursorPos.x, &cursorPos.y);
-		TargetHolder->Events.push(std::make_shared<MouseScrollEvent>(MouseScrollEvent(EventType::MOUSE_SCROLLED, glm::vec2(static_cast<float>(-offsetX), static_cast<float>(offsetY)))));
-		TargetHolder->Events.push(std::make_shared<CursorMoveEvent>(CursorMoveEvent(EventType::MOUSE_MOVED, glm::vec2(cursorPos))));	//When we scroll (e.g. a canvas), it is possible that some buttons or other objects relying on cursor position might be scrolled (moved) as well, so we need to create a CursorMoveEvent.
+		PushEvent(MouseScrollEvent(EventType::MOUSE_SCROLLED, glm::vec2(static_cast<float>(-offsetX), static_cast<float>(offsetY))));
+		PushEvent(CursorMoveEvent(EventType::MOUSE_MOVED, glm::vec2(cursorPos)));	//When we scroll (e.g. a canvas), it is possible that some buttons or other objects relying on cursor position might be scrolled (moved) as well, so we need to create a CursorMoveEvent.
 	}
 
 	void GLFWEventProcessor::FileDropCallback(GLFWwindow* window, int count, const char** paths)
@@ -10,9 +10,12 @@
 #include <physics/CollisionObject.h>
 #include <scene/hierarchy/HierarchyTree.h>
 #include <UI/UICanvas.h>
+#include <animation/AnimationManagerActor.h>
 
 #include <input/InputDevicesStateRetriever.h>
 #include <UI/UICanvasActor.h>
+#include <utility/Profiler.h>
+#include <chrono>
 
 namespace GEE
 {
@@ -79,6 +82,16 @@ namespace GEE
 		return AudioData.get();
 	}
 
+	ComponentUpdateScheduler& GameScene::GetUpdateScheduler()
+	{
+		return UpdateScheduler;
+	}
+
+	SceneStreamingManager* GameScene::GetStreamingManager()
+	{
+		return Streaming.get();
+	}
+
 	GameManager* GameScene::GetGameHandle()
 	{
 		return GameHandle;
@@ -107,6 +120,11 @@ namespace GEE
 		PostLoadLambdas.push_back(postLoadLambda);
 	}
 
+	void GameScene::SetStreamingManager(std::unique_ptr<SceneStreamingManager> streaming)
+	{
+		Streaming = std::move(streaming);
+	}
+
 	void GameScene::AddBlockingCanvas(UICanvas& canvas)
 	{
 		BlockingCanvases.push_back(&canvas);
@@ -123,19 +141,24 @@ namespace GEE
 		return CurrentBlockingCanvas;
 	}
 
-	std::string GameScene::GetUniqueActorName(const std::string& name) const
+	void GameScene::AddAnimationNotifySource(AnimationManagerComponent& animManager)
 	{
-		std::vector <Actor*> actorsWithSimilarNames;
-		bool sameNameExists = false;
-		std::function<void(Actor&)> getActorsWithSimilarNamesFunc = [&actorsWithSimilarNames, name, &getActorsWithSimilarNamesFunc, &sameNameExists](Actor& currentActor) { if (currentActor.GetName().rfind(name, 0) == 0) /* if currentActor's name stars with name */ { actorsWithSimilarNames.push_back(&currentActor); if (currentActor.GetName() == name) sameNameExists = true; }	for (auto& it : currentActor.GetChildren()) getActorsWithSimilarNamesFunc(*it); };
+		AnimationNotifySources.push_back(&animManager);
+	}
 
-		getActorsWithSimilarNamesFunc(*RootActor);
-		if (!sameNameExists)
+	void GameScene::EraseAnimationNotifySource(AnimationManagerComponent& animManager)
+	{
+		AnimationNotifySources.erase(std::remove(AnimationNotifySources.begin(), AnimationNotifySources.end(), &animManager), AnimationNotifySources.end());
+	}
+
+	std::string GameScene::GetUniqueActorName(const std::string& name) const
+	{
+		if (!ActorsIndex.Contains(name))
 			return name;
 
 		int addedIndex = 1;
 		std::string currentNameCandidate = name + std::to_string(addedIndex);
-		while (std::find_if(actorsWithSimilarNames.begin(), actorsWithSimilarNames.end(), [currentNameCandidate](Actor* actor) { return actor->GetName() == currentNameCandidate; }) != actorsWithSimilarNames.end())
+		while (ActorsIndex.Contains(currentNameCandidate))
 			currentNameCandidate = name + std::to_string(++addedIndex);
 
 		return currentNameCandidate;
@@ -149,17 +172,17 @@ namespace GEE
 	HierarchyTemplate::HierarchyTreeT& GameScene::CreateHierarchyTree(const std::string& name)
 	{
 		HierarchyTrees.push_back(std::make_unique<HierarchyTemplate::HierarchyTreeT>(HierarchyTemplate::HierarchyTreeT(*this, name)));
+		HierarchyTreesIndex.Add(HierarchyTrees.back()->GetName(), HierarchyTrees.back().get());
 		std::cout << "Utworzono drzewo z root " << &HierarchyTrees.back()->GetRoot() << " - " << HierarchyTrees.back()->GetName() << '\n';
 		return *HierarchyTrees.back();
 	}
 
 	HierarchyTemplate::HierarchyTreeT* GameScene::FindHierarchyTree(const std::string& name, HierarchyTemplate::HierarchyTreeT* treeToIgnore)
 	{
-		auto found = std::find_if(HierarchyTrees.begin(), HierarchyTrees.end(), [name, treeToIgnore](const std::unique_ptr<HierarchyTemplate::HierarchyTreeT>& tree) { return tree->GetName() == name && tree.get() != treeToIgnore; });
-		if (found != HierarchyTrees.end())
-			return (*found).get();
+		HierarchyTemplate::HierarchyTreeT* found = nullptr;
+		HierarchyTreesIndex.Find(name, found, [treeToIgnore](HierarchyTemplate::HierarchyTreeT* tree) { return tree != treeToIgnore; });
 
-		return nullptr;
+		return found;
 	}
 
 	void GameScene::HandleEventAll(const Event& ev)
@@ -174,7 +197,65 @@ namespace GEE
 		if (CurrentBlockingCanvas)
 			std::cout << dynamic_cast<UICanvasActor*>(CurrentBlockingCanvas)->GetName();
 		std::cout << '\n';*/
-		RootActor->HandleEventAll(ev);
+		if (RootActor->HasEventListenersInHierarchy(ev.GetType()))
+			RootActor->HandleEventAll(ev);
+	}
+
+	namespace
+	{
+		class EventBenchmarkActor : public Actor
+		{
+		public:
+			EventBenchmarkActor(GameScene& scene, Actor* parentActor, const std::string& name, unsigned int& handledCount) :
+				Actor(scene, parentActor, name),
+				HandledCount(handledCount)
+			{
+			}
+			virtual void HandleEvent(const Event&) override
+			{
+				HandledCount++;
+			}
+
+		private:
+			unsigned int& HandledCount;
+		};
+	}
+
+	double GameScene::BenchmarkEventDispatch(unsigned int actorCount, unsigned int listenerCount, unsigned int eventCount)
+	{
+		unsigned int handledCount = 0;
+		const unsigned int groupSize = std::max(static_cast<unsigned int>(glm::sqrt(static_cast<float>(actorCount))), 1u);
+		const unsigned int listenerSpacing = (listenerCount > 0) ? (std::max(actorCount / listenerCount, 1u)) : (actorCount + 1);
+
+		Actor& benchmarkRoot = RootActor->CreateChild<Actor>("GEE_Event_Benchmark");
+		Actor* group = nullptr;
+		for (unsigned int i = 0; i < actorCount; i++)
+		{
+			if (i % groupSize == 0)
+				group = &benchmarkRoot.CreateChild<Actor>("GEE_Event_Benchmark_Group" + std::to_string(i / groupSize));
+
+			EventBenchmarkActor& actor = group->CreateChild<EventBenchmarkActor>("GEE_Event_Benchmark_Actor" + std::to_string(i), handledCount);
+			if (i % listenerSpacing == 0 && i / listenerSpacing < listenerCount)
+				actor.SubscribeToEvent(EventType::MOUSE_MOVED);
+		}
+
+		const CursorMoveEvent ev(EventType::MOUSE_MOVED, glm::uvec2(0));
+		auto begin = std::chrono::high_resolution_clock::now();
+		for (unsigned int i = 0; i < eventCount; i++)
+			benchmarkRoot.HandleEventAll(ev);
+		auto end = std::chrono::high_resolution_clock::now();
+
+		std::cout << "INFO: Dispatched " << eventCount << " events to " << actorCount << " actors; " << handledCount << " of the calls reached a listener.\n";
+
+		for (auto groupToDelete : benchmarkRoot.GetChildren())	//Delete the leaves first, so that no actor outlives the transform of its parent
+		{
+			for (auto actorToDelete : groupToDelete->GetChildren())
+				actorToDelete->Delete();
+			groupToDelete->Delete();
+		}
+		benchmarkRoot.Delete();
+
+		return std::chrono::duration<double, std::micro>(end - begin).count() / static_cast<double>(std::max(eventCount, 1u));
 	}
 
 	void GameScene::Update(float deltaTime)
@@ -188,8 +269,27 @@ namespace GEE
 			BindActiveCamera(nullptr);
 
 		RootActor->UpdateAll(deltaTime);
+		UpdateScheduler.Update(deltaTime, GameHandle->GetJobSystem());
+		UpdateScheduler.DeleteQueuedComponents();
+
+		//Dispatch animation notifies in one batch, after every actor has been updated.
+		//DispatchNotifies may cause new sources to be queued, so the vector is swapped out first.
+		if (!AnimationNotifySources.empty())
+		{
+			std::vector<AnimationManagerComponent*> sources;
+			sources.swap(AnimationNotifySources);
+			for (auto source : sources)
+				source->DispatchNotifies();
+		}
+
 		for (auto& it : RenderData->SkeletonBatches)
 			it->VerifySkeletonsLives();	//verify if any SkeletonInfos are invalid and get rid of any garbage objects
+
+		if (Streaming && ActiveCamera)
+		{
+			GEE_PROFILE_SCOPE("Streaming");
+			Streaming->Update(ActiveCamera->GetTransform().GetWorldTransform().Pos());
+		}
 	}
 
 	void GameScene::BindActiveCamera(CameraComponent* cam)
@@ -197,14 +297,14 @@ namespace GEE
 		ActiveCamera = cam;
 	}
 
-	Actor* GameScene::FindActor(std::string name)
+	Actor* GameScene::FindActor(const std::string& name)
 	{
 		return RootActor->FindActor(name);
 	}
 
 	GameScene::~GameScene()
 	{
-
+		RootActor = nullptr;	//Actors and components erase themselves from the containers of the scene when they are destroyed, so they must be destroyed before the containers
 	}
 
 	void GameScene::MarkAsKilled()
@@ -421,6 +521,11 @@ namespace GEE
 		{
 		}
 
+		GameScenePhysicsData::~GameScenePhysicsData()
+		{
+			PhysicsHandle->ReleaseScenePhysicsData(*this);
+		}
+
 		void GameScenePhysicsData::AddCollisionObject(CollisionObject& object, Transform& t)	//tytaj!!!!!!!!!!!!!!!!!!!!!!!!!!!! TUTAJ TUTAJ TU
 		{
 			CollisionObjects.push_back(&object);
@@ -436,8 +541,7 @@ namespace GEE
 			auto found = std::find(CollisionObjects.begin(), CollisionObjects.end(), &object);
 			if (found != CollisionObjects.end())
 			{
-				if ((*found)->ActorPtr)
-					(*found)->ActorPtr->release();
+				PhysicsHandle->RemoveCollisionObjectFromPxPipeline(**found);
 				CollisionObjects.erase(found);
 			}
 		}
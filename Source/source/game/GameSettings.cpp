@@ -7,6 +7,9 @@ namespace GEE
 		WindowSize = glm::uvec2(800, 600);
 		bWindowFullscreen = false;
 		WindowTitle = "kulki";
+		bAsyncPhysics = false;
+		PhysicsWorkerCount = 0;
+		bCacheDecodedAudio = false;
 	}
 
 	GameSettings::GameSettings(std::string path) :
@@ -46,6 +49,12 @@ namespace GEE
 			filestr >> bWindowFullscreen;				//bool wczytujemy tak jak int - 0 jest falszywe a wieksza wartosc (1) prawdziwa
 		else if (settingName == "windowtitle")
 			getline(filestr.ignore(), WindowTitle);	//tytul moze skladac sie z wielu wyrazow, wczytaj wiec cala linie do konca oraz pomin jeden znak, gdyz jest to spacja
+		else if (settingName == "asyncphysics")
+			filestr >> bAsyncPhysics;
+		else if (settingName == "physicsworkers")
+			filestr >> PhysicsWorkerCount;
+		else if (settingName == "audiocache")
+			filestr >> bCacheDecodedAudio;
 		else
 			return Video.LoadSetting(filestr, settingName);
 
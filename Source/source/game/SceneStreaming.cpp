@@ -0,0 +1,426 @@
+#include <game/SceneStreaming.h>
+#include <game/GameScene.h>
+#include <scene/Actor.h>
+#include <scene/Controller.h>
+#include <scene/CameraComponent.h>
+#include <scene/BoneComponent.h>
+#include <scene/LightProbeComponent.h>
+#include <utility/MemoryArena.h>
+#include <cereal/archives/json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace GEE
+{
+	struct SceneStreamingManager::ParsedChunk
+	{
+		std::stringstream Stream;
+		std::unique_ptr<cereal::JSONInputArchive> Archive;	//Parses the whole document when it is constructed, so only instantiating the actors is left for the main thread
+		std::string Error;
+	};
+
+	namespace
+	{
+		constexpr const char* CellManifestHeader = "GEE_CELLS";
+		constexpr unsigned int CellManifestVersion = 1;
+
+		/**
+		 * @brief Actors that other parts of the scene (or the engine) rely on being resident are not streamed.
+		*/
+		bool IsStreamable(Actor& actor)
+		{
+			if (actor.GetName().rfind("GEE_", 0) == 0)	//Engine actors, including cells
+				return false;
+
+			std::vector<Actor*> actors{ &actor };
+			actor.GetAllActors(&actors);
+			for (Actor* it : actors)
+			{
+				if (dynamic_cast<Controller*>(it))
+					return false;
+
+				Component* root = it->GetRoot();
+				std::vector<CameraComponent*> cameras;
+				std::vector<BoneComponent*> bones;
+				std::vector<LightProbeComponent*> probes;
+				root->GetAllComponents(&cameras);
+				root->GetAllComponents(&bones);
+				root->GetAllComponents(&probes);
+				if (!cameras.empty() || !bones.empty() || !probes.empty() || dynamic_cast<CameraComponent*>(root) || dynamic_cast<BoneComponent*>(root) || dynamic_cast<LightProbeComponent*>(root))
+					return false;
+			}
+
+			return true;
+		}
+
+		size_t GetFileSize(const std::string& filepath)
+		{
+			std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+			return (file.good()) ? (static_cast<size_t>(file.tellg())) : (0);
+		}
+	}
+
+	SceneStreamingManager::SceneStreamingManager(GameScene& scene, const SceneStreamingSettings& settings) :
+		Scene(scene),
+		Settings(settings),
+		LoadedBytes(0)
+	{
+		Settings.CellSize = glm::max(Settings.CellSize, 0.001f);
+		Settings.UnloadRadius = glm::max(Settings.UnloadRadius, Settings.LoadRadius);
+		Settings.MaxConcurrentLoads = std::max(Settings.MaxConcurrentLoads, 1u);
+	}
+
+	SceneStreamingManager::~SceneStreamingManager()
+	{
+		for (auto& cell : Cells)	//The loading jobs write to the cells
+			if (!cell->LoadCounter.IsDone())
+				Scene.GetGameHandle()->GetJobSystem()->Wait(cell->LoadCounter);
+	}
+
+	std::unique_ptr<SceneStreamingManager> SceneStreamingManager::LoadManifest(GameScene& scene, const std::string& manifestFilepath)
+	{
+		std::ifstream file(manifestFilepath);
+		if (!file.good())
+			return nullptr;
+
+		std::string header;
+		unsigned int version = 0;
+		SceneStreamingSettings settings;
+		size_t budgetMB = 0;
+		if (!(file >> header >> version) || header != CellManifestHeader || version != CellManifestVersion || !(file >> settings.CellSize >> settings.LoadRadius >> settings.UnloadRadius >> budgetMB >> settings.MaxConcurrentLoads))
+		{
+			std::cout << "ERROR! " << manifestFilepath << " is not a cell manifest of a supported version.\n";
+			return nullptr;
+		}
+		settings.MemoryBudget = budgetMB * 1024 * 1024;
+
+		std::unique_ptr<SceneStreamingManager> streaming = std::make_unique<SceneStreamingManager>(scene, settings);
+		streaming->ManifestFilepath = manifestFilepath;
+
+		const std::string directory = extractDirectory(manifestFilepath);
+		glm::ivec2 coords;
+		size_t bytes;
+		std::string filename;
+		while (file >> coords.x >> coords.y >> bytes && std::getline(file >> std::ws, filename))	//The filename is the rest of the line
+		{
+			std::unique_ptr<StreamingCell> cell = std::make_unique<StreamingCell>();
+			cell->Coords = coords;
+			cell->Filepath = directory + filename;
+			cell->Bytes = bytes;
+			cell->State = StreamingCellState::UNLOADED;
+			cell->CellActor = nullptr;
+			streaming->Cells.push_back(std::move(cell));
+		}
+
+		std::cout << "INFO: Streaming " << streaming->Cells.size() << " cells of " << scene.GetName() << " from " << manifestFilepath << ".\n";
+		return streaming;
+	}
+
+	unsigned int SceneStreamingManager::PartitionScene(GameScene& scene, const std::string& levelFilepath, const SceneStreamingSettings& settings)
+	{
+		if (scene.GetStreamingManager())
+		{
+			std::cout << "ERROR! Scene " << scene.GetName() << " has already been partitioned into cells.\n";
+			return 0;
+		}
+
+		std::unique_ptr<SceneStreamingManager> streaming = std::make_unique<SceneStreamingManager>(scene, settings);
+		streaming->ManifestFilepath = GetManifestFilepath(levelFilepath);
+
+		Actor& root = *scene.GetRootActor();
+		for (Actor* actor : root.GetChildren())
+		{
+			if (!IsStreamable(*actor))
+				continue;
+
+			const glm::vec3 position = actor->GetTransform()->GetWorldTransform().Pos();
+			const glm::ivec2 coords(glm::floor(glm::vec2(position.x, position.z) / streaming->Settings.CellSize));
+
+			auto found = std::find_if(streaming->Cells.begin(), streaming->Cells.end(), [coords](const std::unique_ptr<StreamingCell>& cell) { return cell->Coords == coords; });
+			if (found == streaming->Cells.end())
+			{
+				std::unique_ptr<StreamingCell> cell = std::make_unique<StreamingCell>();
+				cell->Coords = coords;
+				cell->Filepath = levelFilepath + ".cell_" + std::to_string(coords.x) + "_" + std::to_string(coords.y) + ".json";
+				cell->Bytes = 0;
+				cell->State = StreamingCellState::LOADED;
+				cell->CellActor = &root.CreateChild<Actor>(GetCellName(coords));	//Cells are attached to the root and have the identity transform, so the world transforms of their actors do not change
+				found = streaming->Cells.insert(streaming->Cells.end(), std::move(cell));
+			}
+
+			(*found)->CellActor->AddChild(root.DetachChild(*actor));
+		}
+
+		for (auto& cell : streaming->Cells)
+		{
+			if (!streaming->SaveCell(*cell))
+				std::cout << "ERROR! Could not write the chunk of cell " << GetCellName(cell->Coords) << " to " << cell->Filepath << ".\n";
+			cell->Bytes = GetFileSize(cell->Filepath);
+			streaming->LoadedBytes += cell->Bytes;
+			streaming->Unload(*cell);
+		}
+
+		const unsigned int cellCount = static_cast<unsigned int>(streaming->Cells.size());
+		if (!streaming->SaveManifest())
+		{
+			std::cout << "ERROR! Could not write the cell manifest " << streaming->ManifestFilepath << ".\n";
+			return 0;
+		}
+
+		std::cout << "INFO: Partitioned scene " << scene.GetName() << " into " << cellCount << " cells.\n";
+		scene.SetStreamingManager(std::move(streaming));
+		return cellCount;
+	}
+
+	std::string SceneStreamingManager::GetManifestFilepath(const std::string& levelFilepath)
+	{
+		return levelFilepath + ".cells";
+	}
+
+	void SceneStreamingManager::Update(const glm::vec3& viewerPosition)
+	{
+		const glm::vec2 viewer(viewerPosition.x, viewerPosition.z);
+
+		//1. Instantiate the nearest cell whose chunk has been parsed. Chunks of cells that went out of range in the meantime are dropped.
+		StreamingCell* parsedCell = nullptr;
+		float parsedCellDistance = 0.0f;
+		unsigned int loadingCount = 0;
+		for (auto& cell : Cells)
+		{
+			if (cell->State != StreamingCellState::LOADING)
+				continue;
+			if (!cell->LoadCounter.IsDone())
+			{
+				loadingCount++;
+				continue;
+			}
+
+			const float distance = GetDistance(*cell, viewer);
+			if (distance > Settings.UnloadRadius)
+			{
+				cell->Chunk = nullptr;
+				cell->State = StreamingCellState::UNLOADED;
+				LoadedBytes -= cell->Bytes;
+			}
+			else if (!parsedCell || distance < parsedCellDistance)
+			{
+				parsedCell = cell.get();
+				parsedCellDistance = distance;
+			}
+		}
+		if (parsedCell)
+			Instantiate(*parsedCell);
+
+		//2. Unload the cells beyond the unload radius.
+		for (auto& cell : Cells)
+			if (cell->State == StreamingCellState::LOADED && GetDistance(*cell, viewer) > Settings.UnloadRadius)
+				Unload(*cell);
+
+		//3. Start loading the nearest cells within the load radius. If the budget is exceeded, loaded cells outside the load radius (but still within the unload radius) are unloaded to make room, the farthest first.
+		ArenaVector<std::pair<float, StreamingCell*>> candidates{ ArenaAllocator<std::pair<float, StreamingCell*>>(MemoryArenas::Get(MemoryArenaType::FRAME)) };
+		candidates.reserve(Cells.size());
+		for (auto& cell : Cells)
+			if (cell->State == StreamingCellState::UNLOADED)
+				if (float distance = GetDistance(*cell, viewer); distance <= Settings.LoadRadius)
+					candidates.push_back(std::pair<float, StreamingCell*>(distance, cell.get()));
+		std::sort(candidates.begin(), candidates.end(), [](const std::pair<float, StreamingCell*>& lhs, const std::pair<float, StreamingCell*>& rhs) { return lhs.first < rhs.first; });
+
+		for (auto& candidate : candidates)
+		{
+			if (loadingCount >= Settings.MaxConcurrentLoads)
+				break;
+
+			StreamingCell& cell = *candidate.second;
+			while (LoadedBytes + cell.Bytes > Settings.MemoryBudget)
+			{
+				StreamingCell* farthest = nullptr;
+				float farthestDistance = Settings.LoadRadius;
+				for (auto& loadedCell : Cells)
+					if (loadedCell->State == StreamingCellState::LOADED)
+						if (float distance = GetDistance(*loadedCell, viewer); distance > farthestDistance)
+						{
+							farthest = loadedCell.get();
+							farthestDistance = distance;
+						}
+
+				if (!farthest)
+					break;
+				Unload(*farthest);
+			}
+
+			if (LoadedBytes + cell.Bytes > Settings.MemoryBudget)
+				continue;	//A smaller cell may still fit
+
+			StartLoading(cell);
+			loadingCount++;
+		}
+	}
+
+	std::vector<std::unique_ptr<Actor>> SceneStreamingManager::DetachLoadedCells()
+	{
+		std::vector<std::unique_ptr<Actor>> cellActors;
+		for (auto& cell : Cells)
+		{
+			if (cell->State != StreamingCellState::LOADED || !cell->CellActor)
+				continue;
+
+			if (!SaveCell(*cell))
+				std::cout << "ERROR! Could not write the chunk of cell " << GetCellName(cell->Coords) << " to " << cell->Filepath << ".\n";
+
+			const size_t bytes = GetFileSize(cell->Filepath);
+			LoadedBytes = LoadedBytes - cell->Bytes + bytes;
+			cell->Bytes = bytes;
+
+			cellActors.push_back(Scene.GetRootActor()->DetachChild(*cell->CellActor));
+		}
+
+		if (!cellActors.empty())
+			SaveManifest();
+
+		return cellActors;
+	}
+
+	void SceneStreamingManager::AttachCells(std::vector<std::unique_ptr<Actor>>&& cellActors)
+	{
+		for (auto& cellActor : cellActors)
+			if (cellActor)
+				Scene.GetRootActor()->AddChild(std::move(cellActor));
+		cellActors.clear();
+	}
+
+	const SceneStreamingSettings& SceneStreamingManager::GetSettings() const
+	{
+		return Settings;
+	}
+
+	unsigned int SceneStreamingManager::GetCellCount() const
+	{
+		return static_cast<unsigned int>(Cells.size());
+	}
+
+	unsigned int SceneStreamingManager::GetLoadedCellCount() const
+	{
+		return static_cast<unsigned int>(std::count_if(Cells.begin(), Cells.end(), [](const std::unique_ptr<StreamingCell>& cell) { return cell->State == StreamingCellState::LOADED; }));
+	}
+
+	size_t SceneStreamingManager::GetLoadedBytes() const
+	{
+		return LoadedBytes;
+	}
+
+	float SceneStreamingManager::GetDistance(const StreamingCell& cell, const glm::vec2& viewerPosition) const
+	{
+		const glm::vec2 cellMin = glm::vec2(cell.Coords) * Settings.CellSize;
+		const glm::vec2 cellMax = cellMin + glm::vec2(Settings.CellSize);
+		return glm::length(glm::max(glm::max(cellMin - viewerPosition, viewerPosition - cellMax), glm::vec2(0.0f)));
+	}
+
+	void SceneStreamingManager::StartLoading(StreamingCell& cell)
+	{
+		cell.State = StreamingCellState::LOADING;
+		cell.Chunk = std::make_unique<ParsedChunk>();
+		LoadedBytes += cell.Bytes;
+
+		ParsedChunk* chunk = cell.Chunk.get();
+		const std::string filepath = cell.Filepath;
+		Scene.GetGameHandle()->GetJobSystem()->Schedule([chunk, filepath]()
+		{
+			std::ifstream file(filepath);
+			if (!file.good())
+			{
+				chunk->Error = "could not open " + filepath;
+				return;
+			}
+			chunk->Stream << file.rdbuf();
+
+			try
+			{
+				chunk->Archive = std::make_unique<cereal::JSONInputArchive>(chunk->Stream);
+			}
+			catch (std::exception& ex)
+			{
+				chunk->Error = ex.what();
+			}
+		}, &cell.LoadCounter);
+	}
+
+	void SceneStreamingManager::Instantiate(StreamingCell& cell)
+	{
+		std::unique_ptr<ParsedChunk> chunk = std::move(cell.Chunk);
+		cell.State = StreamingCellState::LOADED;	//Also if the chunk is invalid, so it is not read again every frame
+		if (!chunk->Archive)
+		{
+			std::cout << "ERROR! Could not load cell " << GetCellName(cell.Coords) << ": " << chunk->Error << ".\n";
+			return;
+		}
+
+		GameScene* previousDefaultScene = GameManager::DefaultScene;
+		GameManager::DefaultScene = &Scene;
+		cereal::LoadAndConstruct<Actor>::ScenePtr = &Scene;
+
+		cell.CellActor = &Scene.GetRootActor()->CreateChild<Actor>(GetCellName(cell.Coords));
+		try
+		{
+			cell.CellActor->Load(*chunk->Archive);
+			chunk->Archive->serializeDeferments();
+		}
+		catch (cereal::Exception& ex)
+		{
+			std::cout << "ERROR! While loading cell " << GetCellName(cell.Coords) << ": " << ex.what() << '\n';
+		}
+		Scene.Load();	//Resolve the post-load lambdas of the cell
+
+		GameManager::DefaultScene = previousDefaultScene;
+	}
+
+	void SceneStreamingManager::Unload(StreamingCell& cell)
+	{
+		if (cell.CellActor)
+			cell.CellActor->MarkAsKilled();	//Deleted during the next update of the scene
+
+		cell.CellActor = nullptr;
+		cell.State = StreamingCellState::UNLOADED;
+		LoadedBytes -= cell.Bytes;
+	}
+
+	bool SceneStreamingManager::SaveCell(const StreamingCell& cell) const
+	{
+		std::ofstream stream(cell.Filepath);
+		if (!stream.good())
+			return false;
+
+		try
+		{
+			cereal::JSONOutputArchive archive(stream);
+			cell.CellActor->Save(archive);
+			archive.serializeDeferments();
+		}
+		catch (cereal::Exception& ex)
+		{
+			std::cout << "ERROR While saving cell " << GetCellName(cell.Coords) << ": " << ex.what() << '\n';
+			return false;
+		}
+
+		return true;
+	}
+
+	bool SceneStreamingManager::SaveManifest() const
+	{
+		std::ofstream file(ManifestFilepath);
+		if (!file.good())
+			return false;
+
+		file << CellManifestHeader << ' ' << CellManifestVersion << '\n';
+		file << Settings.CellSize << ' ' << Settings.LoadRadius << ' ' << Settings.UnloadRadius << ' ' << Settings.MemoryBudget / (1024 * 1024) << ' ' << Settings.MaxConcurrentLoads << '\n';
+		for (auto& cell : Cells)
+			file << cell->Coords.x << ' ' << cell->Coords.y << ' ' << cell->Bytes << ' ' << getFileName(cell->Filepath) << '\n';
+
+		return file.good();
+	}
+
+	std::string SceneStreamingManager::GetCellName(const glm::ivec2& coords)
+	{
+		return "GEE_Cell_" + std::to_string(coords.x) + "_" + std::to_string(coords.y);
+	}
+}
@@ -69,19 +69,33 @@ namespace GEE
 	{
 	}
 
+	unsigned int CharEnteredEvent::GetUnicode() const
+	{
+		return Unicode;
+	}
+
 	std::string CharEnteredEvent::GetUTF8() const
 	{
 		return std::string(1, static_cast<unsigned char>(Unicode));
 	}
 
-	std::shared_ptr<Event> EventHolder::PollEvent()
+	EventHolder::EventHolder() :
+		PolledArena(0),
+		PolledCount(0)
 	{
-		if (Events.empty())
-			return nullptr;
-
-		auto polledEvent = Events.front();
-		Events.pop();
+	}
 
-		return polledEvent;
+	const Event* EventHolder::PollEvent()
+	{
+		if (PolledCount >= Arenas[PolledArena].size())
+		{
+			Arenas[PolledArena].clear();
+			PolledCount = 0;
+			PolledArena = (PolledArena + 1) % 2;
+			if (Arenas[PolledArena].empty())
+				return nullptr;
+		}
+
+		return std::visit([](const Event& ev) { return &ev; }, Arenas[PolledArena][PolledCount++]);
 	}
 }
\ No newline at end of file
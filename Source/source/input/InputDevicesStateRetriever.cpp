@@ -1,24 +1,39 @@
 #include <input/InputDevicesStateRetriever.h>
+#include <input/InputRecording.h>
 
 namespace GEE
 {
-	InputDevicesStateRetriever::InputDevicesStateRetriever(GLFWwindow& window) :
-		WindowRef(window)
+	InputDevicesStateRetriever::InputDevicesStateRetriever(GLFWwindow* window) :
+		WindowPtr(window),
+		ReplayerPtr(nullptr)
+	{
+	}
+
+	InputDevicesStateRetriever::InputDevicesStateRetriever(const InputReplayer& replayer) :
+		WindowPtr(nullptr),
+		ReplayerPtr(&replayer)
 	{
 	}
 
 	glm::dvec2 InputDevicesStateRetriever::GetMousePosition() const
 	{
-		glm::dvec2 mousePos;
-		glfwGetCursorPos(&WindowRef, &mousePos.x, &mousePos.y);
+		if (ReplayerPtr)
+			return ReplayerPtr->GetMousePosition();
+
+		glm::dvec2 mousePos(0.0);
+		if (WindowPtr)
+			glfwGetCursorPos(WindowPtr, &mousePos.x, &mousePos.y);
 
 		return mousePos;
 	}
 
 	glm::dvec2 InputDevicesStateRetriever::GetMousePositionNDC() const
 	{
-		glm::ivec2 windowSize;
-		glfwGetWindowSize(&WindowRef, &windowSize.x, &windowSize.y);
+		glm::ivec2 windowSize(1);
+		if (ReplayerPtr)
+			windowSize = glm::max(ReplayerPtr->GetRecording().WindowSize, glm::ivec2(1));
+		else if (WindowPtr)
+			glfwGetWindowSize(WindowPtr, &windowSize.x, &windowSize.y);
 
 		glm::dvec2 mousePosition = GetMousePosition() / static_cast<glm::dvec2>(windowSize);
 		mousePosition.y = 1.0 - mousePosition.y;
@@ -28,7 +43,10 @@ namespace GEE
 
 	bool InputDevicesStateRetriever::IsKeyPressed(const Key& k) const
 	{
-		return glfwGetKey(&WindowRef, static_cast<int>(k)) == GLFW_PRESS;
+		if (ReplayerPtr)
+			return ReplayerPtr->IsKeyPressed(k);
+
+		return WindowPtr && glfwGetKey(WindowPtr, static_cast<int>(k)) == GLFW_PRESS;
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include <input/InputRecording.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace GEE
+{
+	namespace
+	{
+		constexpr char InputRecordingMagic[4] = { 'G', 'E', 'I', 'R' };
+		constexpr unsigned int InputRecordingVersion = 1;
+
+		template <typename T> void WriteValue(std::ofstream& file, const T& value)
+		{
+			file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template <typename T> bool ReadValue(std::ifstream& file, T& value)
+		{
+			return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+		}
+	}
+
+	bool InputRecording::SaveToFile(const std::string& filepath) const
+	{
+		std::ofstream file(filepath, std::ios::binary);
+		if (!file.good())
+		{
+			std::cout << "ERROR! Could not open " << filepath << " for writing the input recording.\n";
+			return false;
+		}
+
+		file.write(InputRecordingMagic, sizeof(InputRecordingMagic));
+		WriteValue(file, InputRecordingVersion);
+		WriteValue(file, TimeStep);
+		WriteValue(file, WindowSize.x);
+		WriteValue(file, WindowSize.y);
+		WriteValue(file, StepCount);
+		WriteValue(file, static_cast<unsigned int>(Records.size()));
+
+		for (const InputRecord& record : Records)	//Field by field, so the file does not depend on the padding of the struct
+		{
+			WriteValue(file, record.StepIndex);
+			WriteValue(file, record.Time);
+			WriteValue(file, static_cast<unsigned char>(record.Type));
+			WriteValue(file, static_cast<unsigned char>(record.EvType));
+			WriteValue(file, record.A);
+			WriteValue(file, record.B);
+			WriteValue(file, record.X);
+			WriteValue(file, record.Y);
+		}
+
+		return file.good();
+	}
+
+	bool InputRecording::LoadFromFile(const std::string& filepath)
+	{
+		std::ifstream file(filepath, std::ios::binary);
+		if (!file.good())
+		{
+			std::cout << "ERROR! Could not open input recording " << filepath << ".\n";
+			return false;
+		}
+
+		char magic[sizeof(InputRecordingMagic)];
+		unsigned int version = 0, recordCount = 0;
+		if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), InputRecordingMagic) || !ReadValue(file, version) || version != InputRecordingVersion)
+		{
+			std::cout << "ERROR! " << filepath << " is not an input recording of a supported version.\n";
+			return false;
+		}
+
+		bool bRead = ReadValue(file, TimeStep) && ReadValue(file, WindowSize.x) && ReadValue(file, WindowSize.y) && ReadValue(file, StepCount) && ReadValue(file, recordCount);
+
+		Records.clear();
+		Records.reserve(recordCount);
+		for (unsigned int i = 0; bRead && i < recordCount; i++)
+		{
+			InputRecord record{};
+			unsigned char type = 0, eventType = 0;
+			bRead = ReadValue(file, record.StepIndex) && ReadValue(file, record.Time) && ReadValue(file, type) && ReadValue(file, eventType) && ReadValue(file, record.A) && ReadValue(file, record.B) && ReadValue(file, record.X) && ReadValue(file, record.Y);
+			record.Type = static_cast<InputRecordType>(type);
+			record.EvType = static_cast<EventType>(eventType);
+			Records.push_back(record);
+		}
+
+		if (!bRead || TimeStep <= 0.0f)
+		{
+			std::cout << "ERROR! Input recording " << filepath << " is truncated or corrupted.\n";
+			Records.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	InputRecorder::InputRecorder() :
+		bRecording(false),
+		CurrentStepIndex(0)
+	{
+	}
+
+	void InputRecorder::Start(float timeStep, glm::ivec2 windowSize)
+	{
+		Recording = InputRecording();
+		Recording.TimeStep = timeStep;
+		Recording.WindowSize = windowSize;
+		Recording.Records.reserve(4096);
+		CurrentStepIndex = 0;
+		StartTime = std::chrono::steady_clock::now();
+		bRecording = true;
+	}
+
+	void InputRecorder::Stop()
+	{
+		bRecording = false;
+	}
+
+	bool InputRecorder::IsRecording() const
+	{
+		return bRecording;
+	}
+
+	void InputRecorder::BeginFrame(unsigned int stepIndex)
+	{
+		if (!bRecording)
+			return;
+
+		CurrentStepIndex = stepIndex;
+		Recording.StepCount = stepIndex;
+	}
+
+	void InputRecorder::RecordEvent(const Event& ev)
+	{
+		if (!bRecording)
+			return;
+
+		InputRecord& record = AddRecord(InputRecordType::EVENT);
+		record.EvType = ev.GetType();
+		switch (ev.GetType())
+		{
+		case EventType::KEY_PRESSED:
+		case EventType::KEY_REPEATED:
+		case EventType::KEY_RELEASED:
+		{
+			const KeyEvent& keyEvent = static_cast<const KeyEvent&>(ev);
+			record.A = static_cast<int>(keyEvent.GetKeyCode());
+			record.B = keyEvent.GetModifierBits();
+			break;
+		}
+		case EventType::MOUSE_PRESSED:
+		case EventType::MOUSE_RELEASED:
+		{
+			const MouseButtonEvent& buttonEvent = static_cast<const MouseButtonEvent&>(ev);
+			record.A = static_cast<int>(buttonEvent.GetButton());
+			record.B = buttonEvent.GetModifierBits();
+			break;
+		}
+		case EventType::MOUSE_MOVED:
+		{
+			const glm::vec2 position(static_cast<const CursorMoveEvent&>(ev).GetNewPosition());
+			record.X = position.x;
+			record.Y = position.y;
+			break;
+		}
+		case EventType::MOUSE_SCROLLED:
+		{
+			const glm::vec2 offset = static_cast<const MouseScrollEvent&>(ev).GetOffset();
+			record.X = offset.x;
+			record.Y = offset.y;
+			break;
+		}
+		case EventType::CHARACTER_ENTERED:
+			record.A = static_cast<int>(static_cast<const CharEnteredEvent&>(ev).GetUnicode());
+			break;
+		default:
+			break;
+		}
+	}
+
+	void InputRecorder::RecordMouseLook(glm::vec2 offset)
+	{
+		if (!bRecording)
+			return;
+
+		InputRecord& record = AddRecord(InputRecordType::MOUSE_LOOK);
+		record.X = offset.x;
+		record.Y = offset.y;
+	}
+
+	void InputRecorder::RecordMouseControl(bool bControlled)
+	{
+		if (!bRecording)
+			return;
+
+		AddRecord(InputRecordType::MOUSE_CONTROL).X = (bControlled) ? (1.0f) : (0.0f);
+	}
+
+	const InputRecording& InputRecorder::GetRecording() const
+	{
+		return Recording;
+	}
+
+	InputRecord& InputRecorder::AddRecord(InputRecordType type)
+	{
+		InputRecord record{};
+		record.StepIndex = CurrentStepIndex;
+		record.Time = std::chrono::duration<float>(std::chrono::steady_clock::now() - StartTime).count();
+		record.Type = type;
+		record.EvType = EventType::WINDOW_CLOSED;
+
+		Recording.Records.push_back(record);
+		return Recording.Records.back();
+	}
+
+	InputReplayer::InputReplayer(InputRecording&& recording) :
+		Recording(std::move(recording)),
+		NextRecord(0),
+		PressedKeys{},
+		MousePosition(glm::dvec2(Recording.WindowSize) / 2.0)
+	{
+	}
+
+	const InputRecord* InputReplayer::PollRecord(unsigned int stepIndex)
+	{
+		if (NextRecord >= Recording.Records.size() || Recording.Records[NextRecord].StepIndex > stepIndex)
+			return nullptr;
+
+		const InputRecord& record = Recording.Records[NextRecord++];
+		if (record.Type != InputRecordType::EVENT)
+			return &record;
+
+		switch (record.EvType)
+		{
+		case EventType::KEY_PRESSED:
+		case EventType::KEY_RELEASED:
+			if (record.A >= 0 && record.A < static_cast<int>(PressedKeys.size()))
+				PressedKeys[record.A] = record.EvType == EventType::KEY_PRESSED;
+			break;
+		case EventType::MOUSE_MOVED:
+			MousePosition = glm::dvec2(record.X, record.Y);
+			break;
+		default:
+			break;
+		}
+
+		return &record;
+	}
+
+	bool InputReplayer::IsFinished(unsigned int stepIndex) const
+	{
+		return NextRecord >= Recording.Records.size() && stepIndex >= Recording.StepCount;
+	}
+
+	const InputRecording& InputReplayer::GetRecording() const
+	{
+		return Recording;
+	}
+
+	bool InputReplayer::IsKeyPressed(Key key) const
+	{
+		const int index = static_cast<int>(key);
+		return index >= 0 && index < static_cast<int>(PressedKeys.size()) && PressedKeys[index];
+	}
+
+	glm::dvec2 InputReplayer::GetMousePosition() const
+	{
+		return MousePosition;
+	}
+}
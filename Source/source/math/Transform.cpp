@@ -42,7 +42,8 @@ namespace GEE
 		Rotation(rot),
 		_Scale(scale),
 		DirtyFlags(3, true),
-		Empty(false)
+		Empty(false),
+		RenderSnapshotSlot(-1)
 	{
 		if (pos == glm::vec3(0.0f) && rot == glm::quat(glm::vec3(0.0f)) && scale == glm::vec3(1.0f))
 			Empty = true;
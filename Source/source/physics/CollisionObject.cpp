@@ -16,13 +16,15 @@ namespace GEE
 
 		CollisionShape::CollisionShape(CollisionShapeType type) :
 			OptionalLocalization(nullptr),
-			Type(type)
+			Type(type),
+			MeshHash(0)
 		{
 		}
 
 		CollisionShape::CollisionShape(HTreeObjectLoc treeObjLoc, const std::string& meshName, CollisionShapeType type) :
 			OptionalLocalization(std::make_unique<ColShapeLoc>(Mesh::MeshLoc(treeObjLoc, meshName, meshName))),
-			Type(type)
+			Type(type),
+			MeshHash(0)
 		{
 		}
 
@@ -42,7 +44,9 @@ namespace GEE
 			TransformPtr(nullptr),
 			IsStatic(isStatic),
 			IgnoreRotation(false),
-			TransformDirtyFlag(std::numeric_limits<unsigned int>::max())
+			TransformDirtyFlag(std::numeric_limits<unsigned int>::max()),
+			ShapesScale(1.0f),
+			CollisionGroups(COLLISION_GROUP_DEFAULT)
 		{
 		}
 
@@ -58,6 +62,8 @@ namespace GEE
 			Shapes(obj.Shapes),
 			TransformPtr(obj.TransformPtr),
 			TransformDirtyFlag(std::numeric_limits<unsigned int>::max()),
+			ShapesScale(obj.ShapesScale),
+			CollisionGroups(obj.CollisionGroups),
 			IgnoreRotation(obj.IgnoreRotation),
 			IsStatic(obj.IsStatic)
 		{
@@ -97,6 +103,19 @@ namespace GEE
 			return nullptr;
 		}
 
+		void CollisionObject::SetCollisionGroups(unsigned int groups)
+		{
+			CollisionGroups = groups;
+			if (!ActorPtr)
+				return;
+
+			const PxFilterData filterData(CollisionGroups, 0, 0, 0);
+			std::vector<PxShape*> shapes(ActorPtr->getNbShapes());
+			ActorPtr->getShapes(shapes.data(), static_cast<PxU32>(shapes.size()));
+			for (PxShape* shape : shapes)
+				shape->setQueryFilterData(filterData);
+		}
+
 		CollisionObject::~CollisionObject()
 		{
 			//std::cout << "attempting to remove collision object " << this << "\n";
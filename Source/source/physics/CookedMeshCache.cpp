@@ -0,0 +1,201 @@
+#include <physics/CookedMeshCache.h>
+#include <physics/CollisionObject.h>
+#include <PhysX/PxPhysicsAPI.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <iostream>
+
+using namespace physx;
+
+namespace GEE
+{
+	namespace Physics
+	{
+		namespace
+		{
+			constexpr char CookedMeshMagic[4] = { 'G', 'E', 'C', 'M' };
+			constexpr unsigned int CookedMeshVersion = 1;
+
+			uint64_t HashBytes(uint64_t hash, const void* data, size_t size)	//FNV-1a
+			{
+				const unsigned char* bytes = static_cast<const unsigned char*>(data);
+				for (size_t i = 0; i < size; i++)
+				{
+					hash ^= bytes[i];
+					hash *= 1099511628211ull;
+				}
+				return hash;
+			}
+		}
+
+		CookedMeshCache::CookedMeshCache(const std::string& directory) :
+			Directory(directory),
+			Physics(nullptr),
+			Cooking(nullptr)
+		{
+		}
+
+		CookedMeshCache::~CookedMeshCache()
+		{
+			Clear();
+		}
+
+		void CookedMeshCache::Init(PxPhysics& physics, PxCooking& cooking)
+		{
+			Physics = &physics;
+			Cooking = &cooking;
+		}
+
+		uint64_t CookedMeshCache::ComputeHash(const std::vector<glm::vec3>& vertices, const std::vector<unsigned int>& indices)
+		{
+			const uint64_t vertexCount = vertices.size(), indexCount = indices.size();
+			uint64_t hash = 14695981039346656037ull;
+			hash = HashBytes(hash, &vertexCount, sizeof(vertexCount));
+			hash = HashBytes(hash, &indexCount, sizeof(indexCount));
+			hash = HashBytes(hash, vertices.data(), vertices.size() * sizeof(glm::vec3));
+			hash = HashBytes(hash, indices.data(), indices.size() * sizeof(unsigned int));
+
+			return (hash != 0) ? (hash) : (1);	//0 means "not hashed yet"
+		}
+
+		PxTriangleMesh* CookedMeshCache::GetTriangleMesh(CollisionShape& shape)
+		{
+			if (shape.MeshHash == 0)
+			{
+				if (shape.VertData.empty() || shape.IndicesData.empty())
+				{
+					std::cout << "ERROR: No VertData or IndicesData present in a triangle mesh collision shape. Vert count: " << shape.VertData.size() << ". Index count: " << shape.IndicesData.size() << "\n";
+					return nullptr;
+				}
+				shape.MeshHash = ComputeHash(shape.VertData, shape.IndicesData);
+			}
+
+			PxTriangleMesh* mesh = nullptr;
+			auto found = Meshes.find(shape.MeshHash);
+			if (found != Meshes.end())
+				mesh = found->second;
+			else
+			{
+				mesh = LoadFromDisk(shape.MeshHash);
+				if (!mesh)
+					mesh = Cook(shape, shape.MeshHash);
+				if (!mesh)
+					return nullptr;
+
+				Meshes[shape.MeshHash] = mesh;
+			}
+
+			std::vector<glm::vec3>().swap(shape.VertData);	//Not needed anymore - the mesh can be found by its hash
+			std::vector<unsigned int>().swap(shape.IndicesData);
+
+			return mesh;
+		}
+
+		void CookedMeshCache::Clear()
+		{
+			for (auto& it : Meshes)
+				it.second->release();
+			Meshes.clear();
+		}
+
+		PxTriangleMesh* CookedMeshCache::Cook(const CollisionShape& shape, uint64_t hash)
+		{
+			if (!Cooking || !Physics)
+				return nullptr;
+			if (shape.VertData.empty() || shape.IndicesData.empty())
+			{
+				std::cout << "ERROR: Triangle mesh " << GetFilepath(hash) << " is not cached and the collision shape has no VertData or IndicesData to cook it from.\n";
+				return nullptr;
+			}
+
+			PxTriangleMeshDesc desc;
+			desc.points.count = static_cast<PxU32>(shape.VertData.size());
+			desc.points.stride = sizeof(glm::vec3);
+			desc.points.data = &shape.VertData[0];
+
+			desc.triangles.count = static_cast<PxU32>(shape.IndicesData.size() / 3);
+			desc.triangles.stride = sizeof(unsigned int) * 3;
+			desc.triangles.data = &shape.IndicesData[0];
+
+			PxDefaultMemoryOutputStream writeBuffer;
+			PxTriangleMeshCookingResult::Enum result;
+			bool status = Cooking->cookTriangleMesh(desc, writeBuffer, &result);
+			if (!status)
+			{
+				std::cerr << "ERROR! Can't cook mesh with " << desc.points.count << " vertices.\n";
+				return nullptr;
+			}
+
+			switch (result)
+			{
+			case PxTriangleMeshCookingResult::Enum::eSUCCESS: std::cout << "INFO: Succesfully cooked a mesh with " << desc.points.count << " vertices.\n"; break;
+			case PxTriangleMeshCookingResult::Enum::eLARGE_TRIANGLE: std::cout << "INFO: Triangles are too large in a cooked mesh!\n"; break;
+			case PxTriangleMeshCookingResult::Enum::eFAILURE: std::cout << "ERROR! Can't cook a mesh\n"; return nullptr;
+			}
+
+			SaveToDisk(hash, writeBuffer.getData(), writeBuffer.getSize());
+
+			PxDefaultMemoryInputData readBuffer(writeBuffer.getData(), writeBuffer.getSize());
+			return Physics->createTriangleMesh(readBuffer);
+		}
+
+		PxTriangleMesh* CookedMeshCache::LoadFromDisk(uint64_t hash) const
+		{
+			if (!Physics)
+				return nullptr;
+
+			std::ifstream file(GetFilepath(hash), std::ios::binary);
+			if (!file.good())
+				return nullptr;
+
+			char magic[sizeof(CookedMeshMagic)];
+			unsigned int version = 0, physxVersion = 0, size = 0;
+			if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), CookedMeshMagic) ||
+				!file.read(reinterpret_cast<char*>(&version), sizeof(version)) || !file.read(reinterpret_cast<char*>(&physxVersion), sizeof(physxVersion)) || !file.read(reinterpret_cast<char*>(&size), sizeof(size)) ||
+				version != CookedMeshVersion || physxVersion != PX_PHYSICS_VERSION)	//Cooked data is only valid for the PhysX version that cooked it
+				return nullptr;
+
+			std::vector<unsigned char> cookedData(size);
+			if (!file.read(reinterpret_cast<char*>(cookedData.data()), size))
+			{
+				std::cout << "ERROR! Cooked mesh " << GetFilepath(hash) << " is truncated. It will be cooked again.\n";
+				return nullptr;
+			}
+
+			PxDefaultMemoryInputData readBuffer(cookedData.data(), size);
+			return Physics->createTriangleMesh(readBuffer);
+		}
+
+		bool CookedMeshCache::SaveToDisk(uint64_t hash, const unsigned char* cookedData, unsigned int size) const
+		{
+			std::error_code error;
+			std::filesystem::create_directories(Directory, error);
+
+			std::ofstream file(GetFilepath(hash), std::ios::binary);
+			if (!file.good())
+			{
+				std::cout << "ERROR! Could not write cooked mesh " << GetFilepath(hash) << ".\n";
+				return false;
+			}
+
+			const unsigned int physxVersion = PX_PHYSICS_VERSION;
+			file.write(CookedMeshMagic, sizeof(CookedMeshMagic));
+			file.write(reinterpret_cast<const char*>(&CookedMeshVersion), sizeof(CookedMeshVersion));
+			file.write(reinterpret_cast<const char*>(&physxVersion), sizeof(physxVersion));
+			file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+			file.write(reinterpret_cast<const char*>(cookedData), size);
+
+			return file.good();
+		}
+
+		std::string CookedMeshCache::GetFilepath(uint64_t hash) const
+		{
+			std::stringstream filepath;
+			filepath << Directory << std::hex << std::setw(16) << std::setfill('0') << hash << ".pxmesh";
+			return filepath.str();
+		}
+	}
+}
@@ -4,6 +4,8 @@
 #include <physics/CollisionObject.h>
 #include <rendering/Mesh.h>
 #include <math/Transform.h>
+#include <physics/SceneQuery.h>
+#include <utility/JobSystem.h>
 
 using namespace physx;
 
@@ -15,13 +17,41 @@ namespace GEE
 
 		physx::PxFoundation* PhysicsEngine::Foundation = nullptr;
 
+		namespace
+		{
+			PxFilterFlags ContinuousCollisionFilterShader(PxFilterObjectAttributes attributes0, PxFilterData filterData0, PxFilterObjectAttributes attributes1, PxFilterData filterData1, PxPairFlags& pairFlags, const void* constantBlock, PxU32 constantBlockSize)
+			{
+				PxFilterFlags filterFlags = PxDefaultSimulationFilterShader(attributes0, filterData0, attributes1, filterData1, pairFlags, constantBlock, constantBlockSize);
+				pairFlags |= PxPairFlag::eDETECT_CCD_CONTACT;	//Only has an effect if one of the bodies has CCD enabled
+				return filterFlags;
+			}
+		}
+
+		JobSystemCpuDispatcher::JobSystemCpuDispatcher(JobSystem& jobs) :
+			Jobs(jobs)
+		{
+		}
+
+		void JobSystemCpuDispatcher::submitTask(PxBaseTask& task)
+		{
+			Jobs.Schedule([&task]() { task.run(); task.release(); });	//release() lets the task manager start the dependent tasks
+		}
+
+		uint32_t JobSystemCpuDispatcher::getWorkerCount() const
+		{
+			return Jobs.GetWorkerCount();
+		}
 
 		PhysicsEngine::PhysicsEngine(bool* debugmode) :
 			Physics(nullptr),
 			Dispatcher(nullptr),
+			DefaultDispatcher(nullptr),
 			DefaultMaterial(nullptr),
+			Jobs(nullptr),
 			Pvd(nullptr),
-			WasSetup(false)
+			WasSetup(false),
+			bAsyncSimulation(false),
+			bSimulating(false)
 		{
 			glGenVertexArrays(1, &VAO);
 			glGenBuffers(1, &VBO);
@@ -37,7 +67,7 @@ namespace GEE
 			DebugModePtr = debugmode;
 		}
 
-		void PhysicsEngine::Init()
+		void PhysicsEngine::Init(JobSystem& jobs, unsigned int workerCount)
 		{
 			if (!Foundation)
 				Foundation = PxCreateFoundation(PX_PHYSICS_VERSION, Allocator, ErrorCallback);
@@ -54,48 +84,64 @@ namespace GEE
 			Cooking = PxCreateCooking(PX_PHYSICS_VERSION, *Foundation, PxCookingParams(PxTolerancesScale()));
 			if (!Cooking)
 				std::cerr << "ERROR! Can't initialize cooking.\n";
+			else
+				MeshCache.Init(*Physics, *Cooking);
 
 			DefaultMaterial = Physics->createMaterial(0.5f, 1.0f, 0.6f);
-		}
 
-		PxShape* PhysicsEngine::CreateTriangleMeshShape(CollisionShape* colShape, glm::vec3 scale)
-		{
-			if (colShape->VertData.empty() || colShape->IndicesData.empty())
+			Jobs = &jobs;
+			if (workerCount == 0)
 			{
-				std::cout << "ERROR: No VertData or IndicesData present in a triangle mesh collision shape. Vert count: " << colShape->VertData.size() << ". Index count: " << colShape->IndicesData.size() << "\n";
-				return nullptr;
+				JobDispatcher = std::make_unique<JobSystemCpuDispatcher>(jobs);
+				Dispatcher = JobDispatcher.get();
 			}
+			else
+				Dispatcher = DefaultDispatcher = PxDefaultCpuDispatcherCreate(workerCount);
+		}
 
-			PxTriangleMeshDesc desc;
-			desc.points.count = colShape->VertData.size();
-			desc.points.stride = sizeof(glm::vec3);
-			desc.points.data = &colShape->VertData[0];
+		void PhysicsEngine::SetAsyncSimulation(bool async)
+		{
+			if (!async)
+				FetchResults();	//Don't leave a step in flight that nobody would fetch
 
-			desc.triangles.count = colShape->IndicesData.size() / 3;
-			desc.triangles.stride = sizeof(unsigned int) * 3;
-			desc.triangles.data = &colShape->IndicesData[0];
+			bAsyncSimulation = async;
+		}
 
-			PxDefaultMemoryOutputStream writeBuffer;
-			PxTriangleMeshCookingResult::Enum result;
-			bool status = Cooking->cookTriangleMesh(desc, writeBuffer, &result);
-			if (!status)
-			{
-				std::cerr << "ERROR! Can't cook mesh with " << desc.points.count << " vertices.\n";
-				return nullptr;
-			}
+		bool PhysicsEngine::IsAsyncSimulation() const
+		{
+			return bAsyncSimulation;
+		}
 
-			switch (result)
-			{
-			case PxTriangleMeshCookingResult::Enum::eSUCCESS: std::cout << "INFO: Succesfully cooked a mesh with " << desc.points.count << " vertices.\n"; break;
-			case PxTriangleMeshCookingResult::Enum::eLARGE_TRIANGLE: std::cout << "INFO: Triangles are too large in a cooked mesh!\n"; break;
-			case PxTriangleMeshCookingResult::Enum::eFAILURE: std::cout << "ERROR! Can't cook a mesh\n"; return nullptr;
-			}
+		bool PhysicsEngine::IsSimulating() const
+		{
+			return bSimulating;
+		}
 
-			PxDefaultMemoryInputData readBuffer(writeBuffer.getData(), writeBuffer.getSize());
-			PxTriangleMesh* mesh = Physics->createTriangleMesh(readBuffer);
-			PxMeshScale meshScale(toPx(scale));
+		CollisionObject* PhysicsEngine::FindCollisionObject(const PxActor& actor)
+		{
+			auto found = CollisionObjectsByActor.find(&actor);
+			return (found != CollisionObjectsByActor.end()) ? (found->second) : (nullptr);
+		}
+
+		void PhysicsEngine::ScheduleSceneQueries(GameScenePhysicsData& scenePhysicsData, SceneQueryBatch& batch)
+		{
+			DeferredSceneQueries.push_back(std::pair<GameScenePhysicsData*, SceneQueryBatch*>(&scenePhysicsData, &batch));
+		}
 
-			return Physics->createShape(PxTriangleMeshGeometry(mesh, meshScale, PxMeshGeometryFlag::eDOUBLE_SIDED), *DefaultMaterial);
+		void PhysicsEngine::CancelSceneQueries(SceneQueryBatch& batch)
+		{
+			DeferredSceneQueries.erase(std::remove_if(DeferredSceneQueries.begin(), DeferredSceneQueries.end(), [&batch](const std::pair<GameScenePhysicsData*, SceneQueryBatch*>& deferred) { return deferred.second == &batch; }), DeferredSceneQueries.end());
+			batch.bPending = false;
+		}
+
+		PxShape* PhysicsEngine::CreateTriangleMeshShape(CollisionShape* colShape, glm::vec3 scale)
+		{
+			PxTriangleMesh* mesh = MeshCache.GetTriangleMesh(*colShape);	//Identical meshes are cooked once and shared
+			if (!mesh)
+				return nullptr;
+
+			PxMeshScale meshScale(toPx(scale));
+			return Physics->createShape(PxTriangleMeshGeometry(mesh, meshScale, PxMeshGeometryFlag::eDOUBLE_SIDED), *DefaultMaterial, true);
 		}
 
 		void PhysicsEngine::AddCollisionObjectToPxPipeline(GameScenePhysicsData& scenePhysicsData, CollisionObject& object)
@@ -121,10 +167,37 @@ namespace GEE
 				return;
 			}
 
+			if (bSimulating)	//The actor is created right away, but it joins the scene once the step in flight is fetched
+			{
+				BufferedAdditions.push_back(std::pair<GameScenePhysicsData*, CollisionObject*>(&scenePhysicsData, &object));
+				return;
+			}
+
 			scenePhysicsData.PhysXScene->addActor(*object.ActorPtr);
 			//Scene->addActor(*object->ActorPtr);
 		}
 
+		void PhysicsEngine::RemoveCollisionObjectFromPxPipeline(CollisionObject& object)
+		{
+			BufferedCommands.erase(std::remove_if(BufferedCommands.begin(), BufferedCommands.end(), [&object](const BufferedCommand& command) { return command.Object == &object; }), BufferedCommands.end());
+
+			auto bufferedAddition = std::find_if(BufferedAdditions.begin(), BufferedAdditions.end(), [&object](const std::pair<GameScenePhysicsData*, CollisionObject*>& addition) { return addition.second == &object; });
+			const bool bInScene = bufferedAddition == BufferedAdditions.end();
+			if (!bInScene)
+				BufferedAdditions.erase(bufferedAddition);
+
+			if (!object.ActorPtr)
+				return;
+
+			CollisionObjectsByActor.erase(object.ActorPtr);
+			if (bSimulating && bInScene)
+				BufferedReleases.push_back(object.ActorPtr);
+			else
+				object.ActorPtr->release();
+
+			object.ActorPtr = nullptr;
+		}
+
 		void PhysicsEngine::CreatePxShape(CollisionShape& shape, CollisionObject& object)
 		{
 			Vec3f worldObjectScale = object.TransformPtr->GetWorldTransform().Scale();
@@ -139,13 +212,13 @@ namespace GEE
 				pxShape = CreateTriangleMeshShape(&shape, shapeScale);
 				break;
 			case CollisionShapeType::COLLISION_BOX:
-				pxShape = Physics->createShape(PxBoxGeometry(toPx(shapeScale)), *DefaultMaterial);
+				pxShape = Physics->createShape(PxBoxGeometry(toPx(shapeScale)), *DefaultMaterial, true);
 				break;
 			case CollisionShapeType::COLLISION_SPHERE:
-				pxShape = Physics->createShape(PxSphereGeometry(shapeScale.x), *DefaultMaterial);
+				pxShape = Physics->createShape(PxSphereGeometry(shapeScale.x), *DefaultMaterial, true);
 				break;
 			case CollisionShapeType::COLLISION_CAPSULE:
-				pxShape = Physics->createShape(PxCapsuleGeometry(shapeScale.x, shapeScale.y), *DefaultMaterial);
+				pxShape = Physics->createShape(PxCapsuleGeometry(shapeScale.x, shapeScale.y), *DefaultMaterial, true);
 			}
 
 			if (!pxShape)
@@ -153,6 +226,7 @@ namespace GEE
 
 			pxShape->setLocalPose(PxTransform(toPx(static_cast<glm::mat3>(object.TransformPtr->GetWorldTransformMatrix()) * shapeT.Pos()), (object.IgnoreRotation) ? (physx::PxQuat()) : (toPx(shapeT.Rot()))));
 			pxShape->userData = &shape.ShapeTransform;
+			pxShape->setQueryFilterData(PxFilterData(object.CollisionGroups, 0, 0, 0));
 
 			if (!object.ActorPtr)
 			{
@@ -160,9 +234,14 @@ namespace GEE
 					(static_cast<PxRigidActor*>(PxCreateStatic(*Physics, toPx(*object.TransformPtr), *pxShape))) :
 					(static_cast<PxRigidActor*>(PxCreateDynamic(*Physics, toPx(*object.TransformPtr), *pxShape, 10.0f)));
 				object.TransformDirtyFlag = object.TransformPtr->AddDirtyFlag();
+				if (object.ActorPtr)
+					CollisionObjectsByActor[object.ActorPtr] = &object;
 			}
 			else
 				object.ActorPtr->attachShape(*pxShape);
+
+			object.ShapesScale = worldObjectScale;
+			pxShape->release();	//The actor holds its own reference to the shape
 		}
 
 		void PhysicsEngine::AddScenePhysicsDataPtr(GameScenePhysicsData& scenePhysicsData)
@@ -172,9 +251,29 @@ namespace GEE
 
 		void PhysicsEngine::RemoveScenePhysicsDataPtr(GameScenePhysicsData& scenePhysicsData)
 		{
+			FetchResults();	//The scene could be destroyed while PhysX is still simulating it
+			for (auto& deferred : DeferredSceneQueries)
+				if (deferred.first == &scenePhysicsData)
+					deferred.second->bPending = false;
+			DeferredSceneQueries.erase(std::remove_if(DeferredSceneQueries.begin(), DeferredSceneQueries.end(), [&scenePhysicsData](const std::pair<GameScenePhysicsData*, SceneQueryBatch*>& deferred) { return deferred.first == &scenePhysicsData; }), DeferredSceneQueries.end());
 			ScenesPhysicsData.erase(std::remove_if(ScenesPhysicsData.begin(), ScenesPhysicsData.end(), [&scenePhysicsData](GameScenePhysicsData* scenePhysicsDataVec) { return scenePhysicsDataVec == &scenePhysicsData; }), ScenesPhysicsData.end());
 		}
 
+		void PhysicsEngine::ReleaseScenePhysicsData(GameScenePhysicsData& scenePhysicsData)
+		{
+			RemoveScenePhysicsDataPtr(scenePhysicsData);	//Also fetches the step in flight, so the buffered releases of the scene's actors are applied while its PxScene still exists
+			BufferedAdditions.erase(std::remove_if(BufferedAdditions.begin(), BufferedAdditions.end(), [&scenePhysicsData](const std::pair<GameScenePhysicsData*, CollisionObject*>& addition) { return addition.first == &scenePhysicsData; }), BufferedAdditions.end());
+
+			if (!scenePhysicsData.WasSetup)
+				return;
+
+			scenePhysicsData.PhysXControllerManager->release();
+			scenePhysicsData.PhysXScene->release();
+			scenePhysicsData.PhysXControllerManager = nullptr;
+			scenePhysicsData.PhysXScene = nullptr;
+			scenePhysicsData.WasSetup = false;
+		}
+
 		PxController* PhysicsEngine::CreateController(GameScenePhysicsData& scenePhysicsData, const Transform& t)
 		{
 			PxCapsuleControllerDesc desc;
@@ -195,26 +294,64 @@ namespace GEE
 			PxShape* shapes[1]; //There is only one shape in this controller
 			actor->getShapes(shapes, 1, 0); //get that shape
 			PxShape* shape = shapes[0];
+			shape->setQueryFilterData(PxFilterData(COLLISION_GROUP_CHARACTER, 0, 0, 0));
 			//shape->setLocalPose(physx::PxTransform(physx::PxVec3(0.0f), physx::PxQuat(physx::PxHalfPi, physx::PxVec3(0.0f, 0.0f, 1.0f))));	//rotate it so we get a vertical capsule (without this line the capsule would be oriented towards X+, I guess that's how physX defaults it)
 			return controller;
 		}
 
 		void PhysicsEngine::ApplyForce(CollisionObject& obj, glm::vec3 force)
 		{
-			Physics::ApplyForce(obj, force);
+			ExecuteOrBuffer(obj, [force](CollisionObject& obj) { Physics::ApplyForce(obj, force); });
+		}
+
+		void PhysicsEngine::SetVelocity(CollisionObject& obj, glm::vec3 linear, glm::vec3 angular)
+		{
+			ExecuteOrBuffer(obj, [linear, angular](CollisionObject& obj) { Physics::SetVelocity(obj, linear, angular); });
+		}
+
+		void PhysicsEngine::SetSimulationEnabled(CollisionObject& obj, bool enabled)
+		{
+			ExecuteOrBuffer(obj, [this, enabled](CollisionObject& obj)
+			{
+				if (!obj.ActorPtr)
+					return;
+
+				obj.ActorPtr->setActorFlag(PxActorFlag::eDISABLE_SIMULATION, !enabled);
+
+				ShapesBuffer.resize(obj.ActorPtr->getNbShapes());
+				obj.ActorPtr->getShapes(ShapesBuffer.data(), static_cast<PxU32>(ShapesBuffer.size()));
+				for (PxShape* shape : ShapesBuffer)
+					shape->setFlag(PxShapeFlag::eSCENE_QUERY_SHAPE, enabled);
+
+				if (PxRigidDynamic* body = obj.ActorPtr->is<PxRigidDynamic>())
+					if (enabled && !(body->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC))
+						body->wakeUp();
+			});
+		}
+
+		void PhysicsEngine::SetContinuousCollision(CollisionObject& obj, bool enabled)
+		{
+			ExecuteOrBuffer(obj, [enabled](CollisionObject& obj)
+			{
+				if (!obj.ActorPtr)
+					return;
+				if (PxRigidDynamic* body = obj.ActorPtr->is<PxRigidDynamic>())
+					body->setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, enabled);
+			});
 		}
 
 
 		void PhysicsEngine::SetupScene(GameScenePhysicsData& scenePhysicsData)
 		{
-			if (!Physics)
+			if (!Physics || !Dispatcher)
 				return;
 			PxSceneDesc sceneDesc(Physics->getTolerancesScale());
-			Dispatcher = PxDefaultCpuDispatcherCreate(2);
 
 			sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
 			sceneDesc.cpuDispatcher = Dispatcher;
-			sceneDesc.filterShader = PxDefaultSimulationFilterShader;
+			sceneDesc.filterShader = ContinuousCollisionFilterShader;
+			sceneDesc.flags |= PxSceneFlag::eENABLE_ACTIVE_ACTORS;
+			sceneDesc.flags |= PxSceneFlag::eENABLE_CCD;	//CCD still has to be enabled per body (see SetContinuousCollision)
 			scenePhysicsData.PhysXScene = Physics->createScene(sceneDesc);
 
 			PxPvdSceneClient* pvdClient = scenePhysicsData.PhysXScene->getScenePvdClient();
@@ -229,6 +366,9 @@ namespace GEE
 			scenePhysicsData.PhysXControllerManager = PxCreateControllerManager(*scenePhysicsData.PhysXScene);
 
 			PxRigidStatic* ground = PxCreatePlane(*Physics, PxPlane(0.0f, 1.0f, 0.0f, 0.5f), *DefaultMaterial);
+			PxShape* groundShape = nullptr;
+			if (ground->getShapes(&groundShape, 1) == 1)
+				groundShape->setQueryFilterData(PxFilterData(COLLISION_GROUP_DEFAULT, 0, 0, 0));
 			scenePhysicsData.PhysXScene->addActor(*ground);
 
 			if (*DebugModePtr)
@@ -249,6 +389,12 @@ namespace GEE
 
 		void PhysicsEngine::Update(float deltaTime)
 		{
+			if (bAsyncSimulation)
+			{
+				FetchResults();
+				return;
+			}
+
 			UpdatePxTransforms();
 
 			for (int i = 0; i < static_cast<int>(ScenesPhysicsData.size()); i++)
@@ -260,29 +406,94 @@ namespace GEE
 			UpdateTransforms();
 		}
 
+		void PhysicsEngine::Simulate(float deltaTime)
+		{
+			for (auto& deferred : DeferredSceneQueries)	//Nothing modifies the scenes now, so the queries can be split between the workers
+				deferred.second->Execute(*deferred.first, Jobs);
+			DeferredSceneQueries.clear();
+
+			if (!bAsyncSimulation)
+				return;
+
+			FetchResults();	//At most one step can be in flight
+			UpdatePxTransforms();
+
+			for (int i = 0; i < static_cast<int>(ScenesPhysicsData.size()); i++)
+				ScenesPhysicsData[i]->PhysXScene->simulate(deltaTime);
+
+			bSimulating = !ScenesPhysicsData.empty();
+		}
+
+		void PhysicsEngine::FetchResults()
+		{
+			if (!bSimulating)
+				return;
+
+			for (int i = 0; i < static_cast<int>(ScenesPhysicsData.size()); i++)
+				ScenesPhysicsData[i]->PhysXScene->fetchResults(true);
+			bSimulating = false;
+
+			UpdateTransforms();
+			FlushBufferedCommands();
+		}
+
+		void PhysicsEngine::FlushBufferedCommands()
+		{
+			for (PxRigidActor* actor : BufferedReleases)
+				actor->release();
+			BufferedReleases.clear();
+
+			for (auto& addition : BufferedAdditions)
+				if (addition.second->ActorPtr)
+					addition.first->PhysXScene->addActor(*addition.second->ActorPtr);
+			BufferedAdditions.clear();
+
+			for (BufferedCommand& command : BufferedCommands)
+				command.Command(*command.Object);
+			BufferedCommands.clear();
+		}
+
+		void PhysicsEngine::ExecuteOrBuffer(CollisionObject& obj, std::function<void(CollisionObject&)> command)
+		{
+			if (bSimulating)
+			{
+				BufferedCommands.push_back(BufferedCommand{ &obj, std::move(command) });
+				return;
+			}
+
+			command(obj);
+		}
+
 		void PhysicsEngine::UpdateTransforms()
 		{
 			for (int sceneIndex = 0; sceneIndex < static_cast<int>(ScenesPhysicsData.size()); sceneIndex++)
 			{
-				for (int i = 0; i < static_cast<int>(ScenesPhysicsData[sceneIndex]->CollisionObjects.size()); i++)
+				PxU32 activeActorCount = 0;
+				PxActor** activeActors = ScenesPhysicsData[sceneIndex]->PhysXScene->getActiveActors(activeActorCount);	//Valid until the next simulate() call
+
+				for (PxU32 i = 0; i < activeActorCount; i++)
 				{
-					CollisionObject* obj = ScenesPhysicsData[sceneIndex]->CollisionObjects[i];
-					if (!obj->ActorPtr || !obj->TransformPtr)
+					auto found = CollisionObjectsByActor.find(activeActors[i]);
+					if (found == CollisionObjectsByActor.end())	//Actors of character controllers and the ground plane
+						continue;
+
+					CollisionObject* obj = found->second;
+					if (!obj->TransformPtr || obj->TransformPtr->GetDirtyFlag(obj->TransformDirtyFlag, false))	//Don't overwrite a transform that was changed after the step was started (e.g. while handling events in the asynchronous mode) - it is sent to PhysX before the next step instead
 						continue;
 
-					PxTransform& pxTransform = obj->ActorPtr->getGlobalPose();
+					const PxTransform pxTransform = obj->ActorPtr->getGlobalPose();
 					obj->TransformPtr->SetPositionWorld(toGlm(pxTransform.p));
 					if (!obj->IgnoreRotation)
 						obj->TransformPtr->SetRotationWorld(toGlm(pxTransform.q));
-
-					//obj->TransformPtr->SetMatrix(t.Matrix);
-
+					obj->TransformPtr->SetDirtyFlag(obj->TransformDirtyFlag, false);	//The pose came from PhysX, so don't send it back in UpdatePxTransforms
 				}
 			}
 		}
 
 		void PhysicsEngine::UpdatePxTransforms()
 		{
+			PoseUpdates.clear();
+
 			for (int sceneIndex = 0; sceneIndex < static_cast<int>(ScenesPhysicsData.size()); sceneIndex++)
 			{
 				for (int i = 0; i < static_cast<int>(ScenesPhysicsData[sceneIndex]->CollisionObjects.size()); i++)
@@ -292,73 +503,68 @@ namespace GEE
 						continue;
 
 					const Transform& worldTransform = obj->TransformPtr->GetWorldTransform();
+					if (worldTransform.Scale() != obj->ShapesScale)
+						UpdatePxShapesScale(*obj, worldTransform);
 
 					PxTransform pxTransform = obj->ActorPtr->getGlobalPose();
 					pxTransform.p = toPx(worldTransform.Pos());
 					if (!obj->IgnoreRotation)
 						pxTransform.q = toPx(worldTransform.Rot());
 
+					PoseUpdates.push_back(std::pair<PxRigidActor*, PxTransform>(obj->ActorPtr, pxTransform));
+				}
+			}
+
+			for (auto& poseUpdate : PoseUpdates)
+			{
+				PxRigidDynamic* dynamic = poseUpdate.first->is<PxRigidDynamic>();
+				if (dynamic && (dynamic->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC))
+					dynamic->setKinematicTarget(poseUpdate.second);	//Kinematic bodies are moved to the target during the step, so they push the bodies in their way instead of teleporting through them
+				else
+					poseUpdate.first->setGlobalPose(poseUpdate.second);
+			}
+		}
+
+		void PhysicsEngine::UpdatePxShapesScale(CollisionObject& obj, const Transform& worldTransform)
+		{
+			const PxU32 shapeCount = obj.ActorPtr->getNbShapes();
+			ShapesBuffer.resize(shapeCount);
+			obj.ActorPtr->getShapes(ShapesBuffer.data(), shapeCount);
 
-					physx::PxShape** shapes = new physx::PxShape * [obj->ActorPtr->getNbShapes()];
-					obj->ActorPtr->getShapes(shapes, obj->ActorPtr->getNbShapes());
-
-					for (int j = 0; j < obj->ActorPtr->getNbShapes(); j++)
-					{
-						if (!shapes[j])
-							continue;
-
-						Transform* shapeTransform = (Transform*)shapes[j]->userData;
-						if (!shapeTransform)
-							continue;
-
-						switch (shapes[j]->getGeometryType())
-						{
-						case PxGeometryType::eTRIANGLEMESH:
-						{
-							physx::PxTriangleMeshGeometry meshGeom;
-							shapes[j]->getTriangleMeshGeometry(meshGeom);
-							meshGeom.scale = toPx(worldTransform.Scale() * shapeTransform->Scale());
-
-							obj->ActorPtr->detachShape(*shapes[j]);
-							shapes[j]->setGeometry(meshGeom);
-							break;
-						}
-						case PxGeometryType::eBOX:
-						{
-							physx::PxBoxGeometry boxGeom;
-							shapes[j]->getBoxGeometry(boxGeom);
-							boxGeom.halfExtents = toPx(worldTransform.Scale() * shapeTransform->Scale());
-
-							obj->ActorPtr->detachShape(*shapes[j]);
-							shapes[j]->setGeometry(boxGeom);
-							break;
-						}
-						case PxGeometryType::eSPHERE:
-						{
-							physx::PxSphereGeometry sphereGeom;
-							shapes[j]->getSphereGeometry(sphereGeom);
-							sphereGeom.radius = worldTransform.Scale().x * shapeTransform->Scale().x;
-
-							obj->ActorPtr->detachShape(*shapes[j]);
-							shapes[j]->setGeometry(sphereGeom);
-							break;
-						}
-						case PxGeometryType::eCAPSULE:
-							continue;
-						default:
-							std::cout << "Geometry type " << shapes[j]->getGeometryType() << " not supported.\n";
-							continue; //skip iteration
-							obj->ActorPtr->detachShape(*shapes[j]);
-						}
-
-						shapes[j]->setLocalPose(PxTransform(toPx(static_cast<glm::mat3>(worldTransform.GetMatrix()) * shapeTransform->Pos()), (obj->IgnoreRotation) ? (physx::PxQuat()) : (toPx(shapeTransform->Rot()))));
-						obj->ActorPtr->attachShape(*shapes[j]);
-
-					}
-
-					obj->ActorPtr->setGlobalPose(pxTransform);
+			for (PxShape* shape : ShapesBuffer)
+			{
+				Transform* shapeTransform = (shape) ? (static_cast<Transform*>(shape->userData)) : (nullptr);
+				if (!shapeTransform)
+					continue;
+
+				const glm::vec3 shapeScale = worldTransform.Scale() * shapeTransform->Scale();
+				switch (shape->getGeometryType())	//The shapes are exclusive, so their geometry can be changed while they are attached
+				{
+				case PxGeometryType::eTRIANGLEMESH:
+				{
+					PxTriangleMeshGeometry meshGeom;
+					shape->getTriangleMeshGeometry(meshGeom);
+					meshGeom.scale = PxMeshScale(toPx(shapeScale));
+					shape->setGeometry(meshGeom);
+					break;
+				}
+				case PxGeometryType::eBOX:
+					shape->setGeometry(PxBoxGeometry(toPx(shapeScale)));
+					break;
+				case PxGeometryType::eSPHERE:
+					shape->setGeometry(PxSphereGeometry(shapeScale.x));
+					break;
+				case PxGeometryType::eCAPSULE:
+					continue;
+				default:
+					std::cout << "Geometry type " << shape->getGeometryType() << " not supported.\n";
+					continue;
 				}
+
+				shape->setLocalPose(PxTransform(toPx(static_cast<glm::mat3>(worldTransform.GetMatrix()) * shapeTransform->Pos()), (obj.IgnoreRotation) ? (physx::PxQuat()) : (toPx(shapeTransform->Rot()))));
 			}
+
+			obj.ShapesScale = worldTransform.Scale();
 		}
 
 		void PhysicsEngine::DebugRender(GameScenePhysicsData& scenePhysicsData, RenderEngine& renderEng, RenderInfo& info)
@@ -369,6 +575,7 @@ namespace GEE
 				return;
 			}
 
+			FetchResults();	//The render buffer cannot be read while the scene is simulated
 			const PxRenderBuffer& rb = scenePhysicsData.PhysXScene->getRenderBuffer();
 
 
@@ -420,10 +627,13 @@ namespace GEE
 
 		PhysicsEngine::~PhysicsEngine()
 		{
+			FetchResults();
 			for (int i = 0; i < static_cast<int>(ScenesPhysicsData.size()); i++)
 				ScenesPhysicsData[i]->PhysXScene->release();
 
-			Dispatcher->release();
+			if (DefaultDispatcher)
+				DefaultDispatcher->release();
+			MeshCache.Clear();
 			Physics->release();
 			Cooking->release();
 
@@ -444,12 +654,29 @@ namespace GEE
 
 		void ApplyForce(CollisionObject& obj, const Vec3f& force)
 		{
+			if (!obj.ActorPtr)
+				return;
+
 			PxRigidDynamic* body = obj.ActorPtr->is<PxRigidDynamic>();
 
 			if (body)
 				body->addForce(toPx(force), PxForceMode::eIMPULSE);
 		}
 
+		void SetVelocity(CollisionObject& obj, const Vec3f& linear, const Vec3f& angular)
+		{
+			if (!obj.ActorPtr)
+				return;
+
+			PxRigidDynamic* body = obj.ActorPtr->is<PxRigidDynamic>();
+
+			if (body && !(body->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC))
+			{
+				body->setLinearVelocity(toPx(linear));
+				body->setAngularVelocity(toPx(angular));
+			}
+		}
+
 		namespace Util
 		{
 			glm::vec3 toVecColor(PxDebugColor::Enum col)
@@ -0,0 +1,221 @@
+#include <physics/SceneQuery.h>
+#include <utility/JobSystem.h>
+#include <PhysX/PxPhysicsAPI.h>
+#include <iostream>
+
+using namespace physx;
+
+namespace GEE
+{
+	namespace Physics
+	{
+		using namespace GEE::Physics::Util;
+
+		namespace
+		{
+			constexpr size_t SceneQueriesPerJob = 64;
+
+			bool GetQueryGeometry(CollisionShapeType shapeType, const Vec3f& shapeSize, PxGeometryHolder& geometry)
+			{
+				switch (shapeType)
+				{
+				case CollisionShapeType::COLLISION_BOX: geometry.storeAny(PxBoxGeometry(toPx(shapeSize))); return true;
+				case CollisionShapeType::COLLISION_SPHERE: geometry.storeAny(PxSphereGeometry(shapeSize.x)); return true;
+				case CollisionShapeType::COLLISION_CAPSULE: geometry.storeAny(PxCapsuleGeometry(shapeSize.x, shapeSize.y)); return true;
+				default: return false;
+				}
+			}
+		}
+
+		SceneQueryBatch::SceneQueryBatch(unsigned int capacity) :
+			Capacity(capacity),
+			ExecutedScene(nullptr),
+			bPending(false)
+		{
+			Queries.reserve(Capacity);
+			Hits.reserve(Capacity);
+		}
+
+		SceneQueryBatch::~SceneQueryBatch()
+		{
+			if (bPending && ExecutedScene)
+				ExecutedScene->GetPhysicsHandle()->CancelSceneQueries(*this);
+		}
+
+		int SceneQueryBatch::AddRaycast(const Vec3f& origin, const Vec3f& direction, float maxDistance, unsigned int groupMask)
+		{
+			SceneQuery query{};
+			query.Type = SceneQueryType::RAYCAST;
+			query.Origin = origin;
+			query.Direction = direction;
+			query.MaxDistance = maxDistance;
+			query.GroupMask = groupMask;
+
+			return AddQuery(query);
+		}
+
+		int SceneQueryBatch::AddSweep(CollisionShapeType shapeType, const Vec3f& shapeSize, const Vec3f& origin, const Quatf& rotation, const Vec3f& direction, float maxDistance, unsigned int groupMask)
+		{
+			SceneQuery query{};
+			query.Type = SceneQueryType::SWEEP;
+			query.ShapeType = shapeType;
+			query.ShapeSize = shapeSize;
+			query.Origin = origin;
+			query.Rotation = rotation;
+			query.Direction = direction;
+			query.MaxDistance = maxDistance;
+			query.GroupMask = groupMask;
+
+			return AddQuery(query);
+		}
+
+		int SceneQueryBatch::AddOverlap(CollisionShapeType shapeType, const Vec3f& shapeSize, const Vec3f& position, const Quatf& rotation, unsigned int groupMask)
+		{
+			SceneQuery query{};
+			query.Type = SceneQueryType::OVERLAP;
+			query.ShapeType = shapeType;
+			query.ShapeSize = shapeSize;
+			query.Origin = position;
+			query.Rotation = rotation;
+			query.GroupMask = groupMask;
+
+			return AddQuery(query);
+		}
+
+		void SceneQueryBatch::Execute(GameScenePhysicsData& scenePhysicsData, JobSystem* jobs)
+		{
+			ExecutedScene = &scenePhysicsData;
+			bPending = false;
+			if (!scenePhysicsData.PhysXScene)
+			{
+				std::cout << "ERROR! Scene queries executed against a scene whose physics has not been set up.\n";
+				return;
+			}
+
+			PxScene& scene = *scenePhysicsData.PhysXScene;
+			if (!jobs || Queries.size() <= SceneQueriesPerJob)
+			{
+				for (size_t i = 0; i < Queries.size(); i++)
+					ExecuteQuery(scene, Queries[i], Hits[i]);
+				return;
+			}
+
+			jobs->ParallelFor(Queries.size(), SceneQueriesPerJob, [this, &scene](size_t begin, size_t end)	//Queries only read the scene, so they can run at the same time
+				{
+					for (size_t i = begin; i < end; i++)
+						ExecuteQuery(scene, Queries[i], Hits[i]);
+				});
+		}
+
+		void SceneQueryBatch::ExecuteDeferred(GameScenePhysicsData& scenePhysicsData)
+		{
+			if (bPending)
+				return;
+
+			ExecutedScene = &scenePhysicsData;
+			bPending = true;
+			scenePhysicsData.GetPhysicsHandle()->ScheduleSceneQueries(scenePhysicsData, *this);
+		}
+
+		bool SceneQueryBatch::IsPending() const
+		{
+			return bPending;
+		}
+
+		void SceneQueryBatch::Clear()
+		{
+			if (bPending)
+			{
+				std::cout << "ERROR! A pending scene query batch cannot be cleared.\n";
+				return;
+			}
+
+			Queries.clear();
+			Hits.clear();
+		}
+
+		unsigned int SceneQueryBatch::GetQueryCount() const
+		{
+			return static_cast<unsigned int>(Queries.size());
+		}
+
+		unsigned int SceneQueryBatch::GetCapacity() const
+		{
+			return Capacity;
+		}
+
+		const SceneQueryHit& SceneQueryBatch::GetHit(unsigned int index) const
+		{
+			return Hits[index];
+		}
+
+		CollisionObject* SceneQueryBatch::GetHitObject(unsigned int index) const
+		{
+			const SceneQueryHit& hit = Hits[index];
+			if (!hit.HasHit() || !ExecutedScene)
+				return nullptr;
+
+			return ExecutedScene->GetPhysicsHandle()->FindCollisionObject(*hit.Actor);
+		}
+
+		int SceneQueryBatch::AddQuery(const SceneQuery& query)
+		{
+			if (bPending || Queries.size() >= Capacity)
+				return -1;
+
+			Queries.push_back(query);
+			Hits.push_back(SceneQueryHit());
+			return static_cast<int>(Queries.size()) - 1;
+		}
+
+		void SceneQueryBatch::ExecuteQuery(PxScene& scene, const SceneQuery& query, SceneQueryHit& hit)
+		{
+			hit = SceneQueryHit();
+			const PxQueryFilterData filterData(PxFilterData(query.GroupMask, 0, 0, 0), PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC);
+
+			switch (query.Type)
+			{
+			case SceneQueryType::RAYCAST:
+			{
+				PxRaycastBuffer raycastHit;
+				if (scene.raycast(toPx(query.Origin), toPx(glm::normalize(static_cast<glm::vec3>(query.Direction))), query.MaxDistance, raycastHit, PxHitFlag::eDEFAULT, filterData) && raycastHit.hasBlock)
+				{
+					hit.Actor = raycastHit.block.actor;
+					hit.Position = toGlm(raycastHit.block.position);
+					hit.Normal = toGlm(raycastHit.block.normal);
+					hit.Distance = raycastHit.block.distance;
+				}
+				break;
+			}
+			case SceneQueryType::SWEEP:
+			{
+				PxGeometryHolder geometry;
+				if (!GetQueryGeometry(query.ShapeType, query.ShapeSize, geometry))
+					break;
+
+				PxSweepBuffer sweepHit;
+				if (scene.sweep(geometry.any(), PxTransform(toPx(query.Origin), toPx(query.Rotation)), toPx(glm::normalize(static_cast<glm::vec3>(query.Direction))), query.MaxDistance, sweepHit, PxHitFlag::eDEFAULT, filterData) && sweepHit.hasBlock)
+				{
+					hit.Actor = sweepHit.block.actor;
+					hit.Position = toGlm(sweepHit.block.position);
+					hit.Normal = toGlm(sweepHit.block.normal);
+					hit.Distance = sweepHit.block.distance;
+				}
+				break;
+			}
+			case SceneQueryType::OVERLAP:
+			{
+				PxGeometryHolder geometry;
+				if (!GetQueryGeometry(query.ShapeType, query.ShapeSize, geometry))
+					break;
+
+				PxOverlapBuffer overlapHit;
+				const PxQueryFilterData anyHitFilterData(filterData.data, filterData.flags | PxQueryFlag::eANY_HIT);	//Overlaps have no closest hit - the first one found is reported
+				if (scene.overlap(geometry.any(), PxTransform(toPx(query.Origin), toPx(query.Rotation)), overlapHit, anyHitFilterData) && overlapHit.hasBlock)
+					hit.Actor = overlapHit.block.actor;
+				break;
+			}
+			}
+		}
+	}
+}
@@ -1,6 +1,7 @@
 #include <rendering/Framebuffer.h>
 #include <iostream>
 #include <algorithm>
+#include <utility/Profiler.h>
 #include <game/GameManager.h> //delete after PrimitiveDebugging is done
 
 
@@ -161,6 +162,7 @@ namespace GEE
 	void Framebuffer::Bind(bool changeViewportSize, const Viewport* viewport) const
 	{
 		glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+		GEE_PROFILE_COUNT(STATE_CHANGES, 1);
 		if (!changeViewportSize)
 			return;
 
@@ -36,6 +36,16 @@ namespace GEE
 		return GetLocalization().GetFullStr();
 	}
 
+	void Material::SetName(const std::string& name)
+	{
+		if (Localization.Name == name)
+			return;
+
+		const std::string previousName = Localization.Name;
+		Localization.Name = name;
+		GameManager::Get().GetRenderEngineHandle()->UpdateMaterialNameIndex(*this, previousName);
+	}
+
 	const std::string& Material::GetRenderShaderName() const
 	{
 		return RenderShaderName;
@@ -106,7 +116,7 @@ namespace GEE
 		material->Get(AI_MATKEY_SHININESS, shininess);
 		material->Get(AI_MATKEY_COLOR_DIFFUSE, color);
 		material->Get(AI_MATKEY_COLOR_SPECULAR, testColor);
-		Localization.Name = name.C_Str();
+		SetName(name.C_Str());
 		Shininess = shininess;
 		Color = glm::vec4(color.r, color.g, color.b, 1.0f);
 
@@ -476,9 +486,9 @@ namespace GEE
 
 	std::shared_ptr<NamedTexture> MaterialLoadingData::FindTexture(const std::string& path) const
 	{
-		auto found = std::find_if(LoadedTextures.begin(), LoadedTextures.end(), [path](const std::shared_ptr<NamedTexture>& tex) { return tex->GetPath() == path; });
-		if (found != LoadedTextures.end())
-			return *found;
+		size_t index = 0;
+		if (LoadedTexturesIndex.Find(path, index))
+			return LoadedTextures[index];
 
 		return nullptr;
 	}
@@ -486,5 +496,7 @@ namespace GEE
 	void MaterialLoadingData::AddTexture(std::shared_ptr<NamedTexture> tex)
 	{
 		LoadedTextures.push_back(tex);
+		if (tex)
+			LoadedTexturesIndex.Add(tex->GetPath(), LoadedTextures.size() - 1);
 	}
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include <rendering/Mesh.h>
 #include <assetload/FileLoader.h>
+#include <animation/CPUSkinning.h>
+#include <utility/Profiler.h>
+#include <algorithm>
 
 namespace GEE
 {
@@ -53,6 +56,11 @@ namespace GEE
 		return IndicesData.get();
 	}
 
+	const std::vector<Vertex>* Mesh::GetBindPoseVertsData() const
+	{
+		return BindPoseVertsData.get();
+	}
+
 	void Mesh::RemoveVertsAndIndicesData() const
 	{
 		VertsData = nullptr;
@@ -94,6 +102,7 @@ namespace GEE
 
 		glBindBuffer(GL_ARRAY_BUFFER, VBO);
 		glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertices.size(), &(vertices)[0], GL_STATIC_DRAW);
+		GEE_PROFILE_COUNT(BUFFER_BYTES_UPLOADED, sizeof(Vertex) * vertices.size());
 
 		if (!indices.empty())
 		{
@@ -101,21 +110,11 @@ namespace GEE
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
 			//std::cout << "uwagaaa: " + std::to_string(indices->size()) + "\n";
 			glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indices.size(), &(indices)[0], GL_STATIC_DRAW);
+			GEE_PROFILE_COUNT(BUFFER_BYTES_UPLOADED, sizeof(unsigned int) * indices.size());
 			//std::cout << "po uwadze\n";
 		}
 
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::Position)));
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::Normal)));
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::TexCoord)));
-
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::Tangent)));
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::Bitangent)));
-
-		glVertexAttribIPointer(5, 4, GL_INT, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::BoneData) + offsetof(VertexBoneData, VertexBoneData::BoneIDs)));
-		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::BoneData) + offsetof(VertexBoneData, VertexBoneData::BoneWeights)));
-
-		for (int i = 0; i < 7; i++)
-			glEnableVertexAttribArray(i);
+		setVertexAttribPointers();
 
 		VertexCount = (unsigned int)vertices.size();
 		IndexCount = (unsigned int)indices.size();
@@ -126,6 +125,9 @@ namespace GEE
 			IndicesData = std::make_shared<std::vector<unsigned int>>(indices);	//copy all indices to heap
 			std::cout << "Keeping vertices for a mesh that has verts and index count: " << VertexCount << " " << IndexCount << '\n';
 		}
+
+		if (std::any_of(vertices.begin(), vertices.end(), [](const Vertex& vert) { return vert.BoneData.BoneWeights.x != 0.0f; }))
+			BindPoseVertsData = (VertsData) ? (VertsData) : (std::make_shared<const std::vector<Vertex>>(vertices));
 	}
 
 	void Mesh::Render() const
@@ -134,6 +136,7 @@ namespace GEE
 			glDrawElements(GL_TRIANGLES, IndexCount, GL_UNSIGNED_INT, nullptr);
 		else
 			glDrawArrays(GL_TRIANGLES, 0, VertexCount);
+		GEE_PROFILE_COUNT(DRAW_CALLS, 1);
 	}
 
 	/*
@@ -145,7 +148,8 @@ namespace GEE
 
 	MeshInstance::MeshInstance(Mesh& mesh, Material* overrideMaterial) :
 		MeshRef(mesh),
-		MaterialInst(nullptr)
+		MaterialInst(nullptr),
+		Skinning(SkinningBackend::GPU)
 	{
 		Material* material = (overrideMaterial) ? (overrideMaterial) : (mesh.GetMaterial());
 		if (material)
@@ -160,7 +164,8 @@ namespace GEE
 
 	MeshInstance::MeshInstance(const MeshInstance& mesh) :
 		MaterialInst(nullptr),
-		MeshRef(mesh.MeshRef)
+		MeshRef(mesh.MeshRef),
+		Skinning(mesh.Skinning)
 	{
 		if (mesh.MaterialInst)
 			MaterialInst = std::make_shared<MaterialInstance>(mesh.MaterialInst->GetMaterialRef());	//create another instance of the same material
@@ -168,12 +173,16 @@ namespace GEE
 
 
 	MeshInstance::MeshInstance(MeshInstance&& mesh) noexcept :
-		MeshRef(mesh.MeshRef)
+		MeshRef(mesh.MeshRef),
+		Skinning(mesh.Skinning),
+		CPUSkinnedStream(std::move(mesh.CPUSkinnedStream))
 	{
 		if (mesh.MaterialInst)
 			MaterialInst = std::move(mesh.MaterialInst);	//move the material instance
 	}
 
+	MeshInstance::~MeshInstance() = default;
+
 	Mesh& MeshInstance::GetMesh()
 	{
 		return MeshRef;
@@ -197,6 +206,22 @@ namespace GEE
 		return MaterialInst.get();
 	}
 
+	SkinningBackend MeshInstance::GetSkinningBackend() const
+	{
+		return Skinning;
+	}
+
+	CPUSkinnedMesh* MeshInstance::GetCPUSkinnedMesh() const
+	{
+		if (Skinning != SkinningBackend::CPU)
+			return nullptr;
+
+		if (!CPUSkinnedStream)
+			CPUSkinnedStream = std::make_unique<CPUSkinnedMesh>(MeshRef);
+
+		return (CPUSkinnedStream->IsValid()) ? (CPUSkinnedStream.get()) : (nullptr);
+	}
+
 	void MeshInstance::SetMaterial(Material* mat)
 	{
 		MaterialInst = std::make_shared<MaterialInstance>(*mat);
@@ -207,6 +232,13 @@ namespace GEE
 		MaterialInst = matInst;
 	}
 
+	void MeshInstance::SetSkinningBackend(SkinningBackend backend)
+	{
+		Skinning = backend;
+		if (Skinning != SkinningBackend::CPU)
+			CPUSkinnedStream = nullptr;
+	}
+
 	/*
 		====================================================================
 		====================================================================
@@ -242,6 +274,22 @@ namespace GEE
 		return VAO;
 	}
 
+	void setVertexAttribPointers()
+	{
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::Position)));
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::Normal)));
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::TexCoord)));
+
+		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::Tangent)));
+		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::Bitangent)));
+
+		glVertexAttribIPointer(5, 4, GL_INT, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::BoneData) + offsetof(VertexBoneData, VertexBoneData::BoneIDs)));
+		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, Vertex::BoneData) + offsetof(VertexBoneData, VertexBoneData::BoneWeights)));
+
+		for (int i = 0; i < 7; i++)
+			glEnableVertexAttribArray(i);
+	}
+
 	VertexBoneData::VertexBoneData() :
 		BoneIDs(glm::ivec4(0)),
 		BoneWeights(glm::vec4(0.0f))
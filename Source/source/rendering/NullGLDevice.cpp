@@ -0,0 +1,468 @@
+#include <rendering/NullGLDevice.h>
+#include <glad/glad.h>
+#include <array>
+#include <cstring>
+#include <iostream>
+
+//Every function loaded by glad for OpenGL 4.0 and GL_ARB_debug_output
+#define GEE_NULL_GL_FUNCTIONS(X) \
+	X(glCullFace) X(glFrontFace) X(glHint) X(glLineWidth) X(glPointSize) X(glPolygonMode) X(glScissor) X(glTexParameterf) X(glTexParameterfv) \
+	X(glTexParameteri) X(glTexParameteriv) X(glTexImage1D) X(glTexImage2D) X(glDrawBuffer) X(glClear) X(glClearColor) X(glClearStencil) \
+	X(glClearDepth) X(glStencilMask) X(glColorMask) X(glDepthMask) X(glDisable) X(glEnable) X(glFinish) X(glFlush) X(glBlendFunc) X(glLogicOp) \
+	X(glStencilFunc) X(glStencilOp) X(glDepthFunc) X(glPixelStoref) X(glPixelStorei) X(glReadBuffer) X(glReadPixels) X(glGetBooleanv) \
+	X(glGetDoublev) X(glGetError) X(glGetFloatv) X(glGetIntegerv) X(glGetString) X(glGetTexImage) X(glGetTexParameterfv) X(glGetTexParameteriv) \
+	X(glGetTexLevelParameterfv) X(glGetTexLevelParameteriv) X(glIsEnabled) X(glDepthRange) X(glViewport) X(glDrawArrays) X(glDrawElements) \
+	X(glPolygonOffset) X(glCopyTexImage1D) X(glCopyTexImage2D) X(glCopyTexSubImage1D) X(glCopyTexSubImage2D) X(glTexSubImage1D) \
+	X(glTexSubImage2D) X(glBindTexture) X(glDeleteTextures) X(glGenTextures) X(glIsTexture) X(glDrawRangeElements) X(glTexImage3D) \
+	X(glTexSubImage3D) X(glCopyTexSubImage3D) X(glActiveTexture) X(glSampleCoverage) X(glCompressedTexImage3D) X(glCompressedTexImage2D) \
+	X(glCompressedTexImage1D) X(glCompressedTexSubImage3D) X(glCompressedTexSubImage2D) X(glCompressedTexSubImage1D) X(glGetCompressedTexImage) \
+	X(glBlendFuncSeparate) X(glMultiDrawArrays) X(glMultiDrawElements) X(glPointParameterf) X(glPointParameterfv) X(glPointParameteri) \
+	X(glPointParameteriv) X(glBlendColor) X(glBlendEquation) X(glGenQueries) X(glDeleteQueries) X(glIsQuery) X(glBeginQuery) X(glEndQuery) \
+	X(glGetQueryiv) X(glGetQueryObjectiv) X(glGetQueryObjectuiv) X(glBindBuffer) X(glDeleteBuffers) X(glGenBuffers) X(glIsBuffer) \
+	X(glBufferData) X(glBufferSubData) X(glGetBufferSubData) X(glMapBuffer) X(glUnmapBuffer) X(glGetBufferParameteriv) X(glGetBufferPointerv) \
+	X(glBlendEquationSeparate) X(glDrawBuffers) X(glStencilOpSeparate) X(glStencilFuncSeparate) X(glStencilMaskSeparate) X(glAttachShader) \
+	X(glBindAttribLocation) X(glCompileShader) X(glCreateProgram) X(glCreateShader) X(glDeleteProgram) X(glDeleteShader) X(glDetachShader) \
+	X(glDisableVertexAttribArray) X(glEnableVertexAttribArray) X(glGetActiveAttrib) X(glGetActiveUniform) X(glGetAttachedShaders) \
+	X(glGetAttribLocation) X(glGetProgramiv) X(glGetProgramInfoLog) X(glGetShaderiv) X(glGetShaderInfoLog) X(glGetShaderSource) \
+	X(glGetUniformLocation) X(glGetUniformfv) X(glGetUniformiv) X(glGetVertexAttribdv) X(glGetVertexAttribfv) X(glGetVertexAttribiv) \
+	X(glGetVertexAttribPointerv) X(glIsProgram) X(glIsShader) X(glLinkProgram) X(glShaderSource) X(glUseProgram) X(glUniform1f) X(glUniform2f) \
+	X(glUniform3f) X(glUniform4f) X(glUniform1i) X(glUniform2i) X(glUniform3i) X(glUniform4i) X(glUniform1fv) X(glUniform2fv) X(glUniform3fv) \
+	X(glUniform4fv) X(glUniform1iv) X(glUniform2iv) X(glUniform3iv) X(glUniform4iv) X(glUniformMatrix2fv) X(glUniformMatrix3fv) \
+	X(glUniformMatrix4fv) X(glValidateProgram) X(glVertexAttrib1d) X(glVertexAttrib1dv) X(glVertexAttrib1f) X(glVertexAttrib1fv) \
+	X(glVertexAttrib1s) X(glVertexAttrib1sv) X(glVertexAttrib2d) X(glVertexAttrib2dv) X(glVertexAttrib2f) X(glVertexAttrib2fv) \
+	X(glVertexAttrib2s) X(glVertexAttrib2sv) X(glVertexAttrib3d) X(glVertexAttrib3dv) X(glVertexAttrib3f) X(glVertexAttrib3fv) \
+	X(glVertexAttrib3s) X(glVertexAttrib3sv) X(glVertexAttrib4Nbv) X(glVertexAttrib4Niv) X(glVertexAttrib4Nsv) X(glVertexAttrib4Nub) \
+	X(glVertexAttrib4Nubv) X(glVertexAttrib4Nuiv) X(glVertexAttrib4Nusv) X(glVertexAttrib4bv) X(glVertexAttrib4d) X(glVertexAttrib4dv) \
+	X(glVertexAttrib4f) X(glVertexAttrib4fv) X(glVertexAttrib4iv) X(glVertexAttrib4s) X(glVertexAttrib4sv) X(glVertexAttrib4ubv) \
+	X(glVertexAttrib4uiv) X(glVertexAttrib4usv) X(glVertexAttribPointer) X(glUniformMatrix2x3fv) X(glUniformMatrix3x2fv) \
+	X(glUniformMatrix2x4fv) X(glUniformMatrix4x2fv) X(glUniformMatrix3x4fv) X(glUniformMatrix4x3fv) X(glColorMaski) X(glGetBooleani_v) \
+	X(glGetIntegeri_v) X(glEnablei) X(glDisablei) X(glIsEnabledi) X(glBeginTransformFeedback) X(glEndTransformFeedback) X(glBindBufferRange) \
+	X(glBindBufferBase) X(glTransformFeedbackVaryings) X(glGetTransformFeedbackVarying) X(glClampColor) X(glBeginConditionalRender) \
+	X(glEndConditionalRender) X(glVertexAttribIPointer) X(glGetVertexAttribIiv) X(glGetVertexAttribIuiv) X(glVertexAttribI1i) \
+	X(glVertexAttribI2i) X(glVertexAttribI3i) X(glVertexAttribI4i) X(glVertexAttribI1ui) X(glVertexAttribI2ui) X(glVertexAttribI3ui) \
+	X(glVertexAttribI4ui) X(glVertexAttribI1iv) X(glVertexAttribI2iv) X(glVertexAttribI3iv) X(glVertexAttribI4iv) X(glVertexAttribI1uiv) \
+	X(glVertexAttribI2uiv) X(glVertexAttribI3uiv) X(glVertexAttribI4uiv) X(glVertexAttribI4bv) X(glVertexAttribI4sv) X(glVertexAttribI4ubv) \
+	X(glVertexAttribI4usv) X(glGetUniformuiv) X(glBindFragDataLocation) X(glGetFragDataLocation) X(glUniform1ui) X(glUniform2ui) \
+	X(glUniform3ui) X(glUniform4ui) X(glUniform1uiv) X(glUniform2uiv) X(glUniform3uiv) X(glUniform4uiv) X(glTexParameterIiv) \
+	X(glTexParameterIuiv) X(glGetTexParameterIiv) X(glGetTexParameterIuiv) X(glClearBufferiv) X(glClearBufferuiv) X(glClearBufferfv) \
+	X(glClearBufferfi) X(glGetStringi) X(glIsRenderbuffer) X(glBindRenderbuffer) X(glDeleteRenderbuffers) X(glGenRenderbuffers) \
+	X(glRenderbufferStorage) X(glGetRenderbufferParameteriv) X(glIsFramebuffer) X(glBindFramebuffer) X(glDeleteFramebuffers) \
+	X(glGenFramebuffers) X(glCheckFramebufferStatus) X(glFramebufferTexture1D) X(glFramebufferTexture2D) X(glFramebufferTexture3D) \
+	X(glFramebufferRenderbuffer) X(glGetFramebufferAttachmentParameteriv) X(glGenerateMipmap) X(glBlitFramebuffer) \
+	X(glRenderbufferStorageMultisample) X(glFramebufferTextureLayer) X(glMapBufferRange) X(glFlushMappedBufferRange) X(glBindVertexArray) \
+	X(glDeleteVertexArrays) X(glGenVertexArrays) X(glIsVertexArray) X(glDrawArraysInstanced) X(glDrawElementsInstanced) X(glTexBuffer) \
+	X(glPrimitiveRestartIndex) X(glCopyBufferSubData) X(glGetUniformIndices) X(glGetActiveUniformsiv) X(glGetActiveUniformName) \
+	X(glGetUniformBlockIndex) X(glGetActiveUniformBlockiv) X(glGetActiveUniformBlockName) X(glUniformBlockBinding) X(glDrawElementsBaseVertex) \
+	X(glDrawRangeElementsBaseVertex) X(glDrawElementsInstancedBaseVertex) X(glMultiDrawElementsBaseVertex) X(glProvokingVertex) X(glFenceSync) \
+	X(glIsSync) X(glDeleteSync) X(glClientWaitSync) X(glWaitSync) X(glGetInteger64v) X(glGetSynciv) X(glGetInteger64i_v) \
+	X(glGetBufferParameteri64v) X(glFramebufferTexture) X(glTexImage2DMultisample) X(glTexImage3DMultisample) X(glGetMultisamplefv) \
+	X(glSampleMaski) X(glBindFragDataLocationIndexed) X(glGetFragDataIndex) X(glGenSamplers) X(glDeleteSamplers) X(glIsSampler) \
+	X(glBindSampler) X(glSamplerParameteri) X(glSamplerParameteriv) X(glSamplerParameterf) X(glSamplerParameterfv) X(glSamplerParameterIiv) \
+	X(glSamplerParameterIuiv) X(glGetSamplerParameteriv) X(glGetSamplerParameterIiv) X(glGetSamplerParameterfv) X(glGetSamplerParameterIuiv) \
+	X(glQueryCounter) X(glGetQueryObjecti64v) X(glGetQueryObjectui64v) X(glVertexAttribDivisor) X(glVertexAttribP1ui) X(glVertexAttribP1uiv) \
+	X(glVertexAttribP2ui) X(glVertexAttribP2uiv) X(glVertexAttribP3ui) X(glVertexAttribP3uiv) X(glVertexAttribP4ui) X(glVertexAttribP4uiv) \
+	X(glVertexP2ui) X(glVertexP2uiv) X(glVertexP3ui) X(glVertexP3uiv) X(glVertexP4ui) X(glVertexP4uiv) X(glTexCoordP1ui) X(glTexCoordP1uiv) \
+	X(glTexCoordP2ui) X(glTexCoordP2uiv) X(glTexCoordP3ui) X(glTexCoordP3uiv) X(glTexCoordP4ui) X(glTexCoordP4uiv) X(glMultiTexCoordP1ui) \
+	X(glMultiTexCoordP1uiv) X(glMultiTexCoordP2ui) X(glMultiTexCoordP2uiv) X(glMultiTexCoordP3ui) X(glMultiTexCoordP3uiv) \
+	X(glMultiTexCoordP4ui) X(glMultiTexCoordP4uiv) X(glNormalP3ui) X(glNormalP3uiv) X(glColorP3ui) X(glColorP3uiv) X(glColorP4ui) \
+	X(glColorP4uiv) X(glSecondaryColorP3ui) X(glSecondaryColorP3uiv) X(glMinSampleShading) X(glBlendEquationi) X(glBlendEquationSeparatei) \
+	X(glBlendFunci) X(glBlendFuncSeparatei) X(glDrawArraysIndirect) X(glDrawElementsIndirect) X(glUniform1d) X(glUniform2d) X(glUniform3d) \
+	X(glUniform4d) X(glUniform1dv) X(glUniform2dv) X(glUniform3dv) X(glUniform4dv) X(glUniformMatrix2dv) X(glUniformMatrix3dv) \
+	X(glUniformMatrix4dv) X(glUniformMatrix2x3dv) X(glUniformMatrix2x4dv) X(glUniformMatrix3x2dv) X(glUniformMatrix3x4dv) \
+	X(glUniformMatrix4x2dv) X(glUniformMatrix4x3dv) X(glGetUniformdv) X(glGetSubroutineUniformLocation) X(glGetSubroutineIndex) \
+	X(glGetActiveSubroutineUniformiv) X(glGetActiveSubroutineUniformName) X(glGetActiveSubroutineName) X(glUniformSubroutinesuiv) \
+	X(glGetUniformSubroutineuiv) X(glGetProgramStageiv) X(glPatchParameteri) X(glPatchParameterfv) X(glBindTransformFeedback) \
+	X(glDeleteTransformFeedbacks) X(glGenTransformFeedbacks) X(glIsTransformFeedback) X(glPauseTransformFeedback) X(glResumeTransformFeedback) \
+	X(glDrawTransformFeedback) X(glDrawTransformFeedbackStream) X(glBeginQueryIndexed) X(glEndQueryIndexed) X(glGetQueryIndexediv) \
+	X(glDebugMessageControlARB) X(glDebugMessageInsertARB) X(glDebugMessageCallbackARB) X(glGetDebugMessageLogARB)
+
+namespace GEE
+{
+	namespace
+	{
+		std::array<unsigned long long, NullGLCounterCount> Counters{};
+		GLuint NextObjectName = 1;
+		GLint NextUniformLocation = 0;
+		bool bNullGLLoaded = false;
+
+		void Count(NullGLCounter counter, unsigned long long amount = 1)
+		{
+			Counters[static_cast<unsigned int>(counter)] += amount;
+		}
+
+		/**
+		 * @brief Stubs with the exact signature of a GL function pointer type, so they are called with the right calling convention. They return a zero-initialized value.
+		*/
+		template <typename> struct NullGLStub;
+		template <typename Ret, typename... Args> struct NullGLStub<Ret(APIENTRYP)(Args...)>
+		{
+			static Ret APIENTRY Call(Args...)
+			{
+				return Ret();
+			}
+			template <NullGLCounter counter> static Ret APIENTRY CountedCall(Args...)
+			{
+				Count(counter);
+				return Ret();
+			}
+		};
+
+		const GLubyte* APIENTRY NullGetString(GLenum name)
+		{
+			switch (name)
+			{
+			case GL_VENDOR: return reinterpret_cast<const GLubyte*>("GEE");
+			case GL_RENDERER: return reinterpret_cast<const GLubyte*>("Null GL device");
+			case GL_VERSION: return reinterpret_cast<const GLubyte*>("4.0 GEE Null");
+			case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<const GLubyte*>("4.00");
+			default: return reinterpret_cast<const GLubyte*>("");
+			}
+		}
+
+		const GLubyte* APIENTRY NullGetStringi(GLenum name, GLuint index)
+		{
+			return reinterpret_cast<const GLubyte*>((name == GL_EXTENSIONS && index == 0) ? ("GL_ARB_debug_output") : (""));
+		}
+
+		void APIENTRY NullGetIntegerv(GLenum pname, GLint* data)
+		{
+			switch (pname)
+			{
+			case GL_NUM_EXTENSIONS: *data = 1; break;
+			case GL_MAJOR_VERSION: *data = 4; break;
+			case GL_MINOR_VERSION: *data = 0; break;
+			case GL_VIEWPORT:
+			case GL_SCISSOR_BOX: data[0] = data[1] = 0; data[2] = data[3] = 1; break;
+			case GL_MAX_TEXTURE_SIZE:
+			case GL_MAX_CUBE_MAP_TEXTURE_SIZE:
+			case GL_MAX_RENDERBUFFER_SIZE: *data = 16384; break;
+			case GL_MAX_UNIFORM_BLOCK_SIZE: *data = 65536; break;
+			case GL_MAX_VERTEX_UNIFORM_COMPONENTS:
+			case GL_MAX_FRAGMENT_UNIFORM_COMPONENTS: *data = 4096; break;
+			case GL_MAX_TEXTURE_IMAGE_UNITS: *data = 32; break;
+			case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS: *data = 192; break;
+			case GL_MAX_COLOR_ATTACHMENTS:
+			case GL_MAX_DRAW_BUFFERS:
+			case GL_MAX_SAMPLES: *data = 8; break;
+			case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT: *data = 256; break;
+			default: *data = 0;
+			}
+		}
+
+		void APIENTRY NullGetInteger64v(GLenum, GLint64* data)
+		{
+			*data = 0;
+		}
+
+		void APIENTRY NullGetFloatv(GLenum, GLfloat* data)
+		{
+			*data = 0.0f;
+		}
+
+		void APIENTRY NullGetBooleanv(GLenum, GLboolean* data)
+		{
+			*data = GL_FALSE;
+		}
+
+		void APIENTRY NullGenObjects(GLsizei n, GLuint* names)
+		{
+			for (GLsizei i = 0; i < n; i++)
+				names[i] = NextObjectName++;
+			Count(NullGLCounter::OBJECTS_CREATED, static_cast<unsigned long long>(n));
+		}
+
+		GLuint APIENTRY NullCreateProgram()
+		{
+			Count(NullGLCounter::OBJECTS_CREATED);
+			return NextObjectName++;
+		}
+
+		GLuint APIENTRY NullCreateShader(GLenum)
+		{
+			Count(NullGLCounter::OBJECTS_CREATED);
+			return NextObjectName++;
+		}
+
+		void APIENTRY NullGetShaderOrProgramiv(GLuint, GLenum pname, GLint* params)	//Every shader compiles and every program links
+		{
+			*params = (pname == GL_COMPILE_STATUS || pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS) ? (GL_TRUE) : (0);
+		}
+
+		void APIENTRY NullGetInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+		{
+			if (length)
+				*length = 0;
+			if (infoLog && bufSize > 0)
+				infoLog[0] = '\0';
+		}
+
+		GLint APIENTRY NullGetLocation(GLuint, const GLchar*)	//Uniform and attribute locations only need to be valid
+		{
+			return NextUniformLocation++;
+		}
+
+		GLenum APIENTRY NullCheckFramebufferStatus(GLenum)
+		{
+			return GL_FRAMEBUFFER_COMPLETE;
+		}
+
+		GLsync APIENTRY NullFenceSync(GLenum, GLbitfield)
+		{
+			static int fence;
+			return reinterpret_cast<GLsync>(&fence);
+		}
+
+		GLenum APIENTRY NullClientWaitSync(GLsync, GLbitfield, GLuint64)
+		{
+			return GL_ALREADY_SIGNALED;
+		}
+
+		void APIENTRY NullGetQueryObjectiv(GLuint, GLenum pname, GLint* params)	//Queries are available immediately and measure nothing
+		{
+			*params = (pname == GL_QUERY_RESULT_AVAILABLE) ? (GL_TRUE) : (0);
+		}
+
+		void APIENTRY NullGetQueryObjectuiv(GLuint, GLenum pname, GLuint* params)
+		{
+			*params = (pname == GL_QUERY_RESULT_AVAILABLE) ? (GL_TRUE) : (0);
+		}
+
+		void APIENTRY NullGetQueryObjecti64v(GLuint, GLenum, GLint64* params)
+		{
+			*params = 0;
+		}
+
+		void APIENTRY NullGetQueryObjectui64v(GLuint, GLenum, GLuint64* params)
+		{
+			*params = 0;
+		}
+
+		unsigned long long GetPixelDataSize(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type)
+		{
+			unsigned long long pixelSize = 0;
+			switch (type)
+			{
+			case GL_UNSIGNED_INT_24_8:
+			case GL_UNSIGNED_INT_10F_11F_11F_REV:
+			case GL_UNSIGNED_INT_2_10_10_10_REV: pixelSize = 4; break;	//Packed formats
+			case GL_FLOAT_32_UNSIGNED_INT_24_8_REV: pixelSize = 8; break;
+			default:
+			{
+				unsigned long long componentSize = 1;
+				switch (type)
+				{
+				case GL_SHORT: case GL_UNSIGNED_SHORT: case GL_HALF_FLOAT: componentSize = 2; break;
+				case GL_INT: case GL_UNSIGNED_INT: case GL_FLOAT: componentSize = 4; break;
+				}
+				unsigned long long componentCount = 4;
+				switch (format)
+				{
+				case GL_RED: case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX: case GL_RED_INTEGER: componentCount = 1; break;
+				case GL_RG: case GL_RG_INTEGER: componentCount = 2; break;
+				case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: componentCount = 3; break;
+				}
+				pixelSize = componentSize * componentCount;
+			}
+			}
+
+			return static_cast<unsigned long long>(width) * static_cast<unsigned long long>(height) * static_cast<unsigned long long>(depth) * pixelSize;
+		}
+
+		void APIENTRY NullBufferData(GLenum, GLsizeiptr size, const void* data, GLenum)
+		{
+			if (data)
+				Count(NullGLCounter::BYTES_UPLOADED, static_cast<unsigned long long>(size));
+		}
+
+		void APIENTRY NullBufferSubData(GLenum, GLintptr, GLsizeiptr size, const void* data)
+		{
+			if (data)
+				Count(NullGLCounter::BYTES_UPLOADED, static_cast<unsigned long long>(size));
+		}
+
+		void APIENTRY NullTexImage1D(GLenum, GLint, GLint, GLsizei width, GLint, GLenum format, GLenum type, const void* pixels)
+		{
+			if (pixels)
+				Count(NullGLCounter::BYTES_UPLOADED, GetPixelDataSize(width, 1, 1, format, type));
+		}
+
+		void APIENTRY NullTexImage2D(GLenum, GLint, GLint, GLsizei width, GLsizei height, GLint, GLenum format, GLenum type, const void* pixels)
+		{
+			if (pixels)
+				Count(NullGLCounter::BYTES_UPLOADED, GetPixelDataSize(width, height, 1, format, type));
+		}
+
+		void APIENTRY NullTexImage3D(GLenum, GLint, GLint, GLsizei width, GLsizei height, GLsizei depth, GLint, GLenum format, GLenum type, const void* pixels)
+		{
+			if (pixels)
+				Count(NullGLCounter::BYTES_UPLOADED, GetPixelDataSize(width, height, depth, format, type));
+		}
+
+		void APIENTRY NullTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels)
+		{
+			if (pixels)
+				Count(NullGLCounter::BYTES_UPLOADED, GetPixelDataSize(width, height, 1, format, type));
+		}
+
+		void APIENTRY NullTexSubImage3D(GLenum, GLint, GLint, GLint, GLint, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels)
+		{
+			if (pixels)
+				Count(NullGLCounter::BYTES_UPLOADED, GetPixelDataSize(width, height, depth, format, type));
+		}
+
+		void APIENTRY NullCompressedTexImage2D(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei imageSize, const void* data)
+		{
+			if (data)
+				Count(NullGLCounter::BYTES_UPLOADED, static_cast<unsigned long long>(imageSize));
+		}
+
+		struct NullGLFunction
+		{
+			const char* Name;
+			void* Function;
+		};
+
+#define GEE_NULL_GL_OVERRIDE(name, function) NullGLFunction{ #name, reinterpret_cast<void*>(static_cast<decltype(glad_##name)>(&function)) }	//The cast checks the signature
+#define GEE_NULL_GL_COUNTED(name, counter) NullGLFunction{ #name, reinterpret_cast<void*>(&NullGLStub<decltype(glad_##name)>::template CountedCall<NullGLCounter::counter>) }
+#define GEE_NULL_GL_STUB(name) NullGLFunction{ #name, reinterpret_cast<void*>(&NullGLStub<decltype(glad_##name)>::Call) },
+
+		const NullGLFunction Overrides[] =
+		{
+			GEE_NULL_GL_OVERRIDE(glGetString, NullGetString),
+			GEE_NULL_GL_OVERRIDE(glGetStringi, NullGetStringi),
+			GEE_NULL_GL_OVERRIDE(glGetIntegerv, NullGetIntegerv),
+			GEE_NULL_GL_OVERRIDE(glGetInteger64v, NullGetInteger64v),
+			GEE_NULL_GL_OVERRIDE(glGetFloatv, NullGetFloatv),
+			GEE_NULL_GL_OVERRIDE(glGetBooleanv, NullGetBooleanv),
+
+			GEE_NULL_GL_OVERRIDE(glGenBuffers, NullGenObjects),
+			GEE_NULL_GL_OVERRIDE(glGenTextures, NullGenObjects),
+			GEE_NULL_GL_OVERRIDE(glGenFramebuffers, NullGenObjects),
+			GEE_NULL_GL_OVERRIDE(glGenRenderbuffers, NullGenObjects),
+			GEE_NULL_GL_OVERRIDE(glGenVertexArrays, NullGenObjects),
+			GEE_NULL_GL_OVERRIDE(glGenQueries, NullGenObjects),
+			GEE_NULL_GL_OVERRIDE(glGenSamplers, NullGenObjects),
+			GEE_NULL_GL_OVERRIDE(glGenTransformFeedbacks, NullGenObjects),
+			GEE_NULL_GL_OVERRIDE(glCreateProgram, NullCreateProgram),
+			GEE_NULL_GL_OVERRIDE(glCreateShader, NullCreateShader),
+
+			GEE_NULL_GL_OVERRIDE(glGetShaderiv, NullGetShaderOrProgramiv),
+			GEE_NULL_GL_OVERRIDE(glGetProgramiv, NullGetShaderOrProgramiv),
+			GEE_NULL_GL_OVERRIDE(glGetShaderInfoLog, NullGetInfoLog),
+			GEE_NULL_GL_OVERRIDE(glGetProgramInfoLog, NullGetInfoLog),
+			GEE_NULL_GL_OVERRIDE(glGetUniformLocation, NullGetLocation),
+			GEE_NULL_GL_OVERRIDE(glGetAttribLocation, NullGetLocation),
+			GEE_NULL_GL_OVERRIDE(glCheckFramebufferStatus, NullCheckFramebufferStatus),
+			GEE_NULL_GL_OVERRIDE(glFenceSync, NullFenceSync),
+			GEE_NULL_GL_OVERRIDE(glClientWaitSync, NullClientWaitSync),
+			GEE_NULL_GL_OVERRIDE(glGetQueryObjectiv, NullGetQueryObjectiv),
+			GEE_NULL_GL_OVERRIDE(glGetQueryObjectuiv, NullGetQueryObjectuiv),
+			GEE_NULL_GL_OVERRIDE(glGetQueryObjecti64v, NullGetQueryObjecti64v),
+			GEE_NULL_GL_OVERRIDE(glGetQueryObjectui64v, NullGetQueryObjectui64v),
+
+			GEE_NULL_GL_OVERRIDE(glBufferData, NullBufferData),
+			GEE_NULL_GL_OVERRIDE(glBufferSubData, NullBufferSubData),
+			GEE_NULL_GL_OVERRIDE(glTexImage1D, NullTexImage1D),
+			GEE_NULL_GL_OVERRIDE(glTexImage2D, NullTexImage2D),
+			GEE_NULL_GL_OVERRIDE(glTexImage3D, NullTexImage3D),
+			GEE_NULL_GL_OVERRIDE(glTexSubImage2D, NullTexSubImage2D),
+			GEE_NULL_GL_OVERRIDE(glTexSubImage3D, NullTexSubImage3D),
+			GEE_NULL_GL_OVERRIDE(glCompressedTexImage2D, NullCompressedTexImage2D),
+
+			GEE_NULL_GL_COUNTED(glDrawArrays, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glDrawArraysInstanced, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glDrawArraysIndirect, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glDrawElements, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glDrawElementsInstanced, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glDrawElementsBaseVertex, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glDrawElementsInstancedBaseVertex, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glDrawElementsIndirect, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glDrawRangeElements, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glDrawRangeElementsBaseVertex, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glMultiDrawArrays, DRAW_CALLS),
+			GEE_NULL_GL_COUNTED(glMultiDrawElements, DRAW_CALLS),
+
+			GEE_NULL_GL_COUNTED(glClear, CLEARS),
+			GEE_NULL_GL_COUNTED(glClearBufferfv, CLEARS),
+			GEE_NULL_GL_COUNTED(glClearBufferiv, CLEARS),
+			GEE_NULL_GL_COUNTED(glClearBufferuiv, CLEARS),
+			GEE_NULL_GL_COUNTED(glClearBufferfi, CLEARS),
+
+			GEE_NULL_GL_COUNTED(glBindBuffer, BINDS),
+			GEE_NULL_GL_COUNTED(glBindBufferBase, BINDS),
+			GEE_NULL_GL_COUNTED(glBindBufferRange, BINDS),
+			GEE_NULL_GL_COUNTED(glBindTexture, BINDS),
+			GEE_NULL_GL_COUNTED(glBindFramebuffer, BINDS),
+			GEE_NULL_GL_COUNTED(glBindRenderbuffer, BINDS),
+			GEE_NULL_GL_COUNTED(glBindVertexArray, BINDS),
+			GEE_NULL_GL_COUNTED(glBindSampler, BINDS),
+			GEE_NULL_GL_COUNTED(glUseProgram, BINDS),
+			GEE_NULL_GL_COUNTED(glActiveTexture, BINDS),
+
+			GEE_NULL_GL_COUNTED(glEnable, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glDisable, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glBlendFunc, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glBlendFuncSeparate, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glBlendEquation, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glBlendEquationSeparate, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glDepthFunc, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glDepthMask, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glCullFace, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glFrontFace, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glStencilFunc, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glStencilFuncSeparate, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glStencilOp, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glStencilOpSeparate, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glStencilMask, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glColorMask, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glViewport, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glScissor, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glPolygonMode, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glPolygonOffset, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glDrawBuffer, STATE_CHANGES),
+			GEE_NULL_GL_COUNTED(glDrawBuffers, STATE_CHANGES)
+		};
+
+		const NullGLFunction Stubs[] =
+		{
+			GEE_NULL_GL_FUNCTIONS(GEE_NULL_GL_STUB)
+		};
+
+		void* NullGLLoad(const char* name)
+		{
+			for (const NullGLFunction& function : Overrides)
+				if (std::strcmp(function.Name, name) == 0)
+					return function.Function;
+			for (const NullGLFunction& function : Stubs)
+				if (std::strcmp(function.Name, name) == 0)
+					return function.Function;
+
+			std::cout << "ERROR! The null GL device does not implement " << name << ".\n";
+			return nullptr;
+		}
+	}
+
+	bool NullGLDevice::Load()
+	{
+		bNullGLLoaded = gladLoadGLLoader(NullGLLoad) != 0;
+		if (!bNullGLLoaded)
+			std::cout << "ERROR! Could not load the null GL device.\n";
+
+		return bNullGLLoaded;
+	}
+
+	bool NullGLDevice::IsLoaded()
+	{
+		return bNullGLLoaded;
+	}
+
+	unsigned long long NullGLDevice::GetCounter(NullGLCounter counter)
+	{
+		return Counters[static_cast<unsigned int>(counter)];
+	}
+
+	void NullGLDevice::ResetCounters()
+	{
+		Counters.fill(0);
+	}
+}
@@ -4,6 +4,7 @@
 #include <rendering/Mesh.h>
 #include <rendering/RenderInfo.h>
 #include <rendering/RenderToolbox.h>
+#include <utility/Profiler.h>
 #include <random>
 
 namespace GEE
@@ -23,6 +24,8 @@ namespace GEE
 		QuadShader = RenderHandle->AddShader(ShaderLoader::LoadShaders("Quad", "Shaders/quad.vs", "Shaders/quad.fs"));
 		QuadShader->Use();
 		QuadShader->Uniform1i("tex", 0);
+
+		QuadMeshInst = std::make_unique<MeshInstance>(RenderHandle->GetBasicShapeMesh(EngineBasicShape::QUAD), nullptr);
 	}
 
 	unsigned int Postprocess::GetFrameIndex()
@@ -97,6 +100,7 @@ namespace GEE
 
 	const Texture* Postprocess::SSAOPass(RenderInfo& info, const Texture* gPosition, const Texture* gNormal)
 	{
+		GEE_PROFILE_PASS("SSAO");
 		SSAOToolbox* tb;
 		if (!(tb = info.TbCollection.GetTb<SSAOToolbox>()))
 		{
@@ -130,6 +134,7 @@ namespace GEE
 
 	const Texture* Postprocess::SMAAPass(PPToolbox<SMAAToolbox> ppTb, const GEE_FB::Framebuffer& writeFramebuffer, const Viewport* viewport, const Texture* colorTex, const Texture* depthTex, const Texture* previousColorTex, const Texture* velocityTex, unsigned int writeColorBuffer, bool bT2x) const
 	{
+		GEE_PROFILE_PASS("SMAA");
 		SMAAToolbox& tb = ppTb.GetTb();
 		tb.SMAAFb->Bind();
 
@@ -209,6 +214,7 @@ namespace GEE
 
 	const Texture* Postprocess::TonemapGammaPass(PPToolbox<ComposedImageStorageToolbox> tb, const GEE_FB::Framebuffer& writeFramebuffer, const Viewport* viewport, const Texture* colorTex, const Texture* blurTex) const
 	{
+		GEE_PROFILE_PASS("Tonemap");
 		writeFramebuffer.Bind(true, viewport);
 		writeFramebuffer.SetDrawBuffer(0);
 
@@ -233,7 +239,10 @@ namespace GEE
 		const GameSettings::VideoSettings& settings = tbCollection.GetSettings();
 
 		if (settings.bBloom && blurTex != 0)
+		{
+			GEE_PROFILE_PASS("Bloom");
 			blurTex = GaussianBlur(GetPPToolbox<GaussianBlurToolbox>(tbCollection), *tbCollection.GetTb<GaussianBlurToolbox>()->BlurFramebuffers[0], nullptr, blurTex, 10);
+		}
 
 		if (settings.AAType == AntiAliasingType::AA_SMAA1X)
 		{
@@ -7,7 +7,11 @@
 #include <scene/LightProbeComponent.h>
 #include <rendering/RenderableVolume.h>
 #include <scene/hierarchy/HierarchyTree.h>
+#include <animation/CPUSkinning.h>
 #include <UI/Font.h>
+#include <utility/Profiler.h>
+#include <utility/MemoryArena.h>
+#include <optional>
 #include <random> //DO WYJEBANIA
 
 #include <input/InputDevicesStateRetriever.h>
@@ -17,7 +21,8 @@ namespace GEE
 	RenderEngine::RenderEngine(GameManager* gameHandle) :
 		GameHandle(gameHandle),
 		PreviousFrameView(glm::mat4(1.0f)),
-		BoundSkeletonBatch(nullptr),
+		BoundSkeletonInfo(nullptr),
+		FrameIndex(1),
 		BoundMesh(nullptr),
 		BoundMaterial(nullptr),
 		CurrentTbCollection(nullptr)
@@ -39,6 +44,8 @@ namespace GEE
 
 		LoadInternalShaders();
 		GenerateEngineObjects();
+		BonePalettes.Generate(10);
+		Profiler::Get().SetGpuTimingEnabled(true);
 
 		Postprocessing.Init(GameHandle, Resolution);
 
@@ -109,26 +116,26 @@ namespace GEE
 		std::string settingsDefines = GameHandle->GetGameSettings()->Video.GetShaderDefines(Resolution);
 
 		//load shadow shaders
-		Shaders.push_back(ShaderLoader::LoadShaders("Depth", "Shaders/depth.vs", "Shaders/depth.fs"));
+		AddShader(ShaderLoader::LoadShaders("Depth", "Shaders/depth.vs", "Shaders/depth.fs"));
 		Shaders.back()->SetExpectedMatrices(std::vector<MatrixType>{MatrixType::MVP});
 		Shaders.back()->UniformBlockBinding("BoneMatrices", 10);
-		Shaders.push_back(ShaderLoader::LoadShaders("DepthLinearize", "Shaders/depth_linearize.vs", "Shaders/depth_linearize.fs"));
+		AddShader(ShaderLoader::LoadShaders("DepthLinearize", "Shaders/depth_linearize.vs", "Shaders/depth_linearize.fs"));
 		Shaders.back()->SetExpectedMatrices(std::vector<MatrixType>{MatrixType::MODEL, MatrixType::MVP});
 		Shaders.back()->UniformBlockBinding("BoneMatrices", 10);
 
-		Shaders.push_back(ShaderLoader::LoadShaders("ErToCubemap", "Shaders/LightProbe/erToCubemap.vs", "Shaders/LightProbe/erToCubemap.fs"));
+		AddShader(ShaderLoader::LoadShaders("ErToCubemap", "Shaders/LightProbe/erToCubemap.vs", "Shaders/LightProbe/erToCubemap.fs"));
 		Shaders.back()->SetExpectedMatrices(std::vector<MatrixType>{MatrixType::VP});
 
-		Shaders.push_back(ShaderLoader::LoadShadersWithInclData("Cubemap", settingsDefines, "Shaders/cubemap.vs", "Shaders/cubemap.fs"));
+		AddShader(ShaderLoader::LoadShadersWithInclData("Cubemap", settingsDefines, "Shaders/cubemap.vs", "Shaders/cubemap.fs"));
 		Shaders.back()->SetExpectedMatrices(std::vector<MatrixType>{MatrixType::VP});
 
-		Shaders.push_back(ShaderLoader::LoadShaders("CubemapToIrradiance", "Shaders/irradianceCubemap.vs", "Shaders/irradianceCubemap.fs"));
+		AddShader(ShaderLoader::LoadShaders("CubemapToIrradiance", "Shaders/irradianceCubemap.vs", "Shaders/irradianceCubemap.fs"));
 		Shaders.back()->SetExpectedMatrices(std::vector<MatrixType>{MatrixType::VP});
 
-		Shaders.push_back(ShaderLoader::LoadShaders("CubemapToPrefilter", "Shaders/prefilterCubemap.vs", "Shaders/prefilterCubemap.fs"));
+		AddShader(ShaderLoader::LoadShaders("CubemapToPrefilter", "Shaders/prefilterCubemap.vs", "Shaders/prefilterCubemap.fs"));
 		Shaders.back()->SetExpectedMatrices(std::vector<MatrixType>{MatrixType::VP});
 
-		Shaders.push_back(ShaderLoader::LoadShaders("BRDFLutGeneration", "Shaders/brdfLutGeneration.vs", "Shaders/brdfLutGeneration.fs"));
+		AddShader(ShaderLoader::LoadShaders("BRDFLutGeneration", "Shaders/brdfLutGeneration.vs", "Shaders/brdfLutGeneration.fs"));
 
 		AddShader(ShaderLoader::LoadShaders("Forward_NoLight", "Shaders/forward_nolight.vs", "Shaders/forward_nolight.fs"), true);
 		Shaders.back()->SetExpectedMatrices(std::vector<MatrixType>{MatrixType::MVP});
@@ -138,7 +145,7 @@ namespace GEE
 		Shaders.back()->SetExpectedMatrices(std::vector<MatrixType>{MatrixType::MVP});
 
 		//load debug shaders
-		Shaders.push_back(ShaderLoader::LoadShaders("Debug", "Shaders/debug.vs", "Shaders/debug.fs"));
+		AddShader(ShaderLoader::LoadShaders("Debug", "Shaders/debug.vs", "Shaders/debug.fs"));
 		Shaders.back()->SetExpectedMatrices(std::vector<MatrixType>{MatrixType::MVP});
 	}
 
@@ -180,6 +187,11 @@ namespace GEE
 		return CurrentTbCollection;
 	}
 
+	RenderSnapshot& RenderEngine::GetRenderSnapshot()
+	{
+		return Snapshot;
+	}
+
 	std::vector<Material*> RenderEngine::GetMaterials()
 	{
 		std::vector<Material*> materials;
@@ -207,6 +219,8 @@ namespace GEE
 		if (material)
 			std::cout << " (" << material->GetLocalization().Name << ")\n";
 		Materials.push_back(material);
+		if (material)
+			MaterialIndex.Add(material->GetLocalization().Name, material);
 		return Materials.back().get();
 	}
 
@@ -216,26 +230,22 @@ namespace GEE
 			ForwardShaders.push_back(shader);
 
 		Shaders.push_back(shader);
+		if (shader)
+			ShaderIndex.Add(shader->GetName(), shader.get());
 
 		return Shaders.back();
 	}
 
-	void RenderEngine::BindSkeletonBatch(SkeletonBatch* batch)
+	bool RenderEngine::BindSkeletonPalette(SkeletonInfo& skelInfo)
 	{
-		if (!batch)
-			return;
+		if (BoundSkeletonInfo == &skelInfo)
+			return true;
 
-		batch->BindToUBO();
-		BoundSkeletonBatch = batch;
-	}
+		if (!BonePalettes.BindPalette(skelInfo, &Snapshot))
+			return false;
 
-	void RenderEngine::BindSkeletonBatch(GameSceneRenderData* sceneRenderData, unsigned int index)
-	{
-		if (index >= sceneRenderData->SkeletonBatches.size())
-			return;
-
-		sceneRenderData->SkeletonBatches[index]->BindToUBO();
-		BoundSkeletonBatch = sceneRenderData->SkeletonBatches[index].get();
+		BoundSkeletonInfo = &skelInfo;
+		return true;
 	}
 
 	void RenderEngine::EraseRenderTbCollection(RenderToolboxCollection& tbCollection)
@@ -245,38 +255,37 @@ namespace GEE
 
 	void RenderEngine::EraseMaterial(Material& mat)
 	{
+		MaterialIndex.EraseIf(mat.GetLocalization().Name, [&mat](const std::shared_ptr<Material>& indexed) { return indexed.get() == &mat; });
 		Materials.erase(std::remove_if(Materials.begin(), Materials.end(), [&mat](std::shared_ptr<Material>& matVec) {return matVec.get() == &mat; }), Materials.end());
 	}
 
-	std::shared_ptr<Material> RenderEngine::FindMaterial(std::string name)
+	void RenderEngine::UpdateMaterialNameIndex(Material& mat, const std::string& previousName)
+	{
+		std::shared_ptr<Material> indexed;
+		if (!MaterialIndex.Find(previousName, indexed, [&mat](const std::shared_ptr<Material>& indexedMat) { return indexedMat.get() == &mat; }))
+			return;	//Not added yet; AddMaterial will index it under its current name
+
+		MaterialIndex.Rename(previousName, mat.GetLocalization().Name, indexed);
+	}
+
+	std::shared_ptr<Material> RenderEngine::FindMaterial(const std::string& name)
 	{
 		if (name.empty())
 			return nullptr;
 
-		auto materialIt = std::find_if(Materials.begin(), Materials.end(), [name](const std::shared_ptr<Material>& material) {	return material->GetLocalization().Name == name; });
-
-		if (materialIt != Materials.end())
-			return *materialIt;
+		std::shared_ptr<Material> found;
+		if (MaterialIndex.Find(name, found))
+			return found;
 
 		std::cerr << "INFO: Can't find material " << name << "!\n";
 		return nullptr;
 	}
 
-	Shader* RenderEngine::FindShader(std::string name)
+	Shader* RenderEngine::FindShader(const std::string& name)
 	{
-		//std::cout << "Searching for " + name + ".\n";
-		auto shaderIt = std::find_if(Shaders.begin(), Shaders.end(), [name](std::shared_ptr<Shader> shader) { return shader->GetName() == name; });
-
-		//std::cout << *shaderIt << '\n';
-		if (*shaderIt == nullptr)
-		{
-			std::cout << "Ups.\n";
-			for (int i = 0; i < Shaders.size(); i++)
-				std::cout << "zjebane: " << Shaders[i]->GetName() << ".\n";
-		}
-
-		if (shaderIt != Shaders.end())
-			return shaderIt->get();
+		Shader* found = nullptr;
+		if (ShaderIndex.Find(name, found))
+			return found;
 
 		std::cerr << "ERROR! Can't find a shader named " << name << "!\n";
 		return nullptr;
@@ -284,6 +293,7 @@ namespace GEE
 
 	void RenderEngine::RenderShadowMaps(RenderToolboxCollection& tbCollection, GameSceneRenderData* sceneRenderData, std::vector <std::reference_wrapper<LightComponent>> lights)
 	{
+		GEE_PROFILE_PASS("ShadowMaps");
 		ShadowMappingToolbox* shadowsTb = tbCollection.GetTb<ShadowMappingToolbox>();
 		bool dynamicShadowRender = tbCollection.GetSettings().ShadowLevel > SettingLevel::SETTING_MEDIUM;
 		shadowsTb->ShadowFramebuffer->Bind(true);
@@ -299,8 +309,6 @@ namespace GEE
 		shadowsTb->ShadowMapArray->Bind(10);
 		shadowsTb->ShadowCubemapArray->Bind(11);
 
-		BindSkeletonBatch(sceneRenderData, static_cast<unsigned int>(0));
-
 		for (int i = 0; i < static_cast<int>(lights.size()); i++)
 		{
 			LightComponent& light = lights[i].get();
@@ -321,8 +329,7 @@ namespace GEE
 					bCubemapBound = true;
 				}
 
-				Transform lightWorld = light.GetTransform().GetWorldTransform();
-				glm::vec3 lightPos = lightWorld.Pos();
+				glm::vec3 lightPos = Snapshot.GetWorldPosition(light.GetTransform());	//shadows follow the interpolated light, like the light data in the UBO
 				glm::mat4 viewTranslation = glm::translate(glm::mat4(1.0f), -lightPos);
 				glm::mat4 projection = light.GetProjection();
 
@@ -346,7 +353,7 @@ namespace GEE
 					bCubemapBound = false;
 				}
 
-				glm::mat4 view = light.GetTransform().GetWorldTransform().GetViewMatrix();
+				glm::mat4 view = Snapshot.GetViewMatrix(light.GetTransform(), true);
 				glm::mat4 projection = light.GetProjection();
 				glm::mat4 VP = projection * view;
 
@@ -403,7 +410,7 @@ namespace GEE
 		RenderVolume(info, volume->GetShape(), *boundShader, &volume->GetRenderTransform());
 	}
 
-	void RenderEngine::RenderVolumes(const RenderInfo& info, const GEE_FB::Framebuffer& framebuffer, const std::vector<std::unique_ptr<RenderableVolume>>& volumes, bool bIBLPass)
+	void RenderEngine::RenderVolumes(const RenderInfo& info, const GEE_FB::Framebuffer& framebuffer, const ArenaVector<RenderableVolume*>& volumes, bool bIBLPass)
 	{
 		Shader* boundShader = nullptr;
 
@@ -431,7 +438,7 @@ namespace GEE
 				glStencilFunc(GL_GREATER, 128, 0xFF);
 				glDepthFunc(GL_LEQUAL);
 				glDrawBuffer(GL_NONE);
-				RenderVolume(info, volumes[i].get(), boundShader, false);
+				RenderVolume(info, volumes[i], boundShader, false);
 			}
 
 			//2nd pass: lighting
@@ -452,8 +459,8 @@ namespace GEE
 			xdCopy.view = glm::mat4(1.0f);
 			xdCopy.projection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f);
 			xdCopy.CalculateVP();
-			RenderVolume((volumes[i]->GetShape() == EngineBasicShape::QUAD) ? (xdCopy) : (info), volumes[i].get(), boundShader, true);
-			//RenderVolume(info, volumes[i].get(), boundShader, true);
+			RenderVolume((volumes[i]->GetShape() == EngineBasicShape::QUAD) ? (xdCopy) : (info), volumes[i], boundShader, true);
+			//RenderVolume(info, volumes[i], boundShader, true);
 		}
 
 		glDisable(GL_BLEND);
@@ -587,6 +594,7 @@ namespace GEE
 		debugShader->UniformMatrix4fv("MVP", info.VP);
 		debugShader->Uniform3fv("color", color);
 		glDrawArrays(mode, first, count);
+		GEE_PROFILE_COUNT(DRAW_CALLS, 1);
 	}
 
 	void RenderEngine::PreLoopPass()
@@ -640,31 +648,34 @@ namespace GEE
 			GEE_FB::Framebuffer& GFramebuffer = *deferredTb->GFb;
 
 			{
-				Viewport onlySizeViewport(glm::uvec2(0), viewport.GetSize());
-				GFramebuffer.Bind(true, &onlySizeViewport);
-			}
-			glEnable(GL_DEPTH_TEST);
-			glEnable(GL_CULL_FACE);
-			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-			info.MainPass = true;
-			info.CareAboutShader = true;
+				GEE_PROFILE_PASS("GBuffer");
+				{
+					Viewport onlySizeViewport(glm::uvec2(0), viewport.GetSize());
+					GFramebuffer.Bind(true, &onlySizeViewport);
+				}
+				glEnable(GL_DEPTH_TEST);
+				glEnable(GL_CULL_FACE);
+				glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+				info.MainPass = true;
+				info.CareAboutShader = true;
 
 
-			if (debugPhysics)
-				glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+				if (debugPhysics)
+					glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-			Shader* gShader = deferredTb->GeometryShader;
-			gShader->Use();
-			gShader->Uniform3fv("camPos", info.camPos);
+				Shader* gShader = deferredTb->GeometryShader;
+				gShader->Use();
+				gShader->Uniform3fv("camPos", info.camPos);
 
-			RenderRawScene(info, sceneRenderData, gShader);
-			info.MainPass = false;
-			info.CareAboutShader = false;
+				RenderRawScene(info, sceneRenderData, gShader);
+				info.MainPass = false;
+				info.CareAboutShader = false;
 
 
-			if (debugPhysics)
-				glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+				if (debugPhysics)
+					glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+			}
 
 			////////////////////2.5 SSAO pass
 			const Texture* SSAOtex = nullptr;
@@ -673,6 +684,7 @@ namespace GEE
 				SSAOtex = Postprocessing.SSAOPass(info, GFramebuffer.GetColorBuffer(0).get(), GFramebuffer.GetColorBuffer(1).get());	//pass gPosition and gNormal
 
 			////////////////////3. Lighting pass
+			GEE_PROFILE_PASS("Lighting");
 			for (int i = 0; i < static_cast<int>(deferredTb->LightShaders.size()); i++)
 				deferredTb->LightShaders[i]->UniformBlockBinding("Lights", sceneRenderData->LightsBuffer.BlockBindingSlot);
 			sceneRenderData->UpdateLightUniforms();
@@ -689,9 +701,16 @@ namespace GEE
 
 			if (SSAOtex)
 				SSAOtex->Bind(4);
-			std::vector<std::unique_ptr<RenderableVolume>> volumes;
-			volumes.resize(sceneRenderData->Lights.size());
-			std::transform(sceneRenderData->Lights.begin(), sceneRenderData->Lights.end(), volumes.begin(), [](const std::reference_wrapper<LightComponent>& light) {return std::make_unique<LightVolume>(LightVolume(light.get())); });
+			LinearArena& renderArena = MemoryArenas::Get(MemoryArenaType::RENDER);
+			ArenaVector<LightVolume> lightVolumes(renderArena);
+			ArenaVector<RenderableVolume*> volumes(renderArena);
+			lightVolumes.reserve(sceneRenderData->Lights.size());
+			volumes.reserve(sceneRenderData->Lights.size());
+			for (auto& light : sceneRenderData->Lights)
+			{
+				lightVolumes.push_back(LightVolume(light.get()));
+				volumes.push_back(&lightVolumes.back());
+			}
 			RenderVolumes(info, MainFramebuffer, volumes, false);// Shading == ShadingModel::SHADING_PBR_COOK_TORRANCE);
 
 			info.TbCollection.FindShader("CookTorranceIBL")->Use();
@@ -699,17 +718,26 @@ namespace GEE
 			{
 				LightProbeComponent* probe = sceneRenderData->LightProbes[i];
 				Shader* shader = probe->GetRenderShader(info.TbCollection);
-				shader->Uniform1f("lightProbes[" + std::to_string(i) + "].intensity", probe->GetProbeIntensity());
+				char uniformName[48];
+				snprintf(uniformName, sizeof(uniformName), "lightProbes[%d].intensity", i);
+				shader->Uniform1f(uniformName, probe->GetProbeIntensity());
 
 				if (probe->GetShape() == EngineBasicShape::QUAD)
 					continue;
 
-				shader->Uniform3fv("lightProbes[" + std::to_string(i) + "].position", probe->GetTransform().GetWorldTransform().Pos());
+				snprintf(uniformName, sizeof(uniformName), "lightProbes[%d].position", i);
+				shader->Uniform3fv(uniformName, probe->GetTransform().GetWorldTransform().Pos());
 			}
 
-			std::vector<std::unique_ptr<RenderableVolume>> probeVolumes;
-			probeVolumes.resize(sceneRenderData->LightProbes.size());
-			std::transform(sceneRenderData->LightProbes.begin(), sceneRenderData->LightProbes.end(), probeVolumes.begin(), [](LightProbeComponent* probe) {return std::make_unique<LightProbeVolume>(LightProbeVolume(*probe)); });
+			ArenaVector<LightProbeVolume> lightProbeVolumes(renderArena);
+			ArenaVector<RenderableVolume*> probeVolumes(renderArena);
+			lightProbeVolumes.reserve(sceneRenderData->LightProbes.size());
+			probeVolumes.reserve(sceneRenderData->LightProbes.size());
+			for (LightProbeComponent* probe : sceneRenderData->LightProbes)
+			{
+				lightProbeVolumes.push_back(LightProbeVolume(*probe));
+				probeVolumes.push_back(&lightProbeVolumes.back());
+			}
 			if (!probeVolumes.empty())	//TODO: DELETE. VERY NASTY!!!!!! ADD LOADING LIGHT PROBES FROM FILE AND DONT DELETE THE FIRST PROBE FOR NO REASON
 			{
 				//if (framebuffer)
@@ -743,27 +771,29 @@ namespace GEE
 
 
 		////////////////////3.5 Forward rendering pass
-		glEnable(GL_DEPTH_TEST);
-		glDisable(GL_CULL_FACE);
-		info.MainPass = true;
-		info.CareAboutShader = true;
-
-		if (modifyForwardsDepthForUI)
-			RenderRawSceneUI(info, sceneRenderData);
-		else
-			for (unsigned int i = 0; i < ForwardShaders.size(); i++)
-				RenderRawScene(info, sceneRenderData, ForwardShaders[i].get());
+		{
+			GEE_PROFILE_PASS("Forward");
+			glEnable(GL_DEPTH_TEST);
+			glDisable(GL_CULL_FACE);
+			info.MainPass = true;
+			info.CareAboutShader = true;
 
-		FindShader("Forward_NoLight")->Use();
-		FindShader("Forward_NoLight")->Uniform2fv("atlasData", glm::vec2(0.0f));
-		FindShader("Forward_NoLight")->Uniform2fv("atlasTexOffset", glm::vec2(0.0f));
+			if (modifyForwardsDepthForUI)
+				RenderRawSceneUI(info, sceneRenderData);
+			else
+				for (unsigned int i = 0; i < ForwardShaders.size(); i++)
+					RenderRawScene(info, sceneRenderData, ForwardShaders[i].get());
 
+			FindShader("Forward_NoLight")->Use();
+			FindShader("Forward_NoLight")->Uniform2fv("atlasData", glm::vec2(0.0f));
+			FindShader("Forward_NoLight")->Uniform2fv("atlasTexOffset", glm::vec2(0.0f));
 
-		info.MainPass = false;
-		info.CareAboutShader = false;
 
-		glDisable(GL_DEPTH_TEST);
+			info.MainPass = false;
+			info.CareAboutShader = false;
 
+			glDisable(GL_DEPTH_TEST);
+		}
 
 		if (debugPhysics && GameHandle->GetMainScene()->GetRenderData() == sceneRenderData)
 			GameHandle->GetPhysicsHandle()->DebugRender(*GameHandle->GetMainScene()->GetPhysicsData(), *this, info);
@@ -776,8 +806,9 @@ namespace GEE
 
 	void RenderEngine::PrepareFrame()
 	{
-		if (GameHandle->GetMainScene())
-			BindSkeletonBatch(GameHandle->GetMainScene()->GetRenderData(), static_cast<unsigned int>(0));
+		BonePalettes.BeginFrame();
+		BoundSkeletonInfo = nullptr;
+		FrameIndex++;
 
 		//std::cout << "***Shaders deubg***\n";
 		//for (auto& it : Shaders)
@@ -1009,9 +1040,8 @@ namespace GEE
 
 	void RenderEngine::RenderStaticMesh(const RenderInfo& info, const MeshInstance& mesh, const Transform& transform, Shader* shader, glm::mat4* lastFrameMVP, Material* material, bool billboard)
 	{
-		std::vector<std::unique_ptr<MeshInstance>> vec;
-		vec.push_back(std::make_unique<MeshInstance>(MeshInstance(mesh)));
-		RenderStaticMeshes(info, vec, transform, shader, lastFrameMVP, material, billboard);
+		const MeshInstance* meshPtr = &mesh;
+		RenderStaticMeshInstances(info, &meshPtr, 1, transform, shader, lastFrameMVP, material, billboard);
 	}
 
 	void RenderEngine::RenderStaticMeshes(const RenderInfo& info, const std::vector<std::unique_ptr<MeshInstance>>& meshes, const Transform& transform, Shader* shader, glm::mat4* lastFrameMVP, Material* overrideMaterial, bool billboard)
@@ -1019,14 +1049,29 @@ namespace GEE
 		if (meshes.empty())
 			return;
 
-		std::unique_ptr<MaterialInstance> createdInstance = ((overrideMaterial) ? (std::make_unique<MaterialInstance>(MaterialInstance(*overrideMaterial))) : (nullptr));
+		ArenaVector<const MeshInstance*> meshPtrs(MemoryArenas::Get(MemoryArenaType::RENDER));
+		meshPtrs.reserve(meshes.size());
+		for (auto& mesh : meshes)
+			meshPtrs.push_back(mesh.get());
+
+		RenderStaticMeshInstances(info, meshPtrs.data(), meshPtrs.size(), transform, shader, lastFrameMVP, overrideMaterial, billboard);
+	}
+
+	void RenderEngine::RenderStaticMeshInstances(const RenderInfo& info, const MeshInstance* const* meshes, size_t meshCount, const Transform& transform, Shader* shader, glm::mat4* lastFrameMVP, Material* overrideMaterial, bool billboard)
+	{
+		if (meshCount == 0)
+			return;
+
+		std::optional<MaterialInstance> createdInstance;
+		if (overrideMaterial)
+			createdInstance.emplace(*overrideMaterial);
 
 		bool handledShader = false;
-		for (int i = 0; i < static_cast<int>(meshes.size()); i++)
+		for (int i = 0; i < static_cast<int>(meshCount); i++)
 		{
 			const MeshInstance& meshInst = *meshes[i];
 			const Mesh& mesh = meshInst.GetMesh();
-			MaterialInstance* materialInst = ((overrideMaterial) ? (createdInstance.get()) : (meshInst.GetMaterialInst()));
+			MaterialInstance* materialInst = ((overrideMaterial) ? (&*createdInstance) : (meshInst.GetMaterialInst()));
 			const Material* material = ((overrideMaterial) ? (overrideMaterial) : (meshInst.GetMaterialPtr()));
 
 			if ((info.CareAboutShader && material && shader->GetName() != material->GetRenderShaderName()) || (info.OnlyShadowCasters && !mesh.CanCastShadow()) || (materialInst && !materialInst->ShouldBeDrawn()))
@@ -1036,7 +1081,7 @@ namespace GEE
 			{
 				handledShader = true;
 
-				glm::mat4 modelMat = transform.GetWorldTransformMatrix();	//the ComponentTransform's world transform is cached
+				glm::mat4 modelMat = Snapshot.GetWorldMatrix(transform);	//interpolated between the two most recent simulation states (falls back to the cached world transform)
 				if (billboard)
 					modelMat = modelMat * glm::mat4(glm::inverse(transform.GetWorldTransform().GetRotationMatrix()) * glm::inverse(glm::mat3(info.view)));
 
@@ -1085,17 +1130,20 @@ namespace GEE
 		if (meshes.empty())
 			return;
 
-		std::unique_ptr<MaterialInstance> createdInstance = ((overrideMaterial) ? (std::make_unique<MaterialInstance>(MaterialInstance(*overrideMaterial))) : (nullptr));
+		std::optional<MaterialInstance> createdInstance;
+		if (overrideMaterial)
+			createdInstance.emplace(*overrideMaterial);
 
 
 		//TODO: Pass the bone matrices from the last frame to fix velocity buffer calculation
 
-		bool handledShader = false;
+		bool handledShader = false, filledCPUPalette = false;
 		for (int i = 0; i < static_cast<int>(meshes.size()); i++)
 		{
 			const MeshInstance& meshInst = *meshes[i];
 			const Mesh& mesh = meshInst.GetMesh();
-			MaterialInstance* materialInst = ((overrideMaterial) ? (createdInstance.get()) : (meshInst.GetMaterialInst()));
+			CPUSkinnedMesh* cpuSkinned = meshInst.GetCPUSkinnedMesh();
+			MaterialInstance* materialInst = ((overrideMaterial) ? (&*createdInstance) : (meshInst.GetMaterialInst()));
 			const Material* material = ((overrideMaterial) ? (overrideMaterial) : (meshInst.GetMaterialPtr()));
 
 			if ((info.CareAboutShader && material && shader->GetName() != material->GetRenderShaderName()) || (info.OnlyShadowCasters && !mesh.CanCastShadow()) || !materialInst->ShouldBeDrawn())
@@ -1105,21 +1153,35 @@ namespace GEE
 			{
 				handledShader = true;
 
-				shader->Uniform1i("boneIDOffset", skelInfo.GetBoneIDOffset());
+				if (!BindSkeletonPalette(skelInfo))
+					return;
+				shader->Uniform1i("boneIDOffset", 0);	//Bone IDs are relative to the skeleton's palette slice
 
-				glm::mat4 modelMat = transform.GetWorldTransformMatrix();	//the ComponentTransform's world transform is cached
+				glm::mat4 modelMat = Snapshot.GetWorldMatrix(transform);	//interpolated between the two most recent simulation states (falls back to the cached world transform)
 				bool bCalcVelocity = GameHandle->GetGameSettings()->Video.IsVelocityBufferNeeded() && info.MainPass;
 				bool jitter = info.MainPass && GameHandle->GetGameSettings()->Video.IsTemporalReprojectionEnabled();
 
 				glm::mat4 jitteredVP = (jitter) ? (Postprocessing.GetJitterMat(info.TbCollection.GetSettings()) * info.VP) : (info.VP);
 				shader->BindMatrices(modelMat, &info.view, &info.projection, &jitteredVP);
 			}
-			if (skelInfo.GetBatchPtr() != BoundSkeletonBatch)
-				BindSkeletonBatch(skelInfo.GetBatchPtr());
-
-			shader->Uniform1i("boneIDOffset", skelInfo.GetBoneIDOffset());
+			if (cpuSkinned)
+			{
+				//Skin once per frame; every other pass (shadow maps, cubemap faces, probes) reuses the stream. Its vertices have no bones bound, so the shader skips the palette.
+				if (!cpuSkinned->IsUpToDate(FrameIndex))
+				{
+					if (!filledCPUPalette)
+					{
+						CPUSkinningPalette.resize(std::max(static_cast<size_t>(skelInfo.GetPaletteMatCount()), CPUSkinningPalette.size()));
+						skelInfo.FillPalette(CPUSkinningPalette.data(), &Snapshot);
+						filledCPUPalette = true;
+					}
+					cpuSkinned->Update(CPUSkinningPalette.data(), FrameIndex);
+				}
 
-			if (BoundMesh != &mesh || i == 0)
+				cpuSkinned->Bind();
+				BoundMesh = nullptr;
+			}
+			else if (BoundMesh != &mesh || i == 0)
 			{
 				mesh.Bind();
 				BoundMesh = &mesh;
@@ -1136,7 +1198,10 @@ namespace GEE
 					materialInst->UpdateInstanceUBOData(shader);
 			}
 
-			mesh.Render();
+			if (cpuSkinned)
+				cpuSkinned->Render();
+			else
+				mesh.Render();
 		}
 	}
 
@@ -1146,6 +1211,8 @@ namespace GEE
 		CubemapData.DefaultFramebuffer.Dispose();
 
 		Postprocessing.Dispose();
+		BonePalettes.Dispose();
+		Profiler::Get().SetGpuTimingEnabled(false);	//Delete the timer queries while the context still exists
 		//ShadowFramebuffer.Dispose();
 
 		//CurrentTbCollection->ShadowsTb->ShadowMapArray->Dispose();
@@ -1156,6 +1223,7 @@ namespace GEE
 			if (std::find(ForwardShaders.begin(), ForwardShaders.end(), *i) == ForwardShaders.end())
 			{
 				(*i)->Dispose();
+				ShaderIndex.Erase((*i)->GetName(), i->get());
 				Shaders.erase(i);
 				i--;
 			}
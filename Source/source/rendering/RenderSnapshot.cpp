@@ -0,0 +1,170 @@
+#include <rendering/RenderSnapshot.h>
+#include <game/GameScene.h>
+#include <scene/RenderableComponent.h>
+#include <scene/CameraComponent.h>
+#include <scene/BoneComponent.h>
+#include <scene/LightComponent.h>
+#include <animation/SkeletonInfo.h>
+
+namespace GEE
+{
+	RenderSnapshot::RenderSnapshot() :
+		StepIndex(0),
+		Alpha(1.0f),
+		bEnabled(true)
+	{
+	}
+
+	bool RenderSnapshot::IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	void RenderSnapshot::SetEnabled(bool enabled)
+	{
+		bEnabled = enabled;
+		if (!bEnabled)
+			Clear();
+	}
+
+	void RenderSnapshot::BeginCapture()
+	{
+		if (!bEnabled)
+			return;
+
+		//Recycle the slots of transforms which were not captured in the last step (destroyed or no longer rendered)
+		for (int i = 0; i < static_cast<int>(Slots.size()); i++)
+			if (Slots[i].Owner && Slots[i].CapturedStep[StepIndex % 2] != StepIndex)
+			{
+				Slots[i].Owner = nullptr;
+				FreeSlots.push_back(i);
+			}
+
+		StepIndex++;
+	}
+
+	void RenderSnapshot::Capture(const GameSceneRenderData& sceneRenderData, const CameraComponent* activeCamera)
+	{
+		if (!bEnabled || sceneRenderData.bIsAnUIScene)
+			return;
+
+		for (auto renderable : sceneRenderData.Renderables)
+			if (auto comp = dynamic_cast<const Component*>(renderable))
+				CaptureTransform(comp->GetTransform());
+
+		for (auto& batch : sceneRenderData.SkeletonBatches)
+			for (auto& skeleton : batch->Skeletons)
+			{
+				if (skeleton->GlobalInverseTransformCompPtr)
+					CaptureTransform(skeleton->GlobalInverseTransformCompPtr->GetTransform());
+				for (auto bone : skeleton->Bones)
+					CaptureTransform(bone->GetTransform());
+			}
+
+		for (auto& light : sceneRenderData.Lights)
+			CaptureTransform(light.get().GetTransform());
+
+		if (activeCamera)
+			CaptureTransform(activeCamera->GetTransform());
+	}
+
+	void RenderSnapshot::SetAlpha(float alpha)
+	{
+		Alpha = glm::clamp(alpha, 0.0f, 1.0f);
+	}
+
+	glm::mat4 RenderSnapshot::GetWorldMatrix(const Transform& transform) const
+	{
+		TransformState state;
+		if (!Interpolate(transform, state))
+			return transform.GetWorldTransformMatrix();
+
+		glm::mat4 mat = glm::translate(glm::mat4(1.0f), state.Position);
+		mat *= glm::mat4_cast(state.Rotation);
+		return glm::scale(mat, state.Scale);
+	}
+
+	glm::mat4 RenderSnapshot::GetViewMatrix(const Transform& transform, bool interpolateRotation) const
+	{
+		glm::vec3 position = GetWorldPosition(transform);
+		glm::vec3 front = (interpolateRotation) ? (GetWorldRotation(transform) * glm::vec3(0.0f, 0.0f, -1.0f)) : (transform.GetWorldTransform().GetFrontVec());
+
+		return glm::lookAt(position, position + front, glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+
+	glm::vec3 RenderSnapshot::GetWorldPosition(const Transform& transform) const
+	{
+		TransformState state;
+		if (!Interpolate(transform, state))
+			return transform.GetWorldTransform().Pos();
+
+		return state.Position;
+	}
+
+	glm::quat RenderSnapshot::GetWorldRotation(const Transform& transform) const
+	{
+		TransformState state;
+		if (!Interpolate(transform, state))
+			return transform.GetWorldTransform().Rot();
+
+		return state.Rotation;
+	}
+
+	void RenderSnapshot::Clear()
+	{
+		//Transforms keep their slot indices, but Interpolate() rejects any index whose slot is not owned by the queried transform
+		Slots.clear();
+		FreeSlots.clear();
+	}
+
+	void RenderSnapshot::CaptureTransform(const Transform& transform)
+	{
+		int slotIndex = transform.RenderSnapshotSlot;
+		if (slotIndex < 0 || slotIndex >= static_cast<int>(Slots.size()) || Slots[slotIndex].Owner != &transform)
+		{
+			if (!FreeSlots.empty())
+			{
+				slotIndex = FreeSlots.back();
+				FreeSlots.pop_back();
+			}
+			else
+			{
+				slotIndex = static_cast<int>(Slots.size());
+				Slots.push_back(Slot());
+				if (FreeSlots.capacity() < Slots.capacity())
+					FreeSlots.reserve(Slots.capacity());
+			}
+
+			Slot& slot = Slots[slotIndex];
+			slot.Owner = &transform;
+			slot.CapturedStep[0] = slot.CapturedStep[1] = -1;
+			transform.RenderSnapshotSlot = slotIndex;
+		}
+
+		Slot& slot = Slots[slotIndex];
+		const Transform& world = transform.GetWorldTransform();
+		slot.States[StepIndex % 2] = TransformState{ world.Pos(), world.Rot(), world.Scale() };
+		slot.CapturedStep[StepIndex % 2] = StepIndex;
+	}
+
+	bool RenderSnapshot::Interpolate(const Transform& transform, TransformState& result) const
+	{
+		if (!bEnabled)
+			return false;
+
+		const int slotIndex = transform.RenderSnapshotSlot;
+		if (slotIndex < 0 || slotIndex >= static_cast<int>(Slots.size()) || Slots[slotIndex].Owner != &transform)
+			return false;
+
+		const Slot& slot = Slots[slotIndex];
+		if (slot.CapturedStep[StepIndex % 2] != StepIndex || slot.CapturedStep[(StepIndex + 1) % 2] != StepIndex - 1)
+			return false;
+
+		const TransformState& previous = slot.States[(StepIndex + 1) % 2];
+		const TransformState& current = slot.States[StepIndex % 2];
+		result.Position = glm::mix(previous.Position, current.Position, Alpha);
+		result.Rotation = glm::slerp(previous.Rotation, current.Rotation, Alpha);
+		result.Scale = glm::mix(previous.Scale, current.Scale, Alpha);
+		return true;
+	}
+}
@@ -1,4 +1,5 @@
 #include <rendering/Shader.h>
+#include <utility/Profiler.h>
 
 #include <UI/UICanvasActor.h>
 #include <UI/UICanvasField.h>
@@ -18,14 +19,15 @@ namespace GEE
 		}
 	}
 
-	GLint Shader::FindLocation(std::string name) const
+	GLint Shader::FindLocation(std::string_view name) const
 	{
 		auto loc = std::find_if(Locations.begin(), Locations.end(), [name](const UniformLocation& location) { return location.Name == name; });
 
 		if (loc != Locations.end())
 			return loc->Location;
 
-		Locations.push_back(UniformLocation(name, glGetUniformLocation(Program, name.c_str())));
+		std::string nameStr(name);	//glGetUniformLocation expects a null-terminated string
+		Locations.push_back(UniformLocation(nameStr, glGetUniformLocation(Program, nameStr.c_str())));
 		return Locations.back().Location;
 	}
 
@@ -43,7 +45,7 @@ namespace GEE
 		ShadersSource = { "", "", "" };
 	}
 
-	std::string Shader::GetName()
+	const std::string& Shader::GetName() const
 	{
 		return Name;
 	}
@@ -104,42 +106,49 @@ namespace GEE
 			std::cerr << "ERROR! Can't find matrix type " << matType << '\n';
 	}
 
-	void Shader::Uniform1i(std::string name, int val) const
+	void Shader::Uniform1i(std::string_view name, int val) const
 	{
 		glUniform1i(FindLocation(name), val);
+		GEE_PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 	}
 
-	void Shader::Uniform1f(std::string name, float val) const
+	void Shader::Uniform1f(std::string_view name, float val) const
 	{
 		glUniform1f(FindLocation(name), val);
+		GEE_PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 	}
 
-	void Shader::Uniform2fv(std::string name, glm::vec2 val) const
+	void Shader::Uniform2fv(std::string_view name, glm::vec2 val) const
 	{
 		glUniform2fv(FindLocation(name), 1, glm::value_ptr(val));
+		GEE_PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 	}
 
-	void Shader::Uniform3fv(std::string name, glm::vec3 val) const
+	void Shader::Uniform3fv(std::string_view name, glm::vec3 val) const
 	{
 		glUniform3fv(FindLocation(name), 1, glm::value_ptr(val));
+		GEE_PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 	}
 
-	void Shader::Uniform4fv(std::string name, glm::vec4 val) const
+	void Shader::Uniform4fv(std::string_view name, glm::vec4 val) const
 	{
 		glUniform4fv(FindLocation(name), 1, glm::value_ptr(val));
+		GEE_PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 	}
 
-	void Shader::UniformMatrix3fv(std::string name, glm::mat3 val) const
+	void Shader::UniformMatrix3fv(std::string_view name, glm::mat3 val) const
 	{
 		glUniformMatrix3fv(FindLocation(name), 1, GL_FALSE, glm::value_ptr(val));
+		GEE_PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 	}
 
-	void Shader::UniformMatrix4fv(std::string name, const glm::mat4& val) const
+	void Shader::UniformMatrix4fv(std::string_view name, const glm::mat4& val) const
 	{
 		glUniformMatrix4fv(FindLocation(name), 1, GL_FALSE, glm::value_ptr(val));
+		GEE_PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 	}
 
-	void Shader::UniformBlockBinding(std::string name, unsigned int binding) const
+	void Shader::UniformBlockBinding(std::string_view name, unsigned int binding) const
 	{
 		glUniformBlockBinding(Program, GetUniformBlockIndex(name), binding);
 	}
@@ -149,14 +158,15 @@ namespace GEE
 		glUniformBlockBinding(Program, blockID, binding);
 	}
 
-	unsigned int Shader::GetUniformBlockIndex(std::string name) const
+	unsigned int Shader::GetUniformBlockIndex(std::string_view name) const
 	{
-		return glGetUniformBlockIndex(Program, name.c_str());
+		return glGetUniformBlockIndex(Program, std::string(name).c_str());
 	}
 
 	void Shader::Use() const
 	{
 		glUseProgram(Program);
+		GEE_PROFILE_COUNT(STATE_CHANGES, 1);
 	}
 
 	void Shader::BindMatrices(const glm::mat4& model, const glm::mat4* view, const glm::mat4* projection, const glm::mat4* VP) const
@@ -5,6 +5,7 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <assimp/texture.h>
 #include <vector>
+#include <utility/Profiler.h>
 
 namespace GEE
 {
@@ -49,6 +50,7 @@ namespace GEE
 		if (texSlot >= 0)
 			glActiveTexture(GL_TEXTURE0 + texSlot);
 		glBindTexture(Type, ID);
+		GEE_PROFILE_COUNT(STATE_CHANGES, 1);
 	}
 
 	void Texture::Dispose()
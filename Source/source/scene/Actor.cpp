@@ -19,8 +19,13 @@ namespace GEE
 		GameHandle(scene.GetGameHandle()),
 		ParentActor(parentActor),
 		bKillingProcessStarted(false),
-		SetupStream(nullptr)
+		bSerializable(true),
+		SetupStream(nullptr),
+		SubscribedEvents(0),
+		bEventListenersAttached(false)
 	{
+		EventListenerCounts.fill(0);
+		Scene.ActorsIndex.Add(Name, this);
 		RootComponent = std::make_unique<Component>(*this, nullptr, Name + "'s root", t);
 		if (GameHandle->HasStarted())
 			RootComponent->OnStartAll();
@@ -34,8 +39,13 @@ namespace GEE
 		SetupStream(moved.SetupStream),
 		Scene(moved.Scene),
 		GameHandle(moved.GameHandle),
-		bKillingProcessStarted(moved.bKillingProcessStarted)
+		bKillingProcessStarted(moved.bKillingProcessStarted),
+		bSerializable(moved.bSerializable),
+		SubscribedEvents(moved.SubscribedEvents),
+		EventListenerCounts(moved.EventListenerCounts),
+		bEventListenersAttached(false)
 	{
+		Scene.ActorsIndex.Add(Name, this);
 		std::cout << "UWAGA: MOVE CONSTRUCTOR NIE DZIALA. (" + Name + ") (" + Scene.GetName() + ")\n";
 		RootComponent = std::make_unique<Component>(*this, nullptr, Name + "'s root", Transform());
 		//exit(-1);
@@ -99,9 +109,26 @@ namespace GEE
 		return bKillingProcessStarted;
 	}
 
+	bool Actor::IsSerializable() const
+	{
+		return bSerializable;
+	}
+
+	void Actor::SetSerializable(bool serializable)
+	{
+		bSerializable = serializable;
+	}
+
 	void Actor::SetName(const std::string& name)
 	{
+		const std::string previousName = Name;
 		Name = name;
+		UpdateNameIndex(previousName);
+	}
+
+	void Actor::UpdateNameIndex(const std::string& previousName)
+	{
+		Scene.ActorsIndex.Rename(previousName, Name, this);
 	}
 
 	void Actor::DebugHierarchy(int nrTabs)
@@ -165,10 +192,26 @@ namespace GEE
 		Children.push_back(std::move(child));
 		Children.back()->GetTransform()->SetParentTransform(&RootComponent->GetTransform());
 		Children.back()->ParentActor = this;
+		AttachChildEventListeners(*Children.back());
 
 		return *Children.back();
 	}
 
+	std::unique_ptr<Actor> Actor::DetachChild(Actor& child)
+	{
+		auto found = std::find_if(Children.begin(), Children.end(), [&child](std::unique_ptr<Actor>& childVec) { return childVec.get() == &child; });
+		if (found == Children.end())
+			return nullptr;
+
+		child.DetachFromParentEventListeners();
+		std::unique_ptr<Actor> detached = std::move(*found);
+		Children.erase(found);
+		detached->ParentActor = nullptr;
+		detached->GetTransform()->SetParentTransform(nullptr);
+
+		return detached;
+	}
+
 	void Actor::SetSetupStream(std::stringstream* stream)
 	{
 		SetupStream = stream;
@@ -189,16 +232,75 @@ namespace GEE
 
 	void Actor::HandleEventAll(const Event& ev)
 	{
-		HandleEvent(ev);
+		if (IsSubscribedToEvent(ev.GetType()))
+			HandleEvent(ev);
 
 		int childrenCount = static_cast<int>(Children.size());
 		for (int i = 0; i < childrenCount; i++)	//This type of loop is put here on purpose. The children might add other children, which would case iterators to become invalid.
-			Children[i]->HandleEventAll(ev);
+			if (Children[i]->HasEventListenersInHierarchy(ev.GetType()))
+				Children[i]->HandleEventAll(ev);
+	}
+
+	void Actor::SubscribeToEvent(EventType type)
+	{
+		if (IsSubscribedToEvent(type))
+			return;
+
+		SubscribedEvents |= (1u << static_cast<unsigned int>(type));
+		ChangeEventListenerCount(type, 1);
+	}
+
+	void Actor::UnsubscribeFromEvent(EventType type)
+	{
+		if (!IsSubscribedToEvent(type))
+			return;
+
+		SubscribedEvents &= ~(1u << static_cast<unsigned int>(type));
+		ChangeEventListenerCount(type, -1);
+	}
+
+	bool Actor::IsSubscribedToEvent(EventType type) const
+	{
+		return (SubscribedEvents & (1u << static_cast<unsigned int>(type))) != 0;
+	}
+
+	bool Actor::HasEventListenersInHierarchy(EventType type) const
+	{
+		return EventListenerCounts[static_cast<unsigned int>(type)] > 0;
+	}
+
+	void Actor::ChangeEventListenerCount(EventType type, int difference)
+	{
+		if (difference == 0)
+			return;
+
+		for (Actor* actor = this; actor; actor = (actor->bEventListenersAttached) ? (actor->ParentActor) : (nullptr))
+			actor->EventListenerCounts[static_cast<unsigned int>(type)] += difference;
+	}
+
+	void Actor::AttachChildEventListeners(Actor& child)
+	{
+		if (child.bEventListenersAttached)
+			return;
+
+		child.bEventListenersAttached = true;
+		for (unsigned int i = 0; i < EventTypeCount; i++)
+			ChangeEventListenerCount(static_cast<EventType>(i), static_cast<int>(child.EventListenerCounts[i]));
+	}
+
+	void Actor::DetachFromParentEventListeners()
+	{
+		if (!bEventListenersAttached || !ParentActor)
+			return;
+
+		for (unsigned int i = 0; i < EventTypeCount; i++)
+			ParentActor->ChangeEventListenerCount(static_cast<EventType>(i), -static_cast<int>(EventListenerCounts[i]));
+		bEventListenersAttached = false;
 	}
 
 	void Actor::Update(float deltaTime)
 	{
-		RootComponent->UpdateAll(deltaTime);
+		//Components are updated by the ComponentUpdateScheduler of the scene
 		if (Name == "CubeActor")
 			;//RootComponent->GetTransform().SetScale(glm::vec3(1.0f + glfwGetTime() * 0.05f));
 	}
@@ -234,7 +336,10 @@ namespace GEE
 		if (!ParentActor)
 			std::cout << "INFO: Cannot delete actor " + GetName() + " because it doesn't have a parent (it is probably the root of a scene). Hopefully it will be deleted when the scene gets deleted.\n";
 		else
+		{
+			DetachFromParentEventListeners();
 			ParentActor->Children.erase(std::remove_if(ParentActor->Children.begin(), ParentActor->Children.end(), [this](std::unique_ptr<Actor>& child) { return child.get() == this; }), ParentActor->Children.end());
+		}
 	}
 
 	void Actor::DebugRender(RenderInfo info, Shader* shader) const
@@ -254,6 +359,17 @@ namespace GEE
 		if (Name == name)
 			return this;
 
+		if (Scene.ActorsIndex.IsUnique(name))
+		{
+			Actor* found = nullptr;
+			Scene.ActorsIndex.Find(name, found);
+			return (!found->IsBeingKilled() && found->IsDescendantOf(*this)) ? (found) : (nullptr);
+		}
+
+		if (!Scene.ActorsIndex.Contains(name))
+			return nullptr;
+
+		//The name is shared - search depth first, so the first actor with the name in this hierarchy is returned
 		for (int i = 0; i < static_cast<int>(Children.size()); i++)
 			if (Actor* found = Children[i]->FindActor(name))
 				if (!found->IsBeingKilled())
@@ -267,6 +383,20 @@ namespace GEE
 		return const_cast<Actor*>(this)->FindActor(name);
 	}
 
+	bool Actor::IsDescendantOf(const Actor& actor) const
+	{
+		for (const Actor* parent = ParentActor; parent; parent = parent->ParentActor)
+			if (parent == &actor)
+				return true;
+
+		return false;
+	}
+
+	Actor::~Actor()
+	{
+		Scene.ActorsIndex.Erase(Name, this);
+	}
+
 	void Actor::GetEditorDescription(EditorDescriptionBuilder descBuilder)
 	{
 		UIInputBoxActor& textActor = descBuilder.CreateActor<UIInputBoxActor>("ComponentsNameActor");
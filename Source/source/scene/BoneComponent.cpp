@@ -12,7 +12,7 @@ namespace GEE
 		FinalMatrix(glm::mat4(1.0f)),
 		InfoPtr(nullptr)
 	{
-
+		RegisterForUpdate(UpdateStage::BONES);
 	}
 
 	BoneComponent::BoneComponent(BoneComponent&& bone) :
@@ -1,6 +1,7 @@
 #include <scene/CameraComponent.h>
 #include <rendering/RenderInfo.h>
 #include <rendering/Material.h>
+#include <rendering/RenderSnapshot.h>
 
 #include <UI/UICanvasActor.h>
 #include <UI/UICanvasField.h>
@@ -29,7 +30,8 @@ namespace GEE
 
 	RenderInfo CameraComponent::GetRenderInfo(RenderToolboxCollection& renderCollection)
 	{
-		return RenderInfo(renderCollection, GetTransform().GetWorldTransform().GetViewMatrix(), GetProjectionMat(), glm::mat4(1.0f), GetTransform().GetWorldTransform().Pos());
+		const RenderSnapshot& snapshot = GameHandle->GetRenderEngineHandle()->GetRenderSnapshot();	//the camera position is interpolated between simulation steps
+		return RenderInfo(renderCollection, snapshot.GetViewMatrix(GetTransform()), GetProjectionMat(), glm::mat4(1.0f), snapshot.GetWorldPosition(GetTransform()));
 	}
 
 	void CameraComponent::RotateWithMouse(glm::vec2 mouseOffset)
@@ -21,8 +21,9 @@ GEE::Component* cereal::LoadAndConstruct<GEE::Component>::ParentComp = nullptr;
 namespace GEE
 {
 	Component::Component(Actor& actor, Component* parentComp, const std::string& name, const Transform& t) :
-		Name(name), ComponentTransform(t), Scene(actor.GetScene()), ActorRef(actor), ParentComponent(parentComp), GameHandle(actor.GetScene().GetGameHandle()), CollisionObj(nullptr), DebugRenderMat(nullptr), DebugRenderMatInst(nullptr), DebugRenderLastFrameMVP(glm::mat4(1.0f)), bKillingProcessStarted(false)
+		Name(name), ComponentTransform(t), Scene(actor.GetScene()), ActorRef(actor), ParentComponent(parentComp), GameHandle(actor.GetScene().GetGameHandle()), CollisionObj(nullptr), DebugRenderMat(nullptr), DebugRenderMatInst(nullptr), DebugRenderLastFrameMVP(glm::mat4(1.0f)), bKillingProcessStarted(false), ScheduledStage(UpdateStage::ANIMATION), UpdateSlot(-1)
 	{
+		Scene.ComponentsIndex.Add(Name, this);
 	}
 
 	Component::Component(Component&& comp) :
@@ -37,16 +38,31 @@ namespace GEE
 		DebugRenderMat(comp.DebugRenderMat),
 		DebugRenderMatInst(comp.DebugRenderMatInst),
 		DebugRenderLastFrameMVP(comp.DebugRenderLastFrameMVP),
-		bKillingProcessStarted(comp.bKillingProcessStarted)
+		bKillingProcessStarted(comp.bKillingProcessStarted),
+		ScheduledStage(comp.ScheduledStage),
+		UpdateSlot(-1)
 	{
+		Scene.ComponentsIndex.Add(Name, this);
+		for (auto& child : Children)
+		{
+			child->ParentComponent = this;
+			child->GetTransform().SetParentTransform(&ComponentTransform);
+		}
+		if (comp.IsRegisteredForUpdate())
+			RegisterForUpdate(ScheduledStage);
 		std::cout << "Komponentowy move...\n";
 	}
 
 	Component& Component::operator=(Component&& comp)
 	{
-		Name = comp.Name;
+		SetName(comp.Name);
 		ComponentTransform = comp.ComponentTransform;
 		Children = std::move(comp.Children);
+		for (auto& child : Children)
+		{
+			child->ParentComponent = this;
+			child->GetTransform().SetParentTransform(&ComponentTransform);
+		}
 		CollisionObj = std::move(comp.CollisionObj);
 		DebugRenderMat = comp.DebugRenderMat;
 		DebugRenderMatInst = comp.DebugRenderMatInst;
@@ -56,7 +72,7 @@ namespace GEE
 
 	Component& Component::operator=(const Component& compT)
 	{
-		Name = compT.Name;
+		SetName(compT.Name);
 		ComponentTransform *= compT.ComponentTransform;
 		CollisionObj = (compT.CollisionObj) ? (std::make_unique<Physics::CollisionObject>(*compT.CollisionObj)) : (nullptr);
 		if (CollisionObj)
@@ -179,6 +195,7 @@ namespace GEE
 			{
 				std::unique_ptr<Component> temp = std::move(*it);
 				Children.erase(it);
+				temp->ParentComponent = nullptr;
 				return std::move(temp);
 			}
 
@@ -203,7 +220,14 @@ namespace GEE
 
 	void Component::SetName(std::string name)
 	{
+		const std::string previousName = Name;
 		Name = name;
+		UpdateNameIndex(previousName);
+	}
+
+	void Component::UpdateNameIndex(const std::string& previousName)
+	{
+		Scene.ComponentsIndex.Rename(previousName, Name, this);
 	}
 	void Component::SetTransform(Transform transform)
 	{
@@ -224,6 +248,7 @@ namespace GEE
 	Component& Component::AddComponent(std::unique_ptr<Component> component)
 	{
 		component->GetTransform().SetParentTransform(&this->ComponentTransform);
+		component->ParentComponent = this;
 		Children.push_back(std::move(component));
 		return *Children.back();
 	}
@@ -232,7 +257,7 @@ namespace GEE
 	{
 		std::transform(components.begin(), components.end(), std::back_inserter(Children), [](std::unique_ptr<Component>& comp) { return std::move(comp); });
 		components.clear();
-		std::for_each(Children.begin(), Children.end(), [this](std::unique_ptr<Component>& comp) { comp->GetTransform().SetParentTransform(&this->ComponentTransform); });
+		std::for_each(Children.begin(), Children.end(), [this](std::unique_ptr<Component>& comp) { comp->GetTransform().SetParentTransform(&this->ComponentTransform); comp->ParentComponent = this; });
 	}
 
 	void Component::Update(float deltaTime)
@@ -240,60 +265,19 @@ namespace GEE
 		ComponentTransform.Update(deltaTime);
 	}
 
-	void Component::UpdateAll(float dt)
-	{
-		Update(dt);
-		for (int i = 0; i < static_cast<int>(Children.size()); i++)
-			Children[i]->UpdateAll(dt);
-
-		if (IsBeingKilled())
-		{
-			Delete();
-			return;
-		}
-	}
-
-	void Component::QueueAnimation(Animation* animation)
-	{
-		for (int i = 0; i < static_cast<int>(animation->Channels.size()); i++)
-		{
-			if (animation->Channels[i]->Name != Name)
-				continue;
-
-			AnimationChannel& channel = *animation->Channels[i];
-
-			for (int j = 0; j < static_cast<int>(channel.PosKeys.size() - 1); j++)
-				ComponentTransform.AddInterpolator<glm::vec3>("position", (float)channel.PosKeys[j]->Time, (float)channel.PosKeys[j + 1]->Time - (float)channel.PosKeys[j]->Time, channel.PosKeys[j]->Value, channel.PosKeys[j + 1]->Value);
-
-			for (int j = 0; j < static_cast<int>(channel.RotKeys.size() - 1); j++)
-				ComponentTransform.AddInterpolator<glm::quat>("rotation", (float)channel.RotKeys[j]->Time, (float)channel.RotKeys[j + 1]->Time - (float)channel.RotKeys[j]->Time, channel.RotKeys[j]->Value, channel.RotKeys[j + 1]->Value);
-
-			for (int j = 0; j < static_cast<int>(channel.ScaleKeys.size() - 1); j++)
-				ComponentTransform.AddInterpolator<glm::vec3>("scale", (float)channel.ScaleKeys[j]->Time, (float)channel.ScaleKeys[j + 1]->Time - (float)channel.ScaleKeys[j]->Time, channel.ScaleKeys[j]->Value, channel.ScaleKeys[j + 1]->Value);
-		}
-	}
-
-	void Component::QueueAnimationAll(Animation* animation)
+	void Component::RegisterForUpdate(UpdateStage stage)
 	{
-		QueueAnimation(animation);
-		for (int i = 0; i < static_cast<int>(Children.size()); i++)
-			Children[i]->QueueAnimationAll(animation);
+		Scene.UpdateScheduler.Register(*this, stage);
 	}
 
-	void Component::QueueKeyFrame(AnimationChannel& channel)
+	void Component::UnregisterFromUpdate()
 	{
-		for (int j = 0; j < static_cast<int>(channel.PosKeys.size() - 1); j++)
-			ComponentTransform.AddInterpolator<glm::vec3>("position", (float)channel.PosKeys[j]->Time, (float)channel.PosKeys[j + 1]->Time - (float)channel.PosKeys[j]->Time, channel.PosKeys[j]->Value, channel.PosKeys[j + 1]->Value);
-
-		for (int j = 0; j < static_cast<int>(channel.RotKeys.size() - 1); j++)
-			ComponentTransform.AddInterpolator<glm::quat>("rotation", (float)channel.RotKeys[j]->Time, (float)channel.RotKeys[j + 1]->Time - (float)channel.RotKeys[j]->Time, channel.RotKeys[j]->Value, channel.RotKeys[j + 1]->Value);
-
-		for (int j = 0; j < static_cast<int>(channel.ScaleKeys.size() - 1); j++)
-			ComponentTransform.AddInterpolator<glm::vec3>("scale", (float)channel.ScaleKeys[j]->Time, (float)channel.ScaleKeys[j + 1]->Time - (float)channel.ScaleKeys[j]->Time, channel.ScaleKeys[j]->Value, channel.ScaleKeys[j + 1]->Value);
+		Scene.UpdateScheduler.Erase(*this);
 	}
 
-	void Component::QueueKeyFrameAll(AnimationChannel&)
+	bool Component::IsRegisteredForUpdate() const
 	{
+		return UpdateSlot >= 0;
 	}
 
 	void CollisionObjRendering(RenderInfo& info, GameManager& gameHandle, Physics::CollisionObject& obj, const Transform& t, const glm::vec3& color)
@@ -303,7 +287,7 @@ namespace GEE
 		shader->Use();
 		Material material("CollisionShapeDebugMaterial\n");
 
-		physx::PxRigidDynamic* rigidDynamicCast = obj.ActorPtr->is<physx::PxRigidDynamic>();
+		physx::PxRigidDynamic* rigidDynamicCast = (obj.ActorPtr && !gameHandle.GetPhysicsHandle()->IsSimulating()) ? (obj.ActorPtr->is<physx::PxRigidDynamic>()) : (nullptr);	//The sleep state cannot be read while a step is simulated
 		bool sleeping = (rigidDynamicCast && rigidDynamicCast->isSleeping());
 		material.SetColor((sleeping) ? (glm::vec3(1.0) - color) : (color));
 		if (!shader)
@@ -392,20 +376,56 @@ namespace GEE
 		}
 	}
 
-	Component* Component::SearchForComponent(std::string name)
+	Component* Component::SearchForComponent(const std::string& name)
+	{
+		return FindComponent(name, [](Component&) { return true; });
+	}
+
+	Component* Component::FindComponent(const std::string& name, bool(*predicate)(Component&))
 	{
 		if (Name == name)
 			return this;
 
-		for (int i = 0; i < static_cast<int>(Children.size()); i++)
+		if (Scene.ComponentsIndex.IsUnique(name))
+		{
+			Component* found = nullptr;
+			Scene.ComponentsIndex.Find(name, found);
+			return (found->IsDescendantOf(*this) && predicate(*found)) ? (found) : (nullptr);
+		}
+
+		if (!Scene.ComponentsIndex.Contains(name))
+			return nullptr;
+
+		return FindComponentDepthFirst(name, predicate);
+	}
+
+	Component* Component::FindComponentDepthFirst(const std::string& name, bool(*predicate)(Component&))
+	{
+		for (auto& child : Children)
 		{
-			Component* childSearch = Children[i]->SearchForComponent(name);
-			if (childSearch)
-				return childSearch;
+			if (child->Name == name)
+			{
+				if (predicate(*child))
+					return child.get();
+				continue;
+			}
+
+			if (Component* found = child->FindComponentDepthFirst(name, predicate))
+				return found;
 		}
+
 		return nullptr;
 	}
 
+	bool Component::IsDescendantOf(const Component& comp) const
+	{
+		for (const Component* parent = ParentComponent; parent; parent = parent->ParentComponent)
+			if (parent == &comp)
+				return true;
+
+		return false;
+	}
+
 	void Component::GetEditorDescription(EditorDescriptionBuilder descBuilder)
 	{
 		UIInputBoxActor& textActor = descBuilder.CreateActor<UIInputBoxActor>("ComponentsNameActor");
@@ -518,6 +538,8 @@ namespace GEE
 
 	void Component::MarkAsKilled()
 	{
+		if (!bKillingProcessStarted)	//The component will be deleted after the scene's components have been updated
+			Scene.UpdateScheduler.QueueForDeletion(*this);
 		bKillingProcessStarted = true;
 		if (!ParentComponent)	//If this is the root component of an Actor, kill the Actor as well.
 			ActorRef.MarkAsKilled();
@@ -528,6 +550,9 @@ namespace GEE
 	Component::~Component()
 	{
 		//std::cout << "Erasing component " << Name << " " << this << ".\n";
+		Scene.ComponentsIndex.Erase(Name, this);
+		Scene.UpdateScheduler.Erase(*this);
+		Scene.UpdateScheduler.EraseFromDeletionQueue(*this);
 		if (ComponentTransform.GetParentTransform())
 			ComponentTransform.GetParentTransform()->RemoveChild(&ComponentTransform);
 		std::for_each(Children.begin(), Children.end(), [](std::unique_ptr<Component>& comp) {comp->GetTransform().SetParentTransform(nullptr); });
@@ -0,0 +1,122 @@
+#include <scene/ComponentUpdateScheduler.h>
+#include <scene/Component.h>
+#include <utility/JobSystem.h>
+#include <utility/Profiler.h>
+#include <algorithm>
+
+namespace GEE
+{
+	ComponentUpdateScheduler::ComponentUpdateScheduler() :
+		bUpdating(false),
+		bCompactionRequired(false)
+	{
+		for (auto& stage : Stages)
+			stage.bParallel = false;
+	}
+
+	void ComponentUpdateScheduler::Register(Component& comp, UpdateStage stageType)
+	{
+		if (comp.UpdateSlot >= 0)
+			Erase(comp);
+
+		Stage& stage = Stages[static_cast<unsigned int>(stageType)];
+		comp.ScheduledStage = stageType;
+		comp.UpdateSlot = static_cast<int>(stage.Components.size());
+		stage.Components.push_back(&comp);
+	}
+
+	void ComponentUpdateScheduler::Erase(Component& comp)
+	{
+		if (comp.UpdateSlot < 0)
+			return;
+
+		std::vector<Component*>& components = Stages[static_cast<unsigned int>(comp.ScheduledStage)].Components;
+		const size_t slot = static_cast<size_t>(comp.UpdateSlot);
+		comp.UpdateSlot = -1;
+
+		if (bUpdating)	//Do not move other components while they are being iterated over
+		{
+			components[slot] = nullptr;
+			bCompactionRequired = true;
+			return;
+		}
+
+		components[slot] = components.back();
+		if (components[slot])
+			components[slot]->UpdateSlot = static_cast<int>(slot);
+		components.pop_back();
+	}
+
+	void ComponentUpdateScheduler::SetStageParallel(UpdateStage stageType, bool bParallel)
+	{
+		Stages[static_cast<unsigned int>(stageType)].bParallel = bParallel;
+	}
+
+	size_t ComponentUpdateScheduler::GetComponentCount(UpdateStage stageType) const
+	{
+		const std::vector<Component*>& components = Stages[static_cast<unsigned int>(stageType)].Components;
+		return components.size() - std::count(components.begin(), components.end(), nullptr);
+	}
+
+	void ComponentUpdateScheduler::Update(float deltaTime, JobSystem* jobSystem)
+	{
+		GEE_PROFILE_SCOPE("Components");
+		bUpdating = true;
+
+		for (auto& stage : Stages)
+		{
+			std::vector<Component*>& components = stage.Components;
+			if (stage.bParallel && jobSystem)
+			{
+				jobSystem->ParallelFor(components.size(), 64, [&components, deltaTime](size_t begin, size_t end)
+					{
+						for (size_t i = begin; i < end; i++)
+							if (components[i])
+								components[i]->Update(deltaTime);
+					});
+				continue;
+			}
+
+			for (size_t i = 0; i < components.size(); i++)	//Components registered during the update are updated in the same frame
+				if (components[i])
+					components[i]->Update(deltaTime);
+		}
+
+		bUpdating = false;
+		if (bCompactionRequired)
+			Compact();
+	}
+
+	void ComponentUpdateScheduler::QueueForDeletion(Component& comp)
+	{
+		DeletionQueue.push_back(&comp);
+	}
+
+	void ComponentUpdateScheduler::EraseFromDeletionQueue(Component& comp)
+	{
+		DeletionQueue.erase(std::remove(DeletionQueue.begin(), DeletionQueue.end(), &comp), DeletionQueue.end());
+	}
+
+	void ComponentUpdateScheduler::DeleteQueuedComponents()
+	{
+		while (!DeletionQueue.empty())	//Deleting a component destroys its children, which erase themselves from the queue
+		{
+			Component* comp = DeletionQueue.back();
+			DeletionQueue.pop_back();
+			comp->Delete();
+		}
+	}
+
+	void ComponentUpdateScheduler::Compact()
+	{
+		for (auto& stage : Stages)
+		{
+			std::vector<Component*>& components = stage.Components;
+			components.erase(std::remove(components.begin(), components.end(), nullptr), components.end());
+			for (size_t i = 0; i < components.size(); i++)
+				components[i]->UpdateSlot = static_cast<int>(i);
+		}
+
+		bCompactionRequired = false;
+	}
+}
@@ -3,6 +3,7 @@
 #include <scene/CameraComponent.h>
 #include <physics/CollisionObject.h>
 #include <animation/Animation.h>
+#include <animation/AnimationManagerActor.h>
 #include <input/InputDevicesStateRetriever.h>
 #include <PhysX/PxPhysicsAPI.h>
 #include <scene/TextComponent.h>
@@ -184,12 +185,17 @@ namespace GEE
 			}
 		}
 
+		//Root motion is applied in the same move, so the possessed actor's transform is written once (by the physics engine) per frame.
+		//The animation manager is looked up every frame instead of being cached, because it can be deleted at the end of any scene update.
+		AnimationManagerComponent* animManager = PossessedActor->GetRoot()->GetFirstComponent<AnimationManagerComponent>();
+		glm::vec3 rootMotion = (animManager && animManager->IsRootMotionEnabled()) ? (animManager->ConsumeRootMotion()) : (glm::vec3(0.0f));
+
 		float beforePxSpeed = glm::length(Velocity.GetGlmType());
 		physx::PxExtendedVec3 prevPos = PxController->getPosition();
-		PxController->move(Physics::Util::toPx(Velocity * deltaTime), 0.001f, deltaTime, physx::PxControllerFilters());
+		PxController->move(Physics::Util::toPx(Velocity * deltaTime + rootMotion), 0.001f, deltaTime, physx::PxControllerFilters());
 		if (isOnGround)
 			PxController->move(Physics::Util::toPx(glm::vec3(0.0f, -0.2f, 0.0f)), 0.001f, 0.0f, physx::PxControllerFilters());
-		Velocity = Physics::Util::toGlm(PxController->getPosition() - prevPos) / deltaTime;
+		Velocity = (Physics::Util::toGlm(PxController->getPosition() - prevPos) - rootMotion) / deltaTime;	//Root motion does not add to the momentum
 
 		if (TextComponent* found = dynamic_cast<TextComponent*>(PossessedActor->GetRoot()->GetComponent("CameraText")))
 			found->SetContent("Velocity: " + std::to_string(glm::length(glm::vec3(Velocity.x, 0.0f, Velocity.z))) + " " + std::to_string(Velocity.y) + ((isOnGround) ? (" ON-GROUND") : (" MID-AIR")));
@@ -277,6 +283,7 @@ namespace GEE
 		Controller(scene, parentActor, name),
 		PossessedGunActor(nullptr)
 	{
+		SubscribeToEvent(EventType::MOUSE_PRESSED);
 	}
 
 	void ShootingController::HandleEvent(const Event& ev)
@@ -19,7 +19,6 @@ namespace GEE
 	{
 		FireCooldown = 2.0f;
 		CooldownLeft = 0.0f;
-		FiredBullets = 0;
 	}
 
 	void GunActor::Setup()
@@ -59,6 +58,11 @@ namespace GEE
 			GunBlast = nullptr;
 		if (FireModel && FireModel->IsBeingKilled())
 			SetFireModel(nullptr);
+		if (Projectiles && !Projectiles->IsValid())
+			Projectiles = nullptr;
+
+		if (Projectiles)
+			Projectiles->Update(deltaTime);
 
 		GetRoot()->GetTransform().Update(deltaTime);	//update for recoil animation
 		CooldownLeft -= deltaTime;
@@ -103,10 +107,21 @@ namespace GEE
 		GetRoot()->GetTransform().AddInterpolator<glm::quat>("rotation", 0.0f, 0.25f, glm::quat(glm::vec3(0.0f)), toQuat(glm::vec3(30.0f, 0.0f, 0.0f)), InterpolationType::QUINTIC, true);
 		GetRoot()->GetTransform().AddInterpolator<glm::quat>("rotation", 0.25f, 1.25f, glm::quat(glm::vec3(0.0f)), InterpolationType::QUADRATIC, true);
 
-		Actor& actor = Scene.CreateActorAtRoot<Actor>("Bullet" + std::to_string(FiredBullets));
 		//TODO: Change it so the bullet is fired at the barrel, not at the center
-		std::unique_ptr<ModelComponent> bulletModel = std::make_unique<ModelComponent>(ModelComponent(actor, nullptr, "BulletModel" + std::to_string(FiredBullets++), Transform(GetTransform()->GetWorldTransform().Pos(), glm::vec3(0.0f), glm::vec3(0.2f))));
-		bulletModel->OnStart();
+		if (ProjectilePool* projectiles = GetProjectiles())
+		{
+			const Transform& worldTransform = GetRoot()->GetTransform().GetWorldTransform();
+			projectiles->Fire(worldTransform.Pos(), worldTransform.Rot(), worldTransform.GetFrontVec() * 0.25f);
+		}
+
+		CooldownLeft = FireCooldown;
+	}
+
+	ProjectilePool* GunActor::GetProjectiles()
+	{
+		if (Projectiles)
+			return Projectiles.get();
+
 		Material* rustedIronMaterial = GameHandle->GetRenderEngineHandle()->FindMaterial("RustedIron").get();
 		if (!rustedIronMaterial)
 		{
@@ -117,26 +132,15 @@ namespace GEE
 			rustedIronMaterial->AddTexture(std::make_shared<NamedTexture>(textureFromFile("EngineMaterials/rustediron_normal.png", GL_RGB), "normal1"));
 		}
 
-		{
-			EngineDataLoader::LoadModel("hqSphere/hqSphere.obj", *bulletModel, MeshTreeInstancingType::ROOTTREE);
-			std::vector<ModelComponent*> models;
-			models.push_back(bulletModel.get());
-			bulletModel->GetAllComponents<ModelComponent>(&models);
-			for (auto& it : models)
-				it->OverrideInstancesMaterial(rustedIronMaterial);
-		}
-
-		std::unique_ptr<Physics::CollisionObject> dupa = std::make_unique<Physics::CollisionObject>(false, Physics::CollisionShapeType::COLLISION_SPHERE);
-		Physics::CollisionObject& col = *bulletModel->SetCollisionObject(std::move(dupa));
-		GameHandle->GetPhysicsHandle()->ApplyForce(col, GetRoot()->GetTransform().GetWorldTransform().GetFrontVec() * 0.25f);
-
-		actor.ReplaceRoot(std::move(bulletModel));
+		ProjectileSettings settings;
+		settings.OverrideMaterial = rustedIronMaterial;
+		Projectiles = std::make_unique<ProjectilePool>(Scene, Name + "Bullets", settings);
+		if (!Projectiles->IsValid())
+			Projectiles = nullptr;
 
-		actor.DebugHierarchy();
-
-
-		CooldownLeft = FireCooldown;
+		return Projectiles.get();
 	}
+
 	void GunActor::GetEditorDescription(EditorDescriptionBuilder descBuilder)
 	{
 		Actor::GetEditorDescription(descBuilder);
@@ -1,5 +1,6 @@
 #include <scene/LightComponent.h>
 #include <rendering/Material.h>
+#include <rendering/RenderSnapshot.h>
 #include <scene/UIInputBoxActor.h>
 #include <UI/UICanvasActor.h>
 
@@ -223,22 +224,24 @@ namespace GEE
 		if (offset != -1)
 			lightsUBO->offsetCache = offset;
 
-		const Transform& worldTransform = ComponentTransform.GetWorldTransform();
+		const RenderSnapshot& snapshot = GameHandle->GetRenderEngineHandle()->GetRenderSnapshot();	//the light is placed between the two most recent simulation states, just like the meshes it lights
 		bool transformDirtyFlag = ComponentTransform.GetDirtyFlag(TransformDirtyFlagIndex);
 
 		if (transformDirtyFlag)
 		{
+			glm::vec3 lightPos = snapshot.GetWorldPosition(ComponentTransform);
+			glm::vec3 lightFront = snapshot.GetWorldRotation(ComponentTransform) * glm::vec3(0.0f, 0.0f, -1.0f);
 			switch (Type)
 			{
 			case LightType::DIRECTIONAL:
 				lightsUBO->offsetCache += sizeof(glm::vec4);
-				lightsUBO->SubData4fv(worldTransform.GetFrontVec(), lightsUBO->offsetCache); break;
+				lightsUBO->SubData4fv(lightFront, lightsUBO->offsetCache); break;
 			case LightType::POINT:
-				lightsUBO->SubData4fv(worldTransform.Pos(), lightsUBO->offsetCache);
+				lightsUBO->SubData4fv(lightPos, lightsUBO->offsetCache);
 				lightsUBO->offsetCache += sizeof(glm::vec4); break;
 			case LightType::SPOT:
-				lightsUBO->SubData4fv(worldTransform.Pos(), lightsUBO->offsetCache);
-				lightsUBO->SubData4fv(worldTransform.GetFrontVec(), lightsUBO->offsetCache); break;
+				lightsUBO->SubData4fv(lightPos, lightsUBO->offsetCache);
+				lightsUBO->SubData4fv(lightFront, lightsUBO->offsetCache); break;
 			}
 		}
 		else
@@ -246,7 +249,8 @@ namespace GEE
 
 		if (DirtyFlag)
 		{
-			lightsUBO->SubData4fv(std::vector <glm::vec4> {Vec4f(Ambient, ShadowBias), Vec4f(Diffuse, 0.0f), Vec4f(Specular, 0.0f)}, lightsUBO->offsetCache);
+			glm::vec4 colors[3] = { Vec4f(Ambient, ShadowBias), Vec4f(Diffuse, 0.0f), Vec4f(Specular, 0.0f) };
+			lightsUBO->SubData(sizeof(colors), glm::value_ptr(colors[0]), lightsUBO->offsetCache);
 			float additionalData[3] = { Attenuation, CutOff, OuterCutOff };
 			lightsUBO->SubData(12, additionalData, lightsUBO->offsetCache);
 			lightsUBO->SubData1f(Type, lightsUBO->offsetCache);
@@ -259,7 +263,7 @@ namespace GEE
 			lightsUBO->offsetCache += 72;
 
 		if (transformDirtyFlag)
-			lightsUBO->SubDataMatrix4fv(Projection * worldTransform.GetViewMatrix(), lightsUBO->offsetCache + 8);
+			lightsUBO->SubDataMatrix4fv(Projection * snapshot.GetViewMatrix(ComponentTransform, true), lightsUBO->offsetCache + 8);
 		else
 			lightsUBO->offsetCache += sizeof(glm::mat4);
 
@@ -329,10 +333,10 @@ namespace GEE
 
 	Transform LightVolume::GetRenderTransform() const
 	{
-		Transform lightTransform = LightCompPtr->GetTransform().GetWorldTransform();
-		lightTransform.SetScale(LightCompPtr->GetTransform().Scale());
+		const Transform& transform = LightCompPtr->GetTransform();
+		const RenderSnapshot& snapshot = LightCompPtr->GameHandle->GetRenderEngineHandle()->GetRenderSnapshot();
 
-		return lightTransform;
+		return Transform(snapshot.GetWorldPosition(transform), snapshot.GetWorldRotation(transform), transform.Scale());
 	}
 
 	Shader* LightVolume::GetRenderShader(const RenderToolboxCollection& renderCol) const
@@ -25,6 +25,7 @@ namespace GEE
 		SkelInfo(info),
 		RenderAsBillboard(false)
 	{
+		RegisterForUpdate(UpdateStage::MATERIALS);
 	}
 
 	ModelComponent::ModelComponent(ModelComponent&& model) :
@@ -157,11 +158,11 @@ namespace GEE
 		if (GetHide())
 			return;
 
-		std::shared_ptr<AtlasMaterial> found = std::dynamic_pointer_cast<AtlasMaterial>(GameHandle->GetRenderEngineHandle()->FindMaterial("Kopec"));
 		if (Name == "KOPEC")
 		{
-			OverrideInstancesMaterialInstances(std::make_shared<MaterialInstance>(*found, found->GetTextureIDInterpolatorTemplate(Interpolation(0.0f, 0.2f, InterpolationType::LINEAR, true, AnimBehaviour::STOP, AnimBehaviour::REPEAT), 0.0f, 1.0f)));
-			Name = "Kopec";
+			if (std::shared_ptr<AtlasMaterial> found = std::dynamic_pointer_cast<AtlasMaterial>(GameHandle->GetRenderEngineHandle()->FindMaterial("Kopec")))
+				OverrideInstancesMaterialInstances(std::make_shared<MaterialInstance>(*found, found->GetTextureIDInterpolatorTemplate(Interpolation(0.0f, 0.2f, InterpolationType::LINEAR, true, AnimBehaviour::STOP, AnimBehaviour::REPEAT), 0.0f, 1.0f)));
+			SetName("Kopec");
 		}
 
 		if (SkelInfo && SkelInfo->GetBoneCount() > 0)
@@ -183,6 +184,8 @@ namespace GEE
 
 		descBuilder.AddField("Render as billboard").GetTemplates().TickBox(RenderAsBillboard);
 		descBuilder.AddField("Hide").GetTemplates().TickBox(Hide);
+		if (SkelInfo)
+			descBuilder.AddField("CPU skinning").GetTemplates().TickBox([this](bool cpu) { for (auto& meshInst : MeshInstances) meshInst->SetSkinningBackend((cpu) ? (SkinningBackend::CPU) : (SkinningBackend::GPU)); }, [this]() { return !MeshInstances.empty() && MeshInstances.front()->GetSkinningBackend() == SkinningBackend::CPU; });
 
 		UICanvasFieldCategory& cat = descBuilder.GetCanvas().AddCategory("Mesh instances");
 		cat.GetExpandButton()->CreateComponent<TextConstantSizeComponent>("NrMeshInstancesText", Transform(), std::to_string(MeshInstances.size()), "", std::pair<TextAlignment, TextAlignment>(TextAlignment::CENTER, TextAlignment::CENTER));
@@ -0,0 +1,171 @@
+#include <scene/ProjectilePool.h>
+#include <scene/ModelComponent.h>
+#include <scene/Actor.h>
+#include <assetload/FileLoader.h>
+#include <physics/CollisionObject.h>
+#include <game/GameScene.h>
+#include <algorithm>
+
+namespace GEE
+{
+	class ProjectilePool::HolderActor : public Actor
+	{
+	public:
+		HolderActor(GameScene& scene, Actor* parentActor, const std::string& name, ProjectilePool& pool) :
+			Actor(scene, parentActor, name),
+			Pool(&pool)
+		{
+		}
+
+		virtual ~HolderActor() override
+		{
+			if (Pool)
+			{
+				Pool->PoolActor = nullptr;
+				Pool->Projectiles.clear();	//They were children of this actor
+				Pool->ActiveCount = 0;
+			}
+		}
+
+		ProjectilePool* Pool;	//nullptr once the pool has been destroyed
+	};
+
+	ProjectilePool::ProjectilePool(GameScene& scene, const std::string& name, const ProjectileSettings& settings) :
+		Scene(scene),
+		Name(name),
+		Settings(settings),
+		PoolActor(nullptr),
+		ActiveCount(0)
+	{
+		Settings.Capacity = std::max(Settings.Capacity, 1u);
+		CreateProjectiles();
+	}
+
+	ProjectilePool::~ProjectilePool()
+	{
+		if (!PoolActor)	//Already deleted (e.g. in the editor)
+			return;
+
+		PoolActor->Pool = nullptr;
+		if (Scene.GetRootActor())	//While the scene is being destroyed its root is already gone and the actor is destroyed with it
+			PoolActor->MarkAsKilled();
+	}
+
+	void ProjectilePool::Fire(const Vec3f& position, const Quatf& rotation, const Vec3f& impulse)
+	{
+		if (!IsValid())
+			return;
+
+		//Fire a projectile that is not in flight or, if there is none, the one closest to expiring
+		Projectile* fired = &Projectiles.front();
+		for (Projectile& it : Projectiles)
+			if (it.LifeLeft < fired->LifeLeft)
+			{
+				fired = &it;
+				if (fired->LifeLeft <= 0.0f)
+					break;
+			}
+
+		Activate(*fired, position, rotation, impulse);
+	}
+
+	void ProjectilePool::Update(float deltaTime)
+	{
+		if (!IsValid() || ActiveCount == 0)
+			return;
+
+		for (Projectile& it : Projectiles)
+			if (it.LifeLeft > 0.0f && (it.LifeLeft -= deltaTime) <= 0.0f)
+				Deactivate(it);
+	}
+
+	bool ProjectilePool::IsValid() const
+	{
+		return PoolActor && !PoolActor->IsBeingKilled();
+	}
+
+	unsigned int ProjectilePool::GetActiveCount() const
+	{
+		return ActiveCount;
+	}
+
+	unsigned int ProjectilePool::GetCapacity() const
+	{
+		return static_cast<unsigned int>(Projectiles.size());
+	}
+
+	void ProjectilePool::CreateProjectiles()
+	{
+		HierarchyTemplate::HierarchyTreeT* tree = EngineDataLoader::LoadHierarchyTree(Scene, Settings.ModelPath);
+		if (!tree)
+		{
+			std::cout << "ERROR! Can't load projectile model " << Settings.ModelPath << ". Projectile pool " << Name << " will be empty.\n";
+			return;
+		}
+
+		Physics::PhysicsEngineManager* physicsHandle = Scene.GetGameHandle()->GetPhysicsHandle();
+		PoolActor = &Scene.CreateActorAtRoot<HolderActor>(Name, *this);
+		PoolActor->SetSerializable(false);
+		Projectiles.reserve(Settings.Capacity);
+
+		for (unsigned int i = 0; i < Settings.Capacity; i++)
+		{
+			Actor& actor = PoolActor->CreateChild<Actor>(Name + "_" + std::to_string(i));
+			std::unique_ptr<ModelComponent> model = std::make_unique<ModelComponent>(actor, nullptr, Name + "Model_" + std::to_string(i), Transform(glm::vec3(0.0f), glm::quat(glm::vec3(0.0f)), glm::vec3(Settings.Scale)));
+			model->OnStart();
+			EngineDataLoader::InstantiateTree(*model, *tree, Settings.OverrideMaterial);
+
+			Projectile projectile;
+			projectile.ProjectileActor = &actor;
+			projectile.Models.push_back(model.get());
+			model->GetAllComponents<ModelComponent>(&projectile.Models);
+			projectile.Body = model->SetCollisionObject(std::make_unique<Physics::CollisionObject>(false, Physics::CollisionShapeType::COLLISION_SPHERE));
+			projectile.LifeLeft = 0.0f;
+
+			actor.ReplaceRoot(std::move(model));
+
+			if (projectile.Body && Settings.bContinuousCollision)
+				physicsHandle->SetContinuousCollision(*projectile.Body, true);
+
+			Projectiles.push_back(projectile);
+			ActiveCount++;	//Deactivate expects the projectile to be in flight
+			Deactivate(Projectiles.back());
+		}
+
+		std::cout << "INFO: Created projectile pool " << Name << " with " << Projectiles.size() << " projectiles.\n";
+	}
+
+	void ProjectilePool::Activate(Projectile& projectile, const Vec3f& position, const Quatf& rotation, const Vec3f& impulse)
+	{
+		if (projectile.LifeLeft <= 0.0f)
+			ActiveCount++;
+		projectile.LifeLeft = Settings.Lifetime;
+
+		Transform& transform = projectile.ProjectileActor->GetRoot()->GetTransform();
+		transform.SetPosition(position);
+		transform.SetRotation(rotation);	//The new pose is sent to PhysX with the transforms of the other moved objects
+
+		for (ModelComponent* model : projectile.Models)
+			model->SetHide(false);
+
+		if (!projectile.Body)
+			return;
+
+		Physics::PhysicsEngineManager* physicsHandle = Scene.GetGameHandle()->GetPhysicsHandle();
+		physicsHandle->SetSimulationEnabled(*projectile.Body, true);
+		physicsHandle->SetVelocity(*projectile.Body, Vec3f(0.0f));	//A reused projectile must not keep the velocity it had
+		physicsHandle->ApplyForce(*projectile.Body, impulse);
+	}
+
+	void ProjectilePool::Deactivate(Projectile& projectile)
+	{
+		ActiveCount--;
+		projectile.LifeLeft = 0.0f;
+
+		for (ModelComponent* model : projectile.Models)
+			model->SetHide(true);
+
+		if (projectile.Body)
+			Scene.GetGameHandle()->GetPhysicsHandle()->SetSimulationEnabled(*projectile.Body, false);
+	}
+}
@@ -3,7 +3,7 @@
 #include <iostream>
 #include <glm/gtc/type_ptr.hpp>
 #include <math/Transform.h>
-#include <audio/AudioFile.h>
+#include <audio/SoundStream.h>
 
 #include <UI/UICanvasActor.h>
 #include <UI/UICanvasField.h>
@@ -15,9 +15,9 @@ namespace GEE
 	namespace Audio
 	{
 		SoundSourceComponent::SoundSourceComponent(Actor& actor, Component* parentComp, const std::string& name, SoundBuffer sndBuffer, const Transform& transform) :
-			Component(actor, parentComp, name, transform), ALIndex(0), SndBuffer(sndBuffer)
+			Component(actor, parentComp, name, transform)
 		{
-			GenerateAL();
+			SourceVoice.TransformPtr = &ComponentTransform;
 			LoadSound(sndBuffer);
 		}
 
@@ -29,66 +29,77 @@ namespace GEE
 
 		void SoundSourceComponent::LoadSound(const SoundBuffer& buffer)
 		{
-			SndBuffer = buffer;
+			DetachStream();
+			GetVoiceManager().Stop(SourceVoice);
+			GameHandle->GetAudioEngineHandle()->ReleaseBuffer(SourceVoice.Buffer);
+			SourceVoice.Buffer = buffer;
+		}
 
-			if (!SndBuffer.IsValid())
-				return;
+		void SoundSourceComponent::LoadStream(std::unique_ptr<SoundStream> stream)
+		{
+			LoadSound(SoundBuffer());
 
-			alSourcei(ALIndex, AL_BUFFER, SndBuffer.ALIndex);
+			Stream = std::move(stream);
+			SourceVoice.Stream = Stream.get();
+			if (Stream)
+				Stream->SetLoop(SourceVoice.bLoop);
+		}
+
+		std::string SoundSourceComponent::GetSoundPath() const
+		{
+			return (Stream) ? (Stream->GetPath()) : (SourceVoice.Buffer.Path);
 		}
 
 		void SoundSourceComponent::SetLoop(bool loop)
 		{
-			if (ALIndex != 0)
-				alSourcei(ALIndex, AL_LOOPING, (loop) ? (AL_TRUE) : (AL_FALSE));
+			GetVoiceManager().SetLoop(SourceVoice, loop);
 		}
 
-		bool SoundSourceComponent::IsPlaying()
+		void SoundSourceComponent::SetGain(float gain)
 		{
-			if (ALIndex == 0)
-				return false;
+			SourceVoice.Gain = gain;
+		}
 
-			ALint state;
-			alGetSourcei(ALIndex, AL_SOURCE_STATE, &state);
-			if (state == AL_PLAYING)
-				return true;
+		void SoundSourceComponent::SetPriority(float priority)
+		{
+			SourceVoice.Priority = priority;
+		}
 
-			return false;
+		void SoundSourceComponent::SetDistances(float referenceDistance, float maxDistance)
+		{
+			SourceVoice.ReferenceDistance = referenceDistance;
+			SourceVoice.MaxDistance = maxDistance;
+		}
+
+		bool SoundSourceComponent::IsPlaying()
+		{
+			return SourceVoice.GetState() == VoiceState::PLAYING;
+		}
+
+		const Voice& SoundSourceComponent::GetVoice() const
+		{
+			return SourceVoice;
 		}
 
 		void SoundSourceComponent::Play()
 		{
-			if (!SndBuffer.IsValid())
+			if (!Stream && !SourceVoice.Buffer.IsValid())
 			{
 				std::cerr << "ERROR! No valid AL buffer is assigned to a sound source; Can't play the sound.\n";
 				return;
 			}
 
-			if (IsPlaying())
-				return;
-
-			std::cout << "Gram dzwiek " << Name << '\n';
-			GameHandle->GetAudioEngineHandle()->CheckError();
-
-			alSourcePlay(ALIndex);
+			GetVoiceManager().Play(SourceVoice);
 		}
 
 		void SoundSourceComponent::Pause()
 		{
-			if (ALIndex != 0)
-				alSourcePause(ALIndex);
+			GetVoiceManager().Pause(SourceVoice);
 		}
 
 		void SoundSourceComponent::Stop()
 		{
-			if (ALIndex != 0)
-				alSourceStop(ALIndex);
-		}
-
-		void SoundSourceComponent::Update(float deltaTime)
-		{
-			if (ALIndex != 0)
-				alSourcefv(ALIndex, AL_POSITION, glm::value_ptr((glm::vec3)ComponentTransform.GetWorldTransform().Pos()));
+			GetVoiceManager().Stop(SourceVoice);
 		}
 
 		MaterialInstance SoundSourceComponent::GetDebugMatInst(EditorIconState state)
@@ -101,17 +112,13 @@ namespace GEE
 		{
 			Component::GetEditorDescription(descBuilder);
 
-			descBuilder.AddField("Path").GetTemplates().PathInput([this](const std::string& path) {GameHandle->GetAudioEngineHandle()->CheckError(); Audio::Loader::LoadSoundFromFile(path, *this); GameHandle->GetAudioEngineHandle()->CheckError(); }, [this]()->std::string { return SndBuffer.Path;; }, { "*.wav" });
+			descBuilder.AddField("Path").GetTemplates().PathInput([this](const std::string& path) {GameHandle->GetAudioEngineHandle()->CheckError(); Audio::Loader::LoadSoundFromFile(path, *this); GameHandle->GetAudioEngineHandle()->CheckError(); }, [this]()->std::string { return GetSoundPath(); }, { "*.wav", "*.ogg" });
 			descBuilder.AddField("Play").CreateChild<UIButtonActor>("PlayButton", "Play", [this]() { Play(); });
 		}
 
 		void SoundSourceComponent::Dispose()
 		{
-			if (IsPlaying())
-				alSourceStop(ALIndex);
-
-			if (ALIndex != 0)
-				alDeleteSources(1, &ALIndex);
+			LoadSound(SoundBuffer());	//Stops the voice and releases the buffer
 		}
 
 		SoundSourceComponent::~SoundSourceComponent()
@@ -119,23 +126,29 @@ namespace GEE
 			Dispose();
 		}
 
-		void SoundSourceComponent::GenerateAL()
+		void SoundSourceComponent::DetachStream()
 		{
-			if (ALIndex != 0)
-				alDeleteSources(1, &ALIndex);
+			if (!Stream)
+				return;
 
-			alGenSources(1, &ALIndex);
-			alSourcefv(ALIndex, AL_POSITION, glm::value_ptr(glm::vec3(0.0f)));
-			alSourcefv(ALIndex, AL_VELOCITY, glm::value_ptr(glm::vec3(0.0f)));
-			alSourcei(ALIndex, AL_BUFFER, SndBuffer.ALIndex);
+			GetVoiceManager().Stop(SourceVoice);	//Takes the buffers of the stream back from the source
+			SourceVoice.Stream = nullptr;
+			Stream = nullptr;
+		}
+
+		VoiceManager& SoundSourceComponent::GetVoiceManager()
+		{
+			return GameHandle->GetAudioEngineHandle()->GetVoiceManager();
 		}
 
 		namespace Loader
 		{
 			void LoadSoundFromFile(const std::string& path, SoundSourceComponent& soundComp)
 			{
-				////////////////// Check our current buffers; if one was loaded from the same path as passed to this function just return its address and don't waste time
-				SoundBuffer buffer = soundComp.GetScene().GetGameHandle()->GetAudioEngineHandle()->FindBuffer(path);
+				AudioEngineManager& audioHandle = *soundComp.GetScene().GetGameHandle()->GetAudioEngineHandle();
+
+				////////////////// Check our current buffers (and the decoded audio cache files); if one was loaded from the same path as passed to this function just use it and don't waste time
+				SoundBuffer buffer = audioHandle.FindBuffer(path);
 				if (buffer.IsValid())
 				{
 					soundComp.LoadSound(buffer);
@@ -143,85 +156,24 @@ namespace GEE
 				}
 
 
-				////////////////// If we have to load, call the appropriate method based on path's file format
-				std::string format = path.substr(path.find('.') + 1);
+				////////////////// If we have to load, open the file with the decoder matching its format. Long sounds are streamed; they are never shared between sources
+				std::unique_ptr<AudioDecoder> decoder = AudioDecoder::Open(path);
+				if (!decoder)
+					return;
 
-				if (format == "wav")
-					buffer = Impl::LoadBufferFromWav(path);
-				else if (format == "ogg")
-					buffer = Impl::LoadBufferFromOgg(path);
-				else
+				if (decoder->GetLengthInSeconds() >= StreamingMinLength)
 				{
-					std::cerr << "ERROR! Unrecognized audio format " << format << " of file " << path << '\n';
+					std::cout << "INFO: Streaming " << path << " (" << decoder->GetLengthInSeconds() << "s).\n";
+					soundComp.LoadStream(std::make_unique<SoundStream>(*soundComp.GetScene().GetGameHandle()->GetJobSystem(), std::move(decoder)));
 					return;
 				}
 
+				buffer = audioHandle.AddBuffer(*decoder);
 				if (!buffer.IsValid())
 					return;
 
-				soundComp.GetScene().GetGameHandle()->GetAudioEngineHandle()->AddBuffer(buffer);
-
 				soundComp.LoadSound(buffer);
 			}
-
-			namespace Impl
-			{
-				SoundBuffer LoadBufferFromWav(const std::string& path)
-				{
-					///////////////// Load the file
-					AudioFile<float> file;
-
-					if (!file.load(path))
-					{
-						std::cerr << "ERROR! Can't load WAV file " << path << "!\n";
-						return SoundBuffer();
-					}
-
-					///////////////// Assign a specific OpenAL format (and give a warning if the loaded type is stereo)
-					bool stereo = file.isStereo();
-					ALenum format = AL_FORMAT_MONO8;
-
-					if (stereo)
-						std::cerr << "INFO: Audio file " << path << " is stereo - it won't work with a 3D sound source.\n";
-
-					if (file.getBitDepth() == 8)
-						format = (stereo) ? (AL_FORMAT_STEREO8) : (AL_FORMAT_MONO8);
-					else if (file.getBitDepth() == 16)
-						format = (stereo) ? (AL_FORMAT_STEREO16) : (AL_FORMAT_MONO16);
-					else
-					{
-						std::cerr << "ERROR! Unsupported bit depth of " << path << ". The bit depth count is: " << file.getBitDepth() << ".\n";
-						return SoundBuffer();
-					}
-
-					//////////////// Create an OpenAL buffer using our loaded data.
-					std::vector <char> charSamples;
-					charSamples.reserve(file.samples[0].size());
-
-					std::transform(file.samples[0].begin(), file.samples[0].end(), std::back_inserter(charSamples), [path](const float& sample) { return static_cast<char>(sample * 128.0f); });
-
-					std::cout << path << ": " << charSamples.size() << ",  samplerate: " << file.getSampleRate() / 2 << ",  bitdepth: " << file.getBitDepth() << ",  length[s]: " << file.getLengthInSeconds() << '\n';
-					return LoadALBuffer(format, &charSamples[0], (ALsizei)charSamples.size(), (ALsizei)file.getSampleRate() / 2, path);
-				}
-
-				SoundBuffer LoadBufferFromOgg(const std::string& path)
-				{
-					std::cerr << "Ogg Vorbis format is not currently supported.\n";
-					return SoundBuffer();
-				}
-
-				SoundBuffer LoadALBuffer(ALenum format, ALvoid* data, ALsizei size, ALsizei freq, const std::string& path)
-				{
-					SoundBuffer buffer;
-
-					alGenBuffers(1, &buffer.ALIndex);
-					alBufferData(buffer.ALIndex, format, data, size - size % 4, freq);
-
-					buffer.Path = path;
-
-					return buffer;
-				}
-			}
 		}
 	}
 }
\ No newline at end of file
@@ -21,6 +21,10 @@ namespace GEE
 		State(EditorIconState::IDLE),
 		bInputDisabled(false)
 	{
+		//Every event updates the state of a button that is being held (WhileBeingClicked, e.g. dragging a window or a scroll bar while a key is pressed) and its material, so subscribe to all of them
+		for (unsigned int type = 0; type < EventTypeCount; type++)
+			SubscribeToEvent(static_cast<EventType>(type));
+
 		ButtonModel = &CreateComponent<ModelComponent>(Name + "'s_Button_Model");
 
 		std::shared_ptr<Material> matIdle, matHover, matClick, matDisabled;
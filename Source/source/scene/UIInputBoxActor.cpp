@@ -11,6 +11,7 @@ namespace GEE
 		ContentTextComp(nullptr),
 		RetrieveContentEachFrame(false)
 	{
+		SubscribeToEvent(EventType::CHARACTER_ENTERED);
 		ContentTextComp = &CreateComponent<TextConstantSizeComponent>(Name + "Text", Transform(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f), glm::vec3(1.0f)), "1.0", "");
 		ContentTextComp->SetAlignment(TextAlignment::CENTER, TextAlignment::CENTER);
 	}
@@ -29,6 +29,9 @@ namespace GEE
 			Root = tree.Root->Copy(*TempActor, true);
 		else
 			Root = static_unique_pointer_cast<HierarchyNodeBase>(std::make_unique<HierarchyNode<Component>>(*TempActor, Name));	//root has the same name as the tree
+
+		for (auto& it : tree.TreeAnimations)	//the clips are shared, only the localization is tree-specific
+			AddAnimation(Animation(*this, it->Clip));
 	}
 
 	HierarchyTreeT::HierarchyTreeT(HierarchyTreeT&& tree) :
@@ -42,6 +45,9 @@ namespace GEE
 			Root = static_unique_pointer_cast<HierarchyNodeBase>(std::make_unique<HierarchyNode<Component>>(*TempActor, Name));	//root has the same name as the tree
 		if (!TempActor)
 			TempActor = std::make_unique<Actor>(Scene, nullptr, Name + "TempActor");
+
+		for (auto& it : tree.TreeAnimations)
+			AddAnimation(Animation(*this, it->Clip));
 	}
 
 	const std::string& HierarchyTreeT::GetName() const
@@ -0,0 +1,332 @@
+#include <utility/JobSystem.h>
+#include <utility/Profiler.h>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+namespace GEE
+{
+	namespace
+	{
+		thread_local const JobSystem* tJobSystem = nullptr;	//The job system that owns the current worker thread
+		thread_local unsigned int tWorkerIndex = 0;
+	}
+
+	JobCounter::JobCounter() :
+		Value(0)
+	{
+	}
+
+	JobCounter::~JobCounter()
+	{
+		std::lock_guard<std::mutex> lock(ContinuationsMutex);	//A finishing job might still hold the lock after it has decremented the counter to 0
+	}
+
+	bool JobCounter::IsDone() const
+	{
+		return Value.load() == 0;
+	}
+
+	int JobCounter::GetValue() const
+	{
+		return Value.load();
+	}
+
+	JobSystem::JobSystem() :
+		QueuedJobCount(0),
+		bQuit(false),
+		bInitialized(false)
+	{
+	}
+
+	void JobSystem::Init(unsigned int workerCount)
+	{
+		if (bInitialized)
+			return;
+
+		if (workerCount == 0)
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		MainThreadID = std::this_thread::get_id();
+		bQuit = false;
+
+		for (unsigned int i = 0; i < workerCount + 1; i++)
+			Queues.push_back(std::make_unique<WorkerQueue>());
+
+		bInitialized = true;
+		for (unsigned int i = 1; i < workerCount + 1; i++)
+			Workers.push_back(std::thread(&JobSystem::WorkerLoop, this, i));
+
+		std::cout << "INFO: Job system started with " << workerCount << " worker threads.\n";
+	}
+
+	bool JobSystem::HasBeenInitialized() const
+	{
+		return bInitialized;
+	}
+
+	unsigned int JobSystem::GetWorkerCount() const
+	{
+		return (bInitialized) ? (static_cast<unsigned int>(Queues.size())) : (1);
+	}
+
+	bool JobSystem::IsMainThread() const
+	{
+		return !bInitialized || std::this_thread::get_id() == MainThreadID;
+	}
+
+	void JobSystem::Schedule(std::function<void()> job, JobCounter* signal, JobCounter* dependency, JobAffinity affinity)
+	{
+		if (signal)
+			signal->Value++;
+
+		if (!bInitialized)	//Jobs are executed in place, so the dependency has already been executed
+		{
+			Job immediateJob{ std::move(job), signal };
+			Execute(immediateJob);
+			return;
+		}
+
+		if (dependency)
+		{
+			std::lock_guard<std::mutex> lock(dependency->ContinuationsMutex);
+			if (dependency->Value.load() > 0)
+			{
+				dependency->Continuations.push_back(JobCounter::PendingJob{ std::move(job), signal, affinity });
+				return;
+			}
+		}
+
+		Enqueue(Job{ std::move(job), signal }, affinity);
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		const unsigned int workerIndex = GetCurrentWorkerIndex();
+		const bool isMainThread = IsMainThread();
+		while (!counter.IsDone())
+			if (!TryRunJob(workerIndex, isMainThread))
+				std::this_thread::yield();
+	}
+
+	void JobSystem::RunMainThreadJobs()
+	{
+		if (!IsMainThread())
+		{
+			std::cout << "ERROR! Main thread jobs can only be run by the main thread.\n";
+			return;
+		}
+
+		Job job;
+		while (PopMainThreadJob(job))
+			Execute(job);
+	}
+
+	void JobSystem::ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)>& function)
+	{
+		if (count == 0)
+			return;
+
+		if (batchSize == 0)
+			batchSize = (count + GetWorkerCount() - 1) / GetWorkerCount();
+
+		JobCounter counter;
+		for (size_t begin = 0; begin < count; begin += batchSize)
+		{
+			size_t end = std::min(begin + batchSize, count);
+			Schedule([&function, begin, end]() { function(begin, end); }, &counter);
+		}
+
+		Wait(counter);
+	}
+
+	double JobSystem::BenchmarkSchedulingOverhead(unsigned int jobCount, unsigned int workerCount)
+	{
+		JobSystem jobSystem;
+		jobSystem.Init(workerCount);
+
+		JobCounter counter;
+		auto begin = std::chrono::high_resolution_clock::now();
+		for (unsigned int i = 0; i < jobCount; i++)
+			jobSystem.Schedule([]() {}, &counter);
+		jobSystem.Wait(counter);
+		auto end = std::chrono::high_resolution_clock::now();
+
+		jobSystem.Dispose();
+
+		return std::chrono::duration<double, std::micro>(end - begin).count() / static_cast<double>(std::max(jobCount, 1u));
+	}
+
+	void JobSystem::Dispose()
+	{
+		if (!bInitialized)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(SleepMutex);
+			bQuit = true;
+		}
+		SleepCondition.notify_all();
+
+		for (auto& it : Workers)
+			it.join();	//Workers finish all the remaining jobs before quitting
+
+		RunMainThreadJobs();
+		Job job;
+		while (PopOwn(0, job))
+			Execute(job);
+
+		Workers.clear();
+		Queues.clear();
+		bInitialized = false;
+	}
+
+	JobSystem::~JobSystem()
+	{
+		Dispose();
+	}
+
+	void JobSystem::Enqueue(Job&& job, JobAffinity affinity)
+	{
+		if (affinity == JobAffinity::MainThread)
+		{
+			std::lock_guard<std::mutex> lock(MainThreadQueue.Mutex);
+			MainThreadQueue.Jobs.push_back(std::move(job));
+			return;
+		}
+
+		static std::atomic<unsigned int> roundRobin(0);
+		unsigned int workerIndex = GetCurrentWorkerIndex();
+		if (workerIndex >= Queues.size())	//Thread that does not belong to the job system
+			workerIndex = roundRobin++ % Queues.size();
+
+		{
+			std::lock_guard<std::mutex> lock(Queues[workerIndex]->Mutex);
+			Queues[workerIndex]->Jobs.push_back(std::move(job));
+		}
+
+		QueuedJobCount++;
+		{
+			std::lock_guard<std::mutex> lock(SleepMutex);	//Make sure that a worker which is about to sleep does not miss the notification
+		}
+		SleepCondition.notify_one();
+	}
+
+	bool JobSystem::TryRunJob(unsigned int workerIndex, bool allowMainThreadJobs)
+	{
+		Job job;
+		if ((allowMainThreadJobs && PopMainThreadJob(job)) || PopOwn(workerIndex, job) || Steal(workerIndex, job))
+		{
+			Execute(job);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool JobSystem::PopOwn(unsigned int workerIndex, Job& job)
+	{
+		if (workerIndex >= Queues.size())
+			return false;
+
+		WorkerQueue& queue = *Queues[workerIndex];
+		std::lock_guard<std::mutex> lock(queue.Mutex);
+		if (queue.Jobs.empty())
+			return false;
+
+		job = std::move(queue.Jobs.back());	//LIFO for the owner - the most recent job is the most likely to have its data in cache
+		queue.Jobs.pop_back();
+		QueuedJobCount--;
+		return true;
+	}
+
+	bool JobSystem::Steal(unsigned int thiefIndex, Job& job)
+	{
+		const unsigned int queueCount = static_cast<unsigned int>(Queues.size());
+		for (unsigned int i = 1; i <= queueCount; i++)
+		{
+			WorkerQueue& queue = *Queues[(thiefIndex + i) % queueCount];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (queue.Jobs.empty())
+				continue;
+
+			job = std::move(queue.Jobs.front());	//FIFO for thieves - the oldest jobs tend to be the biggest ones
+			queue.Jobs.pop_front();
+			QueuedJobCount--;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool JobSystem::PopMainThreadJob(Job& job)
+	{
+		std::lock_guard<std::mutex> lock(MainThreadQueue.Mutex);
+		if (MainThreadQueue.Jobs.empty())
+			return false;
+
+		job = std::move(MainThreadQueue.Jobs.front());
+		MainThreadQueue.Jobs.pop_front();
+		return true;
+	}
+
+	void JobSystem::Execute(Job& job)
+	{
+		{
+			GEE_PROFILE_SCOPE("Job");
+			job.Function();
+		}
+		if (job.Signal)
+			Finish(*job.Signal);
+	}
+
+	void JobSystem::Finish(JobCounter& counter)
+	{
+		std::vector<JobCounter::PendingJob> continuations;
+		{
+			std::lock_guard<std::mutex> lock(counter.ContinuationsMutex);
+			if (--counter.Value > 0)
+				return;
+
+			continuations.swap(counter.Continuations);
+		}
+
+		for (auto& it : continuations)
+		{
+			Job job{ std::move(it.Function), it.Signal };
+			if (bInitialized)
+				Enqueue(std::move(job), it.Affinity);
+			else
+				Execute(job);
+		}
+	}
+
+	void JobSystem::WorkerLoop(unsigned int workerIndex)
+	{
+		tJobSystem = this;
+		tWorkerIndex = workerIndex;
+
+		while (true)
+		{
+			if (TryRunJob(workerIndex, false))
+				continue;
+
+			std::unique_lock<std::mutex> lock(SleepMutex);
+			if (bQuit && QueuedJobCount.load() <= 0)
+				break;
+			SleepCondition.wait(lock, [this]() { return bQuit.load() || QueuedJobCount.load() > 0; });
+		}
+
+		tJobSystem = nullptr;
+	}
+
+	unsigned int JobSystem::GetCurrentWorkerIndex() const
+	{
+		if (bInitialized && std::this_thread::get_id() == MainThreadID)
+			return 0;
+		if (tJobSystem == this)
+			return tWorkerIndex;
+
+		return static_cast<unsigned int>(Queues.size());
+	}
+}
@@ -0,0 +1,221 @@
+#include <utility/MemoryArena.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace GEE
+{
+	namespace
+	{
+		std::atomic<unsigned long long> HeapAllocationCount(0);
+	}
+
+	LinearArena::LinearArena(const char* name, size_t blockSize) :
+		Name(name),
+		BlockSize(blockSize),
+		CurrentBlockOffset(0),
+		UsedBytes(0),
+		PeakBytes(0),
+		AllocationCount(0),
+		BlockAllocationCount(0)
+	{
+	}
+
+	void* LinearArena::Allocate(size_t size, size_t alignment)
+	{
+		if (size == 0)
+			size = 1;
+
+		if (!Blocks.empty())
+		{
+			Block& block = Blocks.back();
+			const uintptr_t begin = reinterpret_cast<uintptr_t>(block.Memory.get());
+			const uintptr_t aligned = (begin + CurrentBlockOffset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+			const size_t newOffset = static_cast<size_t>(aligned - begin) + size;
+			if (newOffset <= block.Size)
+			{
+				UsedBytes += newOffset - CurrentBlockOffset;
+				CurrentBlockOffset = newOffset;
+				AllocationCount++;
+				PeakBytes = std::max(PeakBytes, UsedBytes);
+				return reinterpret_cast<void*>(aligned);
+			}
+		}
+
+		AddBlock(size + alignment);
+		return Allocate(size, alignment);
+	}
+
+	void LinearArena::Reset()
+	{
+		if (Blocks.size() > 1)	//Replace the blocks with one that fits the whole peak
+		{
+			size_t capacity = GetCapacity();
+			Blocks.clear();
+			AddBlock(std::max(capacity, PeakBytes));
+		}
+
+		CurrentBlockOffset = 0;
+		UsedBytes = 0;
+		AllocationCount = 0;
+	}
+
+	const char* LinearArena::GetName() const
+	{
+		return Name;
+	}
+
+	size_t LinearArena::GetUsedBytes() const
+	{
+		return UsedBytes;
+	}
+
+	size_t LinearArena::GetPeakBytes() const
+	{
+		return PeakBytes;
+	}
+
+	size_t LinearArena::GetCapacity() const
+	{
+		size_t capacity = 0;
+		for (auto& block : Blocks)
+			capacity += block.Size;
+		return capacity;
+	}
+
+	unsigned int LinearArena::GetAllocationCount() const
+	{
+		return AllocationCount;
+	}
+
+	unsigned int LinearArena::GetBlockAllocationCount() const
+	{
+		return BlockAllocationCount;
+	}
+
+	void LinearArena::AddBlock(size_t minSize)
+	{
+		if (!Blocks.empty())	//The unused end of the current block counts as used - it cannot be allocated from anymore
+			UsedBytes += Blocks.back().Size - CurrentBlockOffset;
+
+		Block block;
+		block.Size = std::max(BlockSize, minSize);
+		block.Memory = std::make_unique<unsigned char[]>(block.Size);
+		Blocks.push_back(std::move(block));
+		CurrentBlockOffset = 0;
+		BlockAllocationCount++;
+	}
+
+	LinearArena& MemoryArenas::Get(MemoryArenaType type)
+	{
+		static LinearArena arenas[MemoryArenaCount] =
+		{
+			LinearArena("Frame", 256 * 1024),
+			LinearArena("Render", 256 * 1024)
+		};
+		return arenas[static_cast<unsigned int>(type)];
+	}
+
+	void MemoryArenas::NewFrame()
+	{
+		MemoryTracker::Get().NewFrame();
+		for (unsigned int i = 0; i < MemoryArenaCount; i++)
+			Get(static_cast<MemoryArenaType>(i)).Reset();
+	}
+
+	MemoryTracker::MemoryTracker() :
+		LastFrameArenaStats{},
+		FrameNumber(0),
+		HeapAllocationsAtFrameBegin(0),
+		HeapAllocationsLastFrame(0),
+		bSteadyStateCheck(false),
+		SteadyStateBeginFrame(0),
+		WorstSteadyStateAllocations(0)
+	{
+	}
+
+	MemoryTracker& MemoryTracker::Get()
+	{
+		static MemoryTracker tracker;
+		return tracker;
+	}
+
+	void MemoryTracker::NewFrame()
+	{
+		for (unsigned int i = 0; i < MemoryArenaCount; i++)
+		{
+			const LinearArena& arena = MemoryArenas::Get(static_cast<MemoryArenaType>(i));
+			LastFrameArenaStats[i] = ArenaFrameStats{ arena.GetUsedBytes(), arena.GetAllocationCount() };
+		}
+
+		const unsigned long long heapAllocations = HeapAllocationCount.load(std::memory_order_relaxed);
+		HeapAllocationsLastFrame = heapAllocations - HeapAllocationsAtFrameBegin;
+		HeapAllocationsAtFrameBegin = heapAllocations;
+
+		if (bSteadyStateCheck && FrameNumber > SteadyStateBeginFrame && HeapAllocationsLastFrame > WorstSteadyStateAllocations)
+		{
+			WorstSteadyStateAllocations = HeapAllocationsLastFrame;
+			std::cout << "ERROR! " << HeapAllocationsLastFrame << " heap allocations in a steady-state frame (frame " << FrameNumber << ").\n";
+		}
+
+		FrameNumber++;
+	}
+
+	void MemoryTracker::RecordHeapAllocation()
+	{
+		HeapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	unsigned long long MemoryTracker::GetHeapAllocationCount()
+	{
+		return HeapAllocationCount.load(std::memory_order_relaxed);
+	}
+
+	unsigned long long MemoryTracker::GetHeapAllocationsLastFrame() const
+	{
+		return HeapAllocationsLastFrame;
+	}
+
+	void MemoryTracker::SetSteadyStateCheck(bool enabled, unsigned int warmupFrames)
+	{
+		bSteadyStateCheck = enabled;
+		SteadyStateBeginFrame = FrameNumber + warmupFrames;
+		WorstSteadyStateAllocations = 0;
+	}
+
+	std::vector<std::string> MemoryTracker::GetSummary() const
+	{
+		std::vector<std::string> lines;
+		lines.reserve(MemoryArenaCount + 1);
+		lines.push_back("Heap allocations: " + std::to_string(HeapAllocationsLastFrame));
+
+		for (unsigned int i = 0; i < MemoryArenaCount; i++)
+		{
+			const LinearArena& arena = MemoryArenas::Get(static_cast<MemoryArenaType>(i));
+			lines.push_back(std::string("Arena ") + arena.GetName() + ": " + std::to_string(LastFrameArenaStats[i].UsedBytes / 1024) + " KB (" + std::to_string(LastFrameArenaStats[i].AllocationCount) + " allocations), peak " + std::to_string(arena.GetPeakBytes() / 1024) + " KB");
+		}
+
+		return lines;
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	GEE::MemoryTracker::RecordHeapAllocation();
+	if (void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
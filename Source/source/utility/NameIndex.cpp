@@ -0,0 +1,118 @@
+#include <utility/NameIndex.h>
+#include <string_view>
+#include <deque>
+#include <shared_mutex>
+#include <mutex>
+
+namespace GEE
+{
+	namespace
+	{
+		struct InternedNameTable
+		{
+			InternedNameTable()
+			{
+				Strings.push_back(std::string());
+				Hashes.push_back(std::hash<std::string_view>()(std::string_view()));
+				IDs.emplace(std::string_view(Strings.back()), 0);
+			}
+
+			std::deque<std::string> Strings;	//A deque never moves its elements, so the views used as keys stay valid
+			std::deque<size_t> Hashes;
+			std::unordered_map<std::string_view, unsigned int> IDs;
+			mutable std::shared_mutex Mutex;
+		};
+
+		InternedNameTable& GetInternedNameTable()
+		{
+			static InternedNameTable table;
+			return table;
+		}
+	}
+
+	InternedName::InternedName() :
+		InternedName(std::string())
+	{
+	}
+
+	InternedName::InternedName(const std::string& name) :
+		ID(0),
+		Hash(0)
+	{
+		if (TryFind(name, *this))
+			return;
+
+		InternedNameTable& table = GetInternedNameTable();
+		std::unique_lock<std::shared_mutex> lock(table.Mutex);
+
+		auto found = table.IDs.find(std::string_view(name));	//Another thread might have interned the name in the meantime
+		if (found != table.IDs.end())
+		{
+			ID = found->second;
+			Hash = table.Hashes[ID];
+			return;
+		}
+
+		ID = static_cast<unsigned int>(table.Strings.size());
+		table.Strings.push_back(name);
+		Hash = std::hash<std::string_view>()(std::string_view(table.Strings.back()));
+		table.Hashes.push_back(Hash);
+		table.IDs.emplace(std::string_view(table.Strings.back()), ID);
+	}
+
+	InternedName::InternedName(const char* name) :
+		InternedName(std::string(name))
+	{
+	}
+
+	InternedName::InternedName(unsigned int id, size_t hash) :
+		ID(id),
+		Hash(hash)
+	{
+	}
+
+	bool InternedName::TryFind(const std::string& name, InternedName& result)
+	{
+		const InternedNameTable& table = GetInternedNameTable();
+		std::shared_lock<std::shared_mutex> lock(table.Mutex);
+
+		auto found = table.IDs.find(std::string_view(name));
+		if (found == table.IDs.end())
+			return false;
+
+		result = InternedName(found->second, table.Hashes[found->second]);
+		return true;
+	}
+
+	const std::string& InternedName::GetString() const
+	{
+		const InternedNameTable& table = GetInternedNameTable();
+		std::shared_lock<std::shared_mutex> lock(table.Mutex);
+		return table.Strings[ID];
+	}
+
+	unsigned int InternedName::GetID() const
+	{
+		return ID;
+	}
+
+	size_t InternedName::GetHash() const
+	{
+		return Hash;
+	}
+
+	bool InternedName::IsEmpty() const
+	{
+		return ID == 0;
+	}
+
+	bool InternedName::operator==(const InternedName& name) const
+	{
+		return ID == name.ID;
+	}
+
+	bool InternedName::operator!=(const InternedName& name) const
+	{
+		return ID != name.ID;
+	}
+}
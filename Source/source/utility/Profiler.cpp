@@ -0,0 +1,423 @@
+#include <utility/Profiler.h>
+#include <glad/glad.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <algorithm>
+
+namespace GEE
+{
+	namespace
+	{
+		struct CpuScopeSlot
+		{
+			ProfilerScopeRecord Record;
+			std::atomic<unsigned long long> CommittedFrame{ 0 };	//The frame number is stored after the record has been written, so readers never see a half-written record
+		};
+
+		struct GpuScopeSlot
+		{
+			const char* Name;
+			unsigned int Depth;
+			unsigned int QueryIndex;	//The scope uses the queries QueryIndex (begin) and QueryIndex + 1 (end)
+		};
+
+		thread_local unsigned int ThreadCpuDepth = 0;
+
+		const char* GetCounterName(ProfilerCounter counter)
+		{
+			switch (counter)
+			{
+			case ProfilerCounter::DRAW_CALLS: return "Draw calls";
+			case ProfilerCounter::STATE_CHANGES: return "State changes";
+			case ProfilerCounter::UNIFORM_UPLOADS: return "Uniform uploads";
+			case ProfilerCounter::BUFFER_BYTES_UPLOADED: return "Buffer bytes uploaded";
+			}
+			return "";
+		}
+
+		std::string EscapeJson(const char* str)
+		{
+			std::string escaped;
+			for (; str && *str; str++)
+			{
+				if (*str == '"' || *str == '\\')
+					escaped += '\\';
+				escaped += *str;
+			}
+			return escaped;
+		}
+	}
+
+	struct Profiler::FrameSlot
+	{
+		std::atomic<unsigned long long> FrameNumber{ 0 };
+		double BeginUs = 0.0, EndUs = 0.0;
+		std::unique_ptr<CpuScopeSlot[]> CpuScopes{ std::make_unique<CpuScopeSlot[]>(Profiler::MaxCpuScopesPerFrame) };
+		std::atomic<unsigned int> CpuScopeCount{ 0 };
+		std::array<unsigned long long, ProfilerCounterCount> Counters{};
+
+		//Only accessed on the GPU thread
+		std::vector<GpuScopeSlot> GpuScopes;
+		std::vector<GLuint> Queries;	//Reused when the slot is recycled
+		std::vector<ProfilerScopeRecord> ResolvedGpuScopes;
+		double GpuOffsetUs = 0.0;	//Added to GPU timestamps to move them to the CPU timeline
+		bool bGpuResolved = true;
+	};
+
+	Profiler& Profiler::Get()
+	{
+		static Profiler profiler;
+		return profiler;
+	}
+
+	Profiler::Profiler() :
+		Frames(std::make_unique<FrameSlot[]>(FrameRingSize)),
+		CurrentFrame(0),
+		bEnabled(true),
+		bGpuTimingEnabled(false),
+		MainThreadID(0),
+		GpuThreadID(0),
+		GpuDepth(0),
+		StartTimeNs(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count())
+	{
+		for (auto& counter : Counters)
+			counter.store(0);
+	}
+
+	Profiler::~Profiler()
+	{
+		//GL query objects are not deleted here - the context is gone by the time static objects are destroyed. Call SetGpuTimingEnabled(false) before destroying the context instead.
+	}
+
+	void Profiler::NewFrame()
+	{
+		if (!bEnabled)
+			return;
+
+		const double now = GetTimeUs();
+		MainThreadID = GetThreadID();
+		const unsigned long long previous = CurrentFrame.load(std::memory_order_relaxed);
+
+		if (previous > 0)
+		{
+			FrameSlot& previousSlot = Frames[previous % FrameRingSize];
+			previousSlot.EndUs = now;
+			for (unsigned int i = 0; i < ProfilerCounterCount; i++)
+				previousSlot.Counters[i] = Counters[i].exchange(0, std::memory_order_relaxed);
+		}
+
+		if (bGpuTimingEnabled)	//Resolve the queries of older frames before their slots are recycled
+			for (unsigned long long frame = previous; frame > 0 && previous - frame < FrameRingSize - 1; frame--)
+				ResolveGpuScopes(frame);
+
+		const unsigned long long next = previous + 1;
+		FrameSlot& slot = Frames[next % FrameRingSize];
+		slot.FrameNumber.store(next, std::memory_order_relaxed);
+		slot.BeginUs = now;
+		slot.EndUs = now;
+		slot.CpuScopeCount.store(0, std::memory_order_relaxed);
+		slot.Counters.fill(0);
+		slot.GpuScopes.clear();
+		slot.ResolvedGpuScopes.clear();
+		slot.bGpuResolved = false;
+		GpuDepth = 0;
+
+		if (bGpuTimingEnabled && IsGpuThread())
+		{
+			GLint64 gpuTimestamp = 0;
+			glGetInteger64v(GL_TIMESTAMP, &gpuTimestamp);
+			slot.GpuOffsetUs = now - static_cast<double>(gpuTimestamp) / 1000.0;
+		}
+
+		CurrentFrame.store(next, std::memory_order_release);
+	}
+
+	void Profiler::SetEnabled(bool enabled)
+	{
+		bEnabled = enabled;
+	}
+
+	bool Profiler::IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	void Profiler::SetGpuTimingEnabled(bool enabled)
+	{
+		if (enabled == bGpuTimingEnabled)
+			return;
+
+		if (enabled)
+		{
+			if (!GLAD_GL_VERSION_3_3 || !glQueryCounter)
+			{
+				std::cout << "INFO: GL timer queries are not supported by the current context. Only CPU scopes will be profiled.\n";
+				return;
+			}
+			GpuThreadID = GetThreadID();
+			GpuDepth = 0;
+			bGpuTimingEnabled = true;
+			return;
+		}
+
+		bGpuTimingEnabled = false;
+		for (unsigned int i = 0; i < FrameRingSize; i++)
+		{
+			FrameSlot& slot = Frames[i];
+			if (!slot.Queries.empty())
+				glDeleteQueries(static_cast<GLsizei>(slot.Queries.size()), slot.Queries.data());
+			slot.Queries.clear();
+			slot.GpuScopes.clear();
+			slot.bGpuResolved = true;
+		}
+	}
+
+	bool Profiler::IsGpuTimingEnabled() const
+	{
+		return bGpuTimingEnabled;
+	}
+
+	void Profiler::AddToCounter(ProfilerCounter counter, unsigned long long amount)
+	{
+		Counters[static_cast<unsigned int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+	}
+
+	bool Profiler::GetFrame(unsigned int framesAgo, ProfilerFrame& result) const
+	{
+		const unsigned long long current = CurrentFrame.load(std::memory_order_acquire);
+		if (current <= static_cast<unsigned long long>(framesAgo) + 1 || framesAgo >= FrameRingSize - 1)
+			return false;
+
+		const unsigned long long frameNumber = current - 1 - framesAgo;
+		const FrameSlot& slot = Frames[frameNumber % FrameRingSize];
+		if (slot.FrameNumber.load(std::memory_order_relaxed) != frameNumber)
+			return false;
+
+		result.FrameNumber = frameNumber;
+		result.BeginUs = slot.BeginUs;
+		result.EndUs = slot.EndUs;
+		result.Counters = slot.Counters;
+		result.GpuScopes = slot.ResolvedGpuScopes;
+		result.CpuScopes.clear();
+
+		const unsigned int count = std::min(slot.CpuScopeCount.load(std::memory_order_acquire), MaxCpuScopesPerFrame);
+		result.CpuScopes.reserve(count);
+		for (unsigned int i = 0; i < count; i++)
+			if (slot.CpuScopes[i].CommittedFrame.load(std::memory_order_acquire) == frameNumber)
+				result.CpuScopes.push_back(slot.CpuScopes[i].Record);
+
+		std::sort(result.CpuScopes.begin(), result.CpuScopes.end(), [](const ProfilerScopeRecord& lhs, const ProfilerScopeRecord& rhs) { return lhs.BeginUs < rhs.BeginUs; });	//Scopes are recorded when they end
+		return true;
+	}
+
+	std::vector<std::string> Profiler::GetFrameSummary(unsigned int maxDepth) const
+	{
+		std::vector<std::string> lines;
+		ProfilerFrame frame;
+		if (!GetFrame(0, frame))
+			return lines;
+
+		auto formatMs = [](double us) { std::stringstream str; str << std::fixed << std::setprecision(2) << us / 1000.0 << " ms"; return str.str(); };
+		auto aggregate = [&](const std::vector<ProfilerScopeRecord>& scopes, const std::string& prefix)
+		{
+			std::vector<std::pair<const ProfilerScopeRecord*, double>> totals;	//In the order of the first occurrence
+			for (auto& scope : scopes)
+			{
+				if (scope.Depth > maxDepth)
+					continue;
+				auto found = std::find_if(totals.begin(), totals.end(), [&scope](const std::pair<const ProfilerScopeRecord*, double>& total) { return total.first->Depth == scope.Depth && std::string(total.first->Name) == scope.Name; });
+				if (found == totals.end())
+					totals.push_back(std::pair<const ProfilerScopeRecord*, double>(&scope, scope.EndUs - scope.BeginUs));
+				else
+					found->second += scope.EndUs - scope.BeginUs;
+			}
+			for (auto& total : totals)
+				lines.push_back(prefix + std::string(total.first->Depth * 2, ' ') + total.first->Name + ": " + formatMs(total.second));
+		};
+
+		const double frameUs = frame.EndUs - frame.BeginUs;
+		lines.push_back("Frame " + std::to_string(frame.FrameNumber) + ": " + formatMs(frameUs) + ((frameUs > 0.0) ? (" (" + std::to_string(static_cast<int>(1000000.0 / frameUs)) + " FPS)") : ("")));
+		aggregate(frame.CpuScopes, "CPU ");
+		aggregate(frame.GpuScopes, "GPU ");
+		for (unsigned int i = 0; i < ProfilerCounterCount; i++)
+			lines.push_back(std::string(GetCounterName(static_cast<ProfilerCounter>(i))) + ": " + std::to_string(frame.Counters[i]));
+
+		return lines;
+	}
+
+	bool Profiler::ExportChromeTrace(const std::string& filepath) const
+	{
+		std::ofstream file(filepath);
+		if (!file.is_open())
+		{
+			std::cout << "ERROR! Cannot open " << filepath << " to export the profiler trace.\n";
+			return false;
+		}
+
+		file << std::fixed << std::setprecision(3);
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"CPU\"}},\n";
+		file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"GPU\"}}";
+
+		std::vector<unsigned int> namedThreads;
+		unsigned int exportedFrames = 0;
+		for (unsigned int framesAgo = FrameRingSize - 2; ; framesAgo--)	//From the oldest frame
+		{
+			ProfilerFrame frame;
+			if (GetFrame(framesAgo, frame))
+			{
+				exportedFrames++;
+				for (auto& scope : frame.CpuScopes)
+				{
+					if (std::find(namedThreads.begin(), namedThreads.end(), scope.ThreadID) == namedThreads.end())
+					{
+						namedThreads.push_back(scope.ThreadID);
+						file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << scope.ThreadID << ",\"args\":{\"name\":\"" << ((scope.ThreadID == MainThreadID) ? ("Main thread") : ("Thread " + std::to_string(scope.ThreadID))) << "\"}}";
+					}
+					file << ",\n{\"name\":\"" << EscapeJson(scope.Name) << "\",\"cat\":\"CPU\",\"ph\":\"X\",\"pid\":0,\"tid\":" << scope.ThreadID << ",\"ts\":" << scope.BeginUs << ",\"dur\":" << scope.EndUs - scope.BeginUs << "}";
+				}
+				for (auto& scope : frame.GpuScopes)
+					file << ",\n{\"name\":\"" << EscapeJson(scope.Name) << "\",\"cat\":\"GPU\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":" << scope.BeginUs << ",\"dur\":" << scope.EndUs - scope.BeginUs << "}";
+
+				file << ",\n{\"name\":\"Frame counters\",\"ph\":\"C\",\"pid\":0,\"ts\":" << frame.BeginUs << ",\"args\":{";
+				for (unsigned int i = 0; i < ProfilerCounterCount; i++)
+					file << ((i > 0) ? (",") : ("")) << "\"" << GetCounterName(static_cast<ProfilerCounter>(i)) << "\":" << frame.Counters[i];
+				file << "}}";
+			}
+
+			if (framesAgo == 0)
+				break;
+		}
+
+		file << "\n]}\n";
+		std::cout << "INFO: Exported " << exportedFrames << " profiled frames to " << filepath << ".\n";
+		return true;
+	}
+
+	double Profiler::GetTimeUs() const
+	{
+		const long long nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		return static_cast<double>(nowNs - StartTimeNs) / 1000.0;
+	}
+
+	unsigned int Profiler::GetThreadID()
+	{
+		static std::atomic<unsigned int> nextThreadID(0);
+		thread_local unsigned int threadID = nextThreadID.fetch_add(1);
+		return threadID;
+	}
+
+	void Profiler::RecordCpuScope(const ProfilerScopeRecord& record)
+	{
+		const unsigned long long frame = CurrentFrame.load(std::memory_order_acquire);
+		if (frame == 0)
+			return;
+
+		FrameSlot& slot = Frames[frame % FrameRingSize];
+		const unsigned int index = slot.CpuScopeCount.fetch_add(1, std::memory_order_relaxed);
+		if (index >= MaxCpuScopesPerFrame)	//Drop the scope rather than wait
+			return;
+
+		slot.CpuScopes[index].Record = record;
+		slot.CpuScopes[index].CommittedFrame.store(frame, std::memory_order_release);
+	}
+
+	unsigned int Profiler::BeginGpuScope(const char* name)
+	{
+		const unsigned long long frame = CurrentFrame.load(std::memory_order_relaxed);
+		if (!bEnabled || !bGpuTimingEnabled || frame == 0 || !IsGpuThread())
+			return static_cast<unsigned int>(-1);
+
+		FrameSlot& slot = Frames[frame % FrameRingSize];
+		const unsigned int queryIndex = static_cast<unsigned int>(slot.GpuScopes.size()) * 2;
+		if (slot.Queries.size() < queryIndex + 2)
+		{
+			slot.Queries.resize(queryIndex + 2);
+			glGenQueries(2, &slot.Queries[queryIndex]);
+		}
+
+		glQueryCounter(slot.Queries[queryIndex], GL_TIMESTAMP);
+		slot.GpuScopes.push_back(GpuScopeSlot{ name, GpuDepth++, queryIndex });
+		return static_cast<unsigned int>(slot.GpuScopes.size()) - 1;
+	}
+
+	void Profiler::EndGpuScope(unsigned int scopeIndex)
+	{
+		if (scopeIndex == static_cast<unsigned int>(-1) || !bGpuTimingEnabled)
+			return;
+
+		FrameSlot& slot = Frames[CurrentFrame.load(std::memory_order_relaxed) % FrameRingSize];
+		if (scopeIndex >= slot.GpuScopes.size())	//The frame has changed inside the scope
+			return;
+
+		glQueryCounter(slot.Queries[slot.GpuScopes[scopeIndex].QueryIndex + 1], GL_TIMESTAMP);
+		if (GpuDepth > 0)
+			GpuDepth--;
+	}
+
+	void Profiler::ResolveGpuScopes(unsigned long long frameNumber)
+	{
+		FrameSlot& slot = Frames[frameNumber % FrameRingSize];
+		if (slot.bGpuResolved || slot.FrameNumber.load(std::memory_order_relaxed) != frameNumber)
+			return;
+
+		for (auto& scope : slot.GpuScopes)	//Never wait for the GPU - try again next frame
+		{
+			GLint available = 0;
+			glGetQueryObjectiv(slot.Queries[scope.QueryIndex + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return;
+		}
+
+		slot.ResolvedGpuScopes.reserve(slot.GpuScopes.size());
+		for (auto& scope : slot.GpuScopes)
+		{
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(slot.Queries[scope.QueryIndex], GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(slot.Queries[scope.QueryIndex + 1], GL_QUERY_RESULT, &end);
+			slot.ResolvedGpuScopes.push_back(ProfilerScopeRecord{ scope.Name, static_cast<double>(begin) / 1000.0 + slot.GpuOffsetUs, static_cast<double>(end) / 1000.0 + slot.GpuOffsetUs, GpuThreadID, scope.Depth });
+		}
+		slot.bGpuResolved = true;
+	}
+
+	bool Profiler::IsGpuThread() const
+	{
+		return GetThreadID() == GpuThreadID;
+	}
+
+	ProfilerCpuScope::ProfilerCpuScope(const char* name) :
+		bActive(Profiler::Get().IsEnabled())
+	{
+		if (!bActive)
+			return;
+
+		Record.Name = name;
+		Record.ThreadID = Profiler::GetThreadID();
+		Record.Depth = ThreadCpuDepth++;
+		Record.BeginUs = Profiler::Get().GetTimeUs();
+	}
+
+	ProfilerCpuScope::~ProfilerCpuScope()
+	{
+		if (!bActive)
+			return;
+
+		Record.EndUs = Profiler::Get().GetTimeUs();
+		ThreadCpuDepth--;
+		Profiler::Get().RecordCpuScope(Record);
+	}
+
+	ProfilerGpuScope::ProfilerGpuScope(const char* name) :
+		ScopeIndex(Profiler::Get().BeginGpuScope(name))
+	{
+	}
+
+	ProfilerGpuScope::~ProfilerGpuScope()
+	{
+		Profiler::Get().EndGpuScope(ScopeIndex);
+	}
+}
@@ -1,4 +1,5 @@
 #include <utility/Utility.h>
+#include <utility/Profiler.h>
 #include <functional>
 
 namespace GEE
@@ -15,6 +16,8 @@ namespace GEE
 
 		glBindBuffer(GL_UNIFORM_BUFFER, UBO);
 		glBufferData(GL_UNIFORM_BUFFER, size, data, usage);
+		if (data)
+			GEE_PROFILE_COUNT(BUFFER_BYTES_UPLOADED, size);
 		glBindBufferBase(GL_UNIFORM_BUFFER, blockBindingSlot, UBO);
 
 		offsetCache = 0;
@@ -28,6 +31,7 @@ namespace GEE
 	{
 		glBindBuffer(GL_UNIFORM_BUFFER, UBO);
 		glBufferSubData(GL_UNIFORM_BUFFER, offset, sizeof(int), &data);
+		GEE_PROFILE_COUNT(BUFFER_BYTES_UPLOADED, sizeof(int));
 		offsetCache = offset + sizeof(int);
 	}
 	void UniformBuffer::SubData1f(float data, size_t offset)
@@ -38,6 +42,7 @@ namespace GEE
 	{
 		glBindBuffer(GL_UNIFORM_BUFFER, UBO);
 		glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+		GEE_PROFILE_COUNT(BUFFER_BYTES_UPLOADED, size);
 		offsetCache = offset + size;
 	}
 
@@ -46,7 +51,7 @@ namespace GEE
 		glm::vec4 bufferVector(vec, 0.0f);
 		SubData(sizeof(glm::vec4), glm::value_ptr(bufferVector), offset);
 	}
-	void UniformBuffer::SubData4fv(std::vector<glm::vec3> vecs, size_t offset)
+	void UniformBuffer::SubData4fv(const std::vector<glm::vec3>& vecs, size_t offset)
 	{
 		offsetCache = offset;
 		for (unsigned int i = 0; i < vecs.size(); i++)
@@ -56,7 +61,7 @@ namespace GEE
 	{
 		SubData(sizeof(glm::vec4), glm::value_ptr(vec), offset);
 	}
-	void UniformBuffer::SubData4fv(std::vector<glm::vec4> vecs, size_t offset)
+	void UniformBuffer::SubData4fv(const std::vector<glm::vec4>& vecs, size_t offset)
 	{
 		offsetCache = offset;
 		for (unsigned int i = 0; i < vecs.size(); i++)